@@ -77,6 +77,8 @@ typedef struct mbedtls_aes_context {
                                                     case by generating an extra round key.
                                                     </li></ul> */
 #endif /* MBEDTLS_AES_ONLY_128_BIT_KEY_LENGTH && !MBEDTLS_PADLOCK_C */
+    unsigned char MBEDTLS_PRIVATE(acceleration); /*!< The implementation selected
+                                                    when the key was set. */
 }
 mbedtls_aes_context;
 
@@ -170,6 +170,11 @@
 #error "MBEDTLS_ECJPAKE_C defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_ED25519_C) && \
+    ( !defined(MBEDTLS_BIGNUM_C) || !defined(MBEDTLS_SHA512_C) )
+#error "MBEDTLS_ED25519_C defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_ECP_RESTARTABLE)           && \
     ( defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT) || \
       defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT)     || \
@@ -190,6 +195,11 @@
 #error "MBEDTLS_ECDSA_DETERMINISTIC defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL) && \
+    (!defined(MBEDTLS_ECDSA_C) || defined(MBEDTLS_ECDSA_SIGN_ALT))
+#error "MBEDTLS_ECDSA_NONCE_POOL defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_ECP_LIGHT) && ( !defined(MBEDTLS_BIGNUM_C) || (    \
     !defined(MBEDTLS_ECP_DP_SECP192R1_ENABLED) &&                  \
     !defined(MBEDTLS_ECP_DP_SECP224R1_ENABLED) &&                  \
@@ -970,6 +980,17 @@
 #error "MBEDTLS_SSL_SERVER_NAME_INDICATION defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_SSL_CERT_STORE_C) && \
+    ( !defined(MBEDTLS_SSL_SERVER_NAME_INDICATION) || \
+      !defined(MBEDTLS_PK_PARSE_C) )
+#error "MBEDTLS_SSL_CERT_STORE_C defined, but not all prerequisites"
+#endif
+
+#if defined(MBEDTLS_SSL_CERT_STORE_MAX_MATCHES) && \
+    ( MBEDTLS_SSL_CERT_STORE_MAX_MATCHES < 1 || MBEDTLS_SSL_CERT_STORE_MAX_MATCHES > 255 )
+#error "MBEDTLS_SSL_CERT_STORE_MAX_MATCHES must be in the range(1..255)"
+#endif
+
 #if defined(MBEDTLS_THREADING_PTHREAD)
 #if !defined(MBEDTLS_THREADING_C) || defined(MBEDTLS_THREADING_IMPL)
 #error "MBEDTLS_THREADING_PTHREAD defined, but not all prerequisites"
@@ -987,6 +1008,10 @@
 #endif
 #undef MBEDTLS_THREADING_IMPL // temporary macro defined above
 
+#if defined(MBEDTLS_THREADING_STATS) && !defined(MBEDTLS_THREADING_PTHREAD)
+#error "MBEDTLS_THREADING_STATS defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO) && !defined(MBEDTLS_PSA_CRYPTO_CLIENT)
 #error "MBEDTLS_USE_PSA_CRYPTO defined, but not all prerequisites"
 #endif
@@ -931,8 +931,10 @@ int mbedtls_cipher_update_ad(mbedtls_cipher_context_t *ctx,
  *                      Any data that cannot be written immediately is either
  *                      added to the next block, or flushed when
  *                      mbedtls_cipher_finish() is called.
- *                      Exception: For MBEDTLS_MODE_ECB, expects a single block
- *                      in size. For example, 16 Bytes for AES.
+ *                      Exception: For MBEDTLS_MODE_ECB, expects a non-zero
+ *                      multiple of the block size (for example, 16 Bytes for
+ *                      AES), and processes all of it. Passing several blocks
+ *                      at once is more efficient than one call per block.
  *
  * \param ctx           The generic cipher context. This must be initialized and
  *                      bound to a key.
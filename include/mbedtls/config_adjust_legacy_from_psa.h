@@ -287,6 +287,17 @@
 #endif /* missing accel */
 #endif /* PSA_WANT_ALG_ECDSA */
 
+#if defined(PSA_WANT_ALG_PURE_EDDSA) && defined(PSA_WANT_ECC_TWISTED_EDWARDS_255)
+#if !defined(MBEDTLS_PSA_ACCEL_ALG_PURE_EDDSA) || \
+    !defined(MBEDTLS_PSA_ACCEL_ECC_TWISTED_EDWARDS_255)
+#define MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA 1
+#define MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255 1
+#define MBEDTLS_ED25519_C
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_SHA512_C
+#endif /* missing accel */
+#endif /* PSA_WANT_ALG_PURE_EDDSA && PSA_WANT_ECC_TWISTED_EDWARDS_255 */
+
 #if defined(PSA_WANT_ALG_JPAKE)
 #if !defined(MBEDTLS_PSA_ACCEL_ALG_JPAKE) || \
     !defined(MBEDTLS_PSA_ACCEL_ECC_SECP_R1_256) || \
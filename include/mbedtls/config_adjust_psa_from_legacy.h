@@ -305,6 +305,13 @@
 #define PSA_WANT_ECC_MONTGOMERY_448 1
 #endif
 
+#if defined(MBEDTLS_ED25519_C)
+#define MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA 1
+#define PSA_WANT_ALG_PURE_EDDSA 1
+#define MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255 1
+#define PSA_WANT_ECC_TWISTED_EDWARDS_255 1
+#endif
+
 #if defined(MBEDTLS_ECP_DP_SECP192R1_ENABLED)
 #define MBEDTLS_PSA_BUILTIN_ECC_SECP_R1_192 1
 #define PSA_WANT_ECC_SECP_R1_192 1
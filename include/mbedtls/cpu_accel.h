@@ -0,0 +1,102 @@
+/**
+ * \file cpu_accel.h
+ *
+ * \brief Report and override the use of processor acceleration.
+ *
+ * Some primitives have an implementation that uses optional processor
+ * instructions: AES-NI and PCLMULQDQ (#MBEDTLS_AESNI_C), the Armv8-A
+ * Cryptographic Extension (#MBEDTLS_AESCE_C,
+ * #MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT,
+ * #MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT) and VIA Padlock
+ * (#MBEDTLS_PADLOCK_C). Unless the library is built to use these
+ * instructions unconditionally, it checks at runtime whether the processor
+ * supports them and otherwise falls back to portable C code.
+ *
+ * The functions in this module report which implementation is in use, so
+ * that a deployment can check that it benefits from hardware acceleration,
+ * and can force the portable implementation, for example to measure the
+ * difference.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_CPU_ACCEL_H
+#define MBEDTLS_CPU_ACCEL_H
+
+#include "mbedtls/build_info.h"
+
+/** The AES block cipher (key schedule and block encryption/decryption). */
+#define MBEDTLS_CPU_ACCEL_AES       0x01u
+/** The multiplication in GF(2^128) used by GCM. */
+#define MBEDTLS_CPU_ACCEL_GHASH     0x02u
+/** The SHA-224 and SHA-256 compression function. */
+#define MBEDTLS_CPU_ACCEL_SHA256    0x04u
+/** The SHA-384 and SHA-512 compression function. */
+#define MBEDTLS_CPU_ACCEL_SHA512    0x08u
+/** All the primitives above. */
+#define MBEDTLS_CPU_ACCEL_ALL       0x0fu
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief           Get the implementation currently selected for a primitive.
+ *
+ * \param primitive One of the \c MBEDTLS_CPU_ACCEL_xxx values, other than
+ *                  #MBEDTLS_CPU_ACCEL_ALL.
+ *
+ * \return          A static string naming the implementation:
+ *                  - \c "c" for the portable implementation;
+ *                  - \c "aesni", \c "aesce", \c "padlock" or
+ *                    \c "armv8-a-crypto" for an implementation using the
+ *                    corresponding processor instructions;
+ *                  - \c "alt" for an alternative implementation
+ *                    (\c MBEDTLS_xxx_ALT).
+ * \return          \c NULL if \p primitive is not a valid primitive or is
+ *                  not included in the build.
+ */
+const char *mbedtls_cpu_accel_get_implementation(unsigned int primitive);
+
+/**
+ * \brief           Force the portable implementation of some primitives.
+ *
+ *                  This replaces the set of primitives requested by
+ *                  previous calls: pass \c 0 to go back to using processor
+ *                  acceleration wherever it is available.
+ *
+ * \warning         This function is not thread-safe. Call it before using
+ *                  the library, or at least while no other thread is using
+ *                  it. The implementation of AES and GHASH is chosen when
+ *                  a key is set up: contexts that have a key already (AES,
+ *                  GCM, and the PSA keys and TLS connections that use them)
+ *                  keep using the previous implementation until their key
+ *                  is set again.
+ *
+ * \param primitives A combination of \c MBEDTLS_CPU_ACCEL_xxx values.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED if
+ *                  \p primitives contains an unknown value, or a primitive
+ *                  with no portable implementation in this build, for
+ *                  example AES with #MBEDTLS_AES_USE_HARDWARE_ONLY or an
+ *                  alternative implementation. In this case, the previous
+ *                  setting is kept.
+ */
+int mbedtls_cpu_accel_set_portable(unsigned int primitives);
+
+/**
+ * \brief           Get the set of primitives for which the portable
+ *                  implementation is forced.
+ *
+ * \return          The value last set with mbedtls_cpu_accel_set_portable(),
+ *                  or \c 0 if it was never called.
+ */
+unsigned int mbedtls_cpu_accel_get_portable(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_CPU_ACCEL_H */
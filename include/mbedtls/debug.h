@@ -22,30 +22,50 @@
 
 #define MBEDTLS_DEBUG_STRIP_PARENS(...)   __VA_ARGS__
 
+/* The level is checked inline, so that the arguments of messages that
+ * are not output are neither evaluated nor formatted. */
+#define MBEDTLS_SSL_DEBUG_CALL(level, call)                    \
+    do {                                                        \
+        if (mbedtls_debug_is_enabled(ssl, level)) {             \
+            call;                                               \
+        }                                                       \
+    } while (0)
+
 #define MBEDTLS_SSL_DEBUG_MSG(level, args)                    \
-    mbedtls_debug_print_msg(ssl, level, __FILE__, __LINE__,    \
-                            MBEDTLS_DEBUG_STRIP_PARENS args)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_msg(ssl, level, __FILE__, __LINE__, \
+                                                   MBEDTLS_DEBUG_STRIP_PARENS args))
 
 #define MBEDTLS_SSL_DEBUG_RET(level, text, ret)                \
-    mbedtls_debug_print_ret(ssl, level, __FILE__, __LINE__, text, ret)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_ret(ssl, level, __FILE__, __LINE__, \
+                                                   text, ret))
 
 #define MBEDTLS_SSL_DEBUG_BUF(level, text, buf, len)           \
-    mbedtls_debug_print_buf(ssl, level, __FILE__, __LINE__, text, buf, len)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_buf(ssl, level, __FILE__, __LINE__, \
+                                                   text, buf, len))
 
 #if defined(MBEDTLS_BIGNUM_C)
 #define MBEDTLS_SSL_DEBUG_MPI(level, text, X)                  \
-    mbedtls_debug_print_mpi(ssl, level, __FILE__, __LINE__, text, X)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_mpi(ssl, level, __FILE__, __LINE__, \
+                                                   text, X))
 #endif
 
 #if defined(MBEDTLS_ECP_C)
 #define MBEDTLS_SSL_DEBUG_ECP(level, text, X)                  \
-    mbedtls_debug_print_ecp(ssl, level, __FILE__, __LINE__, text, X)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_ecp(ssl, level, __FILE__, __LINE__, \
+                                                   text, X))
 #endif
 
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 #if !defined(MBEDTLS_X509_REMOVE_INFO)
 #define MBEDTLS_SSL_DEBUG_CRT(level, text, crt)                \
-    mbedtls_debug_print_crt(ssl, level, __FILE__, __LINE__, text, crt)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_print_crt(ssl, level, __FILE__, __LINE__, \
+                                                   text, crt))
 #else
 #define MBEDTLS_SSL_DEBUG_CRT(level, text, crt)       do { } while (0)
 #endif /* MBEDTLS_X509_REMOVE_INFO */
@@ -53,7 +73,9 @@
 
 #if defined(MBEDTLS_ECDH_C)
 #define MBEDTLS_SSL_DEBUG_ECDH(level, ecdh, attr)               \
-    mbedtls_debug_printf_ecdh(ssl, level, __FILE__, __LINE__, ecdh, attr)
+    MBEDTLS_SSL_DEBUG_CALL(level,                              \
+                           mbedtls_debug_printf_ecdh(ssl, level, __FILE__, __LINE__, \
+                                                     ecdh, attr))
 #endif
 
 #else /* MBEDTLS_DEBUG_C */
@@ -132,6 +154,47 @@
 extern "C" {
 #endif
 
+/**
+ * \brief   Type of a structured debug event
+ */
+typedef enum {
+    MBEDTLS_DEBUG_EVENT_MSG = 0,    /*!< Message: \c text is its printf format
+                                         string, see mbedtls_debug_event_format() */
+    MBEDTLS_DEBUG_EVENT_RET,        /*!< Return code: \c text is the name of
+                                         the function, \c ret its return value */
+    MBEDTLS_DEBUG_EVENT_BUF,        /*!< Buffer: \c data and \c len           */
+    MBEDTLS_DEBUG_EVENT_MPI,        /*!< Big number: \c data is its big-endian
+                                         value, without leading zeros         */
+    MBEDTLS_DEBUG_EVENT_ECP,        /*!< Elliptic curve point: \c data is the
+                                         big-endian X and Y coordinates, each
+                                         of \c len / 2 bytes                  */
+    MBEDTLS_DEBUG_EVENT_CRT,        /*!< Certificate: \c data is its DER
+                                         encoding, one event per certificate
+                                         of a chain                           */
+} mbedtls_debug_event_type;
+
+/**
+ * \brief   Structured debug event, passed to the callback set with
+ *          mbedtls_ssl_conf_dbg_event()
+ *
+ *          The event and the data it points to are only valid during the
+ *          callback.
+ */
+struct mbedtls_debug_event {
+    mbedtls_debug_event_type type;  /*!< type of the event                    */
+    int level;                      /*!< debug level                          */
+    const char *file;               /*!< file the event occurred in           */
+    int line;                       /*!< line number the event occurred at    */
+    const char *text;               /*!< format string, function name or label
+                                         depending on \c type                 */
+    int ret;                        /*!< return value, for
+                                         #MBEDTLS_DEBUG_EVENT_RET              */
+    const unsigned char *data;      /*!< binary value, or NULL if none or if
+                                         it is too large to be output         */
+    size_t len;                     /*!< length of \c data in bytes           */
+    void *MBEDTLS_PRIVATE(args);    /*!< arguments of a message, if any       */
+};
+
 /**
  * \brief   Set the threshold error level to handle globally all debug output.
  *          Debug messages that have a level over the threshold value are
@@ -149,6 +212,22 @@ extern "C" {
  */
 void mbedtls_debug_set_threshold(int threshold);
 
+/**
+ * \brief   Format the message of a #MBEDTLS_DEBUG_EVENT_MSG event, as it
+ *          would be passed to the callback set with mbedtls_ssl_conf_dbg(),
+ *          but without the final newline. This may only be called from the
+ *          structured debug callback.
+ *
+ * \param event     Debug event
+ * \param buf       Buffer to write the message to
+ * \param buf_size  Size of \p buf in bytes
+ *
+ * \return  The length of the message, as returned by mbedtls_snprintf(),
+ *          or a negative value if \p event is not a message.
+ */
+int mbedtls_debug_event_format(const mbedtls_debug_event *event,
+                               char *buf, size_t buf_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,10 @@
 #include "mbedtls/ecp.h"
 #include "mbedtls/md.h"
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL) && defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+
 /**
  * \brief           Maximum ECDSA signature size for a given curve bit size
  *
@@ -112,6 +116,37 @@ typedef void mbedtls_ecdsa_restart_ctx;
 
 #endif /* MBEDTLS_ECP_RESTARTABLE */
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+/**
+ * \brief           Pool of precomputed ECDSA nonces
+ *
+ *                  Each entry holds r = x(k * G) mod n for a fresh random
+ *                  k, together with a random blinding value t and
+ *                  (k * t)^-1 mod n. An entry is removed from the pool
+ *                  before it is used, and wiped afterwards, so that each
+ *                  nonce is used for exactly one signature.
+ *
+ *                  Entries inherited by a child process after fork() are
+ *                  discarded rather than used, since the parent may use
+ *                  them as well.
+ *
+ * \note            If #MBEDTLS_THREADING_C is enabled, a pool may be filled
+ *                  by one thread while other threads consume it.
+ */
+typedef struct mbedtls_ecdsa_nonce_pool {
+    mbedtls_ecp_group MBEDTLS_PRIVATE(grp);         /*!< Group of the nonces */
+    size_t MBEDTLS_PRIVATE(capacity);               /*!< Number of slots */
+    size_t MBEDTLS_PRIVATE(count);                  /*!< Number of entries */
+    mbedtls_mpi *MBEDTLS_PRIVATE(kt_inv);           /*!< (k * t)^-1 mod n */
+    mbedtls_mpi *MBEDTLS_PRIVATE(t);                /*!< Blinding value t */
+    mbedtls_mpi *MBEDTLS_PRIVATE(r);                /*!< x(k * G) mod n */
+    long MBEDTLS_PRIVATE(pid);                      /*!< Process that filled the pool */
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_threading_mutex_t MBEDTLS_PRIVATE(mutex);
+#endif
+} mbedtls_ecdsa_nonce_pool;
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 /**
  * \brief          This function checks whether a given group can be used
  *                 for ECDSA.
@@ -209,6 +244,56 @@ int mbedtls_ecdsa_sign_det_ext(mbedtls_ecp_group *grp, mbedtls_mpi *r,
                                mbedtls_md_type_t md_alg,
                                int (*f_rng_blind)(void *, unsigned char *, size_t),
                                void *p_rng_blind);
+
+/**
+ * \brief           This function computes the ECDSA signature of a
+ *                  previously-hashed message, hedged version.
+ *
+ *                  The nonce is derived as in mbedtls_ecdsa_sign_det_ext(),
+ *                  with fresh output of \p f_rng mixed in as the additional
+ *                  data \c k' described in <em>RFC-6979</em>, section 3.6.
+ *                  The result is not deterministic, but the nonce remains
+ *                  secret even if \p f_rng is weak or fails to produce
+ *                  unpredictable output, and a fault in one signature is
+ *                  not reproduced when the same message is signed again.
+ *
+ * \note            If the bitlength of the message hash is larger than the
+ *                  bitlength of the group order, then the hash is truncated as
+ *                  defined in <em>Standards for Efficient Cryptography Group
+ *                  (SECG): SEC1 Elliptic Curve Cryptography</em>, section
+ *                  4.1.3, step 5.
+ *
+ * \see             ecp.h
+ *
+ * \param grp       The context for the elliptic curve to use.
+ *                  This must be initialized and have group parameters
+ *                  set, for example through mbedtls_ecp_group_load().
+ * \param r         The MPI context in which to store the first part
+ *                  the signature. This must be initialized.
+ * \param s         The MPI context in which to store the second part
+ *                  the signature. This must be initialized.
+ * \param d         The private signing key. This must be initialized
+ *                  and setup, for example through mbedtls_ecp_gen_privkey().
+ * \param buf       The hashed content to be signed. This must be a readable
+ *                  buffer of length \p blen Bytes. It may be \c NULL if
+ *                  \p blen is zero.
+ * \param blen      The length of \p buf in Bytes.
+ * \param md_alg    The hash algorithm used to hash the original data.
+ * \param f_rng     The RNG function, used both for the additional data and
+ *                  for blinding. This must not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context parameter.
+ *
+ * \return          \c 0 on success.
+ * \return          An \c MBEDTLS_ERR_ECP_XXX or \c MBEDTLS_MPI_XXX
+ *                  error code on failure.
+ */
+int mbedtls_ecdsa_sign_hedged(mbedtls_ecp_group *grp, mbedtls_mpi *r,
+                              mbedtls_mpi *s, const mbedtls_mpi *d,
+                              const unsigned char *buf, size_t blen,
+                              mbedtls_md_type_t md_alg,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void *p_rng);
 #endif /* MBEDTLS_ECDSA_DETERMINISTIC */
 
 #if !defined(MBEDTLS_ECDSA_SIGN_ALT)
@@ -524,6 +609,158 @@ int mbedtls_ecdsa_write_signature_restartable(mbedtls_ecdsa_context *ctx,
                                               void *p_rng,
                                               mbedtls_ecdsa_restart_ctx *rs_ctx);
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+/**
+ * \brief           Initialize a nonce pool.
+ *
+ * \param pool      The pool to initialize. This must not be \c NULL.
+ */
+void mbedtls_ecdsa_nonce_pool_init(mbedtls_ecdsa_nonce_pool *pool);
+
+/**
+ * \brief           Set up a nonce pool for a given curve.
+ *
+ * \param pool      The pool to set up. This must be initialized.
+ * \param grp_id    The curve that the nonces will be used with.
+ * \param capacity  The maximum number of nonces held by the pool.
+ *                  This must not be \c 0.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA if \p grp_id cannot be
+ *                  used for ECDSA or \p capacity is \c 0.
+ * \return          #MBEDTLS_ERR_ECP_ALLOC_FAILED on allocation failure.
+ * \return          Another \c MBEDTLS_ERR_ECP_XXX error code if the curve
+ *                  cannot be loaded.
+ */
+int mbedtls_ecdsa_nonce_pool_setup(mbedtls_ecdsa_nonce_pool *pool,
+                                   mbedtls_ecp_group_id grp_id,
+                                   size_t capacity);
+
+/**
+ * \brief           Compute nonces and add them to a pool.
+ *
+ *                  This is the expensive part of signing. Call it when the
+ *                  application is idle, or from a separate thread. Only
+ *                  one thread at a time may fill a given pool.
+ *
+ * \param pool      The pool to fill. This must be set up.
+ * \param max_count The maximum number of nonces to add. Fewer are added
+ *                  if the pool becomes full.
+ * \param f_rng     The RNG function used to generate the nonces and for
+ *                  blinding. This must not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context parameter.
+ *
+ * \return          \c 0 on success.
+ * \return          An \c MBEDTLS_ERR_ECP_XXX or \c MBEDTLS_MPI_XXX
+ *                  error code on failure.
+ */
+int mbedtls_ecdsa_nonce_pool_fill(mbedtls_ecdsa_nonce_pool *pool,
+                                  size_t max_count,
+                                  int (*f_rng)(void *, unsigned char *, size_t),
+                                  void *p_rng);
+
+/**
+ * \brief           Return the number of nonces currently in a pool.
+ *
+ * \param pool      The pool to query. This must be set up.
+ *
+ * \return          The number of nonces available.
+ */
+size_t mbedtls_ecdsa_nonce_pool_count(mbedtls_ecdsa_nonce_pool *pool);
+
+/**
+ * \brief           Free a nonce pool, wiping the nonces it still holds.
+ *
+ * \param pool      The pool to free. This may be \c NULL, in which case
+ *                  this function does nothing. If it is not \c NULL, it
+ *                  must be initialized.
+ */
+void mbedtls_ecdsa_nonce_pool_free(mbedtls_ecdsa_nonce_pool *pool);
+
+/**
+ * \brief           This function computes the ECDSA signature of a
+ *                  previously-hashed message, using a precomputed nonce.
+ *
+ *                  One nonce is taken out of \p pool. If the pool is empty,
+ *                  this function behaves like mbedtls_ecdsa_sign() with
+ *                  \p f_rng.
+ *
+ * \note            If the bitlength of the message hash is larger than the
+ *                  bitlength of the group order, then the hash is truncated
+ *                  as defined in <em>Standards for Efficient Cryptography
+ *                  Group (SECG): SEC1 Elliptic Curve Cryptography</em>,
+ *                  section 4.1.3, step 5.
+ *
+ * \param grp       The context for the elliptic curve to use.
+ *                  This must be initialized and have group parameters
+ *                  set, for example through mbedtls_ecp_group_load().
+ * \param r         The MPI context in which to store the first part
+ *                  the signature. This must be initialized.
+ * \param s         The MPI context in which to store the second part
+ *                  the signature. This must be initialized.
+ * \param d         The private signing key. This must be initialized.
+ * \param buf       The content to be signed. This is usually the hash of
+ *                  the original data to be signed. This must be a readable
+ *                  buffer of length \p blen Bytes. It may be \c NULL if
+ *                  \p blen is zero.
+ * \param blen      The length of \p buf in Bytes.
+ * \param pool      The nonce pool. This must be set up for the curve of
+ *                  \p grp.
+ * \param f_rng     The RNG function, used if the pool is empty. This must
+ *                  not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context parameter.
+ *
+ * \return          \c 0 on success.
+ * \return          An \c MBEDTLS_ERR_ECP_XXX or \c MBEDTLS_MPI_XXX
+ *                  error code on failure.
+ */
+int mbedtls_ecdsa_sign_pooled(mbedtls_ecp_group *grp,
+                              mbedtls_mpi *r, mbedtls_mpi *s,
+                              const mbedtls_mpi *d,
+                              const unsigned char *buf, size_t blen,
+                              mbedtls_ecdsa_nonce_pool *pool,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void *p_rng);
+
+/**
+ * \brief           This function computes the ECDSA signature using a
+ *                  precomputed nonce, and writes it to a buffer, like
+ *                  mbedtls_ecdsa_write_signature().
+ *
+ * \see             mbedtls_ecdsa_sign_pooled()
+ *
+ * \param ctx       The ECDSA context to use. This must be initialized
+ *                  and have a group and private key bound to it.
+ * \param hash      The message hash to be signed. This must be a readable
+ *                  buffer of length \p hlen Bytes.
+ * \param hlen      The length of the hash \p hash in Bytes.
+ * \param sig       The buffer to which to write the signature. This must
+ *                  be a writable buffer of length \p sig_size Bytes.
+ * \param sig_size  The size of the \p sig buffer in bytes.
+ * \param slen      The address at which to store the actual length of
+ *                  the signature written. Must not be \c NULL.
+ * \param pool      The nonce pool. This must be set up for the curve of
+ *                  \p ctx.
+ * \param f_rng     The RNG function, used if the pool is empty. This must
+ *                  not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context parameter.
+ *
+ * \return          \c 0 on success.
+ * \return          An \c MBEDTLS_ERR_ECP_XXX, \c MBEDTLS_ERR_MPI_XXX or
+ *                  \c MBEDTLS_ERR_ASN1_XXX error code on failure.
+ */
+int mbedtls_ecdsa_write_signature_pooled(mbedtls_ecdsa_context *ctx,
+                                         const unsigned char *hash, size_t hlen,
+                                         unsigned char *sig, size_t sig_size,
+                                         size_t *slen,
+                                         mbedtls_ecdsa_nonce_pool *pool,
+                                         int (*f_rng)(void *, unsigned char *, size_t),
+                                         void *p_rng);
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 /**
  * \brief           This function reads and verifies an ECDSA signature.
  *
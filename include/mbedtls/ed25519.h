@@ -0,0 +1,304 @@
+/**
+ * \file ed25519.h
+ *
+ * \brief This file contains the Ed25519 signature definitions and functions.
+ *
+ * Ed25519 is the Edwards-curve Digital Signature Algorithm (EdDSA)
+ * instantiated with the twisted Edwards curve birationally equivalent to
+ * Curve25519 and with SHA-512, as specified in <em>RFC 8032: Edwards-Curve
+ * Digital Signature Algorithm (EdDSA)</em>. This module implements the pure
+ * variant (PureEdDSA), where the message is signed without being hashed
+ * beforehand.
+ *
+ * Signatures are deterministic. Verification rejects non-canonical
+ * encodings and signatures whose S component is not reduced, and uses the
+ * cofactored verification equation so that individual and batch
+ * verification always agree.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+#ifndef MBEDTLS_ED25519_H
+#define MBEDTLS_ED25519_H
+#include "mbedtls/private_access.h"
+
+#include "mbedtls/build_info.h"
+
+/* for shared error codes */
+#include "mbedtls/ecp.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** The size of an Ed25519 public or private key in Bytes. */
+#define MBEDTLS_ED25519_KEY_SIZE        32
+/** The size of an Ed25519 signature in Bytes. */
+#define MBEDTLS_ED25519_SIGNATURE_SIZE  64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief           A point on the Ed25519 curve, in the internal
+ *                  representation used for arithmetic.
+ */
+typedef struct mbedtls_ed25519_point {
+    int32_t MBEDTLS_PRIVATE(X)[10];
+    int32_t MBEDTLS_PRIVATE(Y)[10];
+    int32_t MBEDTLS_PRIVATE(Z)[10];
+    int32_t MBEDTLS_PRIVATE(T)[10];
+} mbedtls_ed25519_point;
+
+/**
+ * \brief           The Ed25519 context structure.
+ *
+ *                  A context holds either a public key only, or a private
+ *                  key together with its public key. The public key is
+ *                  kept both encoded and decoded, so that verifying many
+ *                  signatures with the same key only decodes it once.
+ */
+typedef struct mbedtls_ed25519_context {
+    unsigned char MBEDTLS_PRIVATE(pub)[MBEDTLS_ED25519_KEY_SIZE];     /*!< Encoded public key. */
+    mbedtls_ed25519_point MBEDTLS_PRIVATE(A);                         /*!< Decoded public key. */
+    unsigned char MBEDTLS_PRIVATE(seed)[MBEDTLS_ED25519_KEY_SIZE];    /*!< Private key, as defined in RFC 8032. */
+    unsigned char MBEDTLS_PRIVATE(scalar)[32];                        /*!< Secret scalar, reduced modulo the group order. */
+    unsigned char MBEDTLS_PRIVATE(prefix)[32];                        /*!< Secret prefix used to derive nonces. */
+    int MBEDTLS_PRIVATE(has_pub);                                     /*!< Whether a public key is loaded. */
+    int MBEDTLS_PRIVATE(has_priv);                                    /*!< Whether a private key is loaded. */
+}
+mbedtls_ed25519_context;
+
+/**
+ * \brief           A signature to check with mbedtls_ed25519_verify_batch().
+ */
+typedef struct mbedtls_ed25519_batch_entry {
+    const mbedtls_ed25519_context *ctx; /*!< The context holding the public key. */
+    const unsigned char *msg;           /*!< The message that was signed. */
+    size_t msg_len;                     /*!< The length of \c msg in Bytes. */
+    const unsigned char *sig;           /*!< The signature to check. */
+    size_t sig_len;                     /*!< The length of \c sig in Bytes. */
+}
+mbedtls_ed25519_batch_entry;
+
+/**
+ * \brief           This function initializes an Ed25519 context.
+ *
+ * \param ctx       The context to initialize. This must not be \c NULL.
+ */
+void mbedtls_ed25519_init(mbedtls_ed25519_context *ctx);
+
+/**
+ * \brief           This function frees an Ed25519 context and wipes the
+ *                  private key it may contain.
+ *
+ * \param ctx       The context to free. This may be \c NULL, in which case
+ *                  this function does nothing. If it is not \c NULL, it must
+ *                  have been initialized.
+ */
+void mbedtls_ed25519_free(mbedtls_ed25519_context *ctx);
+
+/**
+ * \brief           This function generates a new key pair.
+ *
+ * \param ctx       The context to store the key pair in. This must be
+ *                  initialized.
+ * \param f_rng     The RNG function. This must not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_RANDOM_FAILED or another error code
+ *                  returned by \p f_rng on failure.
+ */
+int mbedtls_ed25519_genkey(mbedtls_ed25519_context *ctx,
+                           int (*f_rng)(void *, unsigned char *, size_t),
+                           void *p_rng);
+
+/**
+ * \brief           This function loads a private key and derives the
+ *                  corresponding public key.
+ *
+ * \param ctx       The context to store the key in. This must be
+ *                  initialized.
+ * \param key       The private key: a 32-byte string as defined in
+ *                  RFC 8032 §5.1.5.
+ * \param key_len   The length of \p key in Bytes. This must be
+ *                  #MBEDTLS_ED25519_KEY_SIZE.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_INVALID_KEY if \p key_len is wrong.
+ * \return          Another negative error code on hashing failure.
+ */
+int mbedtls_ed25519_set_private_key(mbedtls_ed25519_context *ctx,
+                                    const unsigned char *key,
+                                    size_t key_len);
+
+/**
+ * \brief           This function loads a public key. Any private key
+ *                  previously loaded in the context is wiped.
+ *
+ * \param ctx       The context to store the key in. This must be
+ *                  initialized.
+ * \param key       The encoded public key, as defined in RFC 8032 §5.1.2.
+ * \param key_len   The length of \p key in Bytes. This must be
+ *                  #MBEDTLS_ED25519_KEY_SIZE.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_INVALID_KEY if \p key is not the
+ *                  canonical encoding of a point on the curve.
+ */
+int mbedtls_ed25519_set_public_key(mbedtls_ed25519_context *ctx,
+                                   const unsigned char *key,
+                                   size_t key_len);
+
+/**
+ * \brief           This function exports the public key.
+ *
+ * \param ctx       The context holding the key. This must hold at least a
+ *                  public key.
+ * \param buf       The buffer to write the encoded public key to.
+ * \param buf_size  The size of \p buf in Bytes.
+ * \param olen      On success, the number of Bytes written to \p buf.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL if \p buf is too small.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA if \p ctx holds no key.
+ */
+int mbedtls_ed25519_write_public_key(const mbedtls_ed25519_context *ctx,
+                                     unsigned char *buf, size_t buf_size,
+                                     size_t *olen);
+
+/**
+ * \brief           This function exports the private key.
+ *
+ * \param ctx       The context holding the key. This must hold a private
+ *                  key.
+ * \param buf       The buffer to write the private key to.
+ * \param buf_size  The size of \p buf in Bytes.
+ * \param olen      On success, the number of Bytes written to \p buf.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL if \p buf is too small.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA if \p ctx holds no
+ *                  private key.
+ */
+int mbedtls_ed25519_write_private_key(const mbedtls_ed25519_context *ctx,
+                                      unsigned char *buf, size_t buf_size,
+                                      size_t *olen);
+
+/**
+ * \brief           This function checks that a public key and a private key
+ *                  belong together.
+ *
+ * \param pub       A context holding a public key.
+ * \param prv       A context holding a private key.
+ *
+ * \return          \c 0 if the keys match.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA otherwise.
+ */
+int mbedtls_ed25519_check_pub_priv(const mbedtls_ed25519_context *pub,
+                                   const mbedtls_ed25519_context *prv);
+
+/**
+ * \brief           This function signs a message with PureEdDSA.
+ *
+ * \note            The signature is deterministic: signing the same
+ *                  message twice with the same key gives the same result,
+ *                  and no random generator is needed.
+ *
+ * \param ctx       The context holding the private key.
+ * \param msg       The message to sign. This may be \c NULL if
+ *                  \p msg_len is \c 0.
+ * \param msg_len   The length of \p msg in Bytes.
+ * \param sig       The buffer to write the signature to.
+ * \param sig_size  The size of \p sig in Bytes.
+ * \param sig_len   On success, the length of the signature, which is
+ *                  always #MBEDTLS_ED25519_SIGNATURE_SIZE.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL if \p sig is too small.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA if \p ctx holds no
+ *                  private key.
+ * \return          Another negative error code on hashing failure.
+ */
+int mbedtls_ed25519_sign(const mbedtls_ed25519_context *ctx,
+                         const unsigned char *msg, size_t msg_len,
+                         unsigned char *sig, size_t sig_size,
+                         size_t *sig_len);
+
+/**
+ * \brief           This function verifies a PureEdDSA signature.
+ *
+ * \param ctx       The context holding the public key.
+ * \param msg       The message that was signed. This may be \c NULL if
+ *                  \p msg_len is \c 0.
+ * \param msg_len   The length of \p msg in Bytes.
+ * \param sig       The signature to verify.
+ * \param sig_len   The length of \p sig in Bytes.
+ *
+ * \return          \c 0 if the signature is valid.
+ * \return          #MBEDTLS_ERR_ECP_VERIFY_FAILED if it is not.
+ * \return          #MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH if \p sig_len is not
+ *                  #MBEDTLS_ED25519_SIGNATURE_SIZE.
+ * \return          #MBEDTLS_ERR_ECP_BAD_INPUT_DATA if \p ctx holds no key.
+ * \return          Another negative error code on hashing failure.
+ */
+int mbedtls_ed25519_verify(const mbedtls_ed25519_context *ctx,
+                           const unsigned char *msg, size_t msg_len,
+                           const unsigned char *sig, size_t sig_len);
+
+/**
+ * \brief           This function verifies several signatures at once.
+ *
+ *                  The signatures are combined with random coefficients and
+ *                  checked with a single multi-scalar multiplication, which
+ *                  is several times faster per signature than calling
+ *                  mbedtls_ed25519_verify() on each of them. The result is
+ *                  the same as checking every signature individually, except
+ *                  with a negligible probability (below 2^-128).
+ *
+ * \note            On failure, this function does not tell which signature
+ *                  is invalid. Callers that need to know can fall back to
+ *                  mbedtls_ed25519_verify() on each entry.
+ *
+ * \param entries   The signatures to verify, with their messages and keys.
+ * \param count     The number of entries. If this is \c 0, the function
+ *                  succeeds.
+ * \param f_rng     The RNG function used to pick the coefficients. This
+ *                  must not be \c NULL.
+ * \param p_rng     The RNG context to be passed to \p f_rng. This may be
+ *                  \c NULL if \p f_rng doesn't need a context.
+ *
+ * \return          \c 0 if all signatures are valid.
+ * \return          #MBEDTLS_ERR_ECP_VERIFY_FAILED if at least one is not.
+ * \return          #MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH if one of the
+ *                  signatures has the wrong length.
+ * \return          #MBEDTLS_ERR_ECP_ALLOC_FAILED on memory allocation
+ *                  failure.
+ * \return          Another negative error code on RNG or hashing failure.
+ */
+int mbedtls_ed25519_verify_batch(const mbedtls_ed25519_batch_entry *entries,
+                                 size_t count,
+                                 int (*f_rng)(void *, unsigned char *, size_t),
+                                 void *p_rng);
+
+#if defined(MBEDTLS_SELF_TEST)
+
+/**
+ * \brief           The Ed25519 checkup routine.
+ *
+ * \return          \c 0 on success.
+ * \return          \c 1 on failure.
+ */
+int mbedtls_ed25519_self_test(int verbose);
+
+#endif /* MBEDTLS_SELF_TEST */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ed25519.h */
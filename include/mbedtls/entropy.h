@@ -61,6 +61,10 @@
 #define MBEDTLS_ENTROPY_MAX_GATHER      128     /**< Maximum amount requested from entropy sources */
 #endif
 
+#if !defined(MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE)
+#define MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE    0   /**< Platform entropy buffered per context (0: disabled) */
+#endif
+
 /** \} name SECTION: Module settings */
 
 #define MBEDTLS_ENTROPY_MAX_SEED_SIZE   1024    /**< Maximum size of seed we read from seed file */
@@ -99,6 +103,24 @@ typedef struct mbedtls_entropy_source_state {
 }
 mbedtls_entropy_source_state;
 
+#if MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE > 0 && !defined(MBEDTLS_NO_PLATFORM_ENTROPY)
+#define MBEDTLS_ENTROPY_PLATFORM_BUFFERED
+
+/**
+ * \brief           Buffered platform entropy
+ *
+ *                  Holds output of the operating system's random generator
+ *                  that has been fetched in a single batch but not yet
+ *                  consumed. Consumed bytes are wiped immediately.
+ */
+typedef struct mbedtls_entropy_platform_buffer {
+    unsigned char MBEDTLS_PRIVATE(buf)[MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE];
+    size_t MBEDTLS_PRIVATE(len);    /*!< Unread bytes, at the end of buf */
+    long MBEDTLS_PRIVATE(pid);      /*!< Process that filled buf */
+}
+mbedtls_entropy_platform_buffer;
+#endif /* MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE > 0 && !MBEDTLS_NO_PLATFORM_ENTROPY */
+
 /**
  * \brief           Entropy context structure
  */
@@ -115,6 +137,9 @@ typedef struct mbedtls_entropy_context {
 #if defined(MBEDTLS_ENTROPY_NV_SEED)
     int MBEDTLS_PRIVATE(initial_entropy_run);
 #endif
+#if defined(MBEDTLS_ENTROPY_PLATFORM_BUFFERED)
+    mbedtls_entropy_platform_buffer MBEDTLS_PRIVATE(platform_buffer);
+#endif
 }
 mbedtls_entropy_context;
 
@@ -129,6 +154,13 @@ int mbedtls_platform_entropy_poll(void *data,
 /**
  * \brief           Initialize the context
  *
+ * \note            Each context has its own accumulator and, if
+ *                  #MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE is non-zero, its
+ *                  own buffer of platform entropy. Threads that reseed
+ *                  frequently, for example with one DRBG per thread, should
+ *                  each use their own entropy context rather than share one,
+ *                  so that they do not contend for the context's mutex.
+ *
  * \param ctx       Entropy context to initialize
  */
 void mbedtls_entropy_init(mbedtls_entropy_context *ctx);
@@ -860,6 +860,31 @@
  */
 #define MBEDTLS_ECDSA_DETERMINISTIC
 
+/**
+ * \def MBEDTLS_ECDSA_NONCE_POOL
+ *
+ * Enable pools of precomputed ECDSA nonces, see mbedtls_ecdsa_nonce_pool.
+ *
+ * The expensive part of an ECDSA signature, computing k * G and k^-1, does
+ * not depend on the message. With this option, an application can compute
+ * nonces ahead of time (for example from an idle loop or a background
+ * thread) and then sign with mbedtls_ecdsa_sign_pooled() at the cost of a
+ * few modular multiplications.
+ *
+ * Signatures made from the pool use a random nonce, they are not
+ * deterministic in the sense of MBEDTLS_ECDSA_DETERMINISTIC.
+ *
+ * Randomized ECDSA signatures made through the PSA API can use a pool as
+ * well, see mbedtls_psa_ecdsa_set_nonce_pool(). This includes the
+ * signatures made by TLS if MBEDTLS_USE_PSA_CRYPTO is enabled and
+ * MBEDTLS_ECDSA_DETERMINISTIC is disabled.
+ *
+ * Requires: MBEDTLS_ECDSA_C, !MBEDTLS_ECDSA_SIGN_ALT
+ *
+ * Uncomment this macro to enable nonce pools.
+ */
+//#define MBEDTLS_ECDSA_NONCE_POOL
+
 /**
  * \def MBEDTLS_KEY_EXCHANGE_PSK_ENABLED
  *
@@ -2092,6 +2117,24 @@
  */
 //#define MBEDTLS_THREADING_PTHREAD
 
+/**
+ * \def MBEDTLS_THREADING_STATS
+ *
+ * Count, for every mutex, how often it is locked, how often a thread has to
+ * wait for it, and the total wait and hold times. The counts are retrieved
+ * with mbedtls_threading_get_stats(), aggregated by the name given to each
+ * mutex where it is initialized.
+ *
+ * This is meant for finding lock contention in multi-threaded applications.
+ * It adds two clock reads to every lock/unlock pair, so leave it disabled in
+ * production builds.
+ *
+ * Requires: MBEDTLS_THREADING_PTHREAD
+ *
+ * Uncomment this to enable mutex statistics.
+ */
+//#define MBEDTLS_THREADING_STATS
+
 /**
  * \def MBEDTLS_USE_PSA_CRYPTO
  *
@@ -2773,6 +2816,28 @@
  */
 #define MBEDTLS_ECP_C
 
+/**
+ * \def MBEDTLS_ED25519_C
+ *
+ * Enable the Ed25519 signature library (PureEdDSA on the Edwards form of
+ * Curve25519, RFC 8032).
+ *
+ * Module:  library/ed25519.c
+ * Caller:  library/pk_wrap.c
+ *          library/psa_crypto_ecp.c
+ *
+ * This module is used for the ed25519 signature algorithm of TLS 1.3 and
+ * for X.509 certificates signed with Ed25519.
+ *
+ * Requires: MBEDTLS_BIGNUM_C, MBEDTLS_SHA512_C
+ *
+ * \note This module is disabled by default because Ed25519 keys and
+ *       certificates cannot be written yet (pkwrite, x509write). When it is
+ *       enabled, also enable #PSA_WANT_ALG_PURE_EDDSA and
+ *       #PSA_WANT_ECC_TWISTED_EDWARDS_255 to use it through PSA.
+ */
+//#define MBEDTLS_ED25519_C
+
 /**
  * \def MBEDTLS_ENTROPY_C
  *
@@ -3522,6 +3587,20 @@
  */
 #define MBEDTLS_SSL_CACHE_C
 
+/**
+ * \def MBEDTLS_SSL_CERT_STORE_C
+ *
+ * Enable a store of server certificates and private keys indexed by DNS
+ * name, with an SNI callback that serves certificates from it and parses
+ * private keys only when they are needed.
+ *
+ * Module:  library/ssl_cert_store.c
+ * Caller:
+ *
+ * Requires: MBEDTLS_SSL_SERVER_NAME_INDICATION, MBEDTLS_PK_PARSE_C
+ */
+#define MBEDTLS_SSL_CERT_STORE_C
+
 /**
  * \def MBEDTLS_SSL_COOKIE_C
  *
@@ -3928,6 +4007,7 @@
 //#define MBEDTLS_ENTROPY_MAX_SOURCES                20 /**< Maximum number of sources supported */
 //#define MBEDTLS_ENTROPY_MAX_GATHER                128 /**< Maximum amount requested from entropy sources */
 //#define MBEDTLS_ENTROPY_MIN_HARDWARE               32 /**< Default minimum number of bytes required for the hardware entropy source mbedtls_hardware_poll() before entropy is released */
+//#define MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE     4096 /**< Bytes fetched from the platform entropy source in one system call and buffered in each entropy context (0 to read the platform source on every poll) */
 
 /* Memory buffer allocator options */
 //#define MBEDTLS_MEMORY_ALIGN_MULTIPLE      4 /**< Align on multiples of this value */
@@ -4042,6 +4122,10 @@
 //#define MBEDTLS_SSL_CACHE_DEFAULT_TIMEOUT       86400 /**< 1 day  */
 //#define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES      50 /**< Maximum entries in cache */
 
+/* SSL certificate store options */
+//#define MBEDTLS_SSL_CERT_STORE_DEFAULT_MAX_KEYS    64 /**< Maximum parsed keys kept */
+//#define MBEDTLS_SSL_CERT_STORE_MAX_MATCHES          4 /**< Maximum certificates offered per name */
+
 /* SSL options */
 
 /** \def MBEDTLS_SSL_IN_CONTENT_LEN
@@ -4061,10 +4145,41 @@
  *       to only change the outgoing buffer size #MBEDTLS_SSL_OUT_CONTENT_LEN
  *       while keeping the default value of 16KB for the incoming buffer.
  *
+ * \note With TLS, handshake messages longer than this are reassembled from
+ *       several records, up to #MBEDTLS_SSL_IN_HS_MAX_LEN bytes.
+ *
  * Uncomment to set the maximum plaintext size of the incoming I/O buffer.
  */
 //#define MBEDTLS_SSL_IN_CONTENT_LEN              16384
 
+/** \def MBEDTLS_SSL_IN_HS_MAX_LEN
+ *
+ * Maximum length (in bytes) of an incoming TLS handshake message that
+ * spans several records, including its 4-byte header.
+ *
+ * Handshake messages that fit in a single record are processed in place,
+ * in the incoming I/O buffer. Longer ones, such as a Certificate message
+ * carrying a long chain, or any handshake message received with
+ * #MBEDTLS_SSL_IN_CONTENT_LEN set below the length of that message, are
+ * reassembled into a heap buffer of exactly the length of the message,
+ * which is freed as soon as the message has been processed. Messages
+ * longer than this value are rejected.
+ *
+ * The default is #MBEDTLS_SSL_IN_CONTENT_LEN, so that by default no message
+ * longer than the incoming I/O buffer is accepted and the memory needed for
+ * a handshake message stays the same as without reassembly. Set a larger
+ * value to accept longer messages, for example a long certificate chain,
+ * with a given #MBEDTLS_SSL_IN_CONTENT_LEN.
+ *
+ * This does not apply to DTLS, where handshake message reassembly is
+ * bounded by #MBEDTLS_SSL_DTLS_MAX_BUFFERING, nor to the initial
+ * ClientHello received by a TLS 1.2 server, which must fit in a single
+ * record.
+ *
+ * Uncomment to set the maximum length of a reassembled handshake message.
+ */
+//#define MBEDTLS_SSL_IN_HS_MAX_LEN               16384
+
 /** \def MBEDTLS_SSL_CID_IN_LEN_MAX
  *
  * The maximum length of CIDs used for incoming DTLS messages.
@@ -183,6 +183,40 @@ int mbedtls_ecdsa_der_to_raw(size_t bits, const unsigned char *der, size_t der_l
 
 #endif /* MBEDTLS_PSA_UTIL_HAVE_ECDSA */
 
+#if defined(MBEDTLS_PSA_CRYPTO_C) && defined(MBEDTLS_ECDSA_NONCE_POOL)
+#include <mbedtls/ecdsa.h>
+
+/** Use a pool of precomputed nonces for randomized ECDSA signatures made
+ * through the PSA API on the given curve.
+ *
+ * Once a pool is set, psa_sign_hash() and psa_sign_message() with
+ * #PSA_ALG_ECDSA keys on \p grp_id take their nonces from it, as
+ * mbedtls_ecdsa_sign_pooled() does. This includes the signatures made
+ * by TLS if #MBEDTLS_USE_PSA_CRYPTO is enabled and it uses randomized
+ * ECDSA, that is if #MBEDTLS_ECDSA_DETERMINISTIC is disabled.
+ * Deterministic ECDSA never uses the pool. Keys handled by a driver do
+ * not use it either.
+ *
+ * The pool remains owned by the caller, who is responsible for filling
+ * it, for example with mbedtls_ecdsa_nonce_pool_fill() from a background
+ * thread. mbedtls_psa_crypto_free() forgets all the pools that are set.
+ *
+ * \param grp_id        The curve to use \p pool for (`MBEDTLS_ECP_DP_xxx`).
+ * \param pool          The pool to use. It must have been set up for
+ *                      \p grp_id. It must not be freed while it is set, nor
+ *                      while signatures that use it may be in progress.
+ *                      This may be \c NULL to stop using a pool for
+ *                      \p grp_id.
+ *
+ * \retval #PSA_SUCCESS \emptydescription
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ *         \p grp_id is not a valid curve, or \p pool was set up for
+ *         another curve.
+ */
+psa_status_t mbedtls_psa_ecdsa_set_nonce_pool(mbedtls_ecp_group_id grp_id,
+                                              mbedtls_ecdsa_nonce_pool *pool);
+#endif /* MBEDTLS_PSA_CRYPTO_C && MBEDTLS_ECDSA_NONCE_POOL */
+
 /**@}*/
 
 #endif /* MBEDTLS_PSA_UTIL_H */
@@ -324,6 +324,9 @@
 #define MBEDTLS_SSL_SESSION_TICKETS_DISABLED     0
 #define MBEDTLS_SSL_SESSION_TICKETS_ENABLED      1
 
+#define MBEDTLS_SSL_TLS1_3_TICKETS_AFTER_HANDSHAKE  0
+#define MBEDTLS_SSL_TLS1_3_TICKETS_DEFERRED         1
+
 #define MBEDTLS_SSL_PRESET_DEFAULT              0
 #define MBEDTLS_SSL_PRESET_SUITEB               2
 
@@ -400,6 +403,14 @@
 #define MBEDTLS_SSL_OUT_CONTENT_LEN 16384
 #endif
 
+/*
+ * Maximum length of a TLS handshake message reassembled from several records.
+ * By default, no longer than a message that fits in the incoming I/O buffer.
+ */
+#if !defined(MBEDTLS_SSL_IN_HS_MAX_LEN)
+#define MBEDTLS_SSL_IN_HS_MAX_LEN MBEDTLS_SSL_IN_CONTENT_LEN
+#endif
+
 /*
  * Maximum number of heap-allocated bytes for the purpose of
  * DTLS handshake message reassembly and future message buffering.
@@ -864,10 +875,27 @@ typedef struct mbedtls_ssl_session mbedtls_ssl_session;
 typedef struct mbedtls_ssl_context mbedtls_ssl_context;
 typedef struct mbedtls_ssl_config  mbedtls_ssl_config;
 
+/* Defined in mbedtls/debug.h */
+typedef struct mbedtls_debug_event mbedtls_debug_event;
+
+/**
+ * \brief          Callback type: structured debug output
+ *
+ * \param p_dbg    Context for the callback
+ * \param ssl      SSL context the event belongs to
+ * \param event    Debug event. Its messages are not formatted: the callback
+ *                 can call mbedtls_debug_event_format() when it needs the
+ *                 text. The event is only valid during the call.
+ */
+typedef void mbedtls_ssl_dbg_event_t(void *p_dbg,
+                                     const mbedtls_ssl_context *ssl,
+                                     const mbedtls_debug_event *event);
+
 /* Defined in library/ssl_misc.h */
 typedef struct mbedtls_ssl_transform mbedtls_ssl_transform;
 typedef struct mbedtls_ssl_handshake_params mbedtls_ssl_handshake_params;
 typedef struct mbedtls_ssl_sig_hash_set_t mbedtls_ssl_sig_hash_set_t;
+typedef struct mbedtls_ssl_hs_reasm mbedtls_ssl_hs_reasm;
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 typedef struct mbedtls_ssl_key_cert mbedtls_ssl_key_cert;
 #endif
@@ -1453,6 +1481,7 @@ struct mbedtls_ssl_config {
     defined(MBEDTLS_SSL_SRV_C) && \
     defined(MBEDTLS_SSL_PROTO_TLS1_3)
     uint16_t MBEDTLS_PRIVATE(new_session_tickets_count);   /*!< number of NewSessionTicket */
+    uint8_t MBEDTLS_PRIVATE(new_session_tickets_timing);   /*!< when to send NewSessionTicket */
 #endif
 
 #if defined(MBEDTLS_SSL_SRV_C)
@@ -1487,6 +1516,8 @@ struct mbedtls_ssl_config {
     /** Callback for printing debug output                                  */
     void(*MBEDTLS_PRIVATE(f_dbg))(void *, int, const char *, int, const char *);
     void *MBEDTLS_PRIVATE(p_dbg);                    /*!< context for the debug function     */
+    mbedtls_ssl_dbg_event_t *MBEDTLS_PRIVATE(f_dbg_event); /*!< structured debug callback */
+    void *MBEDTLS_PRIVATE(p_dbg_event);              /*!< context for the structured debug callback */
 
     /** Callback for getting (pseudo-)random numbers                        */
     int(*MBEDTLS_PRIVATE(f_rng))(void *, unsigned char *, size_t);
@@ -1643,6 +1674,15 @@ struct mbedtls_ssl_config {
 
     uint32_t MBEDTLS_PRIVATE(read_timeout);          /*!< timeout for mbedtls_ssl_read (ms)  */
 
+    uint16_t MBEDTLS_PRIVATE(record_size_initial);   /*!< size of the first application data
+                                                        records, or 0 for full-size records */
+    uint32_t MBEDTLS_PRIVATE(record_size_ramp);      /*!< bytes to send before ramping up to
+                                                        full-size records                  */
+#if defined(MBEDTLS_HAVE_TIME)
+    uint32_t MBEDTLS_PRIVATE(record_size_idle);      /*!< idle time after which records start
+                                                        small again (ms)                   */
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     uint32_t MBEDTLS_PRIVATE(hs_timeout_min);        /*!< initial value of the handshake
                                                         retransmission timeout (ms)        */
@@ -1680,6 +1720,8 @@ struct mbedtls_ssl_config {
 
 struct mbedtls_ssl_context {
     const mbedtls_ssl_config *MBEDTLS_PRIVATE(conf); /*!< configuration information          */
+    int MBEDTLS_PRIVATE(dbg_threshold);          /*!< debug threshold, or -1 to use the
+                                                    global one                          */
 
     /*
      * Miscellaneous
@@ -1811,6 +1853,9 @@ struct mbedtls_ssl_context {
 
     size_t MBEDTLS_PRIVATE(in_hslen);            /*!< current handshake message length,
                                                     including the handshake header   */
+    mbedtls_ssl_hs_reasm *MBEDTLS_PRIVATE(in_hs_reasm); /*!< TLS handshake message
+                                                    being reassembled from several
+                                                    records, if any                  */
     int MBEDTLS_PRIVATE(nb_zero);                /*!< # of 0-length encrypted messages */
 
     int MBEDTLS_PRIVATE(keep_current_message);   /*!< drop or reuse current message
@@ -1868,6 +1913,14 @@ struct mbedtls_ssl_context {
     size_t MBEDTLS_PRIVATE(out_buf_len);         /*!< length of output buffer          */
 #endif
 
+    size_t MBEDTLS_PRIVATE(out_ramp_len);        /*!< application data sent in small
+                                                    records since the start or the last
+                                                    idle period                       */
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_ms_time_t MBEDTLS_PRIVATE(out_last_time); /*!< time of the last application
+                                                         data record (ms)            */
+#endif
+
     unsigned char MBEDTLS_PRIVATE(cur_out_ctr)[MBEDTLS_SSL_SEQUENCE_NUMBER_LEN]; /*!<  Outgoing record sequence  number. */
 
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
@@ -2187,6 +2240,41 @@ void mbedtls_ssl_conf_dbg(mbedtls_ssl_config *conf,
                           void (*f_dbg)(void *, int, const char *, int, const char *),
                           void  *p_dbg);
 
+/**
+ * \brief          Set the structured debug callback
+ *
+ *                 When this callback is set, it receives the debug output
+ *                 instead of the callback set with mbedtls_ssl_conf_dbg().
+ *                 Messages are passed as their format string and arguments,
+ *                 and buffers, big numbers, points and certificates as
+ *                 binary data, so no text is formatted unless the callback
+ *                 asks for it. See ::mbedtls_debug_event.
+ *
+ * \note           This has no effect unless MBEDTLS_DEBUG_C is enabled.
+ *
+ * \param conf     SSL configuration
+ * \param f_dbg    structured debug function, or NULL to go back to the
+ *                 callback set with mbedtls_ssl_conf_dbg()
+ * \param p_dbg    debug parameter
+ */
+void mbedtls_ssl_conf_dbg_event(mbedtls_ssl_config *conf,
+                                mbedtls_ssl_dbg_event_t *f_dbg,
+                                void *p_dbg);
+
+/**
+ * \brief          Set the debug threshold of an SSL context, overriding the
+ *                 global one set with mbedtls_debug_set_threshold(). This
+ *                 allows enabling verbose output for a single connection.
+ *
+ * \note           This has no effect unless MBEDTLS_DEBUG_C is enabled.
+ *
+ * \param ssl      SSL context
+ * \param threshold threshold level, from 0 (no output) to 4 (verbose), or
+ *                 a negative value to use the global threshold again
+ *                 (default)
+ */
+void mbedtls_ssl_set_dbg_threshold(mbedtls_ssl_context *ssl, int threshold);
+
 /**
  * \brief          Return the SSL configuration structure associated
  *                 with the given SSL context.
@@ -4452,6 +4540,52 @@ void mbedtls_ssl_conf_cert_req_ca_list(mbedtls_ssl_config *conf,
 int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *conf, unsigned char mfl_code);
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+/**
+ * \brief          Set the dynamic record sizing policy for application data
+ *                 (Default: disabled, all records are filled up to
+ *                 \c mbedtls_ssl_get_max_out_record_payload())
+ *
+ *                 When enabled, the first application data records of a
+ *                 connection are limited to \p record_size bytes, record
+ *                 overhead included, so that each of them fits in a single
+ *                 TCP segment and can be decrypted by the peer as soon as
+ *                 that segment arrives. Once \p ramp_bytes bytes of
+ *                 application data have been sent, records are filled up
+ *                 to their maximum size again to minimize overhead. If no
+ *                 application data is sent for \p idle_ms milliseconds,
+ *                 the next records are small again, since the congestion
+ *                 window of the transport has likely shrunk.
+ *
+ *                 Typical values are 1400 for \p record_size, which fits in
+ *                 an Ethernet MTU with IPv6 and TCP headers, 64 KiB for
+ *                 \p ramp_bytes and 1000 ms for \p idle_ms.
+ *
+ * \note           This only affects TLS. With DTLS, records are already
+ *                 limited by the path MTU, see \c mbedtls_ssl_set_mtu().
+ *
+ * \note           While records are small, \c mbedtls_ssl_write() may
+ *                 write fewer bytes than
+ *                 \c mbedtls_ssl_get_max_out_record_payload(); as always,
+ *                 the caller must then call it again for the rest of
+ *                 the data.
+ *
+ * \param conf         SSL configuration
+ * \param record_size  Maximum size of the first records, including the
+ *                     record header and the protection overhead, see
+ *                     \c mbedtls_ssl_get_record_expansion().
+ *                     Use 0 to disable dynamic record sizing.
+ * \param ramp_bytes   Number of application data bytes to send in small
+ *                     records before switching to full-size records.
+ * \param idle_ms      Idle time in milliseconds after which records start
+ *                     small again, or 0 to only use small records at the
+ *                     start of the connection. Ignored if
+ *                     #MBEDTLS_HAVE_TIME is disabled.
+ */
+void mbedtls_ssl_conf_dynamic_record_size(mbedtls_ssl_config *conf,
+                                          uint16_t record_size,
+                                          uint32_t ramp_bytes,
+                                          uint32_t idle_ms);
+
 #if defined(MBEDTLS_SSL_SRV_C)
 /**
  * \brief          Pick the ciphersuites order according to the second parameter
@@ -4503,6 +4637,30 @@ void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config *conf, int use_tickets)
  */
 void mbedtls_ssl_conf_new_session_tickets(mbedtls_ssl_config *conf,
                                           uint16_t num_tickets);
+
+/**
+ * \brief   Choose when the server sends its NewSessionTicket messages.
+ *
+ *          By default, the tickets are sent as the last step of the
+ *          handshake, before mbedtls_ssl_handshake() returns. Creating a
+ *          ticket encrypts the session and derives a resumption key, which
+ *          then delays the first response of the server.
+ *
+ *          With #MBEDTLS_SSL_TLS1_3_TICKETS_DEFERRED, the handshake completes
+ *          without them and the tickets are sent after the first call to
+ *          mbedtls_ssl_write() has written application data, or earlier
+ *          when the application calls mbedtls_ssl_send_new_session_tickets(),
+ *          for example when the connection is idle.
+ *
+ * \note    In both cases, the tickets are coalesced into as few records as
+ *          the maximum record size allows, and flushed together.
+ *
+ * \param conf    SSL configuration
+ * \param timing  #MBEDTLS_SSL_TLS1_3_TICKETS_AFTER_HANDSHAKE (default) or
+ *                #MBEDTLS_SSL_TLS1_3_TICKETS_DEFERRED
+ */
+void mbedtls_ssl_conf_new_session_tickets_timing(mbedtls_ssl_config *conf,
+                                                 int timing);
 #endif /* MBEDTLS_SSL_SESSION_TICKETS &&
           MBEDTLS_SSL_SRV_C &&
           MBEDTLS_SSL_PROTO_TLS1_3*/
@@ -5166,6 +5324,34 @@ int mbedtls_ssl_read(mbedtls_ssl_context *ssl, unsigned char *buf, size_t len);
  */
 int mbedtls_ssl_write(mbedtls_ssl_context *ssl, const unsigned char *buf, size_t len);
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && \
+    defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_SSL_PROTO_TLS1_3)
+/**
+ * \brief          Send the NewSessionTicket messages that were deferred,
+ *                 see mbedtls_ssl_conf_new_session_tickets_timing().
+ *
+ *                 A server may call this function when the connection is
+ *                 idle, so that the tickets do not delay its first response.
+ *                 Otherwise they are sent by the first call to
+ *                 mbedtls_ssl_write() that writes application data.
+ *
+ * \param ssl      SSL context
+ *
+ * \return         0 if the tickets were sent, or if there is no ticket
+ *                 to send.
+ * \return         #MBEDTLS_ERR_SSL_WANT_WRITE if the tickets could not be
+ *                 sent yet. This function, mbedtls_ssl_read() or
+ *                 mbedtls_ssl_write() must then be called again to complete
+ *                 the operation.
+ * \return         Another negative error code on failure. The connection
+ *                 must then be closed, as for mbedtls_ssl_handshake().
+ */
+int mbedtls_ssl_send_new_session_tickets(mbedtls_ssl_context *ssl);
+#endif /* MBEDTLS_SSL_SESSION_TICKETS &&
+          MBEDTLS_SSL_SRV_C &&
+          MBEDTLS_SSL_PROTO_TLS1_3 */
+
 /**
  * \brief           Send an alert message
  *
@@ -0,0 +1,206 @@
+/**
+ * \file ssl_cert_store.h
+ *
+ * \brief SNI certificate store for TLS servers
+ *
+ * The store holds any number of certificate chains with their private keys
+ * and serves them through the SNI callback mbedtls_ssl_cert_store_sni().
+ * Certificates are indexed by the DNS names of their leaf (subjectAltName
+ * entries, or the CN if there are none), including wildcard names.
+ *
+ * Private keys are kept in encoded form (or as a file name) and are only
+ * parsed when a handshake needs them. At most
+ * mbedtls_ssl_cert_store_set_max_keys() parsed keys are kept, the least
+ * recently used ones being freed first, so that a server with many hosted
+ * names does not need to keep all of their keys in memory.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_SSL_CERT_STORE_H
+#define MBEDTLS_SSL_CERT_STORE_H
+#include "mbedtls/private_access.h"
+
+#include "mbedtls/build_info.h"
+
+#include "mbedtls/ssl.h"
+
+#if defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+
+/**
+ * \name SECTION: Module settings
+ *
+ * The configuration options you can set for this module are in this section.
+ * Either change them in mbedtls_config.h or define them on the compiler command line.
+ * \{
+ */
+
+#if !defined(MBEDTLS_SSL_CERT_STORE_DEFAULT_MAX_KEYS)
+#define MBEDTLS_SSL_CERT_STORE_DEFAULT_MAX_KEYS    64   /*!< Maximum parsed keys kept */
+#endif
+
+#if !defined(MBEDTLS_SSL_CERT_STORE_MAX_MATCHES)
+#define MBEDTLS_SSL_CERT_STORE_MAX_MATCHES          4   /*!< Maximum certificates offered per name */
+#endif
+
+/** \} name SECTION: Module settings */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mbedtls_ssl_cert_store mbedtls_ssl_cert_store;
+typedef struct mbedtls_ssl_cert_store_entry mbedtls_ssl_cert_store_entry;
+typedef struct mbedtls_ssl_cert_store_name mbedtls_ssl_cert_store_name;
+
+/**
+ * \brief Certificate store context
+ */
+struct mbedtls_ssl_cert_store {
+    mbedtls_ssl_cert_store_entry *MBEDTLS_PRIVATE(entries);  /*!< all entries, newest first */
+    mbedtls_ssl_cert_store_name **MBEDTLS_PRIVATE(names);    /*!< hash table of DNS names   */
+    size_t MBEDTLS_PRIVATE(names_size);                      /*!< number of hash buckets    */
+    size_t MBEDTLS_PRIVATE(names_count);                     /*!< number of indexed names   */
+    mbedtls_ssl_cert_store_entry *MBEDTLS_PRIVATE(lru_head); /*!< most recently used key    */
+    mbedtls_ssl_cert_store_entry *MBEDTLS_PRIVATE(lru_tail); /*!< least recently used key   */
+    size_t MBEDTLS_PRIVATE(keys);                            /*!< number of parsed keys     */
+    size_t MBEDTLS_PRIVATE(max_keys);                        /*!< maximum parsed keys       */
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_threading_mutex_t MBEDTLS_PRIVATE(mutex);        /*!< mutex                     */
+#endif
+};
+
+/**
+ * \brief          Initialize a certificate store
+ *
+ * \param store    Certificate store
+ */
+void mbedtls_ssl_cert_store_init(mbedtls_ssl_cert_store *store);
+
+/**
+ * \brief          Add a certificate chain and its private key to the store
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ *                 The certificate chain is parsed immediately, and the
+ *                 DNS names of its first certificate are added to the
+ *                 index. The private key is copied and only parsed the
+ *                 first time a handshake selects this certificate.
+ *
+ * \note           Several certificates may be added for the same name,
+ *                 for example one with an RSA key and one with an ECDSA
+ *                 key. They are offered to the handshake in the order in
+ *                 which they were added.
+ *
+ * \param store    Certificate store
+ * \param crt      Certificate chain, leaf first, in PEM or DER format, as
+ *                 accepted by mbedtls_x509_crt_parse()
+ * \param crt_len  Length of \p crt in bytes (including the terminating
+ *                 null byte for PEM data)
+ * \param key      Private key in PEM or DER format, as accepted by
+ *                 mbedtls_pk_parse_key()
+ * \param key_len  Length of \p key in bytes (including the terminating
+ *                 null byte for PEM data)
+ * \param pwd      Password for an encrypted key, or NULL
+ * \param pwd_len  Length of \p pwd in bytes
+ *
+ * \return         \c 0 on success.
+ * \return         #MBEDTLS_ERR_SSL_BAD_INPUT_DATA if the certificate has
+ *                 no DNS name.
+ * \return         An X.509 or allocation error code on failure.
+ */
+int mbedtls_ssl_cert_store_add(mbedtls_ssl_cert_store *store,
+                               const unsigned char *crt, size_t crt_len,
+                               const unsigned char *key, size_t key_len,
+                               const unsigned char *pwd, size_t pwd_len);
+
+#if defined(MBEDTLS_FS_IO)
+/**
+ * \brief          Add a certificate chain read from a file, and the name of
+ *                 the file holding its private key, to the store
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ *                 This is like mbedtls_ssl_cert_store_add(), except that
+ *                 only the path of the key file is stored: the file is read
+ *                 each time the key needs to be parsed.
+ *
+ * \param store    Certificate store
+ * \param crt_path Certificate chain file, leaf first
+ * \param key_path Private key file
+ * \param pwd      Password for an encrypted key, or NULL
+ *
+ * \return         \c 0 on success, or a negative error code.
+ */
+int mbedtls_ssl_cert_store_add_file(mbedtls_ssl_cert_store *store,
+                                    const char *crt_path,
+                                    const char *key_path,
+                                    const char *pwd);
+#endif /* MBEDTLS_FS_IO */
+
+/**
+ * \brief          Set the maximum number of parsed private keys to keep
+ *                 (Default: MBEDTLS_SSL_CERT_STORE_DEFAULT_MAX_KEYS)
+ *
+ *                 When this number is exceeded, the least recently used
+ *                 keys are freed, and will be parsed again when needed.
+ *                 Keys used by a handshake in progress are never freed, so
+ *                 the limit may be exceeded temporarily.
+ *
+ * \param store    Certificate store
+ * \param max      Maximum number of parsed keys, or 0 for no limit
+ */
+void mbedtls_ssl_cert_store_set_max_keys(mbedtls_ssl_cert_store *store,
+                                         size_t max);
+
+/**
+ * \brief          SNI callback implementation
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ *                 Use it with mbedtls_ssl_conf_sni(), with the store as
+ *                 the callback parameter.
+ *
+ *                 Names are matched case-insensitively, and a wildcard
+ *                 name such as `*.example.com` matches exactly one label
+ *                 in place of the `*`. Exact names take precedence over
+ *                 wildcard names.
+ *
+ *                 The matching certificates are only remembered here. Once
+ *                 the whole ClientHello has been processed, those whose
+ *                 public key can produce one of the signature algorithms
+ *                 offered by the client are handed to the handshake with
+ *                 mbedtls_ssl_set_hs_own_cert(), and only their keys are
+ *                 parsed. The usual certificate selection then picks one
+ *                 of them.
+ *
+ * \note           If no certificate matches the name, the certificates set
+ *                 with mbedtls_ssl_conf_own_cert() are used if there are
+ *                 any, and the handshake fails otherwise.
+ *
+ * \note           The store must outlive every SSL context that uses it.
+ *
+ * \param p_store  Certificate store
+ * \param ssl      SSL context
+ * \param name     Server name sent by the client
+ * \param name_len Length of \p name in bytes
+ *
+ * \return         \c 0 on success.
+ * \return         #MBEDTLS_ERR_SSL_UNRECOGNIZED_NAME if no certificate
+ *                 matches \p name and there is no default certificate.
+ */
+int mbedtls_ssl_cert_store_sni(void *p_store, mbedtls_ssl_context *ssl,
+                               const unsigned char *name, size_t name_len);
+
+/**
+ * \brief          Free all entries and keys of a certificate store
+ *
+ * \param store    Certificate store
+ */
+void mbedtls_ssl_cert_store_free(mbedtls_ssl_cert_store *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ssl_cert_store.h */
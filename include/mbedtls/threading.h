@@ -26,6 +26,9 @@ extern "C" {
 
 #if defined(MBEDTLS_THREADING_PTHREAD)
 #include <pthread.h>
+#if defined(MBEDTLS_THREADING_STATS)
+#include <stdint.h>
+#endif
 typedef struct mbedtls_threading_mutex_t {
     pthread_mutex_t MBEDTLS_PRIVATE(mutex);
 
@@ -36,6 +39,18 @@ typedef struct mbedtls_threading_mutex_t {
      * part of the public API of Mbed TLS and may change without notice.*/
     char MBEDTLS_PRIVATE(state);
 
+#if defined(MBEDTLS_THREADING_STATS)
+    /* Instrumentation, see mbedtls_threading_get_stats(). The counters are
+     * only written by the thread holding the mutex. */
+    const char *MBEDTLS_PRIVATE(name);
+    uint64_t MBEDTLS_PRIVATE(acquisitions);
+    uint64_t MBEDTLS_PRIVATE(contended);
+    uint64_t MBEDTLS_PRIVATE(wait_ns);
+    uint64_t MBEDTLS_PRIVATE(hold_ns);
+    uint64_t MBEDTLS_PRIVATE(locked_at_ns);
+    struct mbedtls_threading_mutex_t *MBEDTLS_PRIVATE(prev);
+    struct mbedtls_threading_mutex_t *MBEDTLS_PRIVATE(next);
+#endif /* MBEDTLS_THREADING_STATS */
 } mbedtls_threading_mutex_t;
 #endif
 
@@ -83,6 +98,64 @@ extern void (*mbedtls_mutex_free)(mbedtls_threading_mutex_t *mutex);
 extern int (*mbedtls_mutex_lock)(mbedtls_threading_mutex_t *mutex);
 extern int (*mbedtls_mutex_unlock)(mbedtls_threading_mutex_t *mutex);
 
+#if defined(MBEDTLS_THREADING_STATS)
+/**
+ * Lock statistics for all the mutexes that share a name.
+ */
+typedef struct mbedtls_threading_stats_t {
+    const char *name;           /*!< The name of the mutexes */
+    uint64_t acquisitions;      /*!< Number of times they were locked */
+    uint64_t contended;         /*!< Number of times a thread had to wait
+                                 *   because the mutex was already locked */
+    uint64_t wait_ns;           /*!< Total time spent waiting, in ns */
+    uint64_t hold_ns;           /*!< Total time they were held, in ns */
+} mbedtls_threading_stats_t;
+
+/**
+ * \brief           Name a mutex for mbedtls_threading_get_stats().
+ *
+ *                  Call this right after mbedtls_mutex_init(). Mutexes that
+ *                  share a name are reported together. Unnamed mutexes
+ *                  are reported as "unnamed".
+ *
+ * \param mutex     The mutex to name.
+ * \param name      The name. This must remain valid for as long as
+ *                  the mutex is in use.
+ */
+void mbedtls_threading_mutex_set_name(mbedtls_threading_mutex_t *mutex,
+                                      const char *name);
+
+/**
+ * \brief           Get the lock statistics accumulated so far, aggregated
+ *                  by mutex name.
+ *
+ *                  This covers the global mutexes, the mutexes currently
+ *                  initialized, and the mutexes that have been freed.
+ *
+ * \note            The counters of a mutex are updated by the thread that
+ *                  holds it, and this function reads them without locking
+ *                  the mutex. Call it when no other thread is using
+ *                  Mbed TLS, for example at the end of a benchmark.
+ *
+ * \param stats     The array to fill.
+ * \param size      The number of entries in \p stats.
+ *
+ * \return          The number of entries filled in \p stats if they were
+ *                  enough for all names. Otherwise, a larger value: call
+ *                  again with an array of at least that size.
+ */
+size_t mbedtls_threading_get_stats(mbedtls_threading_stats_t *stats,
+                                   size_t size);
+
+/**
+ * \brief           Reset all lock statistics to zero.
+ *
+ * \note            As for mbedtls_threading_get_stats(), no other thread
+ *                  may be using Mbed TLS while this function runs.
+ */
+void mbedtls_threading_reset_stats(void);
+#endif /* MBEDTLS_THREADING_STATS */
+
 /*
  * Global mutexes
  */
@@ -88,6 +88,10 @@
  * Note: when adding support, also adjust include/mbedtls/config_psa.h */
 //#define PSA_WANT_ALG_XTS                        1
 
+/* Ed25519 is not enabled by default until writing Ed25519 keys and
+ * certificates is supported. Enable it together with MBEDTLS_ED25519_C. */
+//#define PSA_WANT_ALG_PURE_EDDSA                 1
+
 #define PSA_WANT_ECC_BRAINPOOL_P_R1_256         1
 #define PSA_WANT_ECC_BRAINPOOL_P_R1_384         1
 #define PSA_WANT_ECC_BRAINPOOL_P_R1_512         1
@@ -108,6 +112,7 @@
 #define PSA_WANT_ECC_SECP_R1_256                1
 #define PSA_WANT_ECC_SECP_R1_384                1
 #define PSA_WANT_ECC_SECP_R1_521                1
+//#define PSA_WANT_ECC_TWISTED_EDWARDS_255        1
 
 #define PSA_WANT_DH_RFC7919_2048                1
 #define PSA_WANT_DH_RFC7919_3072                1
@@ -53,6 +53,8 @@
 #endif
 
 #include "mbedtls/platform.h"
+#include "aes_internal.h"
+#include "cpu_accel_internal.h"
 #include "ctr.h"
 
 /*
@@ -67,10 +69,47 @@
 
 #if !defined(MBEDTLS_AES_ALT)
 
+/* Implementation used with a key, stored in ctx->acceleration when the key
+ * is set, so that it does not change under the feet of a key that is in use
+ * if mbedtls_cpu_accel_set_portable() is called. */
+#define MBEDTLS_AES_ACC_SOFTWARE    0
+#define MBEDTLS_AES_ACC_AESNI       1
+#define MBEDTLS_AES_ACC_AESCE       2
+#define MBEDTLS_AES_ACC_PADLOCK     3
+
+#if defined(MBEDTLS_AES_USE_HARDWARE_ONLY)
+/* There is no other implementation to fall back to. */
+#define AES_USES_ACC(ctx, acc) 1
+#else
+#define AES_USES_ACC(ctx, acc) ((ctx)->acceleration == (acc))
+#endif
+
+/*
+ * Select the implementation for a key being set
+ */
+static unsigned char aes_select_acceleration(void)
+{
+#if defined(MBEDTLS_AESNI_HAVE_CODE)
+    if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES)) {
+        return MBEDTLS_AES_ACC_AESNI;
+    }
+#endif
+
+#if defined(MBEDTLS_AESCE_HAVE_CODE)
+    if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+        return MBEDTLS_AES_ACC_AESCE;
+    }
+#endif
+
 #if defined(MBEDTLS_VIA_PADLOCK_HAVE_CODE)
-static int aes_padlock_ace = -1;
+    if (mbedtls_padlock_has_support(MBEDTLS_PADLOCK_ACE)) {
+        return MBEDTLS_AES_ACC_PADLOCK;
+    }
 #endif
 
+    return MBEDTLS_AES_ACC_SOFTWARE;
+}
+
 #if defined(MBEDTLS_AES_ROM_TABLES)
 /*
  * Forward S-box
@@ -532,22 +571,20 @@ void mbedtls_aes_xts_free(mbedtls_aes_xts_context *ctx)
 #define MAY_NEED_TO_ALIGN
 #endif
 
-MBEDTLS_MAYBE_UNUSED static unsigned mbedtls_aes_rk_offset(uint32_t *buf)
+MBEDTLS_MAYBE_UNUSED static unsigned mbedtls_aes_rk_offset(unsigned char acceleration,
+                                                           uint32_t *buf)
 {
 #if defined(MAY_NEED_TO_ALIGN)
     int align_16_bytes = 0;
 
 #if defined(MBEDTLS_VIA_PADLOCK_HAVE_CODE)
-    if (aes_padlock_ace == -1) {
-        aes_padlock_ace = mbedtls_padlock_has_support(MBEDTLS_PADLOCK_ACE);
-    }
-    if (aes_padlock_ace) {
+    if (acceleration == MBEDTLS_AES_ACC_PADLOCK) {
         align_16_bytes = 1;
     }
 #endif
 
 #if defined(MBEDTLS_AESNI_C) && MBEDTLS_AESNI_HAVE_CODE == 2
-    if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES)) {
+    if (acceleration == MBEDTLS_AES_ACC_AESNI) {
         align_16_bytes = 1;
     }
 #endif
@@ -563,6 +600,7 @@ MBEDTLS_MAYBE_UNUSED static unsigned mbedtls_aes_rk_offset(uint32_t *buf)
         }
     }
 #else /* MAY_NEED_TO_ALIGN */
+    (void) acceleration;
     (void) buf;
 #endif /* MAY_NEED_TO_ALIGN */
 
@@ -594,17 +632,18 @@ int mbedtls_aes_setkey_enc(mbedtls_aes_context *ctx, const unsigned char *key,
     }
 #endif
 
-    ctx->rk_offset = mbedtls_aes_rk_offset(ctx->buf);
+    ctx->acceleration = aes_select_acceleration();
+    ctx->rk_offset = mbedtls_aes_rk_offset(ctx->acceleration, ctx->buf);
     RK = ctx->buf + ctx->rk_offset;
 
 #if defined(MBEDTLS_AESNI_HAVE_CODE)
-    if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES)) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESNI)) {
         return mbedtls_aesni_setkey_enc((unsigned char *) RK, key, keybits);
     }
 #endif
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
-    if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESCE)) {
         return mbedtls_aesce_setkey_enc((unsigned char *) RK, key, keybits);
     }
 #endif
@@ -697,18 +736,18 @@ int mbedtls_aes_setkey_dec(mbedtls_aes_context *ctx, const unsigned char *key,
 
     mbedtls_aes_init(&cty);
 
-    ctx->rk_offset = mbedtls_aes_rk_offset(ctx->buf);
-    RK = ctx->buf + ctx->rk_offset;
-
     /* Also checks keybits */
     if ((ret = mbedtls_aes_setkey_enc(&cty, key, keybits)) != 0) {
         goto exit;
     }
 
     ctx->nr = cty.nr;
+    ctx->acceleration = cty.acceleration;
+    ctx->rk_offset = mbedtls_aes_rk_offset(ctx->acceleration, ctx->buf);
+    RK = ctx->buf + ctx->rk_offset;
 
 #if defined(MBEDTLS_AESNI_HAVE_CODE)
-    if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES)) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESNI)) {
         mbedtls_aesni_inverse_key((unsigned char *) RK,
                                   (const unsigned char *) (cty.buf + cty.rk_offset), ctx->nr);
         goto exit;
@@ -716,7 +755,7 @@ int mbedtls_aes_setkey_dec(mbedtls_aes_context *ctx, const unsigned char *key,
 #endif
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
-    if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESCE)) {
         mbedtls_aesce_inverse_key(
             (unsigned char *) RK,
             (const unsigned char *) (cty.buf + cty.rk_offset),
@@ -1009,7 +1048,7 @@ int mbedtls_internal_aes_decrypt(mbedtls_aes_context *ctx,
  */
 MBEDTLS_MAYBE_UNUSED static void aes_maybe_realign(mbedtls_aes_context *ctx)
 {
-    unsigned new_offset = mbedtls_aes_rk_offset(ctx->buf);
+    unsigned new_offset = mbedtls_aes_rk_offset(ctx->acceleration, ctx->buf);
     if (new_offset != ctx->rk_offset) {
         memmove(ctx->buf + new_offset,     // new address
                 ctx->buf + ctx->rk_offset, // current address
@@ -1035,19 +1074,19 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
 #endif
 
 #if defined(MBEDTLS_AESNI_HAVE_CODE)
-    if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES)) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESNI)) {
         return mbedtls_aesni_crypt_ecb(ctx, mode, input, output);
     }
 #endif
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
-    if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESCE)) {
         return mbedtls_aesce_crypt_ecb(ctx, mode, input, output);
     }
 #endif
 
 #if defined(MBEDTLS_VIA_PADLOCK_HAVE_CODE)
-    if (aes_padlock_ace > 0) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_PADLOCK)) {
         return mbedtls_padlock_xcryptecb(ctx, mode, input, output);
     }
 #endif
@@ -1064,6 +1103,37 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
 #endif /* !MBEDTLS_AES_USE_HARDWARE_ONLY */
 }
 
+/*
+ * Name of the implementation that keys set now would use
+ */
+const char *mbedtls_aes_cpu_accel_implementation(void)
+{
+    switch (aes_select_acceleration()) {
+#if defined(MBEDTLS_AESNI_HAVE_CODE)
+        case MBEDTLS_AES_ACC_AESNI:
+            return "aesni";
+#endif
+#if defined(MBEDTLS_AESCE_HAVE_CODE)
+        case MBEDTLS_AES_ACC_AESCE:
+            return "aesce";
+#endif
+#if defined(MBEDTLS_VIA_PADLOCK_HAVE_CODE)
+        case MBEDTLS_AES_ACC_PADLOCK:
+            return "padlock";
+#endif
+        default:
+            return MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+    }
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC) || defined(MBEDTLS_CIPHER_MODE_XTS) || \
+    defined(MBEDTLS_CIPHER_MODE_CTR)
+/* Maximum number of blocks that the modes of operation hand to
+ * mbedtls_aes_crypt_ecb_blocks() at once, where the blocks are independent
+ * (CBC decryption, XTS, CTR). */
+#define AES_BATCH_BLOCKS 8
+#endif
+
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
 
 /*
@@ -1077,7 +1147,7 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
                           unsigned char *output)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
-    unsigned char temp[16];
+    unsigned char temp[16 * AES_BATCH_BLOCKS];
 
     if (mode != MBEDTLS_AES_ENCRYPT && mode != MBEDTLS_AES_DECRYPT) {
         return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
@@ -1093,7 +1163,7 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
     }
 
 #if defined(MBEDTLS_VIA_PADLOCK_HAVE_CODE)
-    if (aes_padlock_ace > 0) {
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_PADLOCK)) {
         if (mbedtls_padlock_xcryptcbc(ctx, mode, length, iv, input, output) == 0) {
             return 0;
         }
@@ -1107,9 +1177,16 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
     const unsigned char *ivp = iv;
 
     if (mode == MBEDTLS_AES_DECRYPT) {
+        /* Decryption of the blocks is independent, so decrypt several
+         * blocks at once and chain them afterwards. */
         while (length > 0) {
-            memcpy(temp, input, 16);
-            ret = mbedtls_aes_crypt_ecb(ctx, mode, input, output);
+            size_t use_len = length;
+            if (use_len > sizeof(temp)) {
+                use_len = sizeof(temp);
+            }
+
+            memcpy(temp, input, use_len);
+            ret = mbedtls_aes_crypt_ecb_blocks(ctx, mode, use_len, temp, output);
             if (ret != 0) {
                 goto exit;
             }
@@ -1117,12 +1194,13 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
              * the result for the next block in CBC, and the cost of transferring that data from
              * NEON registers, NEON is slower on aarch64. */
             mbedtls_xor_no_simd(output, output, iv, 16);
+            mbedtls_xor_no_simd(output + 16, output + 16, temp, use_len - 16);
 
-            memcpy(iv, temp, 16);
+            memcpy(iv, temp + use_len - 16, 16);
 
-            input  += 16;
-            output += 16;
-            length -= 16;
+            input  += use_len;
+            output += use_len;
+            length -= use_len;
         }
     } else {
         while (length > 0) {
@@ -1196,9 +1274,12 @@ int mbedtls_aes_crypt_xts(mbedtls_aes_xts_context *ctx,
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
     size_t blocks = length / 16;
     size_t leftover = length % 16;
+    size_t last_blocks;
     unsigned char tweak[16];
     unsigned char prev_tweak[16];
     unsigned char tmp[16];
+    unsigned char tweaks[16 * AES_BATCH_BLOCKS];
+    unsigned char batch[16 * AES_BATCH_BLOCKS];
 
     if (mode != MBEDTLS_AES_ENCRYPT && mode != MBEDTLS_AES_DECRYPT) {
         return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
@@ -1221,6 +1302,36 @@ int mbedtls_aes_crypt_xts(mbedtls_aes_xts_context *ctx,
         return ret;
     }
 
+    /* Blocks other than the last one in a decrypt operation with leftover
+     * bytes use consecutive tweaks: process several at once. */
+    last_blocks = (leftover && mode == MBEDTLS_AES_DECRYPT) ? 1 : 0;
+    while (blocks > last_blocks) {
+        size_t nblocks = blocks - last_blocks;
+        size_t i;
+        if (nblocks > AES_BATCH_BLOCKS) {
+            nblocks = AES_BATCH_BLOCKS;
+        }
+
+        for (i = 0; i < nblocks; i++) {
+            memcpy(tweaks + 16 * i, tweak, 16);
+            mbedtls_gf128mul_x_ble(tweak, tweak);
+        }
+
+        mbedtls_xor(batch, input, tweaks, 16 * nblocks);
+
+        ret = mbedtls_aes_crypt_ecb_blocks(&ctx->crypt, mode, 16 * nblocks,
+                                           batch, batch);
+        if (ret != 0) {
+            return ret;
+        }
+
+        mbedtls_xor(output, batch, tweaks, 16 * nblocks);
+
+        blocks -= nblocks;
+        output += 16 * nblocks;
+        input += 16 * nblocks;
+    }
+
     while (blocks--) {
         if (MBEDTLS_UNLIKELY(leftover && (mode == MBEDTLS_AES_DECRYPT) && blocks == 0)) {
             /* We are on the last block in a decrypt operation that has
@@ -1443,32 +1554,53 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
                           unsigned char *output)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
-
+    unsigned char stream[16 * AES_BATCH_BLOCKS];
     size_t offset = *nc_off;
+    size_t i = 0;
 
     if (offset > 0x0F) {
         return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
     }
 
-    for (size_t i = 0; i < length;) {
-        size_t n = 16;
-        if (offset == 0) {
-            ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce_counter, stream_block);
-            if (ret != 0) {
-                goto exit;
-            }
+    // use up the rest of the previous stream block
+    if (offset != 0) {
+        i = 16 - offset;
+        if (i > length) {
+            i = length;
+        }
+        mbedtls_xor(output, input, &stream_block[offset], i);
+    }
+
+    // whole blocks: encrypt several counter blocks at once, so that
+    // implementations that can process blocks in parallel get to do so
+    while (length - i >= 16) {
+        size_t nblocks = (length - i) / 16;
+        if (nblocks > AES_BATCH_BLOCKS) {
+            nblocks = AES_BATCH_BLOCKS;
+        }
+
+        for (size_t b = 0; b < nblocks; b++) {
+            memcpy(&stream[16 * b], nonce_counter, 16);
             mbedtls_ctr_increment_counter(nonce_counter);
-        } else {
-            n -= offset;
         }
+        ret = mbedtls_aes_crypt_ecb_blocks(ctx, MBEDTLS_AES_ENCRYPT, 16 * nblocks,
+                                           stream, stream);
+        if (ret != 0) {
+            goto exit;
+        }
+        mbedtls_xor(&output[i], &input[i], stream, 16 * nblocks);
+        memcpy(stream_block, &stream[16 * (nblocks - 1)], 16);
+        i += 16 * nblocks;
+    }
 
-        if (n > (length - i)) {
-            n = (length - i);
+    // final partial block
+    if (i < length) {
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce_counter, stream_block);
+        if (ret != 0) {
+            goto exit;
         }
-        mbedtls_xor(&output[i], &input[i], &stream_block[offset], n);
-        // offset might be non-zero for the last block, but in that case, we don't use it again
-        offset = 0;
-        i += n;
+        mbedtls_ctr_increment_counter(nonce_counter);
+        mbedtls_xor(&output[i], &input[i], stream_block, length - i);
     }
 
     // capture offset for future resumption
@@ -1477,12 +1609,61 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
     ret = 0;
 
 exit:
+    mbedtls_platform_zeroize(stream, sizeof(stream));
     return ret;
 }
 #endif /* MBEDTLS_CIPHER_MODE_CTR */
 
 #endif /* !MBEDTLS_AES_ALT */
 
+/*
+ * AES-ECB en(de)cryption of several consecutive blocks
+ */
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                 int mode,
+                                 size_t length,
+                                 const unsigned char *input,
+                                 unsigned char *output)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if (mode != MBEDTLS_AES_ENCRYPT && mode != MBEDTLS_AES_DECRYPT) {
+        return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+    }
+
+    if (length % 16) {
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
+
+#if !defined(MBEDTLS_AES_ALT) && defined(MBEDTLS_AESNI_HAVE_CODE)
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESNI)) {
+#if defined(MAY_NEED_TO_ALIGN)
+        aes_maybe_realign(ctx);
+#endif
+        return mbedtls_aesni_crypt_ecb_blocks(ctx, mode, length, input, output);
+    }
+#endif
+
+#if !defined(MBEDTLS_AES_ALT) && defined(MBEDTLS_AESCE_HAVE_CODE)
+    if (AES_USES_ACC(ctx, MBEDTLS_AES_ACC_AESCE)) {
+        return mbedtls_aesce_crypt_ecb_blocks(ctx, mode, length, input, output);
+    }
+#endif
+
+    while (length > 0) {
+        ret = mbedtls_aes_crypt_ecb(ctx, mode, input, output);
+        if (ret != 0) {
+            return ret;
+        }
+
+        input  += 16;
+        output += 16;
+        length -= 16;
+    }
+
+    return 0;
+}
+
 #if defined(MBEDTLS_SELF_TEST)
 /*
  * AES test vectors from:
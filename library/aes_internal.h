@@ -0,0 +1,51 @@
+/**
+ * \file aes_internal.h
+ *
+ * \brief Internal-only AES API.
+ *
+ * This file declares AES-related functions that are to be used
+ * only from within the Mbed TLS library itself.
+ *
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_AES_INTERNAL_H
+#define MBEDTLS_AES_INTERNAL_H
+
+#include "mbedtls/aes.h"
+
+/**
+ * \brief          Encrypt or decrypt several consecutive blocks in ECB mode.
+ *
+ *                 This is equivalent to calling mbedtls_aes_crypt_ecb() on
+ *                 each block in turn, but the choice of implementation is
+ *                 only made once, and implementations that can process
+ *                 several blocks in parallel (such as AES-NI) get the whole
+ *                 buffer at once.
+ *
+ * \param ctx      The AES context to use for encryption or decryption.
+ *                 It must be initialized and bound to a key.
+ * \param mode     The AES operation: #MBEDTLS_AES_ENCRYPT or
+ *                 #MBEDTLS_AES_DECRYPT.
+ * \param length   The length of the input and output in bytes.
+ *                 This must be a multiple of 16.
+ * \param input    The buffer holding the input data.
+ *                 It must be readable and of size \p length bytes.
+ * \param output   The buffer where the output data will be written.
+ *                 It must be writeable and of size \p length bytes.
+ *                 This must either not overlap with \p input, or be equal.
+ *
+ * \return         \c 0 on success.
+ * \return         #MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH if \p length is
+ *                 not a multiple of 16.
+ * \return         Another negative error code on failure.
+ */
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                 int mode,
+                                 size_t length,
+                                 const unsigned char *input,
+                                 unsigned char *output);
+
+#endif /* MBEDTLS_AES_INTERNAL_H */
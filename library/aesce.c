@@ -285,6 +285,98 @@ int mbedtls_aesce_crypt_ecb(mbedtls_aes_context *ctx,
     return 0;
 }
 
+/* Interleaved processing of 8 blocks b0..b7.
+ *
+ * AESE/AESD and AESMC/AESIMC have a latency of several cycles, and cores
+ * that fuse each pair and have more than one AES pipeline can start a new
+ * round every cycle, so a single block leaves them mostly idle. Processing
+ * 8 independent blocks round by round hides the latency. */
+#define AESCE_X8(op) \
+    op(0); op(1); op(2); op(3); op(4); op(5); op(6); op(7)
+
+#define AESCE_LOAD(i)       b ## i = vld1q_u8(input + 16 * i)
+#define AESCE_STORE(i)      vst1q_u8(output + 16 * i, b ## i)
+#define AESCE_ENC_ROUND(i)  b ## i = vaesmcq_u8(vaeseq_u8(b ## i, k))
+#define AESCE_ENC_LAST(i)   b ## i = vaeseq_u8(b ## i, k)
+#define AESCE_DEC_ROUND(i)  b ## i = vaesimcq_u8(vaesdq_u8(b ## i, k))
+#define AESCE_DEC_LAST(i)   b ## i = vaesdq_u8(b ## i, k)
+#define AESCE_ADD_KEY(i)    b ## i = veorq_u8(b ## i, k)
+
+MBEDTLS_OPTIMIZE_FOR_PERFORMANCE
+static void aesce_encrypt_blocks_x8(const unsigned char *keys, int rounds,
+                                    const unsigned char *input,
+                                    unsigned char *output)
+{
+    uint8x16_t b0, b1, b2, b3, b4, b5, b6, b7, k;
+    int i;
+
+    AESCE_X8(AESCE_LOAD);
+    for (i = 0; i < rounds - 1; i++) {
+        k = vld1q_u8(keys);
+        keys += 16;
+        AESCE_X8(AESCE_ENC_ROUND);
+    }
+    k = vld1q_u8(keys);
+    keys += 16;
+    AESCE_X8(AESCE_ENC_LAST);
+    k = vld1q_u8(keys);
+    AESCE_X8(AESCE_ADD_KEY);
+    AESCE_X8(AESCE_STORE);
+}
+
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+MBEDTLS_OPTIMIZE_FOR_PERFORMANCE
+static void aesce_decrypt_blocks_x8(const unsigned char *keys, int rounds,
+                                    const unsigned char *input,
+                                    unsigned char *output)
+{
+    uint8x16_t b0, b1, b2, b3, b4, b5, b6, b7, k;
+    int i;
+
+    AESCE_X8(AESCE_LOAD);
+    for (i = 0; i < rounds - 1; i++) {
+        k = vld1q_u8(keys);
+        keys += 16;
+        AESCE_X8(AESCE_DEC_ROUND);
+    }
+    k = vld1q_u8(keys);
+    keys += 16;
+    AESCE_X8(AESCE_DEC_LAST);
+    k = vld1q_u8(keys);
+    AESCE_X8(AESCE_ADD_KEY);
+    AESCE_X8(AESCE_STORE);
+}
+#endif
+
+/*
+ * AES-ECB en(de)cryption of several blocks
+ */
+int mbedtls_aesce_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                   int mode,
+                                   size_t length,
+                                   const unsigned char *input,
+                                   unsigned char *output)
+{
+    const unsigned char *keys = (const unsigned char *) (ctx->buf + ctx->rk_offset);
+
+    for (; length >= 128; length -= 128, input += 128, output += 128) {
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+        if (mode == MBEDTLS_AES_DECRYPT) {
+            aesce_decrypt_blocks_x8(keys, ctx->nr, input, output);
+        } else
+#endif
+        {
+            aesce_encrypt_blocks_x8(keys, ctx->nr, input, output);
+        }
+    }
+
+    for (; length > 0; length -= 16, input += 16, output += 16) {
+        mbedtls_aesce_crypt_ecb(ctx, mode, input, output);
+    }
+
+    return 0;
+}
+
 /*
  * Compute decryption round keys from encryption round keys
  */
@@ -602,6 +694,55 @@ void mbedtls_aesce_gcm_mult(unsigned char c[16],
     vst1q_u8(&c[0], vc);
 }
 
+/* Accumulate the unreduced product a * b into acc. */
+static inline void poly_mult_128_acc(uint8x16x3_t *acc, uint8x16_t a, uint8x16_t b)
+{
+    uint8x16x3_t p = poly_mult_128(a, b);
+
+    acc->val[0] = veorq_u8(acc->val[0], p.val[0]);
+    acc->val[1] = veorq_u8(acc->val[1], p.val[1]);
+    acc->val[2] = veorq_u8(acc->val[2], p.val[2]);
+}
+
+/*
+ * GHASH of several blocks: x = (...((x + d_0) * H + d_1) * H ...) * H
+ *
+ * Four blocks at a time, this is
+ *     x = (x + d_0) * H^4 + d_1 * H^3 + d_2 * H^2 + d_3 * H
+ * The four multiplications are independent, and a single reduction is
+ * needed since reduction is linear.
+ */
+void mbedtls_aesce_gcm_ghash_blocks(unsigned char x[16],
+                                    const unsigned char htable[64],
+                                    const unsigned char *input,
+                                    size_t nblocks)
+{
+    uint8x16_t vx, h1, h2, h3, h4;
+    uint8x16x3_t acc;
+
+    vx = vrbitq_u8(vld1q_u8(&x[0]));
+    h1 = vrbitq_u8(vld1q_u8(&htable[0]));
+    h2 = vrbitq_u8(vld1q_u8(&htable[16]));
+    h3 = vrbitq_u8(vld1q_u8(&htable[32]));
+    h4 = vrbitq_u8(vld1q_u8(&htable[48]));
+
+    for (; nblocks >= 4; nblocks -= 4, input += 64) {
+        vx = veorq_u8(vx, vrbitq_u8(vld1q_u8(&input[0])));
+        acc = poly_mult_128(vx, h4);
+        poly_mult_128_acc(&acc, vrbitq_u8(vld1q_u8(&input[16])), h3);
+        poly_mult_128_acc(&acc, vrbitq_u8(vld1q_u8(&input[32])), h2);
+        poly_mult_128_acc(&acc, vrbitq_u8(vld1q_u8(&input[48])), h1);
+        vx = poly_mult_reduce(acc);
+    }
+
+    for (; nblocks > 0; nblocks--, input += 16) {
+        vx = veorq_u8(vx, vrbitq_u8(vld1q_u8(&input[0])));
+        vx = poly_mult_reduce(poly_mult_128(vx, h1));
+    }
+
+    vst1q_u8(&x[0], vrbitq_u8(vx));
+}
+
 #endif /* MBEDTLS_GCM_C */
 
 #if defined(MBEDTLS_POP_TARGET_PRAGMA)
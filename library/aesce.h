@@ -19,6 +19,8 @@
 
 #include "mbedtls/aes.h"
 
+#include "cpu_accel_internal.h"
+
 
 #if defined(MBEDTLS_AESCE_C) \
     && defined(MBEDTLS_ARCH_IS_ARMV8_A) && defined(MBEDTLS_HAVE_NEON_INTRINSICS) \
@@ -44,19 +46,29 @@ extern signed char mbedtls_aesce_has_support_result;
  */
 int mbedtls_aesce_has_support_impl(void);
 
-#define MBEDTLS_AESCE_HAS_SUPPORT() (mbedtls_aesce_has_support_result == -1 ? \
-                                     mbedtls_aesce_has_support_impl() : \
-                                     mbedtls_aesce_has_support_result)
+#define MBEDTLS_AESCE_CPU_HAS_SUPPORT() (mbedtls_aesce_has_support_result == -1 ? \
+                                         mbedtls_aesce_has_support_impl() : \
+                                         mbedtls_aesce_has_support_result)
 
 #else /* defined(__linux__) && !defined(MBEDTLS_AES_USE_HARDWARE_ONLY) */
 
 /* If we are not on Linux, we can't detect support so assume that it's supported.
  * Similarly, assume support if MBEDTLS_AES_USE_HARDWARE_ONLY is set.
  */
-#define MBEDTLS_AESCE_HAS_SUPPORT() 1
+#define MBEDTLS_AESCE_CPU_HAS_SUPPORT() 1
 
 #endif /* defined(__linux__) && !defined(MBEDTLS_AES_USE_HARDWARE_ONLY) */
 
+/* Whether to use AESCE for the AES block cipher: MBEDTLS_AESCE_CPU_HAS_SUPPORT()
+ * tells whether the processor has the instructions, which GCM uses
+ * independently. */
+#if defined(MBEDTLS_AES_USE_HARDWARE_ONLY)
+#define MBEDTLS_AESCE_HAS_SUPPORT() 1
+#else
+#define MBEDTLS_AESCE_HAS_SUPPORT() \
+    (!MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_AES) && MBEDTLS_AESCE_CPU_HAS_SUPPORT())
+#endif
+
 /**
  * \brief          Internal AES-ECB block encryption and decryption
  *
@@ -75,6 +87,29 @@ int mbedtls_aesce_crypt_ecb(mbedtls_aes_context *ctx,
                             const unsigned char input[16],
                             unsigned char output[16]);
 
+/**
+ * \brief          Internal AES-ECB encryption and decryption of several
+ *                 consecutive blocks
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param ctx      AES context
+ * \param mode     MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+ * \param length   Length of the input and output in bytes.
+ *                 Must be a multiple of 16.
+ * \param input    Input blocks
+ * \param output   Output blocks. This must either not overlap with
+ *                 \p input, or be equal.
+ *
+ * \return         0 on success (cannot fail)
+ */
+int mbedtls_aesce_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                   int mode,
+                                   size_t length,
+                                   const unsigned char *input,
+                                   unsigned char *output);
+
 /**
  * \brief          Internal GCM multiplication: c = a * b in GF(2^128)
  *
@@ -92,6 +127,26 @@ void mbedtls_aesce_gcm_mult(unsigned char c[16],
                             const unsigned char a[16],
                             const unsigned char b[16]);
 
+/**
+ * \brief          Internal GHASH of several blocks: for each 16-byte
+ *                 block d of \p input in turn, x = (x + d) * H
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param x        GHASH state, updated in place
+ * \param htable   H, H^2, H^3 and H^4, 16 bytes each
+ * \param input    Input blocks
+ * \param nblocks  Number of 16-byte blocks in \p input
+ *
+ * \note           All values are bit strings interpreted as elements of
+ *                 GF(2^128) as per the GCM spec.
+ */
+void mbedtls_aesce_gcm_ghash_blocks(unsigned char x[16],
+                                    const unsigned char htable[64],
+                                    const unsigned char *input,
+                                    size_t nblocks);
+
 
 #if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
 /**
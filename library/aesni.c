@@ -15,6 +15,7 @@
 #if defined(MBEDTLS_AESNI_C)
 
 #include "aesni.h"
+#include "cpu_accel_internal.h"
 
 #include <string.h>
 
@@ -70,6 +71,11 @@ int mbedtls_aesni_has_support(unsigned int what)
         done = 1;
     }
 
+    if ((what & MBEDTLS_AESNI_AES) != 0 &&
+        MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_AES)) {
+        return 0;
+    }
+
     return (c & what) != 0;
 }
 #endif /* !MBEDTLS_AES_USE_HARDWARE_ONLY */
@@ -119,6 +125,77 @@ int mbedtls_aesni_crypt_ecb(mbedtls_aes_context *ctx,
     return 0;
 }
 
+/*
+ * AES-NI AES-ECB en(de)cryption of several blocks.
+ * Interleave four blocks so that the AES unit's pipeline stays busy.
+ */
+int mbedtls_aesni_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                   int mode,
+                                   size_t length,
+                                   const unsigned char *input,
+                                   unsigned char *output)
+{
+    for (; length >= 64; length -= 64, input += 64, output += 64) {
+        const __m128i *rk = (const __m128i *) (ctx->buf + ctx->rk_offset);
+        unsigned nr = ctx->nr; // Number of remaining rounds
+        __m128i s0, s1, s2, s3;
+
+        // Load round key 0
+        memcpy(&s0, input, 16);
+        memcpy(&s1, input + 16, 16);
+        memcpy(&s2, input + 32, 16);
+        memcpy(&s3, input + 48, 16);
+        s0 = _mm_xor_si128(s0, rk[0]);
+        s1 = _mm_xor_si128(s1, rk[0]);
+        s2 = _mm_xor_si128(s2, rk[0]);
+        s3 = _mm_xor_si128(s3, rk[0]);
+        ++rk;
+        --nr;
+
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+        if (mode == MBEDTLS_AES_DECRYPT) {
+            while (nr != 0) {
+                s0 = _mm_aesdec_si128(s0, *rk);
+                s1 = _mm_aesdec_si128(s1, *rk);
+                s2 = _mm_aesdec_si128(s2, *rk);
+                s3 = _mm_aesdec_si128(s3, *rk);
+                ++rk;
+                --nr;
+            }
+            s0 = _mm_aesdeclast_si128(s0, *rk);
+            s1 = _mm_aesdeclast_si128(s1, *rk);
+            s2 = _mm_aesdeclast_si128(s2, *rk);
+            s3 = _mm_aesdeclast_si128(s3, *rk);
+        } else
+#endif
+        {
+            while (nr != 0) {
+                s0 = _mm_aesenc_si128(s0, *rk);
+                s1 = _mm_aesenc_si128(s1, *rk);
+                s2 = _mm_aesenc_si128(s2, *rk);
+                s3 = _mm_aesenc_si128(s3, *rk);
+                ++rk;
+                --nr;
+            }
+            s0 = _mm_aesenclast_si128(s0, *rk);
+            s1 = _mm_aesenclast_si128(s1, *rk);
+            s2 = _mm_aesenclast_si128(s2, *rk);
+            s3 = _mm_aesenclast_si128(s3, *rk);
+        }
+
+        memcpy(output, &s0, 16);
+        memcpy(output + 16, &s1, 16);
+        memcpy(output + 32, &s2, 16);
+        memcpy(output + 48, &s3, 16);
+    }
+
+    for (; length > 0; length -= 16, input += 16, output += 16) {
+        mbedtls_aesni_crypt_ecb(ctx, mode, input, output);
+    }
+
+    return 0;
+}
+
 /*
  * GCM multiplication: c = a times b in GF(2^128)
  * Based on [CLMUL-WP] algorithms 1 (with equation 27) and 5.
@@ -447,6 +524,10 @@ static void aesni_setkey_enc_256(unsigned char *rk_bytes,
 #define xmm0_xmm4   "0xE0"
 #define xmm1_xmm0   "0xC1"
 #define xmm1_xmm2   "0xD1"
+#define xmm4_xmm0   "0xC4"
+#define xmm4_xmm1   "0xCC"
+#define xmm4_xmm2   "0xD4"
+#define xmm4_xmm3   "0xDC"
 
 /*
  * AES-NI AES-ECB block en(de)cryption
@@ -495,6 +576,84 @@ int mbedtls_aesni_crypt_ecb(mbedtls_aes_context *ctx,
     return 0;
 }
 
+/*
+ * AES-NI AES-ECB en(de)cryption of several blocks.
+ * Interleave four blocks so that the AES unit's pipeline stays busy.
+ */
+int mbedtls_aesni_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                   int mode,
+                                   size_t length,
+                                   const unsigned char *input,
+                                   unsigned char *output)
+{
+    for (; length >= 64; length -= 64, input += 64, output += 64) {
+        unsigned nr = ctx->nr;
+        const unsigned char *rk = (const unsigned char *) (ctx->buf + ctx->rk_offset);
+
+        asm volatile ("movdqu    (%3), %%xmm0    \n\t" // load input
+                      "movdqu  16(%3), %%xmm1    \n\t"
+                      "movdqu  32(%3), %%xmm2    \n\t"
+                      "movdqu  48(%3), %%xmm3    \n\t"
+                      "movdqu    (%1), %%xmm4    \n\t" // load round key 0
+                      "pxor      %%xmm4, %%xmm0  \n\t" // round 0
+                      "pxor      %%xmm4, %%xmm1  \n\t"
+                      "pxor      %%xmm4, %%xmm2  \n\t"
+                      "pxor      %%xmm4, %%xmm3  \n\t"
+                      "add       $16, %1         \n\t" // point to next round key
+                      "subl      $1, %0          \n\t" // normal rounds = nr - 1
+                      "test      %2, %2          \n\t" // mode?
+                      "jz        2f              \n\t" // 0 = decrypt
+
+                      "1:                        \n\t" // encryption loop
+                      "movdqu    (%1), %%xmm4    \n\t" // load round key
+                      AESENC(xmm4_xmm0)                // do round
+                      AESENC(xmm4_xmm1)
+                      AESENC(xmm4_xmm2)
+                      AESENC(xmm4_xmm3)
+                      "add       $16, %1         \n\t" // point to next round key
+                      "subl      $1, %0          \n\t" // loop
+                      "jnz       1b              \n\t"
+                      "movdqu    (%1), %%xmm4    \n\t" // load round key
+                      AESENCLAST(xmm4_xmm0)            // last round
+                      AESENCLAST(xmm4_xmm1)
+                      AESENCLAST(xmm4_xmm2)
+                      AESENCLAST(xmm4_xmm3)
+         #if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+                      "jmp       3f              \n\t"
+
+                      "2:                        \n\t" // decryption loop
+                      "movdqu    (%1), %%xmm4    \n\t"
+                      AESDEC(xmm4_xmm0)                // do round
+                      AESDEC(xmm4_xmm1)
+                      AESDEC(xmm4_xmm2)
+                      AESDEC(xmm4_xmm3)
+                      "add       $16, %1         \n\t"
+                      "subl      $1, %0          \n\t"
+                      "jnz       2b              \n\t"
+                      "movdqu    (%1), %%xmm4    \n\t" // load round key
+                      AESDECLAST(xmm4_xmm0)            // last round
+                      AESDECLAST(xmm4_xmm1)
+                      AESDECLAST(xmm4_xmm2)
+                      AESDECLAST(xmm4_xmm3)
+         #endif
+
+                      "3:                        \n\t"
+                      "movdqu    %%xmm0,   (%4)  \n\t" // export output
+                      "movdqu    %%xmm1, 16(%4)  \n\t"
+                      "movdqu    %%xmm2, 32(%4)  \n\t"
+                      "movdqu    %%xmm3, 48(%4)  \n\t"
+                      : "+r" (nr), "+r" (rk)
+                      : "r" (mode), "r" (input), "r" (output)
+                      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4");
+    }
+
+    for (; length > 0; length -= 16, input += 16, output += 16) {
+        mbedtls_aesni_crypt_ecb(ctx, mode, input, output);
+    }
+
+    return 0;
+}
+
 /*
  * GCM multiplication: c = a times b in GF(2^128)
  * Based on [CLMUL-WP] algorithms 1 (with equation 27) and 5.
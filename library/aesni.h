@@ -102,6 +102,29 @@ int mbedtls_aesni_crypt_ecb(mbedtls_aes_context *ctx,
                             const unsigned char input[16],
                             unsigned char output[16]);
 
+/**
+ * \brief          Internal AES-NI AES-ECB encryption and decryption of
+ *                 several consecutive blocks
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param ctx      AES context
+ * \param mode     MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+ * \param length   Length of the input and output in bytes.
+ *                 Must be a multiple of 16.
+ * \param input    Input blocks
+ * \param output   Output blocks. This must either not overlap with
+ *                 \p input, or be equal.
+ *
+ * \return         0 on success (cannot fail)
+ */
+int mbedtls_aesni_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                   int mode,
+                                   size_t length,
+                                   const unsigned char *input,
+                                   unsigned char *output);
+
 /**
  * \brief          Internal GCM multiplication: c = a * b in GF(2^128)
  *
@@ -21,6 +21,20 @@
 #include "bn_mul.h"
 #include "constant_time_internal.h"
 
+/* Vector kernels for mbedtls_mpi_core_cond_or(). These are only used when
+ * the compiler already targets the corresponding instruction set, so no
+ * runtime detection is needed. */
+#if (defined(MBEDTLS_ARCH_IS_X64) || defined(MBEDTLS_ARCH_IS_X86)) && \
+    defined(__SSE2__)
+#define MBEDTLS_MPI_CORE_HAVE_SSE2
+#if defined(__AVX2__)
+#define MBEDTLS_MPI_CORE_HAVE_AVX2
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
 size_t mbedtls_mpi_core_clz(mbedtls_mpi_uint a)
 {
 #if defined(__has_builtin)
@@ -184,6 +198,55 @@ void mbedtls_mpi_core_cond_assign(mbedtls_mpi_uint *X,
     }
 }
 
+void mbedtls_mpi_core_cond_or(mbedtls_mpi_uint *X,
+                              const mbedtls_mpi_uint *A,
+                              size_t limbs,
+                              mbedtls_ct_condition_t cond)
+{
+    /* cond is either all-zeros or all-ones, so it can be used directly as a
+     * mask. Keep it opaque so that the compiler cannot turn the masked OR
+     * below back into a branch. */
+    const mbedtls_mpi_uint mask =
+        (mbedtls_mpi_uint) mbedtls_ct_compiler_opaque((mbedtls_ct_uint_t) cond);
+    size_t i = 0;
+
+    /* This is the inner loop of table lookups (exponentiation windows, ECP
+     * comb tables) which touch every entry of the table, so process as many
+     * limbs per instruction as the target allows. All loads and stores are
+     * unaligned, and the mask is applied to every byte regardless of its
+     * value. */
+#if defined(MBEDTLS_MPI_CORE_HAVE_AVX2)
+    const __m256i mask256 = _mm256_set1_epi8((char) mask);
+    for (; i + 32 / ciL <= limbs; i += 32 / ciL) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (A + i));
+        __m256i x = _mm256_loadu_si256((const __m256i *) (X + i));
+        x = _mm256_or_si256(x, _mm256_and_si256(a, mask256));
+        _mm256_storeu_si256((__m256i *) (X + i), x);
+    }
+#endif
+#if defined(MBEDTLS_MPI_CORE_HAVE_SSE2)
+    const __m128i mask128 = _mm_set1_epi8((char) mask);
+    for (; i + 16 / ciL <= limbs; i += 16 / ciL) {
+        __m128i a = _mm_loadu_si128((const __m128i *) (A + i));
+        __m128i x = _mm_loadu_si128((const __m128i *) (X + i));
+        x = _mm_or_si128(x, _mm_and_si128(a, mask128));
+        _mm_storeu_si128((__m128i *) (X + i), x);
+    }
+#elif defined(MBEDTLS_HAVE_NEON_INTRINSICS)
+    const uint8x16_t mask128 = vdupq_n_u8((uint8_t) mask);
+    for (; i + 16 / ciL <= limbs; i += 16 / ciL) {
+        uint8x16_t a = vld1q_u8((const uint8_t *) (A + i));
+        uint8x16_t x = vld1q_u8((const uint8_t *) (X + i));
+        x = vorrq_u8(x, vandq_u8(a, mask128));
+        vst1q_u8((uint8_t *) (X + i), x);
+    }
+#endif
+
+    for (; i < limbs; i++) {
+        X[i] |= A[i] & mask;
+    }
+}
+
 void mbedtls_mpi_core_cond_swap(mbedtls_mpi_uint *X,
                                 mbedtls_mpi_uint *Y,
                                 size_t limbs,
@@ -600,9 +663,14 @@ void mbedtls_mpi_core_ct_uint_table_lookup(mbedtls_mpi_uint *dest,
                                            size_t count,
                                            size_t index)
 {
+    /* Accumulate the selected entry into a zeroed destination: every entry
+     * is still read, but each step is a plain masked OR which, unlike a
+     * conditional assignment, does not depend on the current value of dest
+     * and can be done on several limbs at once. */
+    memset(dest, 0, limbs * ciL);
     for (size_t i = 0; i < count; i++, table += limbs) {
-        mbedtls_ct_condition_t assign = mbedtls_ct_uint_eq(i, index);
-        mbedtls_mpi_core_cond_assign(dest, table, limbs, assign);
+        mbedtls_ct_condition_t select = mbedtls_ct_uint_eq(i, index);
+        mbedtls_mpi_core_cond_or(dest, table, limbs, select);
     }
 }
 
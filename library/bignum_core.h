@@ -178,6 +178,34 @@ void mbedtls_mpi_core_cond_assign(mbedtls_mpi_uint *X,
                                   size_t limbs,
                                   mbedtls_ct_condition_t assign);
 
+/**
+ * \brief   Perform a safe conditional bitwise OR of an MPI into another,
+ *          without revealing whether the operation was done or not.
+ *
+ * This computes `X |= cond ? A : 0` limb by limb. It is intended for
+ * constant-time table lookups: starting from a zeroed destination and
+ * OR-ing in every table entry with a condition that is true for exactly
+ * one of them leaves that entry in the destination.
+ *
+ * \param[in,out] X     The address of the destination MPI.
+ *                      This must be initialized. Must have at least
+ *                      \p limbs limbs.
+ * \param[in]  A        The address of the source MPI. This must be
+ *                      initialized. It may alias \p X.
+ * \param      limbs    The number of limbs of \p A.
+ * \param      cond     The condition deciding whether to perform the
+ *                      operation or not. Callers will need to use
+ *                      the constant time interface (e.g. `mbedtls_ct_bool()`)
+ *                      to construct this argument.
+ *
+ * \note           This function avoids leaking any information about whether
+ *                 the operation was done or not.
+ */
+void mbedtls_mpi_core_cond_or(mbedtls_mpi_uint *X,
+                              const mbedtls_mpi_uint *A,
+                              size_t limbs,
+                              mbedtls_ct_condition_t cond);
+
 /**
  * \brief   Perform a safe conditional swap of two MPIs which doesn't reveal
  *          whether the swap was done or not.
@@ -19,6 +19,10 @@
 
 #include "block_cipher_internal.h"
 
+#if defined(MBEDTLS_AES_C)
+#include "aes_internal.h"
+#endif
+
 #if defined(MBEDTLS_BLOCK_CIPHER_C)
 
 #if defined(MBEDTLS_BLOCK_CIPHER_SOME_PSA)
@@ -200,4 +204,46 @@ int mbedtls_block_cipher_encrypt(mbedtls_block_cipher_context_t *ctx,
     }
 }
 
+int mbedtls_block_cipher_encrypt_blocks(mbedtls_block_cipher_context_t *ctx,
+                                        size_t length,
+                                        const unsigned char *input,
+                                        unsigned char *output)
+{
+    int ret = 0;
+
+    if (length % 16 != 0) {
+        return MBEDTLS_ERR_CIPHER_FULL_BLOCK_EXPECTED;
+    }
+
+#if defined(MBEDTLS_BLOCK_CIPHER_SOME_PSA)
+    if (ctx->engine == MBEDTLS_BLOCK_CIPHER_ENGINE_PSA) {
+        psa_status_t status;
+        size_t olen;
+
+        if (length == 0) {
+            return 0;
+        }
+
+        status = psa_cipher_encrypt(ctx->psa_key_id, PSA_ALG_ECB_NO_PADDING,
+                                    input, length, output, length, &olen);
+        if (status != PSA_SUCCESS) {
+            return mbedtls_cipher_error_from_psa(status);
+        }
+        return 0;
+    }
+#endif /* MBEDTLS_BLOCK_CIPHER_SOME_PSA */
+
+#if defined(MBEDTLS_AES_C)
+    if (ctx->id == MBEDTLS_BLOCK_CIPHER_ID_AES) {
+        return mbedtls_aes_crypt_ecb_blocks(&ctx->ctx.aes, MBEDTLS_AES_ENCRYPT,
+                                            length, input, output);
+    }
+#endif
+
+    for (; length > 0 && ret == 0; length -= 16, input += 16, output += 16) {
+        ret = mbedtls_block_cipher_encrypt(ctx, input, output);
+    }
+    return ret;
+}
+
 #endif /* MBEDTLS_BLOCK_CIPHER_C */
@@ -85,6 +85,34 @@ int mbedtls_block_cipher_setkey(mbedtls_block_cipher_context_t *ctx,
 int mbedtls_block_cipher_encrypt(mbedtls_block_cipher_context_t *ctx,
                                  const unsigned char input[16],
                                  unsigned char output[16]);
+
+/**
+ * \brief           Encrypt several consecutive blocks with the configured
+ *                  key (ECB).
+ *
+ *                  This is equivalent to calling
+ *                  mbedtls_block_cipher_encrypt() on each block in turn,
+ *                  but the underlying implementation gets all the blocks
+ *                  at once, which lets it process them in parallel.
+ *
+ * \param ctx       The context holding the key.
+ * \param length    The length of \p input and \p output in bytes.
+ *                  Must be a multiple of 16.
+ * \param input     The buffer holding the input blocks.
+ * \param output    The buffer to which the output blocks will be written.
+ *                  This must either not overlap with \p input, or be equal.
+ *
+ * \retval          \c 0 on success.
+ * \retval          #MBEDTLS_ERR_CIPHER_FULL_BLOCK_EXPECTED if \p length
+ *                  is not a multiple of 16.
+ * \retval          #MBEDTLS_ERR_CIPHER_INVALID_CONTEXT if the context was not
+ *                  properly set up before calling this function.
+ * \retval          Another negative value if encryption failed.
+ */
+int mbedtls_block_cipher_encrypt_blocks(mbedtls_block_cipher_context_t *ctx,
+                                        size_t length,
+                                        const unsigned char *input,
+                                        unsigned char *output);
 /**
  * \brief           Clear the context.
  *
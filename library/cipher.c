@@ -602,15 +602,15 @@ int mbedtls_cipher_update(mbedtls_cipher_context_t *ctx, const unsigned char *in
     }
 
     if (((mbedtls_cipher_mode_t) ctx->cipher_info->mode) == MBEDTLS_MODE_ECB) {
-        if (ilen != block_size) {
+        if (ilen == 0 || ilen % block_size != 0) {
             return MBEDTLS_ERR_CIPHER_FULL_BLOCK_EXPECTED;
         }
 
         *olen = ilen;
 
         if (0 != (ret = mbedtls_cipher_get_base(ctx->cipher_info)->ecb_func(ctx->cipher_ctx,
-                                                                            ctx->operation, input,
-                                                                            output))) {
+                                                                            ctx->operation, ilen,
+                                                                            input, output))) {
             return ret;
         }
 
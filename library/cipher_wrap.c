@@ -22,6 +22,7 @@
 
 #if defined(MBEDTLS_AES_C)
 #include "mbedtls/aes.h"
+#include "aes_internal.h"
 #endif
 
 #if defined(MBEDTLS_CAMELLIA_C)
@@ -160,10 +161,11 @@ static void ccm_ctx_free(void *ctx)
 
 #if defined(MBEDTLS_AES_C)
 
-static int aes_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation,
+static int aes_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation, size_t length,
                               const unsigned char *input, unsigned char *output)
 {
-    return mbedtls_aes_crypt_ecb((mbedtls_aes_context *) ctx, operation, input, output);
+    return mbedtls_aes_crypt_ecb_blocks((mbedtls_aes_context *) ctx, operation, length,
+                                        input, output);
 }
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
@@ -774,11 +776,16 @@ static const mbedtls_cipher_info_t aes_256_ccm_star_no_tag_info = {
 
 #if defined(MBEDTLS_CAMELLIA_C)
 
-static int camellia_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation,
+static int camellia_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation, size_t length,
                                    const unsigned char *input, unsigned char *output)
 {
-    return mbedtls_camellia_crypt_ecb((mbedtls_camellia_context *) ctx, operation, input,
-                                      output);
+    int ret = 0;
+
+    for (; length > 0 && ret == 0; length -= 16, input += 16, output += 16) {
+        ret = mbedtls_camellia_crypt_ecb((mbedtls_camellia_context *) ctx, operation, input,
+                                         output);
+    }
+    return ret;
 }
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
@@ -1191,12 +1198,17 @@ static const mbedtls_cipher_info_t camellia_256_ccm_star_no_tag_info = {
 
 #if defined(MBEDTLS_ARIA_C)
 
-static int aria_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation,
+static int aria_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation, size_t length,
                                const unsigned char *input, unsigned char *output)
 {
+    int ret = 0;
     (void) operation;
-    return mbedtls_aria_crypt_ecb((mbedtls_aria_context *) ctx, input,
-                                  output);
+
+    for (; length > 0 && ret == 0; length -= 16, input += 16, output += 16) {
+        ret = mbedtls_aria_crypt_ecb((mbedtls_aria_context *) ctx, input,
+                                     output);
+    }
+    return ret;
 }
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
@@ -1609,18 +1621,28 @@ static const mbedtls_cipher_info_t aria_256_ccm_star_no_tag_info = {
 
 #if defined(MBEDTLS_DES_C)
 
-static int des_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation,
+static int des_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation, size_t length,
                               const unsigned char *input, unsigned char *output)
 {
+    int ret = 0;
     ((void) operation);
-    return mbedtls_des_crypt_ecb((mbedtls_des_context *) ctx, input, output);
+
+    for (; length > 0 && ret == 0; length -= 8, input += 8, output += 8) {
+        ret = mbedtls_des_crypt_ecb((mbedtls_des_context *) ctx, input, output);
+    }
+    return ret;
 }
 
-static int des3_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation,
+static int des3_crypt_ecb_wrap(void *ctx, mbedtls_operation_t operation, size_t length,
                                const unsigned char *input, unsigned char *output)
 {
+    int ret = 0;
     ((void) operation);
-    return mbedtls_des3_crypt_ecb((mbedtls_des3_context *) ctx, input, output);
+
+    for (; length > 0 && ret == 0; length -= 8, input += 8, output += 8) {
+        ret = mbedtls_des3_crypt_ecb((mbedtls_des3_context *) ctx, input, output);
+    }
+    return ret;
 }
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
@@ -75,8 +75,10 @@ struct mbedtls_cipher_base_t {
     /** Base Cipher type (e.g. MBEDTLS_CIPHER_ID_AES) */
     mbedtls_cipher_id_t cipher;
 
-    /** Encrypt using ECB */
-    int (*ecb_func)(void *ctx, mbedtls_operation_t mode,
+    /** Encrypt or decrypt using ECB. \c length is a non-zero multiple of
+     * the block size: implementations should process all the blocks with
+     * a single dispatch to the underlying primitive where possible. */
+    int (*ecb_func)(void *ctx, mbedtls_operation_t mode, size_t length,
                     const unsigned char *input, unsigned char *output);
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
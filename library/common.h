@@ -120,6 +120,18 @@ extern void (*mbedtls_test_hook_test_fail)(const char *test, int line, const cha
  */
 void mbedtls_zeroize_and_free(void *buf, size_t len);
 
+/**
+ * \brief       Identify the current process.
+ *
+ *              This is used to detect state that a child process inherited
+ *              across fork(), such as buffered random data, which must not
+ *              be used by both processes.
+ *
+ * \return      The process ID on platforms that have fork(), and a
+ *              constant elsewhere.
+ */
+long mbedtls_platform_process_id(void);
+
 /** Return an offset into a buffer.
  *
  * This is just the addition of an offset to a pointer, except that this
@@ -150,18 +150,20 @@ int mbedtls_ct_memcmp_partial(const void *a,
 
 void mbedtls_ct_memmove_left(void *start, size_t total, size_t offset)
 {
-    volatile unsigned char *buf = start;
-    for (size_t i = 0; i < total; i++) {
-        mbedtls_ct_condition_t no_op = mbedtls_ct_uint_gt(total - offset, i);
-        /* The first `total - offset` passes are a no-op. The last
-         * `offset` passes shift the data one byte to the left and
-         * zero out the last byte. */
-        for (size_t n = 0; n < total - 1; n++) {
-            unsigned char current = buf[n];
-            unsigned char next    = buf[n+1];
-            buf[n] = mbedtls_ct_uint_if(no_op, current, next);
-        }
-        buf[total-1] = mbedtls_ct_uint_if_else_0(no_op, buf[total-1]);
+    unsigned char *buf = start;
+    /* Decompose the shift into its binary digits: for each power of two
+     * `shift` that can be part of `offset`, conditionally shift the whole
+     * buffer left by `shift` bytes and zero out the last `shift` bytes.
+     * This takes log2(total) passes over the buffer, each of which accesses
+     * every byte regardless of the value of `offset`.
+     *
+     * mbedtls_ct_memcpy_if() works forwards and reads each chunk of src1
+     * before writing the corresponding chunk of dest, so the overlapping
+     * copy with dest < src1 is safe. */
+    for (size_t shift = 1; shift != 0 && shift <= total; shift <<= 1) {
+        mbedtls_ct_condition_t do_shift = mbedtls_ct_bool(offset & shift);
+        mbedtls_ct_memcpy_if(do_shift, buf, buf + shift, NULL, total - shift);
+        mbedtls_ct_zeroize_if(do_shift, buf + total - shift, shift);
     }
 }
 
@@ -456,7 +456,8 @@ void mbedtls_ct_zeroize_if(mbedtls_ct_condition_t condition, void *buf, size_t l
  * memmove(start, start + offset, total - offset);
  * memset(start + (total - offset), 0, offset);
  *
- * Timing independence comes at the expense of performance.
+ * The cost is O(\p total * log(\p total)): one conditional shift of the
+ * whole buffer for each bit of \p offset.
  *
  * \param start     Secret. Pointer to the start of the buffer.
  * \param total     Total size of the buffer.
@@ -486,7 +487,11 @@ void mbedtls_ct_memmove_left(void *start,
  * \param condition The condition
  * \param dest      Secret. Destination pointer.
  * \param src1      Secret. Pointer to copy from (if \p condition == MBEDTLS_CT_TRUE).
- *                  This may be equal to \p dest, but may not overlap in other ways.
+ *                  This may be equal to \p dest. If \p src2 is NULL, it may
+ *                  also overlap \p dest provided that \p src1 > \p dest,
+ *                  since the copy proceeds from lower to higher addresses
+ *                  and reads each chunk before writing it.
+ *                  It may not overlap \p dest in other ways.
  * \param src2      Secret (contents only - may branch to determine if this parameter is NULL).
  *                  Pointer to copy from (if \p condition == MBEDTLS_CT_FALSE and \p src2 is not NULL). May be NULL.
  *                  This may be equal to \p dest, but may not overlap it in other ways. It may overlap with \p src1.
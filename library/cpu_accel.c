@@ -0,0 +1,93 @@
+/*
+ *  Report and override the use of processor acceleration
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+#include "common.h"
+
+#include "mbedtls/cpu_accel.h"
+#include "mbedtls/error.h"
+
+#include "cpu_accel_internal.h"
+
+#include <string.h>
+
+unsigned int mbedtls_cpu_accel_portable = 0;
+
+const char *mbedtls_cpu_accel_get_implementation(unsigned int primitive)
+{
+    switch (primitive) {
+        case MBEDTLS_CPU_ACCEL_AES:
+#if defined(MBEDTLS_AES_ALT)
+            return "alt";
+#elif defined(MBEDTLS_AES_C)
+            return mbedtls_aes_cpu_accel_implementation();
+#else
+            return NULL;
+#endif
+
+        case MBEDTLS_CPU_ACCEL_GHASH:
+#if defined(MBEDTLS_GCM_ALT)
+            return "alt";
+#elif defined(MBEDTLS_GCM_C)
+            return mbedtls_gcm_cpu_accel_implementation();
+#else
+            return NULL;
+#endif
+
+        case MBEDTLS_CPU_ACCEL_SHA256:
+#if defined(MBEDTLS_SHA256_ALT)
+            return "alt";
+#elif defined(MBEDTLS_SHA224_C) || defined(MBEDTLS_SHA256_C)
+            return mbedtls_sha256_cpu_accel_implementation();
+#else
+            return NULL;
+#endif
+
+        case MBEDTLS_CPU_ACCEL_SHA512:
+#if defined(MBEDTLS_SHA512_ALT)
+            return "alt";
+#elif defined(MBEDTLS_SHA384_C) || defined(MBEDTLS_SHA512_C)
+            return mbedtls_sha512_cpu_accel_implementation();
+#else
+            return NULL;
+#endif
+
+        default:
+            return NULL;
+    }
+}
+
+int mbedtls_cpu_accel_set_portable(unsigned int primitives)
+{
+    unsigned int previous = mbedtls_cpu_accel_portable;
+    unsigned int primitive;
+    const char *name;
+
+    if ((primitives & ~MBEDTLS_CPU_ACCEL_ALL) != 0) {
+        return MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED;
+    }
+
+    /* Check that the request had an effect: a primitive that is built to
+     * use processor instructions unconditionally ignores it. */
+    mbedtls_cpu_accel_portable = primitives;
+    for (primitive = 1; primitive <= MBEDTLS_CPU_ACCEL_ALL; primitive <<= 1) {
+        if ((primitives & primitive) == 0) {
+            continue;
+        }
+        name = mbedtls_cpu_accel_get_implementation(primitive);
+        if (name != NULL && strcmp(name, MBEDTLS_CPU_ACCEL_PORTABLE_NAME) != 0) {
+            mbedtls_cpu_accel_portable = previous;
+            return MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED;
+        }
+    }
+
+    return 0;
+}
+
+unsigned int mbedtls_cpu_accel_get_portable(void)
+{
+    return mbedtls_cpu_accel_portable;
+}
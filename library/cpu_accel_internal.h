@@ -0,0 +1,52 @@
+/**
+ * \file cpu_accel_internal.h
+ *
+ * \brief Internal functions shared by the modules with processor
+ *        acceleration and the cpu_accel module.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_CPU_ACCEL_INTERNAL_H
+#define MBEDTLS_CPU_ACCEL_INTERNAL_H
+
+#include "common.h"
+
+#include "mbedtls/cpu_accel.h"
+
+/** The name of the portable implementation of every primitive. */
+#define MBEDTLS_CPU_ACCEL_PORTABLE_NAME "c"
+
+/** The primitives for which mbedtls_cpu_accel_set_portable() forced the
+ * portable implementation. */
+extern unsigned int mbedtls_cpu_accel_portable;
+
+/** Whether the portable implementation of \p primitive is forced.
+ * Runtime support checks for processor instructions return "unsupported"
+ * when this is true. */
+#define MBEDTLS_CPU_ACCEL_IS_PORTABLE(primitive) \
+    ((mbedtls_cpu_accel_portable & (primitive)) != 0)
+
+/* The implementation that each module would select now, as reported by
+ * mbedtls_cpu_accel_get_implementation(). */
+
+#if defined(MBEDTLS_AES_C) && !defined(MBEDTLS_AES_ALT)
+const char *mbedtls_aes_cpu_accel_implementation(void);
+#endif
+
+#if defined(MBEDTLS_GCM_C) && !defined(MBEDTLS_GCM_ALT)
+const char *mbedtls_gcm_cpu_accel_implementation(void);
+#endif
+
+#if (defined(MBEDTLS_SHA224_C) || defined(MBEDTLS_SHA256_C)) && \
+    !defined(MBEDTLS_SHA256_ALT)
+const char *mbedtls_sha256_cpu_accel_implementation(void);
+#endif
+
+#if (defined(MBEDTLS_SHA384_C) || defined(MBEDTLS_SHA512_C)) && \
+    !defined(MBEDTLS_SHA512_ALT)
+const char *mbedtls_sha512_cpu_accel_implementation(void);
+#endif
+
+#endif /* MBEDTLS_CPU_ACCEL_INTERNAL_H */
@@ -18,6 +18,7 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -546,7 +547,7 @@ int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context *ctx,
 
     /* The mutex is initialized iff f_entropy is set. */
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "ctr_drbg");
 #endif
 
     ctx->f_entropy = f_entropy;
@@ -21,11 +21,53 @@
 /* DEBUG_BUF_SIZE must be at least 2 */
 #define DEBUG_BUF_SIZE      512
 
-static int debug_threshold = 0;
+int mbedtls_debug_threshold = 0;
 
 void mbedtls_debug_set_threshold(int threshold)
 {
-    debug_threshold = threshold;
+    mbedtls_debug_threshold = threshold;
+}
+
+int mbedtls_debug_event_format(const mbedtls_debug_event *event,
+                               char *buf, size_t buf_size)
+{
+    va_list argp;
+    int ret;
+
+    if (event->type != MBEDTLS_DEBUG_EVENT_MSG || event->args == NULL) {
+        return -1;
+    }
+
+    va_copy(argp, *(va_list *) event->args);
+    ret = mbedtls_vsnprintf(buf, buf_size, event->text, argp);
+    va_end(argp);
+
+    return ret;
+}
+
+/*
+ * All calls to f_dbg_event must be made via this function
+ */
+static void debug_send_event(const mbedtls_ssl_context *ssl,
+                             mbedtls_debug_event_type type, int level,
+                             const char *file, int line, const char *text,
+                             int ret, va_list *args,
+                             const unsigned char *data, size_t len)
+{
+    mbedtls_debug_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.level = level;
+    event.file = file;
+    event.line = line;
+    event.text = text;
+    event.ret = ret;
+    event.args = args;
+    event.data = data;
+    event.len = len;
+
+    ssl->conf->f_dbg_event(ssl->conf->p_dbg_event, ssl, &event);
 }
 
 /*
@@ -60,14 +102,19 @@ void mbedtls_debug_print_msg(const mbedtls_ssl_context *ssl, int level,
 
     MBEDTLS_STATIC_ASSERT(DEBUG_BUF_SIZE >= 2, "DEBUG_BUF_SIZE too small");
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        level > debug_threshold) {
+    if (!mbedtls_debug_is_enabled(ssl, level)) {
         return;
     }
 
     va_start(argp, format);
+
+    if (ssl->conf->f_dbg_event != NULL) {
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_MSG, level, file, line,
+                         format, 0, &argp, NULL, 0);
+        va_end(argp);
+        return;
+    }
+
     ret = mbedtls_vsnprintf(str, DEBUG_BUF_SIZE, format, argp);
     va_end(argp);
 
@@ -90,10 +137,7 @@ void mbedtls_debug_print_ret(const mbedtls_ssl_context *ssl, int level,
 {
     char str[DEBUG_BUF_SIZE];
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        level > debug_threshold) {
+    if (!mbedtls_debug_is_enabled(ssl, level)) {
         return;
     }
 
@@ -106,6 +150,12 @@ void mbedtls_debug_print_ret(const mbedtls_ssl_context *ssl, int level,
         return;
     }
 
+    if (ssl->conf->f_dbg_event != NULL) {
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_RET, level, file, line,
+                         text, ret, NULL, NULL, 0);
+        return;
+    }
+
     mbedtls_snprintf(str, sizeof(str), "%s() returned %d (-0x%04x)\n",
                      text, ret, (unsigned int) -ret);
 
@@ -120,10 +170,13 @@ void mbedtls_debug_print_buf(const mbedtls_ssl_context *ssl, int level,
     char txt[17];
     size_t i, idx = 0;
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        level > debug_threshold) {
+    if (!mbedtls_debug_is_enabled(ssl, level)) {
+        return;
+    }
+
+    if (ssl->conf->f_dbg_event != NULL) {
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_BUF, level, file, line,
+                         text, 0, NULL, buf, len);
         return;
     }
 
@@ -174,10 +227,28 @@ void mbedtls_debug_print_ecp(const mbedtls_ssl_context *ssl, int level,
 {
     char str[DEBUG_BUF_SIZE];
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        level > debug_threshold) {
+    if (!mbedtls_debug_is_enabled(ssl, level)) {
+        return;
+    }
+
+    if (ssl->conf->f_dbg_event != NULL) {
+        unsigned char bin[2 * MBEDTLS_ECP_MAX_BYTES];
+        const unsigned char *data = bin;
+        size_t plen = mbedtls_mpi_size(&X->X);
+
+        /* Both coordinates are output with the same length */
+        if (mbedtls_mpi_size(&X->Y) > plen) {
+            plen = mbedtls_mpi_size(&X->Y);
+        }
+
+        if (plen > MBEDTLS_ECP_MAX_BYTES ||
+            mbedtls_mpi_write_binary(&X->X, bin, plen) != 0 ||
+            mbedtls_mpi_write_binary(&X->Y, bin + plen, plen) != 0) {
+            data = NULL;
+        }
+
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_ECP, level, file, line,
+                         text, 0, NULL, data, 2 * plen);
         return;
     }
 
@@ -238,10 +309,7 @@ void mbedtls_debug_print_psa_ec(const mbedtls_ssl_context *ssl, int level,
     const uint8_t *coord_start;
     size_t coord_len;
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        level > debug_threshold) {
+    if (!mbedtls_debug_is_enabled(ssl, level)) {
         return;
     }
 
@@ -249,6 +317,12 @@ void mbedtls_debug_print_psa_ec(const mbedtls_ssl_context *ssl, int level,
      * psa_export_public_key() function. */
     coord_len = (pk->pub_raw_len - 1)/2;
 
+    if (ssl->conf->f_dbg_event != NULL) {
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_ECP, level, file, line,
+                         text, 0, NULL, pk->pub_raw + 1, 2 * coord_len);
+        return;
+    }
+
     /* X coordinate */
     coord_start = pk->pub_raw + 1;
     mbedtls_snprintf(str, sizeof(str), "%s(X)", text);
@@ -270,11 +344,21 @@ void mbedtls_debug_print_mpi(const mbedtls_ssl_context *ssl, int level,
     size_t bitlen;
     size_t idx = 0;
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        NULL == X                ||
-        level > debug_threshold) {
+    if (NULL == X || !mbedtls_debug_is_enabled(ssl, level)) {
+        return;
+    }
+
+    if (ssl->conf->f_dbg_event != NULL) {
+        unsigned char bin[MBEDTLS_MPI_MAX_SIZE];
+        const unsigned char *data = bin;
+        size_t n = mbedtls_mpi_size(X);
+
+        if (n > sizeof(bin) || mbedtls_mpi_write_binary(X, bin, n) != 0) {
+            data = NULL;
+        }
+
+        debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_MPI, level, file, line,
+                         text, 0, NULL, data, n);
         return;
     }
 
@@ -388,11 +472,15 @@ void mbedtls_debug_print_crt(const mbedtls_ssl_context *ssl, int level,
     char str[DEBUG_BUF_SIZE];
     int i = 0;
 
-    if (NULL == ssl              ||
-        NULL == ssl->conf        ||
-        NULL == ssl->conf->f_dbg ||
-        NULL == crt              ||
-        level > debug_threshold) {
+    if (NULL == crt || !mbedtls_debug_is_enabled(ssl, level)) {
+        return;
+    }
+
+    if (ssl->conf->f_dbg_event != NULL) {
+        for (; crt != NULL; crt = crt->next) {
+            debug_send_event(ssl, MBEDTLS_DEBUG_EVENT_CRT, level, file, line,
+                             text, 0, NULL, crt->raw.p, crt->raw.len);
+        }
         return;
     }
 
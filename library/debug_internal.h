@@ -12,6 +12,39 @@
 
 #include "mbedtls/debug.h"
 
+/* Global debug threshold, see mbedtls_debug_set_threshold(). */
+extern int mbedtls_debug_threshold;
+
+/**
+ * \brief   Check whether a debug message of the given level would be output.
+ *          The debug macros check this before calling the functions below,
+ *          so that disabled messages cost a comparison and nothing else.
+ *
+ * \param ssl       SSL context, may be NULL
+ * \param level     error level of the debug message
+ *
+ * \return  1 if a debug callback is set and \p level does not exceed the
+ *          threshold of \p ssl, or the global threshold if \p ssl does not
+ *          have its own; 0 otherwise.
+ */
+static inline int mbedtls_debug_is_enabled(const mbedtls_ssl_context *ssl,
+                                           int level)
+{
+    int threshold;
+
+    if (ssl == NULL || ssl->conf == NULL) {
+        return 0;
+    }
+
+    threshold = ssl->dbg_threshold >= 0 ?
+                ssl->dbg_threshold : mbedtls_debug_threshold;
+    if (level > threshold) {
+        return 0;
+    }
+
+    return ssl->conf->f_dbg != NULL || ssl->conf->f_dbg_event != NULL;
+}
+
 /**
  * \brief    Print a message to the debug output. This function is always used
  *          through the MBEDTLS_SSL_DEBUG_MSG() macro, which supplies the ssl
@@ -20,14 +20,159 @@
 
 #include <string.h>
 
-#if defined(MBEDTLS_ECDSA_DETERMINISTIC)
-#include "mbedtls/hmac_drbg.h"
-#endif
-
 #include "mbedtls/platform.h"
 
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "threading_internal.h"
+
+#if defined(MBEDTLS_ECDSA_DETERMINISTIC)
+/*
+ * Nonce generator for deterministic ECDSA: RFC 6979 section 3.2, steps b.
+ * to h., with the optional additional data k' of section 3.6.
+ *
+ * This computes the same sequence as an HMAC_DRBG instantiated with
+ * int2octets(x) || bits2octets(h1) || k', but without the generic DRBG
+ * bookkeeping: in particular the state update that HMAC_DRBG performs after
+ * every output (step h.3) is only done if another candidate is requested,
+ * which for all practical purposes never happens.
+ */
+typedef struct {
+    mbedtls_md_context_t md_ctx;            /* HMAC keyed with K */
+    unsigned char V[MBEDTLS_MD_MAX_SIZE];
+    size_t md_len;
+    int need_update;                        /* do step h.3 before output */
+} ecdsa_rfc6979_context;
+
+static void ecdsa_rfc6979_init(ecdsa_rfc6979_context *ctx)
+{
+    mbedtls_md_init(&ctx->md_ctx);
+    memset(ctx->V, 0, sizeof(ctx->V));
+    ctx->md_len = 0;
+    ctx->need_update = 0;
+}
+
+static void ecdsa_rfc6979_free(ecdsa_rfc6979_context *ctx)
+{
+    mbedtls_md_free(&ctx->md_ctx);
+    mbedtls_platform_zeroize(ctx->V, sizeof(ctx->V));
+    ctx->md_len = 0;
+    ctx->need_update = 0;
+}
+
+/*
+ * K = HMAC_K(V || sep || data)
+ * V = HMAC_K(V)
+ *
+ * On entry the HMAC context must be ready to absorb input under the
+ * current K. On exit it must be reset before its next use.
+ */
+static int ecdsa_rfc6979_update(ecdsa_rfc6979_context *ctx, unsigned char sep,
+                                const unsigned char *data, size_t data_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char K[MBEDTLS_MD_MAX_SIZE];
+
+    if ((ret = mbedtls_md_hmac_update(&ctx->md_ctx, ctx->V, ctx->md_len)) != 0) {
+        goto exit;
+    }
+    if ((ret = mbedtls_md_hmac_update(&ctx->md_ctx, &sep, 1)) != 0) {
+        goto exit;
+    }
+    if (data_len != 0) {
+        if ((ret = mbedtls_md_hmac_update(&ctx->md_ctx, data, data_len)) != 0) {
+            goto exit;
+        }
+    }
+    if ((ret = mbedtls_md_hmac_finish(&ctx->md_ctx, K)) != 0) {
+        goto exit;
+    }
+    if ((ret = mbedtls_md_hmac_starts(&ctx->md_ctx, K, ctx->md_len)) != 0) {
+        goto exit;
+    }
+    if ((ret = mbedtls_md_hmac_update(&ctx->md_ctx, ctx->V, ctx->md_len)) != 0) {
+        goto exit;
+    }
+    ret = mbedtls_md_hmac_finish(&ctx->md_ctx, ctx->V);
+
+exit:
+    mbedtls_platform_zeroize(K, sizeof(K));
+    return ret;
+}
+
+/*
+ * Steps b. to g.: V = 0x01 0x01 ..., K = 0x00 0x00 ..., then two updates
+ * with the seed material.
+ */
+static int ecdsa_rfc6979_seed(ecdsa_rfc6979_context *ctx,
+                              const mbedtls_md_info_t *md_info,
+                              const unsigned char *data, size_t data_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char K[MBEDTLS_MD_MAX_SIZE];
+
+    ctx->md_len = mbedtls_md_get_size(md_info);
+    ctx->need_update = 0;
+    memset(ctx->V, 0x01, ctx->md_len);
+    memset(K, 0x00, ctx->md_len);
+
+    if ((ret = mbedtls_md_setup(&ctx->md_ctx, md_info, 1)) != 0) {
+        return ret;
+    }
+    if ((ret = mbedtls_md_hmac_starts(&ctx->md_ctx, K, ctx->md_len)) != 0) {
+        return ret;
+    }
+    if ((ret = ecdsa_rfc6979_update(ctx, 0x00, data, data_len)) != 0) {
+        return ret;
+    }
+    if ((ret = mbedtls_md_hmac_reset(&ctx->md_ctx)) != 0) {
+        return ret;
+    }
+    return ecdsa_rfc6979_update(ctx, 0x01, data, data_len);
+}
+
+/*
+ * Step h.: produce the next candidate; has the f_rng prototype so that it
+ * can be passed to mbedtls_ecdsa_sign_restartable().
+ */
+static int ecdsa_rfc6979_random(void *p_rng, unsigned char *output, size_t len)
+{
+    ecdsa_rfc6979_context *ctx = (ecdsa_rfc6979_context *) p_rng;
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t use_len;
+
+    if (ctx->need_update) {
+        if ((ret = mbedtls_md_hmac_reset(&ctx->md_ctx)) != 0) {
+            return ret;
+        }
+        if ((ret = ecdsa_rfc6979_update(ctx, 0x00, NULL, 0)) != 0) {
+            return ret;
+        }
+    }
+
+    while (len != 0) {
+        use_len = len > ctx->md_len ? ctx->md_len : len;
+
+        if ((ret = mbedtls_md_hmac_reset(&ctx->md_ctx)) != 0) {
+            return ret;
+        }
+        if ((ret = mbedtls_md_hmac_update(&ctx->md_ctx, ctx->V, ctx->md_len)) != 0) {
+            return ret;
+        }
+        if ((ret = mbedtls_md_hmac_finish(&ctx->md_ctx, ctx->V)) != 0) {
+            return ret;
+        }
+
+        memcpy(output, ctx->V, use_len);
+        output += use_len;
+        len -= use_len;
+    }
+
+    ctx->need_update = 1;
+
+    return 0;
+}
+#endif /* MBEDTLS_ECDSA_DETERMINISTIC */
 
 #if defined(MBEDTLS_ECP_RESTARTABLE)
 
@@ -112,7 +257,7 @@ static void ecdsa_restart_sig_free(mbedtls_ecdsa_restart_sig_ctx *ctx)
  * Sub-context for ecdsa_sign_det()
  */
 struct mbedtls_ecdsa_restart_det {
-    mbedtls_hmac_drbg_context rng_ctx;  /* DRBG state   */
+    ecdsa_rfc6979_context rng_ctx;      /* nonce generator state */
     enum {                      /* what to do next?     */
         ecdsa_det_init = 0,     /* getting started      */
         ecdsa_det_sign,         /* make signature       */
@@ -124,7 +269,7 @@ struct mbedtls_ecdsa_restart_det {
  */
 static void ecdsa_restart_det_init(mbedtls_ecdsa_restart_det_ctx *ctx)
 {
-    mbedtls_hmac_drbg_init(&ctx->rng_ctx);
+    ecdsa_rfc6979_init(&ctx->rng_ctx);
     ctx->state = ecdsa_det_init;
 }
 
@@ -137,7 +282,7 @@ static void ecdsa_restart_det_free(mbedtls_ecdsa_restart_det_ctx *ctx)
         return;
     }
 
-    mbedtls_hmac_drbg_free(&ctx->rng_ctx);
+    ecdsa_rfc6979_free(&ctx->rng_ctx);
 
     ecdsa_restart_det_init(ctx);
 }
@@ -389,24 +534,30 @@ int mbedtls_ecdsa_sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
 
 #if defined(MBEDTLS_ECDSA_DETERMINISTIC)
 /*
- * Deterministic signature wrapper
+ * Deterministic or hedged signature
  *
- * note:    The f_rng_blind parameter must not be NULL.
+ * If f_rng_hedge is not NULL, its output is mixed into the nonce derivation
+ * as the additional data k' of RFC 6979 section 3.6.
  *
+ * note:    The f_rng_blind parameter must not be NULL.
  */
-int mbedtls_ecdsa_sign_det_restartable(mbedtls_ecp_group *grp,
-                                       mbedtls_mpi *r, mbedtls_mpi *s,
-                                       const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
-                                       mbedtls_md_type_t md_alg,
-                                       int (*f_rng_blind)(void *, unsigned char *, size_t),
-                                       void *p_rng_blind,
-                                       mbedtls_ecdsa_restart_ctx *rs_ctx)
+static int ecdsa_sign_det_internal(mbedtls_ecp_group *grp,
+                                   mbedtls_mpi *r, mbedtls_mpi *s,
+                                   const mbedtls_mpi *d,
+                                   const unsigned char *buf, size_t blen,
+                                   mbedtls_md_type_t md_alg,
+                                   int (*f_rng_hedge)(void *, unsigned char *, size_t),
+                                   void *p_rng_hedge,
+                                   int (*f_rng_blind)(void *, unsigned char *, size_t),
+                                   void *p_rng_blind,
+                                   mbedtls_ecdsa_restart_ctx *rs_ctx)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
-    mbedtls_hmac_drbg_context rng_ctx;
-    mbedtls_hmac_drbg_context *p_rng = &rng_ctx;
-    unsigned char data[2 * MBEDTLS_ECP_MAX_BYTES];
+    ecdsa_rfc6979_context rng_ctx;
+    ecdsa_rfc6979_context *p_rng = &rng_ctx;
+    unsigned char data[3 * MBEDTLS_ECP_MAX_BYTES];
     size_t grp_len = (grp->nbits + 7) / 8;
+    size_t data_len = 2 * grp_len;
     const mbedtls_md_info_t *md_info;
     mbedtls_mpi h;
 
@@ -415,7 +566,7 @@ int mbedtls_ecdsa_sign_det_restartable(mbedtls_ecp_group *grp,
     }
 
     mbedtls_mpi_init(&h);
-    mbedtls_hmac_drbg_init(&rng_ctx);
+    ecdsa_rfc6979_init(&rng_ctx);
 
     ECDSA_RS_ENTER(det);
 
@@ -431,11 +582,15 @@ int mbedtls_ecdsa_sign_det_restartable(mbedtls_ecp_group *grp,
     }
 #endif /* MBEDTLS_ECP_RESTARTABLE */
 
-    /* Use private key and message hash (reduced) to initialize HMAC_DRBG */
+    /* Use private key and message hash (reduced) to seed the generator */
     MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(d, data, grp_len));
     MBEDTLS_MPI_CHK(derive_mpi(grp, &h, buf, blen));
     MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&h, data + grp_len, grp_len));
-    MBEDTLS_MPI_CHK(mbedtls_hmac_drbg_seed_buf(p_rng, md_info, data, 2 * grp_len));
+    if (f_rng_hedge != NULL) {
+        MBEDTLS_MPI_CHK(f_rng_hedge(p_rng_hedge, data + data_len, grp_len));
+        data_len += grp_len;
+    }
+    MBEDTLS_MPI_CHK(ecdsa_rfc6979_seed(p_rng, md_info, data, data_len));
 
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     if (rs_ctx != NULL && rs_ctx->det != NULL) {
@@ -448,15 +603,16 @@ sign:
     (void) f_rng_blind;
     (void) p_rng_blind;
     ret = mbedtls_ecdsa_sign(grp, r, s, d, buf, blen,
-                             mbedtls_hmac_drbg_random, p_rng);
+                             ecdsa_rfc6979_random, p_rng);
 #else
     ret = mbedtls_ecdsa_sign_restartable(grp, r, s, d, buf, blen,
-                                         mbedtls_hmac_drbg_random, p_rng,
+                                         ecdsa_rfc6979_random, p_rng,
                                          f_rng_blind, p_rng_blind, rs_ctx);
 #endif /* MBEDTLS_ECDSA_SIGN_ALT */
 
 cleanup:
-    mbedtls_hmac_drbg_free(&rng_ctx);
+    ecdsa_rfc6979_free(&rng_ctx);
+    mbedtls_platform_zeroize(data, sizeof(data));
     mbedtls_mpi_free(&h);
 
     ECDSA_RS_LEAVE(det);
@@ -464,6 +620,43 @@ cleanup:
     return ret;
 }
 
+/*
+ * Deterministic signature wrapper
+ *
+ * note:    The f_rng_blind parameter must not be NULL.
+ *
+ */
+int mbedtls_ecdsa_sign_det_restartable(mbedtls_ecp_group *grp,
+                                       mbedtls_mpi *r, mbedtls_mpi *s,
+                                       const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
+                                       mbedtls_md_type_t md_alg,
+                                       int (*f_rng_blind)(void *, unsigned char *, size_t),
+                                       void *p_rng_blind,
+                                       mbedtls_ecdsa_restart_ctx *rs_ctx)
+{
+    return ecdsa_sign_det_internal(grp, r, s, d, buf, blen, md_alg,
+                                   NULL, NULL, f_rng_blind, p_rng_blind,
+                                   rs_ctx);
+}
+
+/*
+ * Hedged signature wrapper
+ */
+int mbedtls_ecdsa_sign_hedged(mbedtls_ecp_group *grp, mbedtls_mpi *r,
+                              mbedtls_mpi *s, const mbedtls_mpi *d,
+                              const unsigned char *buf, size_t blen,
+                              mbedtls_md_type_t md_alg,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void *p_rng)
+{
+    if (f_rng == NULL) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    return ecdsa_sign_det_internal(grp, r, s, d, buf, blen, md_alg,
+                                   f_rng, p_rng, f_rng, p_rng, NULL);
+}
+
 /*
  * Deterministic signature wrapper
  */
@@ -697,6 +890,353 @@ int mbedtls_ecdsa_write_signature(mbedtls_ecdsa_context *ctx,
         f_rng, p_rng, NULL);
 }
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+/*
+ * Discard the entries of the pool if they were computed by another process,
+ * which may use them too. The pool must be locked.
+ */
+static void ecdsa_nonce_pool_check_owner(mbedtls_ecdsa_nonce_pool *pool,
+                                         long pid)
+{
+    size_t i;
+
+    if (pool->count == 0 || pool->pid == pid) {
+        return;
+    }
+
+    /* mbedtls_mpi_free() wipes the values */
+    for (i = 0; i < pool->count; i++) {
+        mbedtls_mpi_free(&pool->kt_inv[i]);
+        mbedtls_mpi_free(&pool->t[i]);
+        mbedtls_mpi_free(&pool->r[i]);
+    }
+    pool->count = 0;
+}
+
+void mbedtls_ecdsa_nonce_pool_init(mbedtls_ecdsa_nonce_pool *pool)
+{
+    memset(pool, 0, sizeof(*pool));
+    mbedtls_ecp_group_init(&pool->grp);
+#if defined(MBEDTLS_THREADING_C)
+    MBEDTLS_MUTEX_INIT_NAMED(&pool->mutex, "ecdsa_pool");
+#endif
+}
+
+int mbedtls_ecdsa_nonce_pool_setup(mbedtls_ecdsa_nonce_pool *pool,
+                                   mbedtls_ecp_group_id grp_id,
+                                   size_t capacity)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t i;
+
+    if (!mbedtls_ecdsa_can_do(grp_id) || capacity == 0 ||
+        pool->capacity != 0) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    if ((ret = mbedtls_ecp_group_load(&pool->grp, grp_id)) != 0) {
+        return ret;
+    }
+
+    pool->kt_inv = mbedtls_calloc(capacity, sizeof(mbedtls_mpi));
+    pool->t = mbedtls_calloc(capacity, sizeof(mbedtls_mpi));
+    pool->r = mbedtls_calloc(capacity, sizeof(mbedtls_mpi));
+    if (pool->kt_inv == NULL || pool->t == NULL || pool->r == NULL) {
+        mbedtls_free(pool->kt_inv);
+        mbedtls_free(pool->t);
+        mbedtls_free(pool->r);
+        pool->kt_inv = NULL;
+        pool->t = NULL;
+        pool->r = NULL;
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    for (i = 0; i < capacity; i++) {
+        mbedtls_mpi_init(&pool->kt_inv[i]);
+        mbedtls_mpi_init(&pool->t[i]);
+        mbedtls_mpi_init(&pool->r[i]);
+    }
+
+    pool->capacity = capacity;
+    pool->count = 0;
+
+    return 0;
+}
+
+/*
+ * Compute one pool entry: steps 1-3 of SEC1 4.1.3, and the blinding value t
+ * and inversion of step 6 as in mbedtls_ecdsa_sign_restartable().
+ */
+static int ecdsa_nonce_compute(mbedtls_ecp_group *grp,
+                               mbedtls_mpi *kt_inv, mbedtls_mpi *t,
+                               mbedtls_mpi *r,
+                               int (*f_rng)(void *, unsigned char *, size_t),
+                               void *p_rng)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    int key_tries = 0;
+    mbedtls_ecp_point R;
+    mbedtls_mpi k;
+
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&k);
+
+    do {
+        if (key_tries++ > 10) {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+
+        MBEDTLS_MPI_CHK(mbedtls_ecp_gen_privkey(grp, &k, f_rng, p_rng));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_mul(grp, &R, &k, &grp->G, f_rng, p_rng));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(r, &R.X, &grp->N));
+    } while (mbedtls_mpi_cmp_int(r, 0) == 0);
+
+    /* t is kept for the signature, which needs t / (kt) = k^-1 */
+    MBEDTLS_MPI_CHK(mbedtls_ecp_gen_privkey(grp, t, f_rng, p_rng));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&k, &k, t));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&k, &k, &grp->N));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_inv_mod(kt_inv, &k, &grp->N));
+
+cleanup:
+    mbedtls_ecp_point_free(&R);
+    mbedtls_mpi_free(&k);
+
+    return ret;
+}
+
+int mbedtls_ecdsa_nonce_pool_fill(mbedtls_ecdsa_nonce_pool *pool,
+                                  size_t max_count,
+                                  int (*f_rng)(void *, unsigned char *, size_t),
+                                  void *p_rng)
+{
+    int ret = 0;
+    int full = 0;
+    long pid = mbedtls_platform_process_id();
+    mbedtls_mpi kt_inv, t, r;
+
+    if (f_rng == NULL || pool->capacity == 0) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    mbedtls_mpi_init(&kt_inv);
+    mbedtls_mpi_init(&t);
+    mbedtls_mpi_init(&r);
+
+    full = (mbedtls_ecdsa_nonce_pool_count(pool) == pool->capacity);
+
+    while (max_count-- > 0 && !full) {
+        /* The expensive part is done without holding the lock, so that
+         * signers are not blocked while the pool is being refilled. */
+        MBEDTLS_MPI_CHK(ecdsa_nonce_compute(&pool->grp, &kt_inv, &t, &r,
+                                            f_rng, p_rng));
+
+#if defined(MBEDTLS_THREADING_C)
+        if ((ret = mbedtls_mutex_lock(&pool->mutex)) != 0) {
+            goto cleanup;
+        }
+#endif
+        ecdsa_nonce_pool_check_owner(pool, pid);
+        if (pool->count < pool->capacity) {
+            mbedtls_mpi_swap(&pool->kt_inv[pool->count], &kt_inv);
+            mbedtls_mpi_swap(&pool->t[pool->count], &t);
+            mbedtls_mpi_swap(&pool->r[pool->count], &r);
+            pool->count++;
+            pool->pid = pid;
+        }
+        full = (pool->count == pool->capacity);
+#if defined(MBEDTLS_THREADING_C)
+        if (mbedtls_mutex_unlock(&pool->mutex) != 0) {
+            ret = MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+            goto cleanup;
+        }
+#endif
+    }
+
+cleanup:
+    mbedtls_mpi_free(&kt_inv);
+    mbedtls_mpi_free(&t);
+    mbedtls_mpi_free(&r);
+
+    return ret;
+}
+
+size_t mbedtls_ecdsa_nonce_pool_count(mbedtls_ecdsa_nonce_pool *pool)
+{
+    size_t count;
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_lock(&pool->mutex) != 0) {
+        return 0;
+    }
+#endif
+    ecdsa_nonce_pool_check_owner(pool, mbedtls_platform_process_id());
+    count = pool->count;
+#if defined(MBEDTLS_THREADING_C)
+    (void) mbedtls_mutex_unlock(&pool->mutex);
+#endif
+
+    return count;
+}
+
+void mbedtls_ecdsa_nonce_pool_free(mbedtls_ecdsa_nonce_pool *pool)
+{
+    size_t i;
+
+    if (pool == NULL) {
+        return;
+    }
+
+    /* mbedtls_mpi_free() wipes the values */
+    for (i = 0; i < pool->capacity; i++) {
+        mbedtls_mpi_free(&pool->kt_inv[i]);
+        mbedtls_mpi_free(&pool->t[i]);
+        mbedtls_mpi_free(&pool->r[i]);
+    }
+    mbedtls_free(pool->kt_inv);
+    mbedtls_free(pool->t);
+    mbedtls_free(pool->r);
+    mbedtls_ecp_group_free(&pool->grp);
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_free(&pool->mutex);
+#endif
+    memset(pool, 0, sizeof(*pool));
+}
+
+/*
+ * Remove one entry from the pool. Sets *found to 0 if the pool is empty.
+ *
+ * Whatever kt_inv, t and r held before is wiped, as is the slot the entry
+ * is taken from, so that a nonce never goes back into the pool.
+ */
+static int ecdsa_nonce_pool_take(mbedtls_ecdsa_nonce_pool *pool,
+                                 mbedtls_mpi *kt_inv, mbedtls_mpi *t,
+                                 mbedtls_mpi *r, int *found)
+{
+#if defined(MBEDTLS_THREADING_C)
+    int ret;
+
+    if ((ret = mbedtls_mutex_lock(&pool->mutex)) != 0) {
+        return ret;
+    }
+#endif
+
+    *found = 0;
+    ecdsa_nonce_pool_check_owner(pool, mbedtls_platform_process_id());
+    if (pool->count > 0) {
+        pool->count--;
+        mbedtls_mpi_swap(&pool->kt_inv[pool->count], kt_inv);
+        mbedtls_mpi_swap(&pool->t[pool->count], t);
+        mbedtls_mpi_swap(&pool->r[pool->count], r);
+        mbedtls_mpi_free(&pool->kt_inv[pool->count]);
+        mbedtls_mpi_free(&pool->t[pool->count]);
+        mbedtls_mpi_free(&pool->r[pool->count]);
+        *found = 1;
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_unlock(&pool->mutex) != 0) {
+        return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+    }
+#endif
+
+    return 0;
+}
+
+int mbedtls_ecdsa_sign_pooled(mbedtls_ecp_group *grp,
+                              mbedtls_mpi *r, mbedtls_mpi *s,
+                              const mbedtls_mpi *d,
+                              const unsigned char *buf, size_t blen,
+                              mbedtls_ecdsa_nonce_pool *pool,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void *p_rng)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    int found, sign_tries = 0;
+    mbedtls_mpi kt_inv, pr, e, t;
+
+    if (!mbedtls_ecdsa_can_do(grp->id) || grp->N.p == NULL ||
+        grp->id != pool->grp.id || f_rng == NULL) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    /* Make sure d is in range 1..n-1 */
+    if (mbedtls_mpi_cmp_int(d, 1) < 0 || mbedtls_mpi_cmp_mpi(d, &grp->N) >= 0) {
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+
+    mbedtls_mpi_init(&kt_inv); mbedtls_mpi_init(&pr); mbedtls_mpi_init(&e);
+    mbedtls_mpi_init(&t);
+
+    do {
+        if (sign_tries++ > 10) {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+
+        MBEDTLS_MPI_CHK(ecdsa_nonce_pool_take(pool, &kt_inv, &t, &pr, &found));
+        if (!found) {
+            ret = mbedtls_ecdsa_sign(grp, r, s, d, buf, blen, f_rng, p_rng);
+            goto cleanup;
+        }
+
+        /*
+         * Step 5: derive MPI from hashed message
+         */
+        MBEDTLS_MPI_CHK(derive_mpi(grp, &e, buf, blen));
+
+        /*
+         * Step 6: compute s = (e + r * d) / k = t (e + rd) / (kt) mod n
+         *
+         * As in mbedtls_ecdsa_sign_restartable(), e + rd is multiplied by
+         * the random t before it is reduced, avoiding a potential timing
+         * leak. t and (kt)^-1 were computed with the nonce, so that no
+         * modular inversion is needed here.
+         */
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(s, &pr, d));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(&e, &e, s));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&e, &e, &t));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&e, &e, &grp->N));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(s, &e, &kt_inv));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(s, s, &grp->N));
+    } while (mbedtls_mpi_cmp_int(s, 0) == 0);
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_copy(r, &pr));
+
+cleanup:
+    mbedtls_mpi_free(&kt_inv); mbedtls_mpi_free(&pr); mbedtls_mpi_free(&e);
+    mbedtls_mpi_free(&t);
+
+    return ret;
+}
+
+int mbedtls_ecdsa_write_signature_pooled(mbedtls_ecdsa_context *ctx,
+                                         const unsigned char *hash, size_t hlen,
+                                         unsigned char *sig, size_t sig_size,
+                                         size_t *slen,
+                                         mbedtls_ecdsa_nonce_pool *pool,
+                                         int (*f_rng)(void *, unsigned char *, size_t),
+                                         void *p_rng)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_mpi r, s;
+
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    MBEDTLS_MPI_CHK(mbedtls_ecdsa_sign_pooled(&ctx->grp, &r, &s, &ctx->d,
+                                              hash, hlen, pool, f_rng, p_rng));
+    MBEDTLS_MPI_CHK(ecdsa_signature_to_asn1(&r, &s, sig, sig_size, slen));
+
+cleanup:
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+
+    return ret;
+}
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 /*
  * Read and check signature
  */
@@ -68,7 +68,11 @@
 #include "mbedtls/error.h"
 
 #include "bn_mul.h"
+#include "bignum_core.h"
+#include "constant_time_internal.h"
+#include "ecp_field.h"
 #include "ecp_invasive.h"
+#include "ecp_x448.h"
 
 #include <string.h>
 
@@ -313,6 +317,10 @@ int mbedtls_ecp_check_budget(const mbedtls_ecp_group *grp,
 
 #endif /* MBEDTLS_ECP_RESTARTABLE */
 
+#define ECP_MPI_INIT(_p, _n) { .p = (mbedtls_mpi_uint *) (_p), .s = 1, .n = (_n) }
+#define ECP_MPI_INIT_ARRAY(x)   \
+    ECP_MPI_INIT(x, sizeof(x) / sizeof(mbedtls_mpi_uint))
+
 #if defined(MBEDTLS_ECP_C)
 static void mpi_init_many(mbedtls_mpi *arr, size_t size)
 {
@@ -1052,12 +1060,204 @@ cleanup:
         INC_MUL_COUNT                                                   \
     } while (0)
 
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+/*
+ * Fixed-size field arithmetic
+ *
+ * With MBEDTLS_ECP_WITH_MPI_UINT, the helpers below work on limb arrays of
+ * exactly MBEDTLS_ECP_FIELD_LIMBS(grp) limbs: operands are read (zero-extended
+ * if an mbedtls_mpi is shorter), the result is computed on the stack with the
+ * bignum_core primitives and copied into X, which is only grown the first time
+ * it is used. Additions and subtractions use a single constant-time correction
+ * instead of the MOD_ADD/MOD_SUB loops. As in the legacy code, operands are
+ * expected to be in the range 0..P.
+ */
+#define ECP_FIELD_IS_FIXED(grp)                                         \
+    ((grp)->pbits > 0 && (grp)->P.n >= MBEDTLS_ECP_FIELD_LIMBS(grp) &&  \
+     MBEDTLS_ECP_FIELD_LIMBS(grp) <= MBEDTLS_ECP_FIELD_MAX_LIMBS)
+
+MBEDTLS_MAYBE_UNUSED
+static const mbedtls_mpi_uint *ecp_field_limbs(const mbedtls_ecp_group *grp,
+                                               const mbedtls_mpi *A,
+                                               mbedtls_mpi_uint *buf)
+{
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+
+    if (A->n >= limbs) {
+        return A->p;
+    }
+
+    memset(buf, 0, limbs * ciL);
+    if (A->n > 0) {
+        memcpy(buf, A->p, A->n * ciL);
+    }
+    return buf;
+}
+
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_set(const mbedtls_ecp_group *grp,
+                         mbedtls_mpi *X,
+                         const mbedtls_mpi_uint *R)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(X, limbs));
+    memcpy(X->p, R, limbs * ciL);
+    memset(X->p + limbs, 0, (X->n - limbs) * ciL);
+    X->s = 1;
+
+cleanup:
+    return ret;
+}
+
+/* R = a + b mod P, where R may alias a or b */
+MBEDTLS_MAYBE_UNUSED
+static void ecp_field_add_limbs(const mbedtls_ecp_group *grp,
+                                mbedtls_mpi_uint *R,
+                                const mbedtls_mpi_uint *a,
+                                const mbedtls_mpi_uint *b)
+{
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+    mbedtls_mpi_uint carry, borrow;
+
+    carry  = mbedtls_mpi_core_add(R, a, b, limbs);
+    borrow = mbedtls_mpi_core_sub(R, R, grp->P.p, limbs);
+    (void) mbedtls_mpi_core_add_if(R, grp->P.p, limbs,
+                                   (unsigned) (carry ^ borrow));
+}
+
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_add(const mbedtls_ecp_group *grp,
+                         mbedtls_mpi *X,
+                         const mbedtls_mpi *A,
+                         const mbedtls_mpi *B)
+{
+    mbedtls_mpi_uint a_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint b_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    const mbedtls_mpi_uint *a = ecp_field_limbs(grp, A, a_buf);
+    const mbedtls_mpi_uint *b = ecp_field_limbs(grp, B, b_buf);
+
+    ecp_field_add_limbs(grp, R, a, b);
+
+    return ecp_field_set(grp, X, R);
+}
+
+/* X = c * A mod P for a small public c, by repeated addition */
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_mul_int(const mbedtls_ecp_group *grp,
+                             mbedtls_mpi *X,
+                             const mbedtls_mpi *A,
+                             mbedtls_mpi_uint c)
+{
+    mbedtls_mpi_uint a_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    const mbedtls_mpi_uint *a = ecp_field_limbs(grp, A, a_buf);
+
+    memset(R, 0, MBEDTLS_ECP_FIELD_LIMBS(grp) * ciL);
+    for (; c > 0; c--) {
+        ecp_field_add_limbs(grp, R, R, a);
+    }
+
+    return ecp_field_set(grp, X, R);
+}
+
+/* X = 2^count * X mod P, by repeated doubling */
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_shift_l(const mbedtls_ecp_group *grp,
+                             mbedtls_mpi *X,
+                             size_t count)
+{
+    mbedtls_mpi_uint x_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+
+    memcpy(R, ecp_field_limbs(grp, X, x_buf), MBEDTLS_ECP_FIELD_LIMBS(grp) * ciL);
+    for (; count > 0; count--) {
+        ecp_field_add_limbs(grp, R, R, R);
+    }
+
+    return ecp_field_set(grp, X, R);
+}
+
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_sub(const mbedtls_ecp_group *grp,
+                         mbedtls_mpi *X,
+                         const mbedtls_mpi *A,
+                         const mbedtls_mpi *B)
+{
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+    mbedtls_mpi_uint a_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint b_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    const mbedtls_mpi_uint *a = ecp_field_limbs(grp, A, a_buf);
+    const mbedtls_mpi_uint *b = ecp_field_limbs(grp, B, b_buf);
+    mbedtls_mpi_uint borrow;
+
+    borrow = mbedtls_mpi_core_sub(R, a, b, limbs);
+    (void) mbedtls_mpi_core_add_if(R, grp->P.p, limbs, (unsigned) borrow);
+
+    return ecp_field_set(grp, X, R);
+}
+
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_sub_int(const mbedtls_ecp_group *grp,
+                             mbedtls_mpi *X,
+                             const mbedtls_mpi *A,
+                             mbedtls_mpi_uint c)
+{
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+    mbedtls_mpi_uint a_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    const mbedtls_mpi_uint *a = ecp_field_limbs(grp, A, a_buf);
+    mbedtls_mpi_uint borrow;
+
+    borrow = mbedtls_mpi_core_sub_int(R, a, c, limbs);
+    (void) mbedtls_mpi_core_add_if(R, grp->P.p, limbs, (unsigned) borrow);
+
+    return ecp_field_set(grp, X, R);
+}
+
+/* Returns MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE if the group has no fixed-size
+ * reduction, in which case X is left untouched. */
+MBEDTLS_MAYBE_UNUSED
+static int ecp_field_mul(const mbedtls_ecp_group *grp,
+                         mbedtls_mpi *X,
+                         const mbedtls_mpi *A,
+                         const mbedtls_mpi *B)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_mpi_uint a_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint b_buf[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    mbedtls_mpi_uint R[MBEDTLS_ECP_FIELD_MAX_LIMBS];
+    const mbedtls_mpi_uint *a = ecp_field_limbs(grp, A, a_buf);
+    const mbedtls_mpi_uint *b = ecp_field_limbs(grp, B, b_buf);
+
+    MBEDTLS_MPI_CHK(mbedtls_ecp_field_mul(grp, R, a, b));
+    MBEDTLS_MPI_CHK(ecp_field_set(grp, X, R));
+
+cleanup:
+    return ret;
+}
+#endif /* MBEDTLS_ECP_WITH_MPI_UINT */
+
 static inline int mbedtls_mpi_mul_mod(const mbedtls_ecp_group *grp,
                                       mbedtls_mpi *X,
                                       const mbedtls_mpi *A,
                                       const mbedtls_mpi *B)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        ret = ecp_field_mul(grp, X, A, B);
+        if (ret != MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE) {
+            if (ret == 0) {
+                INC_MUL_COUNT
+            }
+            return ret;
+        }
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(X, A, B));
     MOD_MUL(*X);
 cleanup:
@@ -1081,6 +1281,11 @@ static inline int mbedtls_mpi_sub_mod(const mbedtls_ecp_group *grp,
                                       const mbedtls_mpi *B)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        return ecp_field_sub(grp, X, A, B);
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_sub_mpi(X, A, B));
     MOD_SUB(X);
 cleanup:
@@ -1102,6 +1307,11 @@ static inline int mbedtls_mpi_add_mod(const mbedtls_ecp_group *grp,
                                       const mbedtls_mpi *B)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        return ecp_field_add(grp, X, A, B);
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(X, A, B));
     MOD_ADD(X);
 cleanup:
@@ -1116,6 +1326,11 @@ static inline int mbedtls_mpi_mul_int_mod(const mbedtls_ecp_group *grp,
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
 
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        return ecp_field_mul_int(grp, X, A, c);
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_mul_int(X, A, c));
     MOD_ADD(X);
 cleanup:
@@ -1130,6 +1345,11 @@ static inline int mbedtls_mpi_sub_int_mod(const mbedtls_ecp_group *grp,
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
 
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        return ecp_field_sub_int(grp, X, A, c);
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_sub_int(X, A, c));
     MOD_SUB(X);
 cleanup:
@@ -1145,6 +1365,11 @@ static inline int mbedtls_mpi_shift_l_mod(const mbedtls_ecp_group *grp,
                                           size_t count)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+    if (ECP_FIELD_IS_FIXED(grp)) {
+        return ecp_field_shift_l(grp, X, count);
+    }
+#endif
     MBEDTLS_MPI_CHK(mbedtls_mpi_shift_l(X, count));
     MOD_ADD(X);
 cleanup:
@@ -1483,9 +1708,10 @@ cleanup:
  *             4M + 4S          (A == -3)
  *             3M + 6S + 1a     otherwise
  */
-static int ecp_double_jac(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
-                          const mbedtls_ecp_point *P,
-                          mbedtls_mpi tmp[4])
+MBEDTLS_STATIC_TESTABLE
+int mbedtls_ecp_double_jac(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                           const mbedtls_ecp_point *P,
+                           mbedtls_mpi tmp[4])
 {
 #if defined(MBEDTLS_SELF_TEST)
     dbl_count++;
@@ -1580,9 +1806,10 @@ cleanup:
  *
  * Cost: 1A := 8M + 3S
  */
-static int ecp_add_mixed(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
-                         const mbedtls_ecp_point *P, const mbedtls_ecp_point *Q,
-                         mbedtls_mpi tmp[4])
+MBEDTLS_STATIC_TESTABLE
+int mbedtls_ecp_add_mixed(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          const mbedtls_ecp_point *P, const mbedtls_ecp_point *Q,
+                          mbedtls_mpi tmp[4])
 {
 #if defined(MBEDTLS_SELF_TEST)
     add_count++;
@@ -1638,7 +1865,7 @@ static int ecp_add_mixed(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
     /* Special cases (2) and (3) */
     if (MPI_ECP_CMP_INT(&tmp[0], 0) == 0) {
         if (MPI_ECP_CMP_INT(&tmp[1], 0) == 0) {
-            ret = ecp_double_jac(grp, R, P, tmp);
+            ret = mbedtls_ecp_double_jac(grp, R, P, tmp);
             goto cleanup;
         } else {
             ret = mbedtls_ecp_set_zero(R);
@@ -1913,7 +2140,7 @@ dbl:
             MBEDTLS_MPI_CHK(mbedtls_ecp_copy(cur, T + (i >> 1)));
         }
 
-        MBEDTLS_MPI_CHK(ecp_double_jac(grp, cur, cur, tmp));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_double_jac(grp, cur, cur, tmp));
     }
 
 #if defined(MBEDTLS_ECP_RESTARTABLE)
@@ -1925,7 +2152,7 @@ norm_dbl:
 #endif
     /*
      * Normalize current elements in T to allow them to be used in
-     * ecp_add_mixed() below, which requires one normalized input.
+     * mbedtls_ecp_add_mixed() below, which requires one normalized input.
      *
      * As T has holes, use an auxiliary array of pointers to elements in T.
      *
@@ -1955,7 +2182,7 @@ add:
     for (i = 1; i < T_size; i <<= 1) {
         j = i;
         while (j--) {
-            MBEDTLS_MPI_CHK(ecp_add_mixed(grp, &T[i + j], &T[j], &T[i], tmp));
+            MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, &T[i + j], &T[j], &T[i], tmp));
         }
     }
 
@@ -2015,14 +2242,26 @@ static int ecp_select_comb(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
     unsigned char ii, j;
+    size_t limbs = grp->P.n;
 
     /* Ignore the "sign" bit and scale down */
     ii =  (i & 0x7Fu) >> 1;
 
+    /* The coordinates of the table entries are normalized, so they are
+     * non-negative and fit in grp->P.n limbs. Start from zero and OR in
+     * every entry under a mask selecting only T[ii]. */
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(&R->X, limbs));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(&R->Y, limbs));
+    MPI_ECP_LSET(&R->X, 0);
+    MPI_ECP_LSET(&R->Y, 0);
+
     /* Read the whole table to thwart cache-based timing attacks */
     for (j = 0; j < T_size; j++) {
-        MPI_ECP_COND_ASSIGN(&R->X, &T[j].X, j == ii);
-        MPI_ECP_COND_ASSIGN(&R->Y, &T[j].Y, j == ii);
+        mbedtls_ct_condition_t select = mbedtls_ct_uint_eq(j, ii);
+        mbedtls_mpi_core_cond_or(R->X.p, T[j].X.p,
+                                 T[j].X.n < limbs ? T[j].X.n : limbs, select);
+        mbedtls_mpi_core_cond_or(R->Y.p, T[j].Y.p,
+                                 T[j].Y.n < limbs ? T[j].Y.n : limbs, select);
     }
 
     /* Safely invert result if i is "negative" */
@@ -2085,9 +2324,9 @@ static int ecp_mul_comb_core(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
         MBEDTLS_ECP_BUDGET(MBEDTLS_ECP_OPS_DBL + MBEDTLS_ECP_OPS_ADD);
         --i;
 
-        MBEDTLS_MPI_CHK(ecp_double_jac(grp, R, R, tmp));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_double_jac(grp, R, R, tmp));
         MBEDTLS_MPI_CHK(ecp_select_comb(grp, &Txi, T, T_size, x[i]));
-        MBEDTLS_MPI_CHK(ecp_add_mixed(grp, R, R, &Txi, tmp));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, R, R, &Txi, tmp));
     }
 
 cleanup:
@@ -2405,6 +2644,533 @@ cleanup:
     return ret;
 }
 
+#if defined(MBEDTLS_ECP_DP_SECP256K1_ENABLED) && !defined(MBEDTLS_ECP_INTERNAL_ALT)
+#define ECP_SECP256K1_GLV
+#endif
+
+#if defined(ECP_SECP256K1_GLV)
+/*
+ * GLV method for secp256k1 [GLV01], see also GECC 3.5.
+ *
+ * secp256k1 has an efficiently computable endomorphism
+ *      phi(x, y) = (beta * x, y)
+ * where beta is a cube root of unity mod p, and phi(P) = lambda * P for every
+ * point P, where lambda is a cube root of unity mod n. Any scalar k can be
+ * written as k = k1 + k2 * lambda mod n with k1 and k2 about half the size of
+ * n, and then k * P = k1 * P + k2 * phi(P) can be computed with half as many
+ * doublings as a plain multiplication.
+ *
+ * The decomposition uses the short basis {(a1, b1), (a2, b2)} of the lattice
+ * of pairs (x, y) such that x + y * lambda = 0 mod n, with b2 = a1 and
+ * a2 = a1 - b1, and the approximations g1 = round(2^384 * b2 / n) and
+ * g2 = round(2^384 * -b1 / n) for the rounding step.
+ *
+ * [GLV01] R. Gallant, R. Lambert, S. Vanstone, "Faster Point Multiplication on
+ *         Elliptic Curves with Efficient Endomorphisms", CRYPTO 2001.
+ */
+static const mbedtls_mpi_uint secp256k1_glv_beta[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0xEE, 0x01, 0x95, 0x71, 0x28, 0x6C, 0x39, 0xC1),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x95, 0x89, 0xF5, 0x12, 0x75, 0x49, 0xF0, 0x9C),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xE9, 0x34, 0x34, 0xAC, 0x9E, 0x47, 0x64, 0x6E),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x10, 0x07, 0x7C, 0x65, 0x2B, 0x6A, 0xE9, 0x7A),
+};
+static const mbedtls_mpi_uint secp256k1_glv_a1[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0x15, 0xEB, 0x84, 0x92, 0xE4, 0x90, 0x6C, 0xE8),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xCD, 0x6B, 0xD4, 0xA7, 0x21, 0xD2, 0x86, 0x30),
+};
+static const mbedtls_mpi_uint secp256k1_glv_minus_b1[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0xC3, 0xE4, 0xBF, 0x0A, 0xA9, 0x7F, 0x54, 0x6F),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x28, 0x88, 0x0E, 0x01, 0xD6, 0x7E, 0x43, 0xE4),
+};
+static const mbedtls_mpi_uint secp256k1_glv_a2[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0xD8, 0xCF, 0x44, 0x9D, 0x8D, 0x10, 0xC1, 0x57),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xF6, 0xF3, 0xE2, 0xA8, 0xF7, 0x50, 0xCA, 0x14),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+};
+static const mbedtls_mpi_uint secp256k1_glv_g1[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0x31, 0xB0, 0xDB, 0x45, 0x9A, 0x20, 0x93, 0xE8),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x7F, 0xCA, 0xE8, 0x71, 0x14, 0x8A, 0xAA, 0x3D),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x15, 0xEB, 0x84, 0x92, 0xE4, 0x90, 0x6C, 0xE8),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xCD, 0x6B, 0xD4, 0xA7, 0x21, 0xD2, 0x86, 0x30),
+};
+static const mbedtls_mpi_uint secp256k1_glv_g2[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0x71, 0x7F, 0xC4, 0x8A, 0xAE, 0xB4, 0x71, 0x15),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xC6, 0x06, 0xF5, 0x9D, 0xAC, 0x08, 0x12, 0x22),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xC4, 0xE4, 0xBF, 0x0A, 0xA9, 0x7F, 0x54, 0x6F),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x28, 0x88, 0x0E, 0x01, 0xD6, 0x7E, 0x43, 0xE4),
+};
+static const mbedtls_mpi ecp_glv_beta = ECP_MPI_INIT_ARRAY(secp256k1_glv_beta);
+
+#define ECP_GLV_LIMBS(X)    (sizeof(X) / sizeof(mbedtls_mpi_uint))
+
+/*
+ * The split works on fixed-size integers of ECP_GLV_N limbs, enough for any
+ * scalar modulo n. The halves are tracked modulo 2^256 in two's complement,
+ * which is exact since they are much smaller than 2^255 in absolute value.
+ */
+#define ECP_GLV_N           BITS_TO_LIMBS(256)
+
+/*
+ * Upper bound on the bit length of the halves of a split scalar:
+ * |k1|, |k2| <= (|a1| + |a2|) / 2 before the parity adjustment and
+ * |a1| + |a2| < 2^129 after it.
+ */
+#define ECP_GLV_BITS        130
+
+/* Window size for the wNAF in ecp_muladd_glv() */
+#define ECP_GLV_WNAF_W      5
+#define ECP_GLV_WNAF_PRE    (1 << (ECP_GLV_WNAF_W - 2))
+
+/*
+ * Can the GLV code be used for this operation?
+ *
+ * It only applies to secp256k1 and can't be interrupted, so it is skipped
+ * for restartable operations.
+ */
+static int ecp_glv_is_applicable(const mbedtls_ecp_group *grp,
+                                 const mbedtls_ecp_restart_ctx *rs_ctx)
+{
+    if (grp->id != MBEDTLS_ECP_DP_SECP256K1) {
+        return 0;
+    }
+
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    if (rs_ctx != NULL && mbedtls_ecp_restart_is_enabled()) {
+        return 0;
+    }
+#else
+    (void) rs_ctx;
+#endif
+
+    return 1;
+}
+
+/*
+ * Set X = round(K * G / 2^384) for a 256-bit K and a 256-bit constant G.
+ *
+ * X has ECP_GLV_N limbs; the result is below 2^129 for the constants used.
+ */
+static void ecp_glv_round(mbedtls_mpi_uint X[ECP_GLV_N],
+                          const mbedtls_mpi_uint K[ECP_GLV_N],
+                          const mbedtls_mpi_uint G[ECP_GLV_N])
+{
+    const size_t q = 384 / biL;
+    mbedtls_mpi_uint P[2 * ECP_GLV_N];
+    mbedtls_mpi_uint half;
+
+    mbedtls_mpi_core_mul(P, K, ECP_GLV_N, G, ECP_GLV_N);
+    half = P[q - 1] >> (biL - 1);
+
+    memset(X, 0, ECP_GLV_N * ciL);
+    memcpy(X, P + q, (2 * ECP_GLV_N - q) * ciL);
+    (void) mbedtls_mpi_core_mla(X, ECP_GLV_N, &half, 1, 1);
+
+    mbedtls_platform_zeroize(P, sizeof(P));
+}
+
+/*
+ * Set X = C * A modulo 2^256, where C has ECP_GLV_N limbs and A has
+ * A_limbs limbs.
+ */
+static void ecp_glv_mul(mbedtls_mpi_uint X[ECP_GLV_N],
+                        const mbedtls_mpi_uint C[ECP_GLV_N],
+                        const mbedtls_mpi_uint *A, size_t A_limbs)
+{
+    mbedtls_mpi_uint P[2 * ECP_GLV_N];
+
+    mbedtls_mpi_core_mul(P, C, ECP_GLV_N, A, A_limbs);
+    memcpy(X, P, ECP_GLV_N * ciL);
+
+    mbedtls_platform_zeroize(P, sizeof(P));
+}
+
+/*
+ * Split 0 <= k < n as k = k1 + k2 * lambda mod n with k1 and k2 odd and
+ * |k1|, |k2| < 2^ECP_GLV_BITS. The caller must have checked the range of k.
+ *
+ * On return k1 and k2 hold the absolute values of the halves, with
+ * ECP_GLV_N limbs each, and neg1 and neg2 are 1 if the corresponding half
+ * is negative and 0 otherwise.
+ *
+ * k may be secret (see ecp_mul_glv()), so everything is done on fixed-size
+ * limb arrays in two's complement: no step depends on the value or the
+ * size of k, and the parity fixes and signs are handled with conditional
+ * assignments rather than branches.
+ */
+static int ecp_glv_split(const mbedtls_mpi *k,
+                         mbedtls_mpi *k1, mbedtls_mpi *k2,
+                         unsigned char *neg1, unsigned char *neg2)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_mpi_uint K[ECP_GLV_N], C1[ECP_GLV_N], C2[ECP_GLV_N];
+    mbedtls_mpi_uint X1[ECP_GLV_N], X2[ECP_GLV_N], T[ECP_GLV_N];
+    mbedtls_mpi_uint A1[ECP_GLV_N], A2[ECP_GLV_N], MB1[ECP_GLV_N];
+    mbedtls_mpi_uint even, neg;
+    size_t i;
+
+    for (i = 0; i < ECP_GLV_N; i++) {
+        K[i] = i < k->n ? k->p[i] : 0;
+    }
+
+    memset(A1, 0, sizeof(A1));
+    memset(A2, 0, sizeof(A2));
+    memset(MB1, 0, sizeof(MB1));
+    memcpy(A1, secp256k1_glv_a1, sizeof(secp256k1_glv_a1));
+    memcpy(A2, secp256k1_glv_a2, sizeof(secp256k1_glv_a2));
+    memcpy(MB1, secp256k1_glv_minus_b1, sizeof(secp256k1_glv_minus_b1));
+
+    /* c1 = round(k * g1 / 2^384), c2 = round(k * g2 / 2^384) */
+    ecp_glv_round(C1, K, secp256k1_glv_g1);
+    ecp_glv_round(C2, K, secp256k1_glv_g2);
+
+    /* k1 = k - c1 * a1 - c2 * a2, k2 = -c1 * b1 - c2 * b2 */
+    memcpy(X1, K, sizeof(X1));
+    ecp_glv_mul(T, C1, secp256k1_glv_a1, ECP_GLV_LIMBS(secp256k1_glv_a1));
+    (void) mbedtls_mpi_core_sub(X1, X1, T, ECP_GLV_N);
+    ecp_glv_mul(T, C2, secp256k1_glv_a2, ECP_GLV_LIMBS(secp256k1_glv_a2));
+    (void) mbedtls_mpi_core_sub(X1, X1, T, ECP_GLV_N);
+    ecp_glv_mul(X2, C1, secp256k1_glv_minus_b1, ECP_GLV_LIMBS(secp256k1_glv_minus_b1));
+    ecp_glv_mul(T, C2, secp256k1_glv_a1, ECP_GLV_LIMBS(secp256k1_glv_a1));
+    (void) mbedtls_mpi_core_sub(X2, X2, T, ECP_GLV_N);
+
+    /* Make k1 odd by adding (a1, b1) if needed: a1 is odd */
+    even = (X1[0] & 1) ^ 1;
+    (void) mbedtls_mpi_core_add_if(X1, A1, ECP_GLV_N, (unsigned) even);
+    (void) mbedtls_mpi_core_sub(T, X2, MB1, ECP_GLV_N);
+    mbedtls_mpi_core_cond_assign(X2, T, ECP_GLV_N, mbedtls_ct_bool(even));
+
+    /* Make k2 odd by adding (a2, b2) if needed: b2 is odd, a2 is even */
+    even = (X2[0] & 1) ^ 1;
+    (void) mbedtls_mpi_core_add_if(X1, A2, ECP_GLV_N, (unsigned) even);
+    (void) mbedtls_mpi_core_add_if(X2, A1, ECP_GLV_N, (unsigned) even);
+
+    /* Replace each half by its absolute value */
+    memset(K, 0, sizeof(K));
+    neg = X1[ECP_GLV_N - 1] >> (biL - 1);
+    (void) mbedtls_mpi_core_sub(T, K, X1, ECP_GLV_N);
+    mbedtls_mpi_core_cond_assign(X1, T, ECP_GLV_N, mbedtls_ct_bool(neg));
+    *neg1 = (unsigned char) neg;
+    neg = X2[ECP_GLV_N - 1] >> (biL - 1);
+    (void) mbedtls_mpi_core_sub(T, K, X2, ECP_GLV_N);
+    mbedtls_mpi_core_cond_assign(X2, T, ECP_GLV_N, mbedtls_ct_bool(neg));
+    *neg2 = (unsigned char) neg;
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(k1, ECP_GLV_N));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(k2, ECP_GLV_N));
+    memcpy(k1->p, X1, sizeof(X1));
+    memcpy(k2->p, X2, sizeof(X2));
+
+cleanup:
+    mbedtls_platform_zeroize(K, sizeof(K));
+    mbedtls_platform_zeroize(C1, sizeof(C1));
+    mbedtls_platform_zeroize(C2, sizeof(C2));
+    mbedtls_platform_zeroize(X1, sizeof(X1));
+    mbedtls_platform_zeroize(X2, sizeof(X2));
+    mbedtls_platform_zeroize(T, sizeof(T));
+
+    return ret;
+}
+
+/*
+ * Set R = phi(P) for a normalized point P.
+ */
+static int ecp_glv_endo(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                        const mbedtls_ecp_point *P)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+
+    MPI_ECP_MUL(&R->X, &P->X, &ecp_glv_beta);
+    MPI_ECP_MOV(&R->Y, &P->Y);
+    MPI_ECP_LSET(&R->Z, 1);
+
+cleanup:
+    return ret;
+}
+
+/*
+ * Comb multiplication R = m * P using the GLV method
+ *
+ * The halves k1 and k2 of m are recoded as in ecp_comb_recode_core() with
+ * the same comb, so the table for phi(P) is obtained from the table for P by
+ * applying phi to each point, and each step of the main loop consumes one
+ * digit of each half:
+ *      R = 2 R + T[x1[i]] + phi(T)[x2[i]]
+ * The signs of k1 and k2 are folded into the sign bits of the digits.
+ *
+ * Compared to ecp_mul_comb(), d is about halved and so are the doublings
+ * both in the precomputation and in the main loop.
+ *
+ * Unlike in ecp_mul_comb_core(), the two operands of an addition are not
+ * known to be distinct multiples of P. They only coincide with negligible
+ * probability for a random scalar.
+ */
+static int ecp_mul_glv(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                       const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                       int (*f_rng)(void *, unsigned char *, size_t),
+                       void *p_rng)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char w, T_size, neg1 = 0, neg2 = 0;
+    unsigned char x1[COMB_MAX_D + 1], x2[COMB_MAX_D + 1];
+    size_t d, i;
+    mbedtls_ecp_point *T = NULL, *U = NULL;
+    mbedtls_ecp_point RR, Txi;
+    mbedtls_mpi k1, k2, tmp[4];
+
+    mbedtls_ecp_point_init(&RR);
+    mbedtls_ecp_point_init(&Txi);
+    mbedtls_mpi_init(&k1);
+    mbedtls_mpi_init(&k2);
+    mpi_init_many(tmp, sizeof(tmp) / sizeof(mbedtls_mpi));
+
+    w = ecp_pick_window_size(grp, 0);
+    T_size = 1U << (w - 1);
+    d = (ECP_GLV_BITS + w - 1) / w;
+
+    T = mbedtls_calloc(2 * (size_t) T_size, sizeof(mbedtls_ecp_point));
+    if (T == NULL) {
+        ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+        goto cleanup;
+    }
+    U = T + T_size;
+
+    for (i = 0; i < 2 * (size_t) T_size; i++) {
+        mbedtls_ecp_point_init(&T[i]);
+    }
+
+    /* Tables for P and phi(P) */
+    MBEDTLS_MPI_CHK(ecp_precompute_comb(grp, T, P, w, d, NULL));
+    for (i = 0; i < T_size; i++) {
+        MBEDTLS_MPI_CHK(ecp_glv_endo(grp, &U[i], &T[i]));
+    }
+
+    /* Split and recode the scalar */
+    MBEDTLS_MPI_CHK(ecp_glv_split(m, &k1, &k2, &neg1, &neg2));
+    ecp_comb_recode_core(x1, d, w, &k1);
+    ecp_comb_recode_core(x2, d, w, &k2);
+    for (i = 0; i <= d; i++) {
+        x1[i] ^= (unsigned char) (neg1 << 7);
+        x2[i] ^= (unsigned char) (neg2 << 7);
+    }
+
+    /* Main loop */
+    i = d;
+    MBEDTLS_MPI_CHK(ecp_select_comb(grp, &RR, T, T_size, x1[i]));
+    if (f_rng != NULL) {
+        MBEDTLS_MPI_CHK(ecp_randomize_jac(grp, &RR, f_rng, p_rng));
+    }
+    MBEDTLS_MPI_CHK(ecp_select_comb(grp, &Txi, U, T_size, x2[i]));
+    MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, &RR, &RR, &Txi, tmp));
+
+    while (i != 0) {
+        --i;
+
+        MBEDTLS_MPI_CHK(mbedtls_ecp_double_jac(grp, &RR, &RR, tmp));
+        MBEDTLS_MPI_CHK(ecp_select_comb(grp, &Txi, T, T_size, x1[i]));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, &RR, &RR, &Txi, tmp));
+        MBEDTLS_MPI_CHK(ecp_select_comb(grp, &Txi, U, T_size, x2[i]));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, &RR, &RR, &Txi, tmp));
+    }
+
+    /* See ecp_mul_comb_after_precomp() */
+    if (f_rng != NULL) {
+        MBEDTLS_MPI_CHK(ecp_randomize_jac(grp, &RR, f_rng, p_rng));
+    }
+
+    MBEDTLS_MPI_CHK(ecp_normalize_jac(grp, &RR));
+    MBEDTLS_MPI_CHK(mbedtls_ecp_copy(R, &RR));
+
+cleanup:
+    if (T != NULL) {
+        for (i = 0; i < 2 * (size_t) T_size; i++) {
+            mbedtls_ecp_point_free(&T[i]);
+        }
+        mbedtls_free(T);
+    }
+
+    mbedtls_platform_zeroize(x1, sizeof(x1));
+    mbedtls_platform_zeroize(x2, sizeof(x2));
+    mbedtls_ecp_point_free(&RR);
+    mbedtls_ecp_point_free(&Txi);
+    mbedtls_mpi_free(&k1);
+    mbedtls_mpi_free(&k2);
+    mpi_free_many(tmp, sizeof(tmp) / sizeof(mbedtls_mpi));
+
+    /* prevent caller from using invalid value */
+    if (ret != 0) {
+        mbedtls_ecp_point_free(R);
+    }
+
+    return ret;
+}
+
+/*
+ * Width-w NAF of k: on return, k = sum of naf[i] * 2^i for i < *len, where
+ * every naf[i] is either zero or odd with |naf[i]| < 2^(w-1), and any w
+ * consecutive digits contain at most one non-zero digit.
+ *
+ * k must be non-negative; the digits are negated if neg is 1.
+ * NOT constant-time.
+ */
+static int ecp_glv_wnaf(signed char naf[ECP_GLV_BITS + 1], size_t *len,
+                        const mbedtls_mpi *k, unsigned char neg)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    const mbedtls_mpi_uint mask = (1u << ECP_GLV_WNAF_W) - 1;
+    mbedtls_mpi K;
+    size_t i = 0;
+    int digit;
+
+    mbedtls_mpi_init(&K);
+    MBEDTLS_MPI_CHK(mbedtls_mpi_copy(&K, k));
+
+    memset(naf, 0, ECP_GLV_BITS + 1);
+
+    while (mbedtls_mpi_cmp_int(&K, 0) != 0) {
+        if (i > ECP_GLV_BITS) {
+            ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+            goto cleanup;
+        }
+
+        if (mbedtls_mpi_get_bit(&K, 0) == 1) {
+            digit = (int) (K.p[0] & mask);
+            if (digit >= (1 << (ECP_GLV_WNAF_W - 1))) {
+                digit -= 1 << ECP_GLV_WNAF_W;
+            }
+            MBEDTLS_MPI_CHK(mbedtls_mpi_sub_int(&K, &K, digit));
+            naf[i] = (signed char) (neg ? -digit : digit);
+        }
+
+        MBEDTLS_MPI_CHK(mbedtls_mpi_shift_r(&K, 1));
+        i++;
+    }
+
+    *len = i;
+
+cleanup:
+    mbedtls_mpi_free(&K);
+
+    return ret;
+}
+
+/*
+ * Linear combination R = m * P + n * Q using the GLV method
+ * NOT constant-time
+ *
+ * m and n are split into four half-size scalars for the points P, phi(P),
+ * Q and phi(Q), which are recoded in wNAF form and processed together with
+ * a single chain of about 130 shared doublings (Straus-Shamir trick).
+ *
+ * m and n must be in the range [1, n - 1].
+ */
+static int ecp_muladd_glv(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                          const mbedtls_mpi *n, const mbedtls_ecp_point *Q)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    const mbedtls_ecp_point *base[2] = { P, Q };
+    const mbedtls_mpi *scalar[2] = { m, n };
+    signed char naf[4][ECP_GLV_BITS + 1];
+    size_t len[4], max_len = 0, i, j;
+    unsigned char neg[4];
+    mbedtls_ecp_point *T = NULL;
+    mbedtls_ecp_point *TT[2 * (ECP_GLV_WNAF_PRE - 1)];
+    mbedtls_ecp_point D, Ti;
+    mbedtls_mpi k[4], tmp[4];
+
+    mbedtls_ecp_point_init(&D);
+    mbedtls_ecp_point_init(&Ti);
+    mpi_init_many(k, sizeof(k) / sizeof(mbedtls_mpi));
+    mpi_init_many(tmp, sizeof(tmp) / sizeof(mbedtls_mpi));
+
+    /* T[j * ECP_GLV_WNAF_PRE + i] = (2i + 1) * (P, phi(P), Q, phi(Q))[j] */
+    T = mbedtls_calloc(4 * ECP_GLV_WNAF_PRE, sizeof(mbedtls_ecp_point));
+    if (T == NULL) {
+        ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+        goto cleanup;
+    }
+
+    for (i = 0; i < 4 * ECP_GLV_WNAF_PRE; i++) {
+        mbedtls_ecp_point_init(&T[i]);
+    }
+
+    for (j = 0; j < 2; j++) {
+        mbedtls_ecp_point *Tj = T + 2 * j * ECP_GLV_WNAF_PRE;
+
+        MBEDTLS_MPI_CHK(mbedtls_ecp_copy(&Tj[0], base[j]));
+        MBEDTLS_MPI_CHK(mbedtls_ecp_double_jac(grp, &D, base[j], tmp));
+        MBEDTLS_MPI_CHK(ecp_normalize_jac(grp, &D));
+
+        for (i = 1; i < ECP_GLV_WNAF_PRE; i++) {
+            MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, &Tj[i], &Tj[i - 1], &D, tmp));
+            TT[j * (ECP_GLV_WNAF_PRE - 1) + i - 1] = &Tj[i];
+        }
+    }
+
+    MBEDTLS_MPI_CHK(ecp_normalize_jac_many(grp, TT, 2 * (ECP_GLV_WNAF_PRE - 1)));
+
+    for (j = 0; j < 2; j++) {
+        mbedtls_ecp_point *Tj = T + 2 * j * ECP_GLV_WNAF_PRE;
+
+        for (i = 0; i < ECP_GLV_WNAF_PRE; i++) {
+            MBEDTLS_MPI_CHK(ecp_glv_endo(grp, &Tj[ECP_GLV_WNAF_PRE + i], &Tj[i]));
+        }
+    }
+
+    /* Split and recode the scalars */
+    for (j = 0; j < 2; j++) {
+        MBEDTLS_MPI_CHK(ecp_glv_split(scalar[j], &k[2 * j], &k[2 * j + 1],
+                                      &neg[2 * j], &neg[2 * j + 1]));
+    }
+
+    for (j = 0; j < 4; j++) {
+        MBEDTLS_MPI_CHK(ecp_glv_wnaf(naf[j], &len[j], &k[j], neg[j]));
+        if (len[j] > max_len) {
+            max_len = len[j];
+        }
+    }
+
+    /* Main loop, starting from zero */
+    MBEDTLS_MPI_CHK(mbedtls_ecp_set_zero(R));
+
+    for (i = max_len; i > 0; i--) {
+        if (i != max_len) {
+            MBEDTLS_MPI_CHK(mbedtls_ecp_double_jac(grp, R, R, tmp));
+        }
+
+        for (j = 0; j < 4; j++) {
+            int digit = naf[j][i - 1];
+            const mbedtls_ecp_point *Tj = T + j * ECP_GLV_WNAF_PRE;
+
+            if (digit > 0) {
+                MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, R, R, &Tj[digit / 2], tmp));
+            } else if (digit < 0) {
+                MBEDTLS_MPI_CHK(mbedtls_ecp_copy(&Ti, &Tj[-digit / 2]));
+                MBEDTLS_MPI_CHK(mbedtls_mpi_sub_mpi(&Ti.Y, &grp->P, &Ti.Y));
+                MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, R, R, &Ti, tmp));
+            }
+        }
+    }
+
+    MBEDTLS_MPI_CHK(ecp_normalize_jac(grp, R));
+
+cleanup:
+    if (T != NULL) {
+        for (i = 0; i < 4 * ECP_GLV_WNAF_PRE; i++) {
+            mbedtls_ecp_point_free(&T[i]);
+        }
+        mbedtls_free(T);
+    }
+
+    mbedtls_ecp_point_free(&D);
+    mbedtls_ecp_point_free(&Ti);
+    mpi_free_many(k, sizeof(k) / sizeof(mbedtls_mpi));
+    mpi_free_many(tmp, sizeof(tmp) / sizeof(mbedtls_mpi));
+
+    return ret;
+}
+#endif /* ECP_SECP256K1_GLV */
+
 #endif /* MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED */
 
 #if defined(MBEDTLS_ECP_MONTGOMERY_ENABLED)
@@ -2538,6 +3304,38 @@ cleanup:
 #endif /* !defined(MBEDTLS_ECP_NO_FALLBACK) || !defined(MBEDTLS_ECP_DOUBLE_ADD_MXZ_ALT) */
 }
 
+#if defined(MBEDTLS_ECP_X448_FIELD)
+/*
+ * Multiplication on Curve448 with the dedicated fixed-size ladder.
+ *
+ * The field arithmetic is constant-time and the inversion is done by
+ * exponentiation, so there's no need for the randomization of projective
+ * coordinates done in ecp_mul_mxz().
+ */
+static int ecp_mul_mxz_x448(mbedtls_ecp_point *R, const mbedtls_mpi *m,
+                            const mbedtls_ecp_point *P)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char k[MBEDTLS_ECP_X448_BYTES];
+    unsigned char u[MBEDTLS_ECP_X448_BYTES];
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary_le(m, k, sizeof(k)));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary_le(&P->X, u, sizeof(u)));
+
+    mbedtls_ecp_x448_mul(u, k, u);
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary_le(&R->X, u, sizeof(u)));
+    MPI_ECP_LSET(&R->Z, 1);
+    mbedtls_mpi_free(&R->Y);
+
+cleanup:
+    mbedtls_platform_zeroize(k, sizeof(k));
+    mbedtls_platform_zeroize(u, sizeof(u));
+
+    return ret;
+}
+#endif /* MBEDTLS_ECP_X448_FIELD */
+
 /*
  * Multiplication with Montgomery ladder in x/z coordinates,
  * for curves in Montgomery form
@@ -2561,6 +3359,12 @@ static int ecp_mul_mxz(mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
         return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
     }
 
+#if defined(MBEDTLS_ECP_X448_FIELD)
+    if (grp->id == MBEDTLS_ECP_DP_CURVE448) {
+        return ecp_mul_mxz_x448(R, m, P);
+    }
+#endif
+
     /* Save PX and read from P before writing to R, in case P == R */
     MPI_ECP_MOV(&PX, &P->X);
     MBEDTLS_MPI_CHK(mbedtls_ecp_copy(&RP, P));
@@ -2670,6 +3474,18 @@ static int ecp_mul_restartable_internal(mbedtls_ecp_group *grp, mbedtls_ecp_poin
 #endif
 #if defined(MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED)
     if (mbedtls_ecp_get_type(grp) == MBEDTLS_ECP_TYPE_SHORT_WEIERSTRASS) {
+#if defined(ECP_SECP256K1_GLV)
+        /* Keep using the precomputed tables for the base point */
+        int p_eq_g = 0;
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+        p_eq_g = (MPI_ECP_CMP(&P->Y, &grp->G.Y) == 0 &&
+                  MPI_ECP_CMP(&P->X, &grp->G.X) == 0);
+#endif
+        if (!p_eq_g && ecp_glv_is_applicable(grp, rs_ctx)) {
+            MBEDTLS_MPI_CHK(ecp_mul_glv(grp, R, m, P, f_rng, p_rng));
+            goto cleanup;
+        }
+#endif
         MBEDTLS_MPI_CHK(ecp_mul_comb(grp, R, m, P, f_rng, p_rng, rs_ctx));
     }
 #endif
@@ -2815,6 +3631,19 @@ int mbedtls_ecp_muladd_restartable(
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
 
+#if defined(ECP_SECP256K1_GLV)
+    /* Scalars outside [1, n - 1] go through the shortcuts and checks below */
+    if (ecp_glv_is_applicable(grp, rs_ctx) &&
+        mbedtls_ecp_check_privkey(grp, m) == 0 &&
+        mbedtls_ecp_check_privkey(grp, n) == 0) {
+        if ((ret = mbedtls_ecp_check_pubkey(grp, P)) != 0 ||
+            (ret = mbedtls_ecp_check_pubkey(grp, Q)) != 0) {
+            return ret;
+        }
+        return ecp_muladd_glv(grp, R, m, P, n, Q);
+    }
+#endif
+
     mbedtls_ecp_point_init(&mP);
     mpi_init_many(tmp, sizeof(tmp) / sizeof(mbedtls_mpi));
 
@@ -2863,7 +3692,7 @@ mul2:
 add:
 #endif
     MBEDTLS_ECP_BUDGET(MBEDTLS_ECP_OPS_ADD);
-    MBEDTLS_MPI_CHK(ecp_add_mixed(grp, pR, pmP, pR, tmp));
+    MBEDTLS_MPI_CHK(mbedtls_ecp_add_mixed(grp, pR, pmP, pR, tmp));
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     if (rs_ctx != NULL && rs_ctx->ma != NULL) {
         rs_ctx->ma->state = ecp_rsma_norm;
@@ -2912,9 +3741,6 @@ int mbedtls_ecp_muladd(mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
 
 #if defined(MBEDTLS_ECP_MONTGOMERY_ENABLED)
 #if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
-#define ECP_MPI_INIT(_p, _n) { .p = (mbedtls_mpi_uint *) (_p), .s = 1, .n = (_n) }
-#define ECP_MPI_INIT_ARRAY(x)   \
-    ECP_MPI_INIT(x, sizeof(x) / sizeof(mbedtls_mpi_uint))
 /*
  * Constants for the two points other than 0, 1, -1 (mod p) in
  * https://cr.yp.to/ecdh.html#validate
@@ -22,6 +22,7 @@
 
 #include "bn_mul.h"
 #include "bignum_core.h"
+#include "ecp_field.h"
 #include "ecp_invasive.h"
 
 #include <string.h>
@@ -2892,6 +2893,13 @@ static const mbedtls_mpi_uint brainpoolP256r1_p[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0x72, 0x8D, 0x83, 0x9D, 0x90, 0x0A, 0x66, 0x3E),
     MBEDTLS_BYTES_TO_T_UINT_8(0xBC, 0xA9, 0xEE, 0xA1, 0xDB, 0x57, 0xFB, 0xA9),
 };
+/* R^2 mod p, for Montgomery multiplication in mbedtls_ecp_field_mul() */
+static const mbedtls_mpi_uint brainpoolP256r1_rr[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0x6C, 0x5B, 0x46, 0xA6, 0x7B, 0xDF, 0xFE, 0x8C),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x4D, 0x4F, 0x4D, 0x61, 0x26, 0x4C, 0xCE, 0x5C),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x07, 0xC8, 0x1A, 0x6B, 0xCD, 0xDA, 0xEC, 0xA1),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xA8, 0x7F, 0x95, 0xE5, 0x21, 0xAA, 0x17, 0x47),
+};
 static const mbedtls_mpi_uint brainpoolP256r1_a[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0xD9, 0xB5, 0x30, 0xF3, 0x44, 0x4B, 0x4A, 0xE9),
     MBEDTLS_BYTES_TO_T_UINT_8(0x6C, 0x5C, 0xDC, 0x26, 0xC1, 0x55, 0x80, 0xFB),
@@ -3152,6 +3160,15 @@ static const mbedtls_mpi_uint brainpoolP384r1_p[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0xDF, 0x41, 0xE6, 0x50, 0x7E, 0x6F, 0x5D, 0x0F),
     MBEDTLS_BYTES_TO_T_UINT_8(0x28, 0x6D, 0x38, 0xA3, 0x82, 0x1E, 0xB9, 0x8C),
 };
+/* R^2 mod p, for Montgomery multiplication in mbedtls_ecp_field_mul() */
+static const mbedtls_mpi_uint brainpoolP384r1_rr[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0xDE, 0x4B, 0xB6, 0x40, 0xFF, 0xEF, 0x7C, 0x08),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x65, 0xD9, 0x7F, 0x3D, 0x34, 0x83, 0x52, 0x53),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x99, 0x08, 0x94, 0xC9, 0x9C, 0xF9, 0x28, 0x8E),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xAF, 0xD5, 0x18, 0x99, 0x91, 0x01, 0x14, 0x62),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x2C, 0x05, 0x7E, 0xA5, 0x3B, 0xEF, 0xC6, 0xD5),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x42, 0xF8, 0x8D, 0x17, 0x83, 0x68, 0xBF, 0x36),
+};
 static const mbedtls_mpi_uint brainpoolP384r1_a[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0x26, 0x28, 0xCE, 0x22, 0xDD, 0xC7, 0xA8, 0x04),
     MBEDTLS_BYTES_TO_T_UINT_8(0xEB, 0xD4, 0x3A, 0x50, 0x4A, 0x81, 0xA5, 0x8A),
@@ -3760,6 +3777,17 @@ static const mbedtls_mpi_uint brainpoolP512r1_p[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0x07, 0xFC, 0xC9, 0x33, 0xAE, 0xE6, 0xD4, 0x3F),
     MBEDTLS_BYTES_TO_T_UINT_8(0x8B, 0xC4, 0xE9, 0xDB, 0xB8, 0x9D, 0xDD, 0xAA),
 };
+/* R^2 mod p, for Montgomery multiplication in mbedtls_ecp_field_mul() */
+static const mbedtls_mpi_uint brainpoolP512r1_rr[] = {
+    MBEDTLS_BYTES_TO_T_UINT_8(0x05, 0xF2, 0x58, 0x61, 0x4A, 0x14, 0xAD, 0x49),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x05, 0x79, 0x15, 0x27, 0x30, 0xB1, 0x3F, 0x79),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xD3, 0xFF, 0x5A, 0x90, 0xBC, 0xF9, 0xB7, 0x53),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x25, 0x4A, 0x51, 0x83, 0x77, 0x9A, 0xC1, 0xE0),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x57, 0x80, 0x89, 0xD5, 0xD8, 0x6F, 0x48, 0x19),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x83, 0xFF, 0x2B, 0xD4, 0x5F, 0xAA, 0x6D, 0xA1),
+    MBEDTLS_BYTES_TO_T_UINT_8(0xCC, 0xEE, 0x56, 0x20, 0x40, 0x19, 0x2E, 0x20),
+    MBEDTLS_BYTES_TO_T_UINT_8(0x50, 0x64, 0xFF, 0xA9, 0x05, 0x9D, 0x4C, 0x3C),
+};
 static const mbedtls_mpi_uint brainpoolP512r1_a[] = {
     MBEDTLS_BYTES_TO_T_UINT_8(0xCA, 0x94, 0xFC, 0x77, 0x4D, 0xAC, 0xC1, 0xE7),
     MBEDTLS_BYTES_TO_T_UINT_8(0xB9, 0xC7, 0xF2, 0x2B, 0xA7, 0x17, 0x11, 0x7F),
@@ -5811,6 +5839,130 @@ int mbedtls_ecp_mod_p256k1_raw(mbedtls_mpi_uint *X, size_t X_limbs)
 
 #endif /* MBEDTLS_ECP_DP_SECP256K1_ENABLED */
 
+/*
+ * Fixed-size multiplication modulo the field prime, for ecp.c.
+ *
+ * Curves with a fast quasi-reduction multiply into a double-width buffer
+ * and reduce it in place. The Brainpool primes have no special form, so
+ * they use Montgomery multiplication instead: A * B * R^-1 followed by a
+ * multiplication by R^2 gives A * B mod P without leaving the plain
+ * representation, which keeps the rest of ecp.c unchanged.
+ */
+int mbedtls_ecp_field_mul(const mbedtls_ecp_group *grp,
+                          mbedtls_mpi_uint *X,
+                          const mbedtls_mpi_uint *A,
+                          const mbedtls_mpi_uint *B)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    int (*modp)(mbedtls_mpi_uint *, size_t) = NULL;
+    const mbedtls_mpi_uint *rr = NULL;
+    const mbedtls_mpi_uint *P = grp->P.p;
+    const size_t limbs = MBEDTLS_ECP_FIELD_LIMBS(grp);
+    mbedtls_mpi_uint T[2 * MBEDTLS_ECP_FIELD_MAX_LIMBS + 1];
+    mbedtls_mpi_uint borrow;
+
+    switch (grp->id) {
+#if defined(MBEDTLS_ECP_NIST_OPTIM)
+#if defined(MBEDTLS_ECP_DP_SECP192R1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP192R1:
+            modp = &mbedtls_ecp_mod_p192_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP224R1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP224R1:
+            modp = &mbedtls_ecp_mod_p224_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP256R1:
+            modp = &mbedtls_ecp_mod_p256_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP384R1:
+            modp = &mbedtls_ecp_mod_p384_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP521R1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP521R1:
+            modp = &mbedtls_ecp_mod_p521_raw;
+            break;
+#endif
+#endif /* MBEDTLS_ECP_NIST_OPTIM */
+#if defined(MBEDTLS_ECP_DP_SECP192K1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP192K1:
+            modp = &mbedtls_ecp_mod_p192k1_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP224K1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP224K1:
+            modp = &mbedtls_ecp_mod_p224k1_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP256K1_ENABLED)
+        case MBEDTLS_ECP_DP_SECP256K1:
+            modp = &mbedtls_ecp_mod_p256k1_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
+        case MBEDTLS_ECP_DP_CURVE25519:
+            modp = &mbedtls_ecp_mod_p255_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_CURVE448_ENABLED)
+        case MBEDTLS_ECP_DP_CURVE448:
+            modp = &mbedtls_ecp_mod_p448_raw;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_BP256R1_ENABLED)
+        case MBEDTLS_ECP_DP_BP256R1:
+            rr = brainpoolP256r1_rr;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_BP384R1_ENABLED)
+        case MBEDTLS_ECP_DP_BP384R1:
+            rr = brainpoolP384r1_rr;
+            break;
+#endif
+#if defined(MBEDTLS_ECP_DP_BP512R1_ENABLED)
+        case MBEDTLS_ECP_DP_BP512R1:
+            rr = brainpoolP512r1_rr;
+            break;
+#endif
+        default:
+            return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+
+    if (limbs == 0 || limbs > MBEDTLS_ECP_FIELD_MAX_LIMBS || limbs > grp->P.n) {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+
+    if (rr != NULL) {
+        mbedtls_mpi_uint mm = mbedtls_mpi_core_montmul_init(P);
+
+        mbedtls_mpi_core_montmul(X, A, B, limbs, P, limbs, mm, T);
+        mbedtls_mpi_core_montmul(X, X, rr, limbs, P, limbs, mm, T);
+        ret = 0;
+        goto cleanup;
+    }
+
+    mbedtls_mpi_core_mul(T, A, limbs, B, limbs);
+    MBEDTLS_MPI_CHK(modp(T, 2 * limbs));
+
+    /* The quasi-reduction leaves a value in the range 0..2P, and it fits
+     * in the low limbs. Two conditional subtractions make it canonical
+     * even with a slightly oversized input (e.g. an unreduced x-coordinate
+     * on a Montgomery curve). */
+    borrow = mbedtls_mpi_core_sub(X, T, P, limbs);
+    (void) mbedtls_mpi_core_add_if(X, P, limbs, (unsigned) borrow);
+    borrow = mbedtls_mpi_core_sub(X, X, P, limbs);
+    (void) mbedtls_mpi_core_add_if(X, P, limbs, (unsigned) borrow);
+
+cleanup:
+    mbedtls_platform_zeroize(T, sizeof(T));
+    return ret;
+}
+
 #if defined(MBEDTLS_TEST_HOOKS)
 MBEDTLS_STATIC_TESTABLE
 int mbedtls_ecp_modulus_setup(mbedtls_mpi_mod_modulus *N,
@@ -0,0 +1,68 @@
+/**
+ * \file ecp_field.h
+ *
+ * \brief Fixed-size arithmetic modulo the field prime of built-in curves.
+ *
+ * These functions back the coordinate arithmetic of ecp.c when
+ * MBEDTLS_ECP_WITH_MPI_UINT is enabled. Field elements are little-endian
+ * arrays of exactly MBEDTLS_ECP_FIELD_LIMBS(grp) limbs, so no allocation or
+ * resizing takes place in the inner loops of point multiplication.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_ECP_FIELD_H
+#define MBEDTLS_ECP_FIELD_H
+
+#include "common.h"
+#include "mbedtls/ecp.h"
+#include "bignum_core.h"
+
+#if defined(MBEDTLS_ECP_WITH_MPI_UINT)
+
+/** The maximum number of limbs of a field element of a built-in curve. */
+#define MBEDTLS_ECP_FIELD_MAX_LIMBS BITS_TO_LIMBS(MBEDTLS_ECP_MAX_BITS)
+
+/** The number of limbs of a field element of \p grp. This can be less
+ * than `grp->P.n`, since some curve constants are stored with a spare
+ * zero limb. */
+#define MBEDTLS_ECP_FIELD_LIMBS(grp) BITS_TO_LIMBS((grp)->pbits)
+
+/**
+ * \brief           Multiply two field elements of a built-in curve:
+ *                  `X = A * B mod P`.
+ *
+ *                  The reduction is curve-specific: the fast quasi-reduction
+ *                  of the NIST (with #MBEDTLS_ECP_NIST_OPTIM), Koblitz,
+ *                  Curve25519 and Curve448 primes, or two Montgomery
+ *                  multiplications with a precomputed `R^2 mod P` for the
+ *                  Brainpool primes.
+ *
+ * \param grp       The group. Its \c id selects the reduction.
+ * \param[out] X    The result, of MBEDTLS_ECP_FIELD_LIMBS(\p grp) limbs.
+ *                  This is fully reduced (`0 <= X < P`). It may alias \p A
+ *                  or \p B.
+ * \param[in] A     The first operand, of MBEDTLS_ECP_FIELD_LIMBS(\p grp)
+ *                  limbs.
+ * \param[in] B     The second operand, of MBEDTLS_ECP_FIELD_LIMBS(\p grp)
+ *                  limbs.
+ *
+ * \note            For the Brainpool curves, \p A and \p B must be less
+ *                  than `P`. For the other curves, `A * B` must fit in
+ *                  twice as many limbs as `P`.
+ *
+ * \return          \c 0 on success.
+ * \return          #MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE if there is no
+ *                  fixed-size reduction for this group. The caller must
+ *                  fall back to generic bignum arithmetic.
+ * \return          Another negative error code if the reduction failed.
+ */
+int mbedtls_ecp_field_mul(const mbedtls_ecp_group *grp,
+                          mbedtls_mpi_uint *X,
+                          const mbedtls_mpi_uint *A,
+                          const mbedtls_mpi_uint *B);
+
+#endif /* MBEDTLS_ECP_WITH_MPI_UINT */
+
+#endif /* MBEDTLS_ECP_FIELD_H */
@@ -320,6 +320,42 @@ int mbedtls_ecp_modulus_setup(mbedtls_mpi_mod_modulus *N,
                               const mbedtls_ecp_group_id id,
                               const mbedtls_ecp_modulus_type ctype);
 
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED)
+
+/** Point doubling in Jacobian coordinates: `R = 2 P`.
+ *
+ * \param[in] grp   The group. This must be a short Weierstrass curve.
+ * \param[out] R    The result. This may alias \p P.
+ * \param[in] P     The point to double.
+ * \param[in,out] tmp Four initialized MPIs used as scratch space.
+ *
+ * \return          \c 0 if successful.
+ * \return          \c MBEDTLS_ERR_ECP_xxx or MBEDTLS_ERR_MPI_xxx on failure.
+ */
+MBEDTLS_STATIC_TESTABLE
+int mbedtls_ecp_double_jac(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                           const mbedtls_ecp_point *P,
+                           mbedtls_mpi tmp[4]);
+
+/** Mixed affine-Jacobian point addition: `R = P + Q`.
+ *
+ * \param[in] grp   The group. This must be a short Weierstrass curve.
+ * \param[out] R    The result, not normalized. This may alias \p P or
+ *                  \p Q as a whole point.
+ * \param[in] P     The first point, in Jacobian coordinates.
+ * \param[in] Q     The second point. This must be normalized (`Z = 1`).
+ * \param[in,out] tmp Four initialized MPIs used as scratch space.
+ *
+ * \return          \c 0 if successful.
+ * \return          \c MBEDTLS_ERR_ECP_xxx or MBEDTLS_ERR_MPI_xxx on failure.
+ */
+MBEDTLS_STATIC_TESTABLE
+int mbedtls_ecp_add_mixed(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          const mbedtls_ecp_point *P, const mbedtls_ecp_point *Q,
+                          mbedtls_mpi tmp[4]);
+
+#endif /* MBEDTLS_ECP_C && MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED */
+
 #endif /* MBEDTLS_TEST_HOOKS && MBEDTLS_ECP_C */
 
 #endif /* MBEDTLS_ECP_INVASIVE_H */
@@ -0,0 +1,346 @@
+/*
+ *  Dedicated X448 scalar multiplication
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+/*
+ * References:
+ *
+ * [1] RFC 7748: Elliptic Curves for Security
+ * [2] M. Hamburg: Ed448-Goldilocks, a new elliptic curve (2015)
+ *
+ * Field elements modulo p = 2^448 - 2^224 - 1 are held in eight unsigned
+ * 64-bit limbs of 56 bits each as in [2]. Since limb 4 has weight 2^224,
+ * the "golden ratio" form of p lets products of weight 2^448 and above be
+ * folded back by adding them both 4 and 8 limbs lower. Products are
+ * accumulated in 128-bit integers, and the 8 spare bits of every limb
+ * absorb carries so that additions and subtractions need only a single
+ * carry pass.
+ *
+ * Every operation runs in constant time, and nothing is allocated: the
+ * whole ladder works on a few arrays on the stack.
+ */
+
+#include "common.h"
+
+#include "ecp_x448.h"
+
+#if defined(MBEDTLS_ECP_X448_FIELD)
+
+#include "mbedtls/platform_util.h"
+
+#include <string.h>
+
+typedef uint64_t fe[8];
+typedef mbedtls_t_udbl fe_acc;
+
+#define FE_MASK     (((uint64_t) 1 << 56) - 1)
+
+/* (A - 2) / 4 for Curve448 */
+#define X448_A24    39081
+
+/* Limb i of p */
+#define FE_P(i)     ((i) == 4 ? FE_MASK - 1 : FE_MASK)
+
+/* Carry every limb into the next one and fold the carry out of the top limb
+ * into limbs 0 and 4. Afterwards every limb is below 2^56, except limbs 0
+ * and 4 which may exceed it by a small amount. */
+static void fe_carry(fe h)
+{
+    uint64_t c;
+    int i;
+
+    for (i = 0; i < 7; i++) {
+        c = h[i] >> 56;
+        h[i] &= FE_MASK;
+        h[i + 1] += c;
+    }
+    c = h[7] >> 56;
+    h[7] &= FE_MASK;
+    h[0] += c;
+    h[4] += c;
+}
+
+/* Same as fe_carry() for 128-bit accumulators, with two passes since the
+ * first one may leave up to 2^62 in limbs 0 and 4. */
+static void fe_reduce(fe h, fe_acc c[8])
+{
+    fe_acc top;
+    int i, pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 0; i < 7; i++) {
+            c[i + 1] += c[i] >> 56;
+            c[i] &= FE_MASK;
+        }
+        top = c[7] >> 56;
+        c[7] &= FE_MASK;
+        c[0] += top;
+        c[4] += top;
+    }
+
+    for (i = 0; i < 8; i++) {
+        h[i] = (uint64_t) c[i];
+    }
+}
+
+static void fe_copy(fe h, const fe f)
+{
+    memcpy(h, f, sizeof(fe));
+}
+
+static void fe_add(fe h, const fe f, const fe g)
+{
+    int i;
+    for (i = 0; i < 8; i++) {
+        h[i] = f[i] + g[i];
+    }
+    fe_carry(h);
+}
+
+/* h = f - g + 2p, so that no limb goes negative */
+static void fe_sub(fe h, const fe f, const fe g)
+{
+    int i;
+    for (i = 0; i < 8; i++) {
+        h[i] = f[i] + 2 * FE_P(i) - g[i];
+    }
+    fe_carry(h);
+}
+
+/* h = f * g. Products of weight 2^(56k) with k >= 8 are folded into
+ * positions k - 4 and k - 8, from the top down so that folding k >= 12
+ * lands in positions that are folded afterwards. */
+static void fe_mul(fe h, const fe f, const fe g)
+{
+    fe_acc c[15] = { 0 };
+    int i, j;
+
+    for (i = 0; i < 8; i++) {
+        for (j = 0; j < 8; j++) {
+            c[i + j] += (fe_acc) f[i] * g[j];
+        }
+    }
+    for (i = 14; i >= 8; i--) {
+        c[i - 4] += c[i];
+        c[i - 8] += c[i];
+    }
+    fe_reduce(h, c);
+}
+
+/* h = f^2, computing each cross product once */
+static void fe_sq(fe h, const fe f)
+{
+    fe_acc c[15] = { 0 };
+    int i, j;
+
+    for (i = 0; i < 8; i++) {
+        c[2 * i] += (fe_acc) f[i] * f[i];
+        for (j = i + 1; j < 8; j++) {
+            c[i + j] += (fe_acc) (2 * f[i]) * f[j];
+        }
+    }
+    for (i = 14; i >= 8; i--) {
+        c[i - 4] += c[i];
+        c[i - 8] += c[i];
+    }
+    fe_reduce(h, c);
+}
+
+/* h = f^(2^n) */
+static void fe_sq_n(fe h, const fe f, int n)
+{
+    fe_sq(h, f);
+    while (--n > 0) {
+        fe_sq(h, h);
+    }
+}
+
+/* h = f * n for a small constant n */
+static void fe_mul_small(fe h, const fe f, uint32_t n)
+{
+    fe_acc c[8];
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        c[i] = (fe_acc) f[i] * n;
+    }
+    fe_reduce(h, c);
+}
+
+/* Swap f and g if swap is 1, leave them unchanged if it is 0 */
+static void fe_cswap(fe f, fe g, uint64_t swap)
+{
+    const uint64_t mask = (uint64_t) 0 - swap;
+    uint64_t x;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        x = mask & (f[i] ^ g[i]);
+        f[i] ^= x;
+        g[i] ^= x;
+    }
+}
+
+/* h = z^(p - 2) = 1 / z (or 0 if z = 0), with
+ * p - 2 = (2^223 - 1) * 2^225 + (2^222 - 1) * 2^2 + 1.
+ * Write e_n for z^(2^n - 1), so that e_(a+b) = e_a^(2^b) * e_b. */
+static void fe_invert(fe h, const fe z)
+{
+    fe e3, e6, e24, e30, e222, t;
+
+    fe_sq(t, z);
+    fe_mul(t, t, z);                /* e_2 */
+    fe_sq(t, t);
+    fe_mul(e3, t, z);               /* e_3 */
+    fe_sq_n(t, e3, 3);
+    fe_mul(e6, t, e3);              /* e_6 */
+    fe_sq_n(t, e6, 6);
+    fe_mul(t, t, e6);               /* e_12 */
+    fe_sq_n(e24, t, 12);
+    fe_mul(e24, e24, t);            /* e_24 */
+    fe_sq_n(e30, e24, 6);
+    fe_mul(e30, e30, e6);           /* e_30 */
+    fe_sq_n(t, e24, 24);
+    fe_mul(t, t, e24);              /* e_48 */
+    fe_sq_n(e222, t, 48);
+    fe_mul(e222, e222, t);          /* e_96 */
+    fe_sq_n(t, e222, 96);
+    fe_mul(t, t, e222);             /* e_192 */
+    fe_sq_n(e222, t, 30);
+    fe_mul(e222, e222, e30);        /* e_222 */
+    fe_sq(t, e222);
+    fe_mul(t, t, z);                /* e_223 */
+
+    fe_sq_n(t, t, 225);
+    fe_sq_n(e222, e222, 2);
+    fe_mul(t, t, e222);
+    fe_mul(h, t, z);
+
+    mbedtls_platform_zeroize(e3, sizeof(e3));
+    mbedtls_platform_zeroize(e6, sizeof(e6));
+    mbedtls_platform_zeroize(e24, sizeof(e24));
+    mbedtls_platform_zeroize(e30, sizeof(e30));
+    mbedtls_platform_zeroize(e222, sizeof(e222));
+    mbedtls_platform_zeroize(t, sizeof(t));
+}
+
+/* Load a 448-bit little-endian value. It may be non-canonical (>= p). */
+static void fe_frombytes(fe h, const unsigned char s[MBEDTLS_ECP_X448_BYTES])
+{
+    int i, j;
+
+    for (i = 0; i < 8; i++) {
+        h[i] = 0;
+        for (j = 6; j >= 0; j--) {
+            h[i] = (h[i] << 8) | s[7 * i + j];
+        }
+    }
+}
+
+/* Store the canonical (fully reduced) value of f. */
+static void fe_tobytes(unsigned char s[MBEDTLS_ECP_X448_BYTES], const fe f)
+{
+    fe t;
+    int64_t borrow = 0;
+    uint64_t mask, c = 0;
+    int i, j;
+
+    /* Now t < 2p, so subtracting p at most once is enough */
+    fe_copy(t, f);
+    fe_carry(t);
+
+    /* t -= p. Right shifts of negative values are arithmetic on every
+     * supported platform. */
+    for (i = 0; i < 8; i++) {
+        borrow += (int64_t) t[i] - (int64_t) FE_P(i);
+        t[i] = (uint64_t) borrow & FE_MASK;
+        borrow >>= 56;
+    }
+
+    /* Add p back if the result went negative */
+    mask = (uint64_t) borrow;
+    for (i = 0; i < 8; i++) {
+        c += t[i] + (FE_P(i) & mask);
+        t[i] = c & FE_MASK;
+        c >>= 56;
+    }
+
+    for (i = 0; i < 8; i++) {
+        for (j = 0; j < 7; j++) {
+            s[7 * i + j] = (unsigned char) (t[i] >> (8 * j));
+        }
+    }
+
+    mbedtls_platform_zeroize(t, sizeof(t));
+}
+
+/*
+ * Montgomery ladder, RFC 7748 section 5
+ */
+void mbedtls_ecp_x448_mul(unsigned char out[MBEDTLS_ECP_X448_BYTES],
+                          const unsigned char k[MBEDTLS_ECP_X448_BYTES],
+                          const unsigned char u[MBEDTLS_ECP_X448_BYTES])
+{
+    fe x1, x2, z2, x3, z3;
+    fe a, aa, b, bb, e, c, d;
+    uint64_t swap = 0, bit;
+    int i;
+
+    fe_frombytes(x1, u);
+    memset(x2, 0, sizeof(fe));
+    x2[0] = 1;
+    memset(z2, 0, sizeof(fe));
+    fe_copy(x3, x1);
+    memset(z3, 0, sizeof(fe));
+    z3[0] = 1;
+
+    for (i = 8 * MBEDTLS_ECP_X448_BYTES - 1; i >= 0; i--) {
+        bit = (k[i >> 3] >> (i & 7)) & 1;
+        swap ^= bit;
+        fe_cswap(x2, x3, swap);
+        fe_cswap(z2, z3, swap);
+        swap = bit;
+
+        fe_add(a, x2, z2);
+        fe_sq(aa, a);
+        fe_sub(b, x2, z2);
+        fe_sq(bb, b);
+        fe_sub(e, aa, bb);
+        fe_add(c, x3, z3);
+        fe_sub(d, x3, z3);
+        fe_mul(d, d, a);                /* DA */
+        fe_mul(c, c, b);                /* CB */
+        fe_add(x3, d, c);
+        fe_sq(x3, x3);                  /* (DA + CB)^2 */
+        fe_sub(z3, d, c);
+        fe_sq(z3, z3);
+        fe_mul(z3, z3, x1);             /* x1 * (DA - CB)^2 */
+        fe_mul(x2, aa, bb);             /* AA * BB */
+        fe_mul_small(z2, e, X448_A24);
+        fe_add(z2, z2, aa);
+        fe_mul(z2, z2, e);              /* E * (AA + a24 * E) */
+    }
+    fe_cswap(x2, x3, swap);
+    fe_cswap(z2, z3, swap);
+
+    fe_invert(z2, z2);
+    fe_mul(x2, x2, z2);
+    fe_tobytes(out, x2);
+
+    mbedtls_platform_zeroize(x2, sizeof(x2));
+    mbedtls_platform_zeroize(z2, sizeof(z2));
+    mbedtls_platform_zeroize(x3, sizeof(x3));
+    mbedtls_platform_zeroize(z3, sizeof(z3));
+    mbedtls_platform_zeroize(a, sizeof(a));
+    mbedtls_platform_zeroize(aa, sizeof(aa));
+    mbedtls_platform_zeroize(b, sizeof(b));
+    mbedtls_platform_zeroize(bb, sizeof(bb));
+    mbedtls_platform_zeroize(e, sizeof(e));
+    mbedtls_platform_zeroize(c, sizeof(c));
+    mbedtls_platform_zeroize(d, sizeof(d));
+}
+
+#endif /* MBEDTLS_ECP_X448_FIELD */
@@ -0,0 +1,56 @@
+/**
+ * \file ecp_x448.h
+ *
+ * \brief Dedicated X448 scalar multiplication.
+ *
+ * This is a fixed-size, allocation-free and constant-time implementation of
+ * the Curve448 Montgomery ladder. It is used by ecp.c for all scalar
+ * multiplications on MBEDTLS_ECP_DP_CURVE448 (and thus by ECDH and key
+ * generation through the legacy and PSA APIs) on platforms with a 128-bit
+ * integer type. Other platforms keep the generic bignum ladder.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_ECP_X448_H
+#define MBEDTLS_ECP_X448_H
+
+#include "common.h"
+#include "mbedtls/ecp.h"
+
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_DP_CURVE448_ENABLED) && \
+    defined(MBEDTLS_HAVE_INT64) && defined(MBEDTLS_HAVE_UDBL) &&       \
+    !defined(MBEDTLS_ECP_INTERNAL_ALT)
+#define MBEDTLS_ECP_X448_FIELD
+#endif
+
+#if defined(MBEDTLS_ECP_X448_FIELD)
+
+/** The size of X448 scalars and u-coordinates in bytes. */
+#define MBEDTLS_ECP_X448_BYTES 56
+
+/**
+ * \brief           Compute the u-coordinate of `k * P` on Curve448, where
+ *                  P is any point whose u-coordinate is \p u.
+ *
+ *                  Unlike the X448 function of RFC 7748, this does not clamp
+ *                  \p k: the caller is expected to have validated it with
+ *                  mbedtls_ecp_check_privkey(). All 448 bits are used.
+ *
+ * \param[out] out  The u-coordinate of the result, fully reduced, as
+ *                  #MBEDTLS_ECP_X448_BYTES little-endian bytes. This may
+ *                  alias \p u.
+ * \param[in] k     The scalar, as #MBEDTLS_ECP_X448_BYTES little-endian
+ *                  bytes.
+ * \param[in] u     The u-coordinate of P, as #MBEDTLS_ECP_X448_BYTES
+ *                  little-endian bytes. Non-canonical values (`u >= p`) are
+ *                  reduced modulo p.
+ */
+void mbedtls_ecp_x448_mul(unsigned char out[MBEDTLS_ECP_X448_BYTES],
+                          const unsigned char k[MBEDTLS_ECP_X448_BYTES],
+                          const unsigned char u[MBEDTLS_ECP_X448_BYTES]);
+
+#endif /* MBEDTLS_ECP_X448_FIELD */
+
+#endif /* MBEDTLS_ECP_X448_H */
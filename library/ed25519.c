@@ -0,0 +1,2480 @@
+/*
+ *  Ed25519 signatures (PureEdDSA, RFC 8032)
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+/*
+ * References:
+ *
+ * [1] RFC 8032: Edwards-Curve Digital Signature Algorithm (EdDSA)
+ * [2] D. J. Bernstein, N. Duif, T. Lange, P. Schwabe, B.-Y. Yang:
+ *     High-speed high-security signatures (2011)
+ * [3] H. Hisil, K. K.-H. Wong, G. Carter, E. Dawson:
+ *     Twisted Edwards Curves Revisited (2008)
+ *
+ * The curve is -x^2 + y^2 = 1 + d x^2 y^2 over GF(2^255 - 19), which is
+ * birationally equivalent to Curve25519 as used by the ECP module for
+ * X25519. Field elements use ten signed limbs of alternately 26 and 25 bits
+ * as in [2], and points use the extended coordinates of [3], whose addition
+ * formula is complete on this curve.
+ *
+ * Operations on secret data (key generation and signing) run in constant
+ * time, and multiply the base point with a precomputed table. Verification
+ * only handles public data and uses faster variable-time sliding-window
+ * multi-scalar multiplication.
+ */
+
+#include "common.h"
+
+#if defined(MBEDTLS_ED25519_C)
+
+#include "mbedtls/ed25519.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls/error.h"
+
+#include "bignum_core.h"
+#include "constant_time_internal.h"
+
+#include <string.h>
+
+#include "mbedtls/platform.h"
+
+/*
+ * Field arithmetic modulo p = 2^255 - 19
+ *
+ * Limb i has weight 2^ceil(25.5 * i) and holds FE_BITS(i) bits when fully
+ * carried. Additions and subtractions are not carried: their results may
+ * only be used as inputs of a multiplication, a squaring or a negation.
+ * Products are accumulated in 64-bit integers, folding limbs of weight
+ * 2^255 and above back with a factor of 19.
+ */
+typedef int32_t fe[10];
+
+#define FE_BITS(i) (26 - ((i) & 1))
+
+static const fe ed25519_d = {
+    56195235, 13857412, 51736253, 6949390, 114729,
+    24766616, 60832955, 30306712, 48412415, 21499315
+};
+static const fe ed25519_d2 = {
+    45281625, 27714825, 36363642, 13898781, 229458,
+    15978800, 54557047, 27058993, 29715967, 9444199
+};
+static const fe ed25519_sqrtm1 = {
+    34513072, 25610706, 9377949, 3500415, 12389472,
+    33281959, 41962654, 31548777, 326685, 11406482
+};
+static const fe ed25519_base_x = {
+    52811034, 25909283, 16144682, 17082669, 27570973,
+    30858332, 40966398, 8378388, 20764389, 8758491
+};
+static const fe ed25519_base_y = {
+    40265304, 26843545, 13421772, 20132659, 26843545,
+    6710886, 53687091, 13421772, 40265318, 26843545
+};
+static const fe ed25519_base_t = {
+    28827043, 27438313, 39759291, 244362, 8635006,
+    11264893, 19351346, 13413597, 16611511, 27139452
+};
+
+static void fe_0(fe h)
+{
+    memset(h, 0, sizeof(fe));
+}
+
+static void fe_1(fe h)
+{
+    fe_0(h);
+    h[0] = 1;
+}
+
+static void fe_copy(fe h, const fe f)
+{
+    memcpy(h, f, sizeof(fe));
+}
+
+static void fe_add(fe h, const fe f, const fe g)
+{
+    int i;
+    for (i = 0; i < 10; i++) {
+        h[i] = f[i] + g[i];
+    }
+}
+
+static void fe_sub(fe h, const fe f, const fe g)
+{
+    int i;
+    for (i = 0; i < 10; i++) {
+        h[i] = f[i] - g[i];
+    }
+}
+
+static void fe_neg(fe h, const fe f)
+{
+    int i;
+    for (i = 0; i < 10; i++) {
+        h[i] = -f[i];
+    }
+}
+
+/* Set f to g if cond is true, and leave it unchanged otherwise. */
+static void fe_cmov(fe f, const fe g, mbedtls_ct_condition_t cond)
+{
+    uint32_t mask = (uint32_t) cond;
+    int i;
+    for (i = 0; i < 10; i++) {
+        f[i] = (int32_t) (((uint32_t) f[i] & ~mask) | ((uint32_t) g[i] & mask));
+    }
+}
+
+/* Carry the 64-bit accumulators t into h, leaving every limb within
+ * 2^(FE_BITS(i) - 1) of zero except for a small excess on limb 1.
+ * Right shifts of negative values are arithmetic on every supported
+ * platform. */
+static void fe_reduce(fe h, int64_t t[10])
+{
+    int64_t carry;
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        carry = (t[i] + ((int64_t) 1 << (FE_BITS(i) - 1))) >> FE_BITS(i);
+        t[i] -= carry * ((int64_t) 1 << FE_BITS(i));
+        if (i < 9) {
+            t[i + 1] += carry;
+        } else {
+            t[0] += 19 * carry;
+        }
+    }
+    carry = (t[0] + ((int64_t) 1 << 25)) >> 26;
+    t[0] -= carry * ((int64_t) 1 << 26);
+    t[1] += carry;
+
+    for (i = 0; i < 10; i++) {
+        h[i] = (int32_t) t[i];
+    }
+}
+
+static void fe_carry(fe h)
+{
+    int64_t t[10];
+    int i;
+    for (i = 0; i < 10; i++) {
+        t[i] = h[i];
+    }
+    fe_reduce(h, t);
+}
+
+/* h = f * g. The loops have constant bounds so that compilers unroll them
+ * and fold the factors, which only depend on the limb indices. */
+static void fe_mul(fe h, const fe f, const fe g)
+{
+    int64_t t[10] = { 0 };
+    int64_t gj;
+    int i, j;
+
+    for (i = 0; i < 10; i++) {
+        for (j = 0; j < 10; j++) {
+            gj = g[j];
+            if ((i & j & 1) != 0) {
+                gj *= 2;
+            }
+            if (i + j >= 10) {
+                gj *= 19;
+            }
+            t[(i + j) % 10] += (int64_t) f[i] * gj;
+        }
+    }
+    fe_reduce(h, t);
+}
+
+/* h = scale * f^2, with scale 1 or 2 */
+static void fe_sq_scaled(fe h, const fe f, int scale)
+{
+    int64_t t[10] = { 0 };
+    int64_t fj;
+    int i, j;
+
+    for (i = 0; i < 10; i++) {
+        for (j = i; j < 10; j++) {
+            fj = (int64_t) f[j] * scale;
+            if ((i & j & 1) != 0) {
+                fj *= 2;
+            }
+            if (i != j) {
+                fj *= 2;
+            }
+            if (i + j >= 10) {
+                fj *= 19;
+            }
+            t[(i + j) % 10] += (int64_t) f[i] * fj;
+        }
+    }
+    fe_reduce(h, t);
+}
+
+static void fe_sq(fe h, const fe f)
+{
+    fe_sq_scaled(h, f, 1);
+}
+
+/* h = f^(2^n) */
+static void fe_sq_n(fe h, const fe f, int n)
+{
+    fe_sq(h, f);
+    while (--n > 0) {
+        fe_sq(h, h);
+    }
+}
+
+/* Load a 255-bit little-endian value, ignoring the top bit. The result may
+ * be the non-canonical representation of a value below 19. */
+static void fe_frombytes(fe h, const unsigned char s[32])
+{
+    uint64_t v;
+    size_t pos = 0, byte, j;
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        byte = pos / 8;
+        v = 0;
+        for (j = 0; j < 5 && byte + j < 32; j++) {
+            v |= (uint64_t) s[byte + j] << (8 * j);
+        }
+        v >>= pos % 8;
+        h[i] = (int32_t) (v & (((uint64_t) 1 << FE_BITS(i)) - 1));
+        pos += FE_BITS(i);
+    }
+    fe_carry(h);
+}
+
+/* Store the canonical encoding of h, which must be carried. */
+static void fe_tobytes(unsigned char s[32], const fe f)
+{
+    fe h;
+    int32_t q, carry;
+    uint64_t v;
+    size_t pos = 0, byte, j;
+    int i;
+
+    fe_copy(h, f);
+
+    /* q = floor(h / p), which is 0 or 1 for carried inputs */
+    q = (19 * h[9] + ((int32_t) 1 << 24)) >> 25;
+    for (i = 0; i < 10; i++) {
+        q = (h[i] + q) >> FE_BITS(i);
+    }
+
+    /* h - q * p = h + 19 * q - 2^255 * q; the last carry drops 2^255 * q */
+    h[0] += 19 * q;
+    for (i = 0; i < 9; i++) {
+        carry = h[i] >> FE_BITS(i);
+        h[i + 1] += carry;
+        h[i] &= ((int32_t) 1 << FE_BITS(i)) - 1;
+    }
+    h[9] &= ((int32_t) 1 << 25) - 1;
+
+    memset(s, 0, 32);
+    for (i = 0; i < 10; i++) {
+        byte = pos / 8;
+        v = (uint64_t) h[i] << (pos % 8);
+        for (j = 0; j < 5 && byte + j < 32; j++) {
+            s[byte + j] |= (unsigned char) (v >> (8 * j));
+        }
+        pos += FE_BITS(i);
+    }
+    mbedtls_platform_zeroize(h, sizeof(h));
+}
+
+static int fe_isnegative(const fe f)
+{
+    unsigned char s[32];
+    fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+static int fe_isnonzero(const fe f)
+{
+    unsigned char s[32];
+    unsigned char acc = 0;
+    size_t i;
+    fe_tobytes(s, f);
+    for (i = 0; i < sizeof(s); i++) {
+        acc |= s[i];
+    }
+    return acc != 0;
+}
+
+/* Compute z^(2^250 - 1) and z^11, the common part of the addition chains
+ * for inversion and square roots. */
+static void fe_pow_2_250_1(fe out, fe z11, const fe z)
+{
+    fe t0, t1, t2;
+
+    fe_sq(t0, z);                   /* z^2 */
+    fe_sq_n(t1, t0, 2);             /* z^8 */
+    fe_mul(t1, z, t1);              /* z^9 */
+    fe_mul(z11, t0, t1);            /* z^11 */
+    fe_sq(t0, z11);                 /* z^22 */
+    fe_mul(t0, t1, t0);             /* z^(2^5 - 1) */
+    fe_sq_n(t1, t0, 5);
+    fe_mul(t0, t1, t0);             /* z^(2^10 - 1) */
+    fe_sq_n(t1, t0, 10);
+    fe_mul(t1, t1, t0);             /* z^(2^20 - 1) */
+    fe_sq_n(t2, t1, 20);
+    fe_mul(t1, t2, t1);             /* z^(2^40 - 1) */
+    fe_sq_n(t1, t1, 10);
+    fe_mul(t0, t1, t0);             /* z^(2^50 - 1) */
+    fe_sq_n(t1, t0, 50);
+    fe_mul(t1, t1, t0);             /* z^(2^100 - 1) */
+    fe_sq_n(t2, t1, 100);
+    fe_mul(t1, t2, t1);             /* z^(2^200 - 1) */
+    fe_sq_n(t1, t1, 50);
+    fe_mul(out, t1, t0);            /* z^(2^250 - 1) */
+}
+
+/* h = z^(p - 2) = z^-1 */
+static void fe_invert(fe h, const fe z)
+{
+    fe t, z11;
+    fe_pow_2_250_1(t, z11, z);
+    fe_sq_n(t, t, 5);
+    fe_mul(h, t, z11);              /* z^(2^255 - 21) */
+}
+
+/* h = z^((p - 5) / 8) */
+static void fe_pow22523(fe h, const fe z)
+{
+    fe t, z11;
+    fe_pow_2_250_1(t, z11, z);
+    fe_sq_n(t, t, 2);
+    fe_mul(h, t, z);                /* z^(2^252 - 3) */
+}
+
+/*
+ * Group arithmetic
+ *
+ * p3:     extended coordinates (X:Y:Z:T) with x = X/Z, y = Y/Z, xy = T/Z
+ * p2:     projective coordinates (X:Y:Z), enough as input of a doubling
+ * p1p1:   completed coordinates, the output of additions and doublings
+ * cached: (Y+X, Y-X, Z, 2dT), the second operand of an addition
+ */
+typedef mbedtls_ed25519_point ge_p3;
+
+typedef struct {
+    fe X, Y, Z;
+} ge_p2;
+
+typedef struct {
+    fe X, Y, Z, T;
+} ge_p1p1;
+
+typedef struct {
+    fe YplusX, YminusX, Z, T2d;
+} ge_cached;
+
+static void ge_p3_0(ge_p3 *h)
+{
+    fe_0(h->X);
+    fe_1(h->Y);
+    fe_1(h->Z);
+    fe_0(h->T);
+}
+
+static void ge_p2_0(ge_p2 *h)
+{
+    fe_0(h->X);
+    fe_1(h->Y);
+    fe_1(h->Z);
+}
+
+static void ge_base(ge_p3 *h)
+{
+    fe_copy(h->X, ed25519_base_x);
+    fe_copy(h->Y, ed25519_base_y);
+    fe_1(h->Z);
+    fe_copy(h->T, ed25519_base_t);
+}
+
+static void ge_p3_neg(ge_p3 *r, const ge_p3 *p)
+{
+    fe_neg(r->X, p->X);
+    fe_copy(r->Y, p->Y);
+    fe_copy(r->Z, p->Z);
+    fe_neg(r->T, p->T);
+}
+
+static void ge_p3_to_p2(ge_p2 *r, const ge_p3 *p)
+{
+    fe_copy(r->X, p->X);
+    fe_copy(r->Y, p->Y);
+    fe_copy(r->Z, p->Z);
+}
+
+static void ge_p3_to_cached(ge_cached *r, const ge_p3 *p)
+{
+    fe_add(r->YplusX, p->Y, p->X);
+    fe_sub(r->YminusX, p->Y, p->X);
+    fe_copy(r->Z, p->Z);
+    fe_mul(r->T2d, p->T, ed25519_d2);
+}
+
+static void ge_p1p1_to_p2(ge_p2 *r, const ge_p1p1 *p)
+{
+    fe_mul(r->X, p->X, p->T);
+    fe_mul(r->Y, p->Y, p->Z);
+    fe_mul(r->Z, p->Z, p->T);
+}
+
+static void ge_p1p1_to_p3(ge_p3 *r, const ge_p1p1 *p)
+{
+    fe_mul(r->X, p->X, p->T);
+    fe_mul(r->Y, p->Y, p->Z);
+    fe_mul(r->Z, p->Z, p->T);
+    fe_mul(r->T, p->X, p->Y);
+}
+
+/* r = 2 * p ("dbl-2008-hwcd" from [3] with a = -1) */
+static void ge_p2_dbl(ge_p1p1 *r, const ge_p2 *p)
+{
+    fe t0;
+
+    fe_sq(r->X, p->X);
+    fe_sq(r->Z, p->Y);
+    fe_sq_scaled(r->T, p->Z, 2);
+    fe_add(r->Y, p->X, p->Y);
+    fe_sq(t0, r->Y);
+    fe_add(r->Y, r->Z, r->X);
+    fe_sub(r->Z, r->Z, r->X);
+    fe_sub(r->X, t0, r->Y);
+    fe_sub(r->T, r->T, r->Z);
+}
+
+static void ge_p3_dbl(ge_p1p1 *r, const ge_p3 *p)
+{
+    ge_p2 q;
+    ge_p3_to_p2(&q, p);
+    ge_p2_dbl(r, &q);
+}
+
+/* r = p + q ("add-2008-hwcd-3" from [3]) */
+static void ge_add(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q)
+{
+    fe t0;
+
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->YplusX);
+    fe_mul(r->Y, r->Y, q->YminusX);
+    fe_mul(r->T, q->T2d, p->T);
+    fe_mul(r->X, p->Z, q->Z);
+    fe_add(t0, r->X, r->X);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_add(r->Z, t0, r->T);
+    fe_sub(r->T, t0, r->T);
+}
+
+/* r = p - q */
+static void ge_sub(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q)
+{
+    fe t0;
+
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->YminusX);
+    fe_mul(r->Y, r->Y, q->YplusX);
+    fe_mul(r->T, q->T2d, p->T);
+    fe_mul(r->X, p->Z, q->Z);
+    fe_add(t0, r->X, r->X);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_sub(r->Z, t0, r->T);
+    fe_add(r->T, t0, r->T);
+}
+
+static void ge_tobytes(unsigned char s[32], const ge_p3 *h)
+{
+    fe recip, x, y;
+
+    fe_invert(recip, h->Z);
+    fe_mul(x, h->X, recip);
+    fe_mul(y, h->Y, recip);
+    fe_tobytes(s, y);
+    s[31] ^= (unsigned char) (fe_isnegative(x) << 7);
+}
+
+/* Decode a point as specified in [1] §5.1.3. Return 0 on success and -1 if
+ * the encoding is not canonical or not on the curve. */
+static int ge_frombytes(ge_p3 *h, const unsigned char s[32])
+{
+    fe u, v, v3, vxx, check;
+    unsigned char canonical[32];
+    int sign = s[31] >> 7;
+
+    fe_frombytes(h->Y, s);
+    fe_tobytes(canonical, h->Y);
+    canonical[31] |= (unsigned char) (sign << 7);
+    if (memcmp(canonical, s, sizeof(canonical)) != 0) {
+        return -1;
+    }
+
+    fe_1(h->Z);
+    fe_sq(u, h->Y);
+    fe_mul(v, u, ed25519_d);
+    fe_sub(u, u, h->Z);             /* u = y^2 - 1 */
+    fe_add(v, v, h->Z);             /* v = d y^2 + 1 */
+
+    fe_sq(v3, v);
+    fe_mul(v3, v3, v);              /* v^3 */
+    fe_sq(h->X, v3);
+    fe_mul(h->X, h->X, v);
+    fe_mul(h->X, h->X, u);          /* u v^7 */
+    fe_pow22523(h->X, h->X);        /* (u v^7)^((p - 5) / 8) */
+    fe_mul(h->X, h->X, v3);
+    fe_mul(h->X, h->X, u);          /* x = u v^3 (u v^7)^((p - 5) / 8) */
+
+    fe_sq(vxx, h->X);
+    fe_mul(vxx, vxx, v);
+    fe_sub(check, vxx, u);
+    fe_carry(check);
+    if (fe_isnonzero(check)) {
+        fe_add(check, vxx, u);
+        fe_carry(check);
+        if (fe_isnonzero(check)) {
+            return -1;
+        }
+        fe_mul(h->X, h->X, ed25519_sqrtm1);
+    }
+
+    if (!fe_isnonzero(h->X) && sign) {
+        return -1;
+    }
+    if (fe_isnegative(h->X) != sign) {
+        fe_neg(h->X, h->X);
+    }
+
+    fe_mul(h->T, h->X, h->Y);
+    return 0;
+}
+
+/* Return whether 8 * p is the neutral element. */
+static int ge_mul8_is_neutral(const ge_p3 *p)
+{
+    ge_p2 q;
+    ge_p1p1 t;
+    unsigned char y[32], z[32];
+    int i;
+
+    ge_p3_to_p2(&q, p);
+    for (i = 0; i < 3; i++) {
+        ge_p2_dbl(&t, &q);
+        ge_p1p1_to_p2(&q, &t);
+    }
+    fe_tobytes(y, q.Y);
+    fe_tobytes(z, q.Z);
+    return !fe_isnonzero(q.X) && memcmp(y, z, sizeof(y)) == 0;
+}
+
+/* Recode a, where a[31] <= 127, as sum(e[i] * 16^i) with e[i] in [-8, 8] */
+static void sc_recode_signed4(signed char e[64], const unsigned char a[32])
+{
+    signed char carry = 0;
+    int i;
+
+    for (i = 0; i < 32; i++) {
+        e[2 * i] = (signed char) (a[i] & 15);
+        e[2 * i + 1] = (signed char) ((a[i] >> 4) & 15);
+    }
+    for (i = 0; i < 63; i++) {
+        e[i] = (signed char) (e[i] + carry);
+        carry = (signed char) ((e[i] + 8) >> 4);
+        e[i] = (signed char) (e[i] - carry * 16);
+    }
+    e[63] = (signed char) (e[63] + carry);
+}
+
+/* h = 16 * h */
+static void ge_p3_mul16(ge_p3 *h)
+{
+    ge_p1p1 r;
+    ge_p2 s;
+    int j;
+
+    ge_p3_to_p2(&s, h);
+    for (j = 0; j < 3; j++) {
+        ge_p2_dbl(&r, &s);
+        ge_p1p1_to_p2(&s, &r);
+    }
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p3(h, &r);
+}
+
+/*
+ * Constant-time multiplication of the base point
+ *
+ * The scalar is recoded in 64 signed digits in [-8, 8], and each digit
+ * selects a multiple of B by scanning a whole row of a precomputed table.
+ * The table is in affine form (y + x, y - x, 2dxy), which saves a
+ * multiplication per addition. Row k holds 1..8 times 2^(16k) B, so the
+ * digits e[4k + m] for a given m each use a different row and only
+ * 3 * 4 doublings are needed:
+ *      a * B = sum_m 16^m * sum_k e[4k + m] * 2^(16k) B
+ * The table takes 15 KiB and is generated by scripts/ed25519_base_table.py.
+ */
+typedef struct {
+    fe yplusx, yminusx, xy2d;
+} ge_precomp;
+
+static const ge_precomp ed25519_base_table[16][8] = {
+    {   /* B .. 8 B */
+        {
+            { 25967493, 19198397, 29566455, 3660896, 54414519,
+              4014786, 27544626, 21800161, 61029707, 2047604 },
+            { 54563134, 934261, 64385954, 3049989, 66381436,
+              9406985, 12720692, 5043384, 19500929, 18085054 },
+            { 58370664, 4489569, 9688441, 18769238, 10184608,
+              21191052, 29287918, 11864899, 42594502, 29115885 }
+        },
+        {
+            { 54292951, 20578084, 45527620, 11784319, 41753206,
+              30803714, 55390960, 29739860, 66750418, 23343128 },
+            { 45405608, 6903824, 27185491, 6451973, 37531140,
+              24000426, 51492312, 11189267, 40279186, 28235350 },
+            { 26966623, 11152617, 32442495, 15396054, 14353839,
+              20802097, 63980037, 24013313, 51636816, 29387734 }
+        },
+        {
+            { 15636272, 23865875, 24204772, 25642034, 616976,
+              16869170, 27787599, 18782243, 28944399, 32004408 },
+            { 16568933, 4717097, 55552716, 32452109, 15682895,
+              21747389, 16354576, 21778470, 7689661, 11199574 },
+            { 30464137, 27578307, 55329429, 17883566, 23220364,
+              15915852, 7512774, 10017326, 49359771, 23634074 }
+        },
+        {
+            { 50071967, 13921891, 10945806, 27521001, 27105051,
+              17470053, 38182653, 15006022, 3284568, 27277892 },
+            { 23599295, 25248385, 55915199, 25867015, 13236773,
+              10506355, 7464579, 9656445, 13059162, 10374397 },
+            { 7798537, 16710257, 3033922, 2874086, 28997861,
+              2835604, 32406664, 29715387, 66467155, 33453106 }
+        },
+        {
+            { 10861363, 11473154, 27284546, 1981175, 37044515,
+              12577860, 32867885, 14515107, 51670560, 10819379 },
+            { 4708026, 6336745, 20377586, 9066809, 55836755,
+              6594695, 41455196, 12483687, 54440373, 5581305 },
+            { 19563141, 16186464, 37722007, 4097518, 10237984,
+              29206317, 28542349, 13850243, 43430843, 17738489 }
+        },
+        {
+            { 51736881, 20691677, 32573249, 4720197, 40672342,
+              5875510, 47920237, 18329612, 57289923, 21468654 },
+            { 58559652, 109982, 15149363, 2178705, 22900618,
+              4543417, 3044240, 17864545, 1762327, 14866737 },
+            { 48909169, 17603008, 56635573, 1707277, 49922944,
+              3916100, 38872452, 3959420, 27914454, 4383652 }
+        },
+        {
+            { 5153727, 9909285, 1723747, 30776558, 30523604,
+              5516873, 19480852, 5230134, 43156425, 18378665 },
+            { 36839857, 30090922, 7665485, 10083793, 28475525,
+              1649722, 20654025, 16520125, 30598449, 7715701 },
+            { 28881826, 14381568, 9657904, 3680757, 46927229,
+              7843315, 35708204, 1370707, 29794553, 32145132 }
+        },
+        {
+            { 14499471, 30824833, 33917750, 29299779, 28494861,
+              14271267, 30290735, 10876454, 33954766, 2381725 },
+            { 59913433, 30899068, 52378708, 462250, 39384538,
+              3941371, 60872247, 3696004, 34808032, 15351954 },
+            { 27431194, 8222322, 16448760, 29646437, 48401861,
+              11938354, 34147463, 30583916, 29551812, 10109425 }
+        },
+    },
+    {   /* 2^16 B .. 8 * 2^16 B */
+        {
+            { 6721966, 13833823, 43585476, 32003117, 26354292,
+              21691111, 23365146, 29604700, 7390889, 2759800 },
+            { 4409022, 2052381, 23373853, 10530217, 7676779,
+              20668478, 21302352, 29290375, 1244379, 20634787 },
+            { 62687625, 7169618, 4982368, 30596842, 30256824,
+              30776892, 14086412, 9208236, 15886429, 16489664 }
+        },
+        {
+            { 1996056, 10375649, 14346367, 13311202, 60234729,
+              17116020, 53415665, 398368, 36502409, 32841498 },
+            { 41801399, 9795879, 64331450, 14878808, 33577029,
+              14780362, 13348553, 12076947, 36272402, 5113181 },
+            { 49338080, 11797795, 31950843, 13929123, 41220562,
+              12288343, 36767763, 26218045, 13847710, 5387222 }
+        },
+        {
+            { 48526701, 30138214, 17824842, 31213466, 22744342,
+              23111821, 8763060, 3617786, 47508202, 10370990 },
+            { 20246567, 19185054, 22358228, 33010720, 18507282,
+              23140436, 14554436, 24808340, 32232923, 16763880 },
+            { 9648486, 10094563, 26416693, 14745928, 36734546,
+              27081810, 11094160, 15689506, 3140038, 17044340 }
+        },
+        {
+            { 50948792, 5472694, 31895588, 4744994, 8823515,
+              10365685, 39884064, 9448612, 38334410, 366294 },
+            { 19153450, 11523972, 56012374, 27051289, 42461232,
+              5420646, 28344573, 8041113, 719605, 11671788 },
+            { 8678006, 2694440, 60300850, 2517371, 4964326,
+              11152271, 51675948, 18287915, 27000812, 23358879 }
+        },
+        {
+            { 51950941, 7134311, 8639287, 30739555, 59873175,
+              10421741, 564065, 5336097, 6750977, 19033406 },
+            { 11836410, 29574944, 26297893, 16080799, 23455045,
+              15735944, 1695823, 24735310, 8169719, 16220347 },
+            { 48993007, 8653646, 17578566, 27461813, 59083086,
+              17541668, 55964556, 30926767, 61118155, 19388398 }
+        },
+        {
+            { 43800366, 22586119, 15213227, 23473218, 36255258,
+              22504427, 27884328, 2847284, 2655861, 1738395 },
+            { 39571412, 19301410, 41772562, 25551651, 57738101,
+              8129820, 21651608, 30315096, 48021414, 22549153 },
+            { 1533110, 3437855, 23735889, 459276, 29970501,
+              11335377, 26030092, 5821408, 10478196, 8544890 }
+        },
+        {
+            { 32173102, 17425121, 24896206, 3921497, 22579056,
+              30143578, 19270448, 12217473, 17789017, 30158437 },
+            { 36555903, 31326030, 51530034, 23407230, 13243888,
+              517024, 15479401, 29701199, 30460519, 1052596 },
+            { 55493970, 13323617, 32618793, 8175907, 51878691,
+              12596686, 27491595, 28942073, 3179267, 24075541 }
+        },
+        {
+            { 31947050, 19187781, 62468280, 18214510, 51982886,
+              27514722, 52352086, 17142691, 19072639, 24043372 },
+            { 11685058, 11822410, 3158003, 19601838, 33402193,
+              29389366, 5977895, 28339415, 473098, 5040608 },
+            { 46817982, 8198641, 39698732, 11602122, 1290375,
+              30754672, 28326861, 1721092, 47550222, 30422825 }
+        },
+    },
+    {   /* 2^32 B .. 8 * 2^32 B */
+        {
+            { 59098600, 23963614, 55988460, 6196037, 29344158,
+              20123547, 7585294, 30377806, 18549496, 15302069 },
+            { 34450527, 27383209, 59436070, 22502750, 6258877,
+              13504381, 10458790, 27135971, 58236621, 8424745 },
+            { 24687186, 8613276, 36441818, 30320886, 1863891,
+              31723888, 19206233, 7134917, 55824382, 32725512 }
+        },
+        {
+            { 11334899, 24336410, 8025292, 12707519, 17523892,
+              23078361, 10243737, 18868971, 62042829, 16498836 },
+            { 8911542, 6887158, 57524604, 26595841, 11145640,
+              24010752, 17303924, 19430194, 6536640, 10543906 },
+            { 38162480, 15479762, 49642029, 568875, 65611181,
+              11223453, 64439674, 16928857, 39873154, 8876770 }
+        },
+        {
+            { 41365946, 20987567, 51458897, 32707824, 34082177,
+              32758143, 33627041, 15824473, 66504438, 24514614 },
+            { 10330056, 70051, 7957388, 24551765, 9764901,
+              15609756, 27698697, 28664395, 1657393, 3084098 },
+            { 10477963, 26084172, 12119565, 20303627, 29016246,
+              28188843, 31280318, 14396151, 36875289, 15272408 }
+        },
+        {
+            { 54820555, 3169462, 28813183, 16658753, 25116432,
+              27923966, 41934906, 20918293, 42094106, 1950503 },
+            { 40928506, 9489186, 11053416, 18808271, 36055143,
+              5825629, 58724558, 24786899, 15341278, 8373727 },
+            { 28685821, 7759505, 52730348, 21551571, 35137043,
+              4079241, 298136, 23321830, 64230656, 15190419 }
+        },
+        {
+            { 34175969, 13806335, 52771379, 17760000, 43104243,
+              10940927, 8669718, 2742393, 41075551, 26679428 },
+            { 65528476, 21825014, 41129205, 22109408, 49696989,
+              22641577, 9291593, 17306653, 54954121, 6048604 },
+            { 36803549, 14843443, 1539301, 11864366, 20201677,
+              1900163, 13934231, 5128323, 11213262, 9168384 }
+        },
+        {
+            { 40828332, 11007846, 19408960, 32613674, 48515898,
+              29225851, 62020803, 22449281, 20470156, 17155731 },
+            { 43972811, 9282191, 14855179, 18164354, 59746048,
+              19145871, 44324911, 14461607, 14042978, 5230683 },
+            { 29969548, 30812838, 50396996, 25001989, 9175485,
+              31085458, 21556950, 3506042, 61174973, 21104723 }
+        },
+        {
+            { 63964118, 8744660, 19704003, 4581278, 46678178,
+              6830682, 45824694, 8971512, 38569675, 15326562 },
+            { 47644235, 10110287, 49846336, 30050539, 43608476,
+              1355668, 51585814, 15300987, 46594746, 9168259 },
+            { 61755510, 4488612, 43305616, 16314346, 7780487,
+              17915493, 38160505, 9601604, 33087103, 24543045 }
+        },
+        {
+            { 47665694, 18041531, 46311396, 21109108, 37284416,
+              10229460, 39664535, 18553900, 61111993, 15664671 },
+            { 23294591, 16921819, 44458082, 25083453, 27844203,
+              11461195, 13099750, 31094076, 18151675, 13417686 },
+            { 42385932, 29377914, 35958184, 5988918, 40250079,
+              6685064, 1661597, 21002991, 15271675, 18101767 }
+        },
+    },
+    {   /* 2^48 B .. 8 * 2^48 B */
+        {
+            { 54923003, 25874643, 16438268, 10826160, 58412047,
+              27318820, 17860443, 24280586, 65013061, 9304566 },
+            { 20714545, 29217521, 29088194, 7406487, 11426967,
+              28458727, 14792666, 18945815, 5289420, 33077305 },
+            { 50443312, 22903641, 60948518, 20248671, 9192019,
+              31751970, 17271489, 12349094, 26939669, 29802138 }
+        },
+        {
+            { 54218966, 9373457, 31595848, 16374215, 21471720,
+              13221525, 39825369, 21205872, 63410057, 117886 },
+            { 22263325, 26994382, 3984569, 22379786, 51994855,
+              32987646, 28311252, 5358056, 43789084, 541963 },
+            { 16259200, 3261970, 2309254, 18019958, 50223152,
+              28972515, 24134069, 16848603, 53771797, 20002236 }
+        },
+        {
+            { 9378160, 20414246, 44262881, 20809167, 28198280,
+              26310334, 64709179, 32837080, 690425, 14876244 },
+            { 24977353, 33240048, 58884894, 20089345, 28432342,
+              32378079, 54040059, 21257083, 44727879, 6618998 },
+            { 65570671, 11685645, 12944378, 13682314, 42719353,
+              19141238, 8044828, 19737104, 32239828, 27901670 }
+        },
+        {
+            { 48505798, 4762989, 66182614, 8885303, 38696384,
+              30367116, 9781646, 23204373, 32779358, 5095274 },
+            { 34100715, 28339925, 34843976, 29869215, 9460460,
+              24227009, 42507207, 14506723, 21639561, 30924196 },
+            { 50707921, 20442216, 25239337, 15531969, 3987758,
+              29055114, 65819361, 26690896, 17874573, 558605 }
+        },
+        {
+            { 53508735, 10240080, 9171883, 16131053, 46239610,
+              9599699, 33499487, 5080151, 2085892, 5119761 },
+            { 44903700, 31034903, 50727262, 414690, 42089314,
+              2170429, 30634760, 25190818, 35108870, 27794547 },
+            { 60263160, 15791201, 8550074, 32241778, 29928808,
+              21462176, 27534429, 26362287, 44757485, 12961481 }
+        },
+        {
+            { 42616785, 23983660, 10368193, 11582341, 43711571,
+              31309144, 16533929, 8206996, 36914212, 28394793 },
+            { 55987368, 30172197, 2307365, 6362031, 66973409,
+              8868176, 50273234, 7031274, 7589640, 8945490 },
+            { 34956097, 8917966, 6661220, 21876816, 65916803,
+              17761038, 7251488, 22372252, 24099108, 19098262 }
+        },
+        {
+            { 5019539, 25646962, 4244126, 18840076, 40175591,
+              6453164, 47990682, 20265406, 60876967, 23273695 },
+            { 10853575, 10721687, 26480089, 5861829, 44113045,
+              1972174, 65242217, 22996533, 63745412, 27113307 },
+            { 50106456, 5906789, 221599, 26991285, 7828207,
+              20305514, 24362660, 31546264, 53242455, 7421391 }
+        },
+        {
+            { 8139908, 27007935, 32257645, 27663886, 30375718,
+              1886181, 45933756, 15441251, 28826358, 29431403 },
+            { 6267067, 9695052, 7709135, 16950835, 34239795,
+              31668296, 14795159, 25714308, 13746020, 31812384 },
+            { 28584883, 7787108, 60375922, 18503702, 22846040,
+              25983196, 63926927, 33190907, 4771361, 25134474 }
+        },
+    },
+    {   /* 2^64 B .. 8 * 2^64 B */
+        {
+            { 64091413, 10058205, 1980837, 3964243, 22160966,
+              12322533, 60677741, 20936246, 12228556, 26550755 },
+            { 32944382, 14922211, 44263970, 5188527, 21913450,
+              24834489, 4001464, 13238564, 60994061, 8653814 },
+            { 22865569, 28901697, 27603667, 21009037, 14348957,
+              8234005, 24808405, 5719875, 28483275, 2841751 }
+        },
+        {
+            { 50687877, 32441126, 66781144, 21446575, 21886281,
+              18001658, 65220897, 33238773, 19932057, 20815229 },
+            { 55452759, 10087520, 58243976, 28018288, 47830290,
+              30498519, 3999227, 13239134, 62331395, 19644223 },
+            { 1382174, 21859713, 17266789, 9194690, 53784508,
+              9720080, 20403944, 11284705, 53095046, 3093229 }
+        },
+        {
+            { 16650902, 22516500, 66044685, 1570628, 58779118,
+              7352752, 66806440, 16271224, 43059443, 26862581 },
+            { 45197768, 27626490, 62497547, 27994275, 35364760,
+              22769138, 24123613, 15193618, 45456747, 16815042 },
+            { 57172930, 29264984, 41829040, 4372841, 2087473,
+              10399484, 31870908, 14690798, 17361620, 11864968 }
+        },
+        {
+            { 55801235, 6210371, 13206574, 5806320, 38091172,
+              19587231, 54777658, 26067830, 41530403, 17313742 },
+            { 14668443, 21284197, 26039038, 15305210, 25515617,
+              4542480, 10453892, 6577524, 9145645, 27110552 },
+            { 5974855, 3053895, 57675815, 23169240, 35243739,
+              3225008, 59136222, 3936127, 61456591, 30504127 }
+        },
+        {
+            { 30625386, 28825032, 41552902, 20761565, 46624288,
+              7695098, 17097188, 17250936, 39109084, 1803631 },
+            { 63555773, 9865098, 61880298, 4272700, 61435032,
+              16864731, 14911343, 12196514, 45703375, 7047411 },
+            { 20093258, 9920966, 55970670, 28210574, 13161586,
+              12044805, 34252013, 4124600, 34765036, 23296865 }
+        },
+        {
+            { 46320040, 14084653, 53577151, 7842146, 19119038,
+              19731827, 4752376, 24839792, 45429205, 2288037 },
+            { 40289628, 30270716, 29965058, 3039786, 52635099,
+              2540456, 29457502, 14625692, 42289247, 12570231 },
+            { 66045306, 22002608, 16920317, 12494842, 1278292,
+              27685323, 45948920, 30055751, 55134159, 4724942 }
+        },
+        {
+            { 17960970, 21778898, 62967895, 23851901, 58232301,
+              32143814, 54201480, 24894499, 37532563, 1903855 },
+            { 23134274, 19275300, 56426866, 31942495, 20684484,
+              15770816, 54119114, 3190295, 26955097, 14109738 },
+            { 15308788, 5320727, 36995055, 19235554, 22902007,
+              7767164, 29425325, 22276870, 31960941, 11934971 }
+        },
+        {
+            { 39713153, 8435795, 4109644, 12222639, 42480996,
+              14818668, 20638173, 4875028, 10491392, 1379718 },
+            { 53949449, 9197840, 3875503, 24618324, 65725151,
+              27674630, 33518458, 16176658, 21432314, 12180697 },
+            { 55321537, 11500837, 13787581, 19721842, 44678184,
+              10140204, 1465425, 12689540, 56807545, 19681548 }
+        },
+    },
+    {   /* 2^80 B .. 8 * 2^80 B */
+        {
+            { 12015105, 2801261, 28198131, 10151021, 24818120,
+              28811299, 55914672, 27908697, 5150967, 7274186 },
+            { 2831347, 21062286, 1478974, 6122054, 23825128,
+              20820846, 31097298, 6083058, 31021603, 23760822 },
+            { 64578913, 31324785, 445612, 10720828, 53259337,
+              22048494, 43601132, 16354464, 15067285, 19406725 }
+        },
+        {
+            { 7840923, 14037873, 33744001, 15934015, 66380651,
+              29911725, 21403987, 1057586, 47729402, 21151211 },
+            { 915865, 17085158, 15608284, 24765302, 42751837,
+              6060029, 49737545, 8410996, 59888403, 16527024 },
+            { 32922597, 32997445, 20336073, 17369864, 10903704,
+              28169945, 16957573, 52992, 23834301, 6588044 }
+        },
+        {
+            { 32752011, 11232950, 3381995, 24839566, 22652987,
+              22810329, 17159698, 16689107, 46794284, 32248439 },
+            { 62419196, 9166775, 41398568, 22707125, 11576751,
+              12733943, 7924251, 30802151, 1976122, 26305405 },
+            { 21251203, 16309901, 64125849, 26771309, 30810596,
+              12967303, 156041, 30183180, 12331344, 25317235 }
+        },
+        {
+            { 8651595, 29077400, 51023227, 28557437, 13002506,
+              2950805, 29054427, 28447462, 10008135, 28886531 },
+            { 31486061, 15114593, 52847614, 12951353, 14369431,
+              26166587, 16347320, 19892343, 8684154, 23021480 },
+            { 19443825, 11385320, 24468943, 23895364, 43189605,
+              2187568, 40845657, 27467510, 31316347, 14219878 }
+        },
+        {
+            { 38514374, 1193784, 32245219, 11392485, 31092169,
+              15722801, 27146014, 6992409, 29126555, 9207390 },
+            { 32382916, 1110093, 18477781, 11028262, 39697101,
+              26006320, 62128346, 10843781, 59151264, 19118701 },
+            { 2814918, 7836403, 27519878, 25686276, 46214848,
+              22000742, 45614304, 8550129, 28346258, 1994730 }
+        },
+        {
+            { 47530565, 8085544, 53108345, 29605809, 2785837,
+              17323125, 47591912, 7174893, 22628102, 8115180 },
+            { 36703732, 955510, 55975026, 18476362, 34661776,
+              20276352, 41457285, 3317159, 57165847, 930271 },
+            { 51805164, 26720662, 28856489, 1357446, 23421993,
+              1057177, 24091212, 32165462, 44343487, 22903716 }
+        },
+        {
+            { 44357633, 28250434, 54201256, 20785565, 51297352,
+              25757378, 52269845, 17000211, 65241845, 8398969 },
+            { 35139535, 2106402, 62372504, 1362500, 12813763,
+              16200670, 22981545, 27263159, 18009407, 17781660 },
+            { 49887941, 24009210, 39324209, 14166834, 29815394,
+              7444469, 29551787, 29827013, 19288548, 1325865 }
+        },
+        {
+            { 15100138, 17718680, 43184885, 32549333, 40658671,
+              15509407, 12376730, 30075286, 33166106, 25511682 },
+            { 20909212, 13023121, 57899112, 16251777, 61330449,
+              25459517, 12412150, 10018715, 2213263, 19676059 },
+            { 32529814, 22479743, 30361438, 16864679, 57972923,
+              1513225, 22922121, 6382134, 61341936, 8371347 }
+        },
+    },
+    {   /* 2^96 B .. 8 * 2^96 B */
+        {
+            { 48083108, 1632004, 13466291, 25559332, 43468412,
+              16573536, 35094956, 30497327, 22208661, 2000468 },
+            { 3065054, 32141671, 41510189, 33192999, 49425798,
+              27851016, 58944651, 11248526, 63417650, 26140247 },
+            { 10379208, 27508878, 8877318, 1473647, 37817580,
+              21046851, 16690914, 2553332, 63976176, 16400288 }
+        },
+        {
+            { 15716668, 1254266, 48636174, 7446273, 58659946,
+              6344163, 45011593, 26268851, 26894936, 9132066 },
+            { 24158868, 12938817, 11085297, 25376834, 39045385,
+              29097348, 36532400, 64451, 60291780, 30861549 },
+            { 13488534, 7794716, 22236231, 5989356, 25426474,
+              20976224, 2350709, 30135921, 62420857, 2364225 }
+        },
+        {
+            { 16335033, 9132434, 25640582, 6678888, 1725628,
+              8517937, 55301840, 21856974, 15445874, 25756331 },
+            { 29004188, 25687351, 28661401, 32914020, 54314860,
+              25611345, 31863254, 29418892, 66830813, 17795152 },
+            { 60986784, 18687766, 38493958, 14569918, 56250865,
+              29962602, 10343411, 26578142, 37280576, 22738620 }
+        },
+        {
+            { 27081650, 3463984, 14099042, 29036828, 1616302,
+              27348828, 29542635, 15372179, 17293797, 960709 },
+            { 20263915, 11434237, 61343429, 11236809, 13505955,
+              22697330, 50997518, 6493121, 47724353, 7639713 },
+            { 64278047, 18715199, 25403037, 25339236, 58791851,
+              17380732, 18006286, 17510682, 29994676, 17746311 }
+        },
+        {
+            { 9769828, 5202651, 42951466, 19923039, 39057860,
+              21992807, 42495722, 19693649, 35924288, 709463 },
+            { 12286395, 13076066, 45333675, 32377809, 42105665,
+              4057651, 35090736, 24663557, 16102006, 13205847 },
+            { 13733362, 5599946, 10557076, 3195751, 61550873,
+              8536969, 41568694, 8525971, 10151379, 10394400 }
+        },
+        {
+            { 4024660, 17416881, 22436261, 12276534, 58009849,
+              30868332, 19698228, 11743039, 33806530, 8934413 },
+            { 51229064, 29029191, 58528116, 30620370, 14634844,
+              32856154, 57659786, 3137093, 55571978, 11721157 },
+            { 17555920, 28540494, 8268605, 2331751, 44370049,
+              9761012, 9319229, 8835153, 57903375, 32274386 }
+        },
+        {
+            { 66647436, 25724417, 20614117, 16688288, 59594098,
+              28747312, 22300303, 505429, 6108462, 27371017 },
+            { 62038564, 12367916, 36445330, 3234472, 32617080,
+              25131790, 29880582, 20071101, 40210373, 25686972 },
+            { 35133562, 5726538, 26934134, 10237677, 63935147,
+              32949378, 24199303, 3795095, 7592688, 18562353 }
+        },
+        {
+            { 21594432, 18590204, 17466407, 29477210, 32537083,
+              2739898, 6407723, 12018833, 38852812, 4298411 },
+            { 46458361, 21592935, 39872588, 570497, 3767144,
+              31836892, 13891941, 31985238, 13717173, 10805743 },
+            { 52432215, 17910135, 15287173, 11927123, 24177847,
+              25378864, 66312432, 14860608, 40169934, 27690595 }
+        },
+    },
+    {   /* 2^112 B .. 8 * 2^112 B */
+        {
+            { 64864412, 32799703, 62511833, 32488122, 60861691,
+              1455298, 45461136, 24339642, 61886162, 12650266 },
+            { 57202067, 17484121, 21134159, 12198166, 40044289,
+              708125, 387813, 13770293, 47974538, 10958662 },
+            { 22470984, 12369526, 23446014, 28113323, 45588061,
+              23855708, 55336367, 21979976, 42025033, 4271861 }
+        },
+        {
+            { 41939299, 23500789, 47199531, 15361594, 61124506,
+              2159191, 75375, 29275903, 34582642, 8469672 },
+            { 15854951, 4148314, 58214974, 7259001, 11666551,
+              13824734, 36577666, 2697371, 24154791, 24093489 },
+            { 15446137, 17747788, 29759746, 14019369, 30811221,
+              23944241, 35526855, 12840103, 24913809, 9815020 }
+        },
+        {
+            { 62399578, 27940162, 35267365, 21265538, 52665326,
+              10799413, 58005188, 13438768, 18735128, 9466238 },
+            { 11933045, 9281483, 5081055, 28370608, 64480701,
+              28648802, 59381042, 22658328, 44380208, 16199063 },
+            { 14576810, 379472, 40322331, 25237195, 37682355,
+              22741457, 67006097, 1876698, 30801119, 2164795 }
+        },
+        {
+            { 15995086, 3199873, 13672555, 13712240, 47730029,
+              28906785, 54027253, 18058162, 53616056, 1268051 },
+            { 56818250, 29895392, 63822271, 10948817, 23037027,
+              3794475, 63638526, 20954210, 50053494, 3565903 },
+            { 29210069, 24135095, 61189071, 28601646, 10834810,
+              20226706, 50596761, 22733718, 39946641, 19523900 }
+        },
+        {
+            { 53946955, 15508587, 16663704, 25398282, 38758921,
+              9019122, 37925443, 29785008, 2244110, 19552453 },
+            { 61955989, 29753495, 57802388, 27482848, 16243068,
+              14684434, 41435776, 17373631, 13491505, 4641841 },
+            { 10813398, 643330, 47920349, 32825515, 30292061,
+              16954354, 27548446, 25833190, 14476988, 20787001 }
+        },
+        {
+            { 10292079, 9984945, 6481436, 8279905, 59857350,
+              7032742, 27282937, 31910173, 39196053, 12651323 },
+            { 35923332, 32741048, 22271203, 11835308, 10201545,
+              15351028, 17099662, 3988035, 21721536, 30405492 },
+            { 10202177, 27008593, 35735631, 23979793, 34958221,
+              25434748, 54202543, 3852693, 13216206, 14842320 }
+        },
+        {
+            { 51293224, 22953365, 60569911, 26295436, 60124204,
+              26972653, 35608016, 13765823, 39674467, 9900183 },
+            { 14465486, 19721101, 34974879, 18815558, 39665676,
+              12990491, 33046193, 15796406, 60056998, 25514317 },
+            { 30924398, 25274812, 6359015, 20738097, 16508376,
+              9071735, 41620263, 15413634, 9524356, 26535554 }
+        },
+        {
+            { 12274201, 20378885, 32627640, 31769106, 6736624,
+              13267305, 5237659, 28444949, 15663515, 4035784 },
+            { 64157555, 8903984, 17349946, 601635, 50676049,
+              28941875, 53376124, 17665097, 44850385, 4659090 },
+            { 50192582, 28601458, 36715152, 18395610, 20774811,
+              15897498, 5736189, 15026997, 64930608, 20098846 }
+        },
+    },
+    {   /* 2^128 B .. 8 * 2^128 B */
+        {
+            { 11374242, 12660715, 17861383, 21013599, 10935567,
+              1099227, 53222788, 24462691, 39381819, 11358503 },
+            { 54378055, 10311866, 1510375, 10778093, 64989409,
+              24408729, 32676002, 11149336, 40985213, 4985767 },
+            { 48012542, 341146, 60911379, 33315398, 15756972,
+              24757770, 66125820, 13794113, 47694557, 17933176 }
+        },
+        {
+            { 6490062, 11940286, 25495923, 25828072, 8668372,
+              24803116, 3367602, 6970005, 65417799, 24549641 },
+            { 1656478, 13457317, 15370807, 6364910, 13605745,
+              8362338, 47934242, 28078708, 50312267, 28522993 },
+            { 44835530, 20030007, 67044178, 29220208, 48503227,
+              22632463, 46537798, 26546453, 67009010, 23317098 }
+        },
+        {
+            { 17747446, 10039260, 19368299, 29503841, 46478228,
+              17513145, 31992682, 17696456, 37848500, 28042460 },
+            { 31932008, 28568291, 47496481, 16366579, 22023614,
+              88450, 11371999, 29810185, 4882241, 22927527 },
+            { 29796488, 37186, 19818052, 10115756, 55279832,
+              3352735, 18551198, 3272828, 61917932, 29392022 }
+        },
+        {
+            { 12501267, 4044383, 58495907, 20162046, 34678811,
+              5136598, 47878486, 30024734, 330069, 29895023 },
+            { 6384877, 2899513, 17807477, 7663917, 64749976,
+              12363164, 25366522, 24980540, 66837568, 12071498 },
+            { 58743349, 29511910, 25133447, 29037077, 60897836,
+              2265926, 34339246, 1936674, 61949167, 3829362 }
+        },
+        {
+            { 28425966, 27718999, 66531773, 28857233, 52891308,
+              6870929, 7921550, 26986645, 26333139, 14267664 },
+            { 56041645, 11871230, 27385719, 22994888, 62522949,
+              22365119, 10004785, 24844944, 45347639, 8930323 },
+            { 45911060, 17158396, 25654215, 31829035, 12282011,
+              11008919, 1541940, 4757911, 40617363, 17145491 }
+        },
+        {
+            { 13537262, 25794942, 46504023, 10961926, 61186044,
+              20336366, 53952279, 6217253, 51165165, 13814989 },
+            { 49686272, 15157789, 18705543, 29619, 24409717,
+              33293956, 27361680, 9257833, 65152338, 31777517 },
+            { 42063564, 23362465, 15366584, 15166509, 54003778,
+              8423555, 37937324, 12361134, 48422886, 4578289 }
+        },
+        {
+            { 24579768, 3711570, 1342322, 22374306, 40103728,
+              14124955, 44564335, 14074918, 21964432, 8235257 },
+            { 60580251, 31142934, 9442965, 27628844, 12025639,
+              32067012, 64127349, 31885225, 13006805, 2355433 },
+            { 50803946, 19949172, 60476436, 28412082, 16974358,
+              22643349, 27202043, 1719366, 1141648, 20758196 }
+        },
+        {
+            { 54244920, 20334445, 58790597, 22536340, 60298718,
+              28710537, 13475065, 30420460, 32674894, 13715045 },
+            { 11423316, 28086373, 32344215, 8962751, 24989809,
+              9241752, 53843611, 16086211, 38367983, 17912338 },
+            { 65699196, 12530727, 60740138, 10847386, 19531186,
+              19422272, 55399715, 7791793, 39862921, 4383346 }
+        },
+    },
+    {   /* 2^144 B .. 8 * 2^144 B */
+        {
+            { 33852691, 4144781, 62632835, 26975308, 10770038,
+              26398890, 60458447, 20618131, 48789665, 10212859 },
+            { 2756062, 8598110, 7383731, 26694540, 22312758,
+              32449420, 21179800, 2600940, 57120566, 21047965 },
+            { 42463153, 13317461, 36659605, 17900503, 21365573,
+              22684775, 11344423, 864440, 64609187, 16844368 }
+        },
+        {
+            { 40676061, 6148328, 49924452, 19080277, 18782928,
+              33278435, 44547329, 211299, 2719757, 4940997 },
+            { 65784982, 3911312, 60160120, 14759764, 37081714,
+              7851206, 21690126, 8518463, 26699843, 5276295 },
+            { 53958991, 27125364, 9396248, 365013, 24703301,
+              23065493, 1321585, 149635, 51656090, 7159368 }
+        },
+        {
+            { 9987761, 30149673, 17507961, 9505530, 9731535,
+              31388918, 22356008, 8312176, 22477218, 25151047 },
+            { 18155857, 17049442, 19744715, 9006923, 15154154,
+              23015456, 24256459, 28689437, 44560690, 9334108 },
+            { 2986088, 28642539, 10776627, 30080588, 10620589,
+              26471229, 45695018, 14253544, 44521715, 536905 }
+        },
+        {
+            { 4377737, 8115836, 24567078, 15495314, 11625074,
+              13064599, 7390551, 10589625, 10838060, 18134008 },
+            { 47766460, 867879, 9277171, 30335973, 52677291,
+              31567988, 19295825, 17757482, 6378259, 699185 },
+            { 7895007, 4057113, 60027092, 20476675, 49222032,
+              33231305, 66392824, 15693154, 62063800, 20180469 }
+        },
+        {
+            { 59371282, 27685029, 52542544, 26147512, 11385653,
+              13201616, 31730678, 22591592, 63190227, 23885106 },
+            { 10188286, 17783598, 59772502, 13427542, 22223443,
+              14896287, 30743455, 7116568, 45322357, 5427592 },
+            { 696102, 13206899, 27047647, 22922350, 15285304,
+              23701253, 10798489, 28975712, 19236242, 12477404 }
+        },
+        {
+            { 55879425, 11243795, 50054594, 25513566, 66320635,
+              25386464, 63211194, 11180503, 43939348, 7733643 },
+            { 17800790, 19518253, 40108434, 21787760, 23887826,
+              3149671, 23466177, 23016261, 10322026, 15313801 },
+            { 26246234, 11968874, 32263343, 28085704, 6830754,
+              20231401, 51314159, 33452449, 42659621, 10890803 }
+        },
+        {
+            { 35743198, 10271362, 54448239, 27287163, 16690206,
+              20491888, 52126651, 16484930, 25180797, 28219548 },
+            { 66522290, 10376443, 34522450, 22268075, 19801892,
+              10997610, 2276632, 9482883, 316878, 13820577 },
+            { 57226037, 29044064, 64993357, 16457135, 56008783,
+              11674995, 30756178, 26039378, 30696929, 29841583 }
+        },
+        {
+            { 32988917, 23951020, 12499365, 7910787, 56491607,
+              21622917, 59766047, 23569034, 34759346, 7392472 },
+            { 58253184, 15927860, 9866406, 29905021, 64711949,
+              16898650, 36699387, 24419436, 25112946, 30627788 },
+            { 64604801, 33117465, 25621773, 27875660, 15085041,
+              28074555, 42223985, 20028237, 5537437, 19640113 }
+        },
+    },
+    {   /* 2^160 B .. 8 * 2^160 B */
+        {
+            { 5975889, 28311244, 47649501, 23872684, 55567586,
+              14015781, 43443107, 1228318, 17544096, 22960650 },
+            { 5811932, 31839139, 3442886, 31285122, 48741515,
+              25194890, 49064820, 18144304, 61543482, 12348899 },
+            { 35709185, 11407554, 25755363, 6891399, 63851926,
+              14872273, 42259511, 8141294, 56476330, 32968952 }
+        },
+        {
+            { 54433560, 694025, 62032719, 13300343, 14015258,
+              19103038, 57410191, 22225381, 30944592, 1130208 },
+            { 8247747, 26843490, 40546482, 25845122, 52706924,
+              18905521, 4652151, 2488540, 23550156, 33283200 },
+            { 17294297, 29765994, 7026747, 15626851, 22990044,
+              113481, 2267737, 27646286, 66700045, 33416712 }
+        },
+        {
+            { 16091066, 17300506, 18599251, 7340678, 2137637,
+              32332775, 63744702, 14550935, 3260525, 26388161 },
+            { 62198760, 20221544, 18550886, 10864893, 50649539,
+              26262835, 44079994, 20349526, 54360141, 2701325 },
+            { 58534169, 16099414, 4629974, 17213908, 46322650,
+              27548999, 57090500, 9276970, 11329923, 1862132 }
+        },
+        {
+            { 14763057, 17650824, 36190593, 3689866, 3511892,
+              10313526, 45157776, 12219230, 58070901, 32614131 },
+            { 8894987, 30108338, 6150752, 3013931, 301220,
+              15693451, 35127648, 30644714, 51670695, 11595569 },
+            { 15214943, 3537601, 40870142, 19495559, 4418656,
+              18323671, 13947275, 10730794, 53619402, 29190761 }
+        },
+        {
+            { 64570558, 7682792, 32759013, 263109, 37124133,
+              25598979, 44776739, 23365796, 977107, 699994 },
+            { 54642373, 4195083, 57897332, 550903, 51543527,
+              12917919, 19118110, 33114591, 36574330, 19216518 },
+            { 31788442, 19046775, 4799988, 7372237, 8808585,
+              18806489, 9408236, 23502657, 12493931, 28145115 }
+        },
+        {
+            { 41428258, 5260743, 47873055, 27269961, 63412921,
+              16566086, 27218280, 2607121, 29375955, 6024730 },
+            { 842132, 30759739, 62345482, 24831616, 26332017,
+              21148791, 11831879, 6985184, 57168503, 2854095 },
+            { 62261602, 25585100, 2516241, 27706719, 9695690,
+              26333246, 16512644, 960770, 12121869, 16648078 }
+        },
+        {
+            { 51890212, 14667095, 53772635, 2013716, 30598287,
+              33090295, 35603941, 25672367, 20237805, 2838411 },
+            { 47820798, 4453151, 15298546, 17376044, 22115042,
+              17581828, 12544293, 20083975, 1068880, 21054527 },
+            { 57549981, 17035596, 33238497, 13506958, 30505848,
+              32439836, 58621956, 30924378, 12521377, 4845654 }
+        },
+        {
+            { 38910324, 10744107, 64150484, 10199663, 7759311,
+              20465832, 3409347, 32681032, 60626557, 20668561 },
+            { 43547042, 6230155, 46726851, 10655313, 43068279,
+              21933259, 10477733, 32314216, 63995636, 13974497 },
+            { 12966261, 15550616, 35069916, 31939085, 21025979,
+              32924988, 5642324, 7188737, 18895762, 12629579 }
+        },
+    },
+    {   /* 2^176 B .. 8 * 2^176 B */
+        {
+            { 22092954, 20363309, 65066070, 21585919, 32186752,
+              22037044, 60534522, 2470659, 39691498, 16625500 },
+            { 56051142, 3042015, 13770083, 24296510, 584235,
+              33009577, 59338006, 2602724, 39757248, 14247412 },
+            { 6314156, 23289540, 34336361, 15957556, 56951134,
+              168749, 58490057, 14290060, 27108877, 32373552 }
+        },
+        {
+            { 58522267, 26383465, 13241781, 10960156, 34117849,
+              19759835, 33547975, 22495543, 39960412, 981873 },
+            { 22833421, 9293594, 34459416, 19935764, 57971897,
+              14756818, 44180005, 19583651, 56629059, 17356469 },
+            { 59340277, 3326785, 38997067, 10783823, 19178761,
+              14905060, 22680049, 13906969, 51175174, 3797898 }
+        },
+        {
+            { 21721337, 29341686, 54902740, 9310181, 63226625,
+              19901321, 23740223, 30845200, 20491982, 25512280 },
+            { 9209251, 18419377, 53852306, 27386633, 66377847,
+              15289672, 25947805, 15286587, 30997318, 26851369 },
+            { 7392013, 16618386, 23946583, 25514540, 53843699,
+              32020573, 52911418, 31232855, 17649997, 33304352 }
+        },
+        {
+            { 57807776, 19360604, 30609525, 30504889, 41933794,
+              32270679, 51867297, 24028707, 64875610, 7662145 },
+            { 49550191, 1763593, 33994528, 15908609, 37067994,
+              21380136, 7335079, 25082233, 63934189, 3440182 },
+            { 47219164, 27577423, 42997570, 23865561, 10799742,
+              16982475, 40449, 29122597, 4862399, 1133 }
+        },
+        {
+            { 34252636, 25680474, 61686474, 14860949, 50789833,
+              7956141, 7258061, 311861, 36513873, 26175010 },
+            { 63335436, 31988495, 28985339, 7499440, 24445838,
+              9325937, 29727763, 16527196, 18278453, 15405622 },
+            { 62726958, 8508651, 47210498, 29880007, 61124410,
+              15149969, 53795266, 843522, 45233802, 13626196 }
+        },
+        {
+            { 2281448, 20067377, 56193445, 30944521, 1879357,
+              16164207, 56324982, 3953791, 13340839, 15928663 },
+            { 31727126, 26374577, 48671360, 25270779, 2875792,
+              17164102, 41838969, 26539605, 43656557, 5964752 },
+            { 4100401, 27594980, 49929526, 6017713, 48403027,
+              12227140, 40424029, 11344143, 2538215, 25983677 }
+        },
+        {
+            { 57675240, 6123112, 11159803, 31397824, 30016279,
+              14966241, 46633881, 1485420, 66479608, 17595569 },
+            { 40304287, 4260918, 11851389, 9658551, 35091757,
+              16367491, 46903439, 20363143, 11659921, 22439314 },
+            { 26180377, 10015009, 36264640, 24973138, 5418196,
+              9480663, 2231568, 23384352, 33100371, 32248261 }
+        },
+        {
+            { 15121094, 28352561, 56718958, 15427820, 39598927,
+              17561924, 21670946, 4486675, 61177054, 19088051 },
+            { 16166467, 24070699, 56004733, 6023907, 35182066,
+              32189508, 2340059, 17299464, 56373093, 23514607 },
+            { 28042865, 29997343, 54982337, 12259705, 63391366,
+              26608532, 6766452, 24864833, 18036435, 5803270 }
+        },
+    },
+    {   /* 2^192 B .. 8 * 2^192 B */
+        {
+            { 793280, 24323954, 8836301, 27318725, 39747955,
+              31184838, 33152842, 28669181, 57202663, 32932579 },
+            { 5666214, 525582, 20782575, 25516013, 42570364,
+              14657739, 16099374, 1468826, 60937436, 18367850 },
+            { 62249590, 29775088, 64191105, 26806412, 7778749,
+              11688288, 36704511, 23683193, 65549940, 23690785 }
+        },
+        {
+            { 10896313, 25834728, 824274, 472601, 47648556,
+              3009586, 25248958, 14783338, 36527388, 17796587 },
+            { 10566929, 12612572, 35164652, 11118702, 54475488,
+              12362878, 21752402, 8822496, 24003793, 14264025 },
+            { 27713843, 26198459, 56100623, 9227529, 27050101,
+              2504721, 23886875, 20436907, 13958494, 27821979 }
+        },
+        {
+            { 43627235, 4867225, 39861736, 3900520, 29838369,
+              25342141, 35219464, 23512650, 7340520, 18144364 },
+            { 4646495, 25543308, 44342840, 22021777, 23184552,
+              8566613, 31366726, 32173371, 52042079, 23179239 },
+            { 49838347, 12723031, 50115803, 14878793, 21619651,
+              27356856, 27584816, 3093888, 58265170, 3849920 }
+        },
+        {
+            { 58043933, 2103171, 25561640, 18428694, 61869039,
+              9582957, 32477045, 24536477, 5002293, 18004173 },
+            { 55051311, 22376525, 21115584, 20189277, 8808711,
+              21523724, 16489529, 13378448, 41263148, 12741425 },
+            { 61162478, 10645102, 36197278, 15390283, 63821882,
+              26435754, 24306471, 15852464, 28834118, 25908360 }
+        },
+        {
+            { 49773116, 24447374, 42577584, 9434952, 58636780,
+              32971069, 54018092, 455840, 20461858, 5491305 },
+            { 13669229, 17458950, 54626889, 23351392, 52539093,
+              21661233, 42112877, 11293806, 38520660, 24132599 },
+            { 28497909, 6272777, 34085870, 14470569, 8906179,
+              32328802, 18504673, 19389266, 29867744, 24758489 }
+        },
+        {
+            { 50901822, 13517195, 39309234, 19856633, 24009063,
+              27180541, 60741263, 20379039, 22853428, 29542421 },
+            { 24191359, 16712145, 53177067, 15217830, 14542237,
+              1646131, 18603514, 22516545, 12876622, 31441985 },
+            { 17902668, 4518229, 66697162, 30725184, 26878216,
+              5258055, 54248111, 608396, 16031844, 3723494 }
+        },
+        {
+            { 38476072, 12763727, 46662418, 7577503, 33001348,
+              20536687, 17558841, 25681542, 23896953, 29240187 },
+            { 47103464, 21542479, 31520463, 605201, 2543521,
+              5991821, 64163800, 7229063, 57189218, 24727572 },
+            { 28816026, 298879, 38943848, 17633493, 19000927,
+              31888542, 54428030, 30605106, 49057085, 31471516 }
+        },
+        {
+            { 16000882, 33209536, 3493091, 22107234, 37604268,
+              20394642, 12577739, 16041268, 47393624, 7847706 },
+            { 10151868, 10572098, 27312476, 7922682, 14825339,
+              4723128, 34252933, 27035413, 57088296, 3852847 },
+            { 55678375, 15697595, 45987307, 29133784, 5386313,
+              15063598, 16514493, 17622322, 29330898, 18478208 }
+        },
+    },
+    {   /* 2^208 B .. 8 * 2^208 B */
+        {
+            { 60209940, 9824393, 54804085, 29153342, 35711722,
+              27277596, 32574488, 12532905, 59605792, 24879084 },
+            { 39765323, 17038963, 39957339, 22831480, 946345,
+              16291093, 254968, 7168080, 21676107, 31611404 },
+            { 21260942, 25129680, 50276977, 21633609, 43430902,
+              3968120, 63456915, 27338965, 63552672, 25641356 }
+        },
+        {
+            { 16544735, 13250366, 50304436, 15546241, 62525861,
+              12757257, 64646556, 24874095, 48201831, 23891632 },
+            { 64693606, 17976703, 18312302, 4964443, 51836334,
+              20900867, 26820650, 16690659, 25459437, 28989823 },
+            { 41964155, 11425019, 28423002, 22533875, 60963942,
+              17728207, 9142794, 31162830, 60676445, 31909614 }
+        },
+        {
+            { 44004212, 6253475, 16964147, 29785560, 41994891,
+              21257994, 39651638, 17209773, 6335691, 7249989 },
+            { 36775618, 13979674, 7503222, 21186118, 55152142,
+              28932738, 36836594, 2682241, 25993170, 21075909 },
+            { 4364628, 5930691, 32304656, 23509878, 59054082,
+              15091130, 22857016, 22955477, 31820367, 15075278 }
+        },
+        {
+            { 31879134, 24635739, 17258760, 90626, 59067028,
+              28636722, 24162787, 23903546, 49138625, 12833044 },
+            { 19073683, 14851414, 42705695, 21694263, 7625277,
+              11091125, 47489674, 2074448, 57694925, 14905376 },
+            { 24483648, 21618865, 64589997, 22007013, 65555733,
+              15355505, 41826784, 9253128, 27628530, 25998952 }
+        },
+        {
+            { 17597607, 8340603, 19355617, 552187, 26198470,
+              30377849, 4593323, 24396850, 52997988, 15297015 },
+            { 510886, 14337390, 35323607, 16638631, 6328095,
+              2713355, 46891447, 21690211, 8683220, 2921426 },
+            { 18606791, 11874196, 27155355, 28272950, 43077121,
+              6265445, 41930624, 32275507, 4674689, 13890525 }
+        },
+        {
+            { 13609624, 13069022, 39736503, 20498523, 24360585,
+              9592974, 14977157, 9835105, 4389687, 288396 },
+            { 9922506, 33035038, 13613106, 5883594, 48350519,
+              33120168, 54804801, 8317627, 23388070, 16052080 },
+            { 12719997, 11937594, 35138804, 28525742, 26900119,
+              8561328, 46953177, 21921452, 52354592, 22741539 }
+        },
+        {
+            { 15961858, 14150409, 26716931, 32888600, 44314535,
+              13603568, 11829573, 7467844, 38286736, 929274 },
+            { 11038231, 21972036, 39798381, 26237869, 56610336,
+              17246600, 43629330, 24182562, 45715720, 2465073 },
+            { 20017144, 29231206, 27915241, 1529148, 12396362,
+              15675764, 13817261, 23896366, 2463390, 28932292 }
+        },
+        {
+            { 50749986, 20890520, 55043680, 4996453, 65852442,
+              1073571, 9583558, 12851107, 4003896, 12673717 },
+            { 65377275, 18398561, 63845933, 16143081, 19294135,
+              13385325, 14741514, 24450706, 7903885, 2348101 },
+            { 24536016, 17039225, 12715591, 29692277, 1511292,
+              10047386, 63266518, 26425272, 38731325, 10048126 }
+        },
+    },
+    {   /* 2^224 B .. 8 * 2^224 B */
+        {
+            { 20678527, 25178694, 34436965, 8849122, 62099106,
+              14574751, 31186971, 29580702, 9014761, 24975376 },
+            { 53464795, 23204192, 51146355, 5075807, 65594203,
+              22019831, 34006363, 9160279, 8473550, 30297594 },
+            { 24900749, 14435722, 17209120, 18261891, 44516588,
+              9878982, 59419555, 17218610, 42540382, 11788947 }
+        },
+        {
+            { 63990690, 22159237, 53306774, 14797440, 9652448,
+              26708528, 47071426, 10410732, 42540394, 32095740 },
+            { 51449703, 16736705, 44641714, 10215877, 58011687,
+              7563910, 11871841, 21049238, 48595538, 8464117 },
+            { 43708233, 8348506, 52522913, 32692717, 63158658,
+              27181012, 14325288, 8628612, 33313881, 25183915 }
+        },
+        {
+            { 46921872, 28586496, 22367355, 5271547, 66011747,
+              28765593, 42303196, 23317577, 58168128, 27736162 },
+            { 60160060, 31759219, 34483180, 17533252, 32635413,
+              26180187, 15989196, 20716244, 28358191, 29300528 },
+            { 43547083, 30755372, 34757181, 31892468, 57961144,
+              10429266, 50471180, 4072015, 61757200, 5596588 }
+        },
+        {
+            { 38872266, 30164383, 12312895, 6213178, 3117142,
+              16078565, 29266239, 2557221, 1768301, 15373193 },
+            { 59865506, 30307471, 62515396, 26001078, 66980936,
+              32642186, 66017961, 29049440, 42448372, 3442909 },
+            { 36898293, 5124042, 14181784, 8197961, 18964734,
+              21615339, 22597930, 7176455, 48523386, 13365929 }
+        },
+        {
+            { 59231455, 32054473, 8324672, 4690079, 6261860,
+              890446, 24538107, 24984246, 57419264, 30522764 },
+            { 25008885, 22782833, 62803832, 23916421, 16265035,
+              15721635, 683793, 21730648, 15723478, 18390951 },
+            { 57448220, 12374378, 40101865, 26528283, 59384749,
+              21239917, 11879681, 5400171, 519526, 32318556 }
+        },
+        {
+            { 22258397, 17222199, 59239046, 14613015, 44588609,
+              30603508, 46754982, 7315966, 16648397, 7605640 },
+            { 59027556, 25089834, 58885552, 9719709, 19259459,
+              18206220, 23994941, 28272877, 57640015, 4763277 },
+            { 45409620, 9220968, 51378240, 1084136, 41632757,
+              30702041, 31088446, 25789909, 55752334, 728111 }
+        },
+        {
+            { 26047201, 21802961, 60208540, 17032633, 24092067,
+              9158119, 62835319, 20998873, 37743427, 28056159 },
+            { 17510331, 33231575, 5854288, 8403524, 17133918,
+              30441820, 38997856, 12327944, 10750447, 10014012 },
+            { 56796096, 3936951, 9156313, 24656749, 16498691,
+              32559785, 39627812, 32887699, 3424690, 7540221 }
+        },
+        {
+            { 30322361, 26590322, 11361004, 29411115, 7433303,
+              4989748, 60037442, 17237212, 57864598, 15258045 },
+            { 13054543, 30774935, 19155473, 469045, 54626067,
+              4566041, 5631406, 2711395, 1062915, 28418087 },
+            { 47868616, 22299832, 37599834, 26054466, 61273100,
+              13005410, 61042375, 12194496, 32960380, 1459310 }
+        },
+    },
+    {   /* 2^240 B .. 8 * 2^240 B */
+        {
+            { 41091971, 33334488, 21339190, 33513044, 19745255,
+              30675732, 37471583, 2227039, 21612326, 33008704 },
+            { 54031477, 1184227, 23562814, 27583990, 46757619,
+              27205717, 25764460, 12243797, 46252298, 11649657 },
+            { 57077370, 11262625, 27384172, 2271902, 26947504,
+              17556661, 39943, 6114064, 33514190, 2333242 }
+        },
+        {
+            { 45675257, 21132610, 8119781, 7219913, 45278342,
+              24538297, 60429113, 20883793, 24350577, 20104431 },
+            { 62992557, 22282898, 43222677, 4843614, 37020525,
+              690622, 35572776, 23147595, 8317859, 12352766 },
+            { 18200138, 19078521, 34021104, 30857812, 43406342,
+              24451920, 43556767, 31266881, 20712162, 6719373 }
+        },
+        {
+            { 26656189, 6075253, 59250308, 1886071, 38764821,
+              4262325, 11117530, 29791222, 26224234, 30256974 },
+            { 49939907, 18700334, 63713187, 17184554, 47154818,
+              14050419, 21728352, 9493610, 18620611, 17125804 },
+            { 53785524, 13325348, 11432106, 5964811, 18609221,
+              6062965, 61839393, 23828875, 36407290, 17074774 }
+        },
+        {
+            { 43248326, 22321272, 26961356, 1640861, 34695752,
+              16816491, 12248508, 28313793, 13735341, 1934062 },
+            { 25089769, 6742589, 17081145, 20148166, 21909292,
+              17486451, 51972569, 29789085, 45830866, 5473615 },
+            { 31883658, 25593331, 1083431, 21982029, 22828470,
+              13290673, 59983779, 12469655, 29111212, 28103418 }
+        },
+        {
+            { 24244947, 18504025, 40845887, 2791539, 52111265,
+              16666677, 24367466, 6388839, 56813277, 452382 },
+            { 41468082, 30136590, 5217915, 16224624, 19987036,
+              29472163, 42872612, 27639183, 15766061, 8407814 },
+            { 46701865, 13990230, 15495425, 16395525, 5377168,
+              15166495, 58191841, 29165478, 59040954, 2276717 }
+        },
+        {
+            { 30157899, 12924066, 49396814, 9245752, 19895028,
+              3368142, 43281277, 5096218, 22740376, 26251015 },
+            { 2041139, 19298082, 7783686, 13876377, 41161879,
+              20201972, 24051123, 13742383, 51471265, 13295221 },
+            { 33338218, 25048699, 12532112, 7977527, 9106186,
+              31839181, 49388668, 28941459, 62657506, 18884987 }
+        },
+        {
+            { 47063583, 5454096, 52762316, 6447145, 28862071,
+              1883651, 64639598, 29412551, 7770568, 9620597 },
+            { 23208049, 7979712, 33071466, 8149229, 1758231,
+              22719437, 30945527, 31860109, 33606523, 18786461 },
+            { 1439939, 17283952, 66028874, 32760649, 4625401,
+              10647766, 62065063, 1220117, 30494170, 22113633 }
+        },
+        {
+            { 62071265, 20526136, 64138304, 30492664, 15640973,
+              26852766, 40369837, 926049, 65424525, 20220784 },
+            { 13908495, 30005160, 30919927, 27280607, 45587000,
+              7989038, 9021034, 9078865, 3353509, 4033511 },
+            { 37445433, 18440821, 32259990, 33209950, 24295848,
+              20642309, 23161162, 8839127, 27485041, 7356032 }
+        },
+    },
+};
+
+/* r = p + q for an affine q ("madd-2008-hwcd-3" from [3]) */
+static void ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q)
+{
+    fe t0;
+
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->yplusx);
+    fe_mul(r->Y, r->Y, q->yminusx);
+    fe_mul(r->T, q->xy2d, p->T);
+    fe_add(t0, p->Z, p->Z);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_add(r->Z, t0, r->T);
+    fe_sub(r->T, t0, r->T);
+}
+
+static void ge_precomp_cmov(ge_precomp *t, const ge_precomp *u,
+                            mbedtls_ct_condition_t cond)
+{
+    fe_cmov(t->yplusx, u->yplusx, cond);
+    fe_cmov(t->yminusx, u->yminusx, cond);
+    fe_cmov(t->xy2d, u->xy2d, cond);
+}
+
+static void ge_select_base(ge_precomp *t, const ge_precomp row[8],
+                           signed char b)
+{
+    ge_precomp minus;
+    mbedtls_ct_uint_t negative = (unsigned char) b >> 7;
+    mbedtls_ct_uint_t abs = (unsigned char) (b - ((-(int) negative & b) * 2));
+    mbedtls_ct_uint_t j;
+
+    fe_1(t->yplusx);
+    fe_1(t->yminusx);
+    fe_0(t->xy2d);
+    for (j = 0; j < 8; j++) {
+        ge_precomp_cmov(t, &row[j], mbedtls_ct_uint_eq(abs, j + 1));
+    }
+    fe_copy(minus.yplusx, t->yminusx);
+    fe_copy(minus.yminusx, t->yplusx);
+    fe_neg(minus.xy2d, t->xy2d);
+    ge_precomp_cmov(t, &minus, mbedtls_ct_bool(negative));
+}
+
+/* h = a * B, where a[31] <= 127 */
+static void ge_scalarmult_base(ge_p3 *h, const unsigned char a[32])
+{
+    ge_precomp t;
+    ge_p1p1 r;
+    signed char e[64];
+    int k, m;
+
+    sc_recode_signed4(e, a);
+
+    ge_p3_0(h);
+    for (m = 3; m >= 0; m--) {
+        if (m != 3) {
+            ge_p3_mul16(h);
+        }
+        for (k = 0; k < 16; k++) {
+            ge_select_base(&t, ed25519_base_table[k], e[4 * k + m]);
+            ge_madd(&r, h, &t);
+            ge_p1p1_to_p3(h, &r);
+        }
+    }
+
+    mbedtls_platform_zeroize(e, sizeof(e));
+    mbedtls_platform_zeroize(&t, sizeof(t));
+}
+
+/*
+ * Variable-time multi-scalar multiplication (Straus' method)
+ *
+ * Each scalar is recoded in sliding windows of odd digits in [-15, 15],
+ * so that about one digit in six is non-zero, and all points share the
+ * same doublings.
+ */
+#define ED25519_SLIDE_DIGITS 256
+
+static void sc_slide(signed char r[ED25519_SLIDE_DIGITS],
+                     const unsigned char a[32])
+{
+    int i, b, k;
+
+    for (i = 0; i < ED25519_SLIDE_DIGITS; i++) {
+        r[i] = (signed char) (1 & (a[i >> 3] >> (i & 7)));
+    }
+
+    for (i = 0; i < ED25519_SLIDE_DIGITS; i++) {
+        if (r[i] == 0) {
+            continue;
+        }
+        for (b = 1; b <= 6 && i + b < ED25519_SLIDE_DIGITS; b++) {
+            if (r[i + b] == 0) {
+                continue;
+            }
+            if (r[i] + (r[i + b] << b) <= 15) {
+                r[i] = (signed char) (r[i] + (r[i + b] << b));
+                r[i + b] = 0;
+            } else if (r[i] - (r[i + b] << b) >= -15) {
+                r[i] = (signed char) (r[i] - (r[i + b] << b));
+                for (k = i + b; k < ED25519_SLIDE_DIGITS; k++) {
+                    if (r[k] == 0) {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+/* table[i] = (2 * i + 1) * p for i = 0..7 */
+static void ge_precompute_odd(ge_cached table[8], const ge_p3 *p)
+{
+    ge_p1p1 t;
+    ge_p3 p2, u;
+    int i;
+
+    ge_p3_to_cached(&table[0], p);
+    ge_p3_dbl(&t, p);
+    ge_p1p1_to_p3(&p2, &t);
+    for (i = 1; i < 8; i++) {
+        ge_add(&t, &p2, &table[i - 1]);
+        ge_p1p1_to_p3(&u, &t);
+        ge_p3_to_cached(&table[i], &u);
+    }
+}
+
+/* h = sum of slides[j] * points[j] for j = 0..n-1, where tables[8 * j ...]
+ * has been filled by ge_precompute_odd() for points[j] */
+static void ge_multi_scalarmult_vartime(ge_p3 *h, const ge_cached *tables,
+                                        const signed char *slides, size_t n)
+{
+    ge_p1p1 t;
+    ge_p2 r;
+    ge_p3 u;
+    signed char d;
+    size_t j;
+    int i;
+
+    for (i = ED25519_SLIDE_DIGITS - 1; i >= 0; i--) {
+        for (j = 0; j < n; j++) {
+            if (slides[j * ED25519_SLIDE_DIGITS + i] != 0) {
+                break;
+            }
+        }
+        if (j < n) {
+            break;
+        }
+    }
+
+    ge_p3_0(h);
+    ge_p2_0(&r);
+    for (; i >= 0; i--) {
+        ge_p2_dbl(&t, &r);
+        for (j = 0; j < n; j++) {
+            d = slides[j * ED25519_SLIDE_DIGITS + i];
+            if (d > 0) {
+                ge_p1p1_to_p3(&u, &t);
+                ge_add(&t, &u, &tables[8 * j + d / 2]);
+            } else if (d < 0) {
+                ge_p1p1_to_p3(&u, &t);
+                ge_sub(&t, &u, &tables[8 * j + (-d) / 2]);
+            }
+        }
+        if (i > 0) {
+            ge_p1p1_to_p2(&r, &t);
+        } else {
+            ge_p1p1_to_p3(h, &t);
+        }
+    }
+}
+
+/*
+ * Arithmetic modulo the group order L = 2^252 + 27742317777372353535851937790883648493
+ *
+ * Scalars are 32-byte little-endian strings. Computations use the
+ * constant-time Montgomery multiplication of the bignum core with
+ * R = 2^256, whatever the size of a limb.
+ */
+#define ED25519_SC_LIMBS (32 / sizeof(mbedtls_mpi_uint))
+
+static const unsigned char ed25519_order[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+/* R^2 mod L */
+static const unsigned char ed25519_order_rr[32] = {
+    0x01, 0x0f, 0x9c, 0x44, 0xe3, 0x11, 0x06, 0xa4,
+    0x47, 0x93, 0x85, 0x68, 0xa7, 0x1b, 0x0e, 0xd0,
+    0x65, 0xbe, 0xf5, 0x17, 0xd2, 0x73, 0xec, 0xce,
+    0x3d, 0x9a, 0x30, 0x7c, 0x1b, 0x41, 0x99, 0x03,
+};
+
+/* 2^252 * R mod L */
+static const unsigned char ed25519_order_k252[32] = {
+    0xa3, 0xc2, 0x32, 0x54, 0x40, 0x05, 0xcd, 0xd6,
+    0x07, 0x95, 0x92, 0x86, 0x83, 0x2d, 0x5a, 0x6b,
+    0xe6, 0x5b, 0x7f, 0x21, 0x3d, 0xc7, 0xee, 0xdc,
+    0xa3, 0x09, 0xc3, 0xb7, 0x11, 0x94, 0x39, 0x0b,
+};
+
+/* 2^504 * R mod L */
+static const unsigned char ed25519_order_k504[32] = {
+    0x55, 0x85, 0x8f, 0xfb, 0xf6, 0x69, 0xc4, 0xda,
+    0x44, 0x26, 0x99, 0xa4, 0x8b, 0x49, 0x31, 0x67,
+    0x5b, 0xec, 0x04, 0x6c, 0xdc, 0x65, 0x80, 0xc7,
+    0xce, 0x99, 0x35, 0x77, 0x0b, 0x53, 0x9e, 0x01,
+};
+
+typedef struct {
+    mbedtls_mpi_uint N[ED25519_SC_LIMBS];
+    mbedtls_mpi_uint mm;
+    mbedtls_mpi_uint A[ED25519_SC_LIMBS];
+    mbedtls_mpi_uint B[ED25519_SC_LIMBS];
+    mbedtls_mpi_uint C[ED25519_SC_LIMBS];
+    mbedtls_mpi_uint T[2 * ED25519_SC_LIMBS + 1];
+} ed25519_sc_work;
+
+static void sc_load(mbedtls_mpi_uint X[ED25519_SC_LIMBS],
+                    const unsigned char s[32])
+{
+    (void) mbedtls_mpi_core_read_le(X, ED25519_SC_LIMBS, s, 32);
+}
+
+static void sc_setup(ed25519_sc_work *w)
+{
+    sc_load(w->N, ed25519_order);
+    w->mm = mbedtls_mpi_core_montmul_init(w->N);
+}
+
+static void sc_finish(ed25519_sc_work *w, unsigned char out[32],
+                      const mbedtls_mpi_uint X[ED25519_SC_LIMBS])
+{
+    (void) mbedtls_mpi_core_write_le(X, ED25519_SC_LIMBS, out, 32);
+    mbedtls_platform_zeroize(w, sizeof(*w));
+}
+
+/* X = X + Y mod L, where X, Y < L */
+static void sc_add_limbs(const ed25519_sc_work *w, mbedtls_mpi_uint *X,
+                         const mbedtls_mpi_uint *Y)
+{
+    mbedtls_mpi_uint borrow;
+
+    (void) mbedtls_mpi_core_add(X, X, Y, ED25519_SC_LIMBS);
+    borrow = mbedtls_mpi_core_sub(X, X, w->N, ED25519_SC_LIMBS);
+    (void) mbedtls_mpi_core_add_if(X, w->N, ED25519_SC_LIMBS, (unsigned) borrow);
+}
+
+/* X = A * K * R^-1 mod L, where A, K < L */
+static void sc_montmul(ed25519_sc_work *w, mbedtls_mpi_uint *X,
+                       const mbedtls_mpi_uint *A, const unsigned char k[32])
+{
+    sc_load(w->C, k);
+    mbedtls_mpi_core_montmul(X, A, w->C, ED25519_SC_LIMBS, w->N,
+                             ED25519_SC_LIMBS, w->mm, w->T);
+}
+
+/* out = in mod L for a 64-byte input: split it into 252-bit chunks, which
+ * are all smaller than L, and fold the upper ones with precomputed powers
+ * of 2. */
+static void sc_reduce(unsigned char out[32], const unsigned char in[64])
+{
+    ed25519_sc_work w;
+    unsigned char chunk[32];
+    size_t i;
+
+    sc_setup(&w);
+
+    memcpy(chunk, in, 32);
+    chunk[31] &= 0x0f;
+    sc_load(w.A, chunk);
+
+    for (i = 0; i < 31; i++) {
+        chunk[i] = (unsigned char) ((in[31 + i] >> 4) | (in[32 + i] << 4));
+    }
+    chunk[31] = in[62] >> 4;
+    sc_load(w.B, chunk);
+    sc_montmul(&w, w.B, w.B, ed25519_order_k252);
+    sc_add_limbs(&w, w.A, w.B);
+
+    memset(chunk, 0, sizeof(chunk));
+    chunk[0] = in[63];
+    sc_load(w.B, chunk);
+    sc_montmul(&w, w.B, w.B, ed25519_order_k504);
+    sc_add_limbs(&w, w.A, w.B);
+
+    mbedtls_platform_zeroize(chunk, sizeof(chunk));
+    sc_finish(&w, out, w.A);
+}
+
+/* out = a * b + c mod L, where a, b, c < L. c may be NULL for 0. */
+static void sc_muladd(unsigned char out[32], const unsigned char a[32],
+                      const unsigned char b[32], const unsigned char c[32])
+{
+    ed25519_sc_work w;
+
+    sc_setup(&w);
+    sc_load(w.A, a);
+    sc_montmul(&w, w.A, w.A, ed25519_order_rr);
+    sc_montmul(&w, w.A, w.A, b);
+    if (c != NULL) {
+        sc_load(w.B, c);
+        sc_add_limbs(&w, w.A, w.B);
+    }
+    sc_finish(&w, out, w.A);
+}
+
+/* Return whether s < L. This is only used on public data. */
+static int sc_is_canonical(const unsigned char s[32])
+{
+    int i;
+    for (i = 31; i >= 0; i--) {
+        if (s[i] != ed25519_order[i]) {
+            return s[i] < ed25519_order[i];
+        }
+    }
+    return 0;
+}
+
+/*
+ * EdDSA
+ */
+
+/* out = SHA-512(a || b || msg) */
+static int ed25519_hash(unsigned char out[64],
+                        const unsigned char *a, size_t a_len,
+                        const unsigned char *b, size_t b_len,
+                        const unsigned char *msg, size_t msg_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_sha512_context sha;
+
+    mbedtls_sha512_init(&sha);
+    if ((ret = mbedtls_sha512_starts(&sha, 0)) != 0 ||
+        (ret = mbedtls_sha512_update(&sha, a, a_len)) != 0) {
+        goto cleanup;
+    }
+    if (b_len != 0 && (ret = mbedtls_sha512_update(&sha, b, b_len)) != 0) {
+        goto cleanup;
+    }
+    if (msg_len != 0 && (ret = mbedtls_sha512_update(&sha, msg, msg_len)) != 0) {
+        goto cleanup;
+    }
+    ret = mbedtls_sha512_finish(&sha, out);
+
+cleanup:
+    mbedtls_sha512_free(&sha);
+    return ret;
+}
+
+/* k = SHA-512(R || A || M) mod L */
+static int ed25519_challenge(unsigned char k[32], const unsigned char R[32],
+                             const unsigned char pub[32],
+                             const unsigned char *msg, size_t msg_len)
+{
+    int ret;
+    unsigned char h[64];
+
+    ret = ed25519_hash(h, R, 32, pub, 32, msg, msg_len);
+    if (ret == 0) {
+        sc_reduce(k, h);
+    }
+    return ret;
+}
+
+void mbedtls_ed25519_init(mbedtls_ed25519_context *ctx)
+{
+    memset(ctx, 0, sizeof(mbedtls_ed25519_context));
+}
+
+void mbedtls_ed25519_free(mbedtls_ed25519_context *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    mbedtls_platform_zeroize(ctx, sizeof(mbedtls_ed25519_context));
+}
+
+int mbedtls_ed25519_set_private_key(mbedtls_ed25519_context *ctx,
+                                    const unsigned char *key,
+                                    size_t key_len)
+{
+    int ret;
+    unsigned char h[64];
+
+    if (key_len != MBEDTLS_ED25519_KEY_SIZE) {
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+
+    mbedtls_ed25519_free(ctx);
+
+    ret = ed25519_hash(h, key, key_len, NULL, 0, NULL, 0);
+    if (ret != 0) {
+        return ret;
+    }
+
+    memcpy(ctx->seed, key, key_len);
+    memcpy(ctx->prefix, h + 32, 32);
+
+    /* Prune the first half of the hash into the secret scalar
+     * ([1] §5.1.5). Multiples of the base point only depend on the scalar
+     * modulo L, so keep it reduced for signing. */
+    h[0] &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
+    memset(h + 32, 0, 32);
+    sc_reduce(ctx->scalar, h);
+    mbedtls_platform_zeroize(h, sizeof(h));
+
+    ge_scalarmult_base(&ctx->A, ctx->scalar);
+    ge_tobytes(ctx->pub, &ctx->A);
+
+    ctx->has_pub = 1;
+    ctx->has_priv = 1;
+    return 0;
+}
+
+int mbedtls_ed25519_genkey(mbedtls_ed25519_context *ctx,
+                           int (*f_rng)(void *, unsigned char *, size_t),
+                           void *p_rng)
+{
+    int ret;
+    unsigned char seed[MBEDTLS_ED25519_KEY_SIZE];
+
+    if (f_rng == NULL) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    ret = f_rng(p_rng, seed, sizeof(seed));
+    if (ret == 0) {
+        ret = mbedtls_ed25519_set_private_key(ctx, seed, sizeof(seed));
+    }
+
+    mbedtls_platform_zeroize(seed, sizeof(seed));
+    return ret;
+}
+
+int mbedtls_ed25519_set_public_key(mbedtls_ed25519_context *ctx,
+                                   const unsigned char *key,
+                                   size_t key_len)
+{
+    mbedtls_ed25519_free(ctx);
+
+    if (key_len != MBEDTLS_ED25519_KEY_SIZE ||
+        ge_frombytes(&ctx->A, key) != 0) {
+        mbedtls_ed25519_free(ctx);
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    }
+
+    memcpy(ctx->pub, key, key_len);
+    ctx->has_pub = 1;
+    return 0;
+}
+
+int mbedtls_ed25519_write_public_key(const mbedtls_ed25519_context *ctx,
+                                     unsigned char *buf, size_t buf_size,
+                                     size_t *olen)
+{
+    if (!ctx->has_pub) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    if (buf_size < MBEDTLS_ED25519_KEY_SIZE) {
+        return MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(buf, ctx->pub, MBEDTLS_ED25519_KEY_SIZE);
+    *olen = MBEDTLS_ED25519_KEY_SIZE;
+    return 0;
+}
+
+int mbedtls_ed25519_write_private_key(const mbedtls_ed25519_context *ctx,
+                                      unsigned char *buf, size_t buf_size,
+                                      size_t *olen)
+{
+    if (!ctx->has_priv) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    if (buf_size < MBEDTLS_ED25519_KEY_SIZE) {
+        return MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(buf, ctx->seed, MBEDTLS_ED25519_KEY_SIZE);
+    *olen = MBEDTLS_ED25519_KEY_SIZE;
+    return 0;
+}
+
+int mbedtls_ed25519_check_pub_priv(const mbedtls_ed25519_context *pub,
+                                   const mbedtls_ed25519_context *prv)
+{
+    if (!pub->has_pub || !prv->has_priv ||
+        memcmp(pub->pub, prv->pub, MBEDTLS_ED25519_KEY_SIZE) != 0) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    return 0;
+}
+
+int mbedtls_ed25519_sign(const mbedtls_ed25519_context *ctx,
+                         const unsigned char *msg, size_t msg_len,
+                         unsigned char *sig, size_t sig_size,
+                         size_t *sig_len)
+{
+    int ret;
+    unsigned char h[64], r[32], k[32];
+    ge_p3 R;
+
+    if (!ctx->has_priv) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    if (sig_size < MBEDTLS_ED25519_SIGNATURE_SIZE) {
+        return MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL;
+    }
+
+    /* r = SHA-512(prefix || M) mod L, R = r * B */
+    ret = ed25519_hash(h, ctx->prefix, 32, NULL, 0, msg, msg_len);
+    if (ret != 0) {
+        goto cleanup;
+    }
+    sc_reduce(r, h);
+    ge_scalarmult_base(&R, r);
+    ge_tobytes(sig, &R);
+
+    /* S = r + SHA-512(R || A || M) * s mod L */
+    ret = ed25519_challenge(k, sig, ctx->pub, msg, msg_len);
+    if (ret != 0) {
+        goto cleanup;
+    }
+    sc_muladd(sig + 32, k, ctx->scalar, r);
+    *sig_len = MBEDTLS_ED25519_SIGNATURE_SIZE;
+
+cleanup:
+    mbedtls_platform_zeroize(h, sizeof(h));
+    mbedtls_platform_zeroize(r, sizeof(r));
+    mbedtls_platform_zeroize(&R, sizeof(R));
+    if (ret != 0) {
+        mbedtls_platform_zeroize(sig, MBEDTLS_ED25519_SIGNATURE_SIZE);
+    }
+    return ret;
+}
+
+/* Check the format of a signature and decode R. */
+static int ed25519_parse_signature(ge_p3 *R, const unsigned char *sig,
+                                   size_t sig_len)
+{
+    if (sig_len != MBEDTLS_ED25519_SIGNATURE_SIZE) {
+        return MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH;
+    }
+    if (!sc_is_canonical(sig + 32) || ge_frombytes(R, sig) != 0) {
+        return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+    return 0;
+}
+
+int mbedtls_ed25519_verify(const mbedtls_ed25519_context *ctx,
+                           const unsigned char *msg, size_t msg_len,
+                           const unsigned char *sig, size_t sig_len)
+{
+    int ret;
+    unsigned char k[32];
+    ge_cached tables[2 * 8], rc;
+    signed char slides[2 * ED25519_SLIDE_DIGITS];
+    ge_p3 B, negA, R, P;
+    ge_p1p1 t;
+
+    if (!ctx->has_pub) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    ret = ed25519_parse_signature(&R, sig, sig_len);
+    if (ret != 0) {
+        return ret;
+    }
+    ret = ed25519_challenge(k, sig, ctx->pub, msg, msg_len);
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* Check that 8 * (S * B - k * A - R) is the neutral element */
+    ge_base(&B);
+    ge_precompute_odd(&tables[0], &B);
+    sc_slide(&slides[0], sig + 32);
+    ge_p3_neg(&negA, &ctx->A);
+    ge_precompute_odd(&tables[8], &negA);
+    sc_slide(&slides[ED25519_SLIDE_DIGITS], k);
+    ge_multi_scalarmult_vartime(&P, tables, slides, 2);
+
+    ge_p3_to_cached(&rc, &R);
+    ge_sub(&t, &P, &rc);
+    ge_p1p1_to_p3(&P, &t);
+
+    return ge_mul8_is_neutral(&P) ? 0 : MBEDTLS_ERR_ECP_VERIFY_FAILED;
+}
+
+/* Number of signatures combined in one multi-scalar multiplication. Each
+ * signature adds two points, whose tables and digits take 3 KiB. */
+#define ED25519_BATCH_CHUNK 16
+
+/* Verify entries[0..n-1], with n <= ED25519_BATCH_CHUNK, by checking that
+ * 8 * ((sum z_i S_i) B - sum z_i R_i - sum (z_i k_i) A_i) is the neutral
+ * element, for random 128-bit z_i. */
+static int ed25519_verify_chunk(const mbedtls_ed25519_batch_entry *entries,
+                                size_t n, ge_cached *tables,
+                                signed char *slides,
+                                int (*f_rng)(void *, unsigned char *, size_t),
+                                void *p_rng)
+{
+    int ret;
+    unsigned char k[32], z[32], sum[32];
+    ge_p3 P;
+    size_t i;
+
+    memset(sum, 0, sizeof(sum));
+    memset(z, 0, sizeof(z));
+
+    for (i = 0; i < n; i++) {
+        const mbedtls_ed25519_batch_entry *e = &entries[i];
+
+        if (!e->ctx->has_pub) {
+            return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+        }
+        ret = ed25519_parse_signature(&P, e->sig, e->sig_len);
+        if (ret != 0) {
+            return ret;
+        }
+        ret = ed25519_challenge(k, e->sig, e->ctx->pub, e->msg, e->msg_len);
+        if (ret != 0) {
+            return ret;
+        }
+        ret = f_rng(p_rng, z, 16);
+        if (ret != 0) {
+            return ret;
+        }
+
+        /* -z_i R_i */
+        ge_p3_neg(&P, &P);
+        ge_precompute_odd(&tables[8 * (1 + i)], &P);
+        sc_slide(&slides[ED25519_SLIDE_DIGITS * (1 + i)], z);
+
+        /* -(z_i k_i) A_i */
+        ge_p3_neg(&P, &e->ctx->A);
+        ge_precompute_odd(&tables[8 * (1 + n + i)], &P);
+        sc_muladd(k, z, k, NULL);
+        sc_slide(&slides[ED25519_SLIDE_DIGITS * (1 + n + i)], k);
+
+        /* (sum z_i S_i) B */
+        sc_muladd(sum, z, e->sig + 32, sum);
+    }
+
+    ge_base(&P);
+    ge_precompute_odd(&tables[0], &P);
+    sc_slide(&slides[0], sum);
+
+    ge_multi_scalarmult_vartime(&P, tables, slides, 2 * n + 1);
+
+    return ge_mul8_is_neutral(&P) ? 0 : MBEDTLS_ERR_ECP_VERIFY_FAILED;
+}
+
+int mbedtls_ed25519_verify_batch(const mbedtls_ed25519_batch_entry *entries,
+                                 size_t count,
+                                 int (*f_rng)(void *, unsigned char *, size_t),
+                                 void *p_rng)
+{
+    int ret = 0;
+    ge_cached *tables = NULL;
+    signed char *slides = NULL;
+    size_t n;
+
+    if (f_rng == NULL) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    if (count == 1) {
+        return mbedtls_ed25519_verify(entries->ctx, entries->msg,
+                                      entries->msg_len, entries->sig,
+                                      entries->sig_len);
+    }
+
+    tables = mbedtls_calloc(8 * (2 * ED25519_BATCH_CHUNK + 1), sizeof(ge_cached));
+    slides = mbedtls_calloc(2 * ED25519_BATCH_CHUNK + 1, ED25519_SLIDE_DIGITS);
+    if (tables == NULL || slides == NULL) {
+        ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+        goto cleanup;
+    }
+
+    while (count > 0) {
+        n = count < ED25519_BATCH_CHUNK ? count : ED25519_BATCH_CHUNK;
+        ret = ed25519_verify_chunk(entries, n, tables, slides, f_rng, p_rng);
+        if (ret != 0) {
+            goto cleanup;
+        }
+        entries += n;
+        count -= n;
+    }
+
+cleanup:
+    mbedtls_free(tables);
+    mbedtls_free(slides);
+    return ret;
+}
+
+#if defined(MBEDTLS_SELF_TEST)
+
+/* RFC 8032 §7.1, TEST 2 */
+static const unsigned char test_seed[32] = {
+    0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda,
+    0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+    0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24,
+    0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb,
+};
+static const unsigned char test_pub[32] = {
+    0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a,
+    0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+    0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c,
+    0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c,
+};
+static const unsigned char test_msg[1] = { 0x72 };
+static const unsigned char test_sig[64] = {
+    0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8,
+    0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+    0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f,
+    0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+    0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e,
+    0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+    0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee,
+    0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00,
+};
+
+int mbedtls_ed25519_self_test(int verbose)
+{
+    int ret = 1;
+    mbedtls_ed25519_context ctx;
+    unsigned char sig[MBEDTLS_ED25519_SIGNATURE_SIZE];
+    size_t sig_len;
+
+    mbedtls_ed25519_init(&ctx);
+
+    if (verbose != 0) {
+        mbedtls_printf("  Ed25519 key derivation: ");
+    }
+    if (mbedtls_ed25519_set_private_key(&ctx, test_seed, sizeof(test_seed)) != 0 ||
+        memcmp(ctx.pub, test_pub, sizeof(test_pub)) != 0) {
+        goto exit;
+    }
+
+    if (verbose != 0) {
+        mbedtls_printf("passed\n  Ed25519 sign: ");
+    }
+    if (mbedtls_ed25519_sign(&ctx, test_msg, sizeof(test_msg),
+                             sig, sizeof(sig), &sig_len) != 0 ||
+        sig_len != sizeof(test_sig) ||
+        memcmp(sig, test_sig, sizeof(test_sig)) != 0) {
+        goto exit;
+    }
+
+    if (verbose != 0) {
+        mbedtls_printf("passed\n  Ed25519 verify: ");
+    }
+    if (mbedtls_ed25519_set_public_key(&ctx, test_pub, sizeof(test_pub)) != 0 ||
+        mbedtls_ed25519_verify(&ctx, test_msg, sizeof(test_msg),
+                               test_sig, sizeof(test_sig)) != 0) {
+        goto exit;
+    }
+    sig[0] ^= 1;
+    if (mbedtls_ed25519_verify(&ctx, test_msg, sizeof(test_msg),
+                               sig, sizeof(sig)) != MBEDTLS_ERR_ECP_VERIFY_FAILED) {
+        goto exit;
+    }
+
+    ret = 0;
+
+exit:
+    if (verbose != 0) {
+        mbedtls_printf(ret == 0 ? "passed\n\n" : "failed\n");
+    }
+    mbedtls_ed25519_free(&ctx);
+    return ret;
+}
+
+#endif /* MBEDTLS_SELF_TEST */
+
+#endif /* MBEDTLS_ED25519_C */
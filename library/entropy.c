@@ -13,6 +13,7 @@
 #include "entropy_poll.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -30,7 +31,7 @@ void mbedtls_entropy_init(mbedtls_entropy_context *ctx)
     memset(ctx->source, 0, sizeof(ctx->source));
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "entropy");
 #endif
 
     ctx->accumulator_started = 0;
@@ -40,7 +41,13 @@ void mbedtls_entropy_init(mbedtls_entropy_context *ctx)
      *           when adding more strong entropy sources here. */
 
 #if !defined(MBEDTLS_NO_DEFAULT_ENTROPY_SOURCES)
-#if !defined(MBEDTLS_NO_PLATFORM_ENTROPY)
+#if defined(MBEDTLS_ENTROPY_PLATFORM_BUFFERED)
+    memset(&ctx->platform_buffer, 0, sizeof(ctx->platform_buffer));
+    mbedtls_entropy_add_source(ctx, mbedtls_platform_entropy_poll_buffered,
+                               &ctx->platform_buffer,
+                               MBEDTLS_ENTROPY_MIN_PLATFORM,
+                               MBEDTLS_ENTROPY_SOURCE_STRONG);
+#elif !defined(MBEDTLS_NO_PLATFORM_ENTROPY)
     mbedtls_entropy_add_source(ctx, mbedtls_platform_entropy_poll, NULL,
                                MBEDTLS_ENTROPY_MIN_PLATFORM,
                                MBEDTLS_ENTROPY_SOURCE_STRONG);
@@ -73,6 +80,9 @@ void mbedtls_entropy_free(mbedtls_entropy_context *ctx)
     mbedtls_md_free(&ctx->accumulator);
 #if defined(MBEDTLS_ENTROPY_NV_SEED)
     ctx->initial_entropy_run = 0;
+#endif
+#if defined(MBEDTLS_ENTROPY_PLATFORM_BUFFERED)
+    mbedtls_platform_zeroize(&ctx->platform_buffer, sizeof(ctx->platform_buffer));
 #endif
     ctx->source_count = 0;
     mbedtls_platform_zeroize(ctx->source, sizeof(ctx->source));
@@ -329,15 +339,10 @@ int mbedtls_entropy_func(void *data, unsigned char *output, size_t len)
     }
 
     /*
-     * Reset accumulator and counters and recycle existing entropy
+     * Reset accumulator and counters and recycle existing entropy.
+     * The accumulator keeps its hash context, so that this does not
+     * allocate while holding the mutex.
      */
-    mbedtls_md_free(&ctx->accumulator);
-    mbedtls_md_init(&ctx->accumulator);
-    ret = mbedtls_md_setup(&ctx->accumulator,
-                           mbedtls_md_info_from_type(MBEDTLS_ENTROPY_MD), 0);
-    if (ret != 0) {
-        goto exit;
-    }
     ret = mbedtls_md_starts(&ctx->accumulator);
     if (ret != 0) {
         goto exit;
@@ -19,6 +19,7 @@
 #include "mbedtls/entropy.h"
 #include "entropy_poll.h"
 #include "mbedtls/error.h"
+#include "mbedtls/platform_util.h"
 
 #if defined(MBEDTLS_TIMING_C)
 #include "mbedtls/timing.h"
@@ -199,6 +200,60 @@ int mbedtls_platform_entropy_poll(void *data,
 #endif /* HAVE_SYSCTL_ARND */
 }
 #endif /* _WIN32 && !EFIX64 && !EFI32 */
+
+#if defined(MBEDTLS_ENTROPY_PLATFORM_BUFFERED)
+
+int mbedtls_platform_entropy_poll_buffered(void *data,
+                                           unsigned char *output, size_t len,
+                                           size_t *olen)
+{
+    mbedtls_entropy_platform_buffer *pool = (mbedtls_entropy_platform_buffer *) data;
+    const size_t size = sizeof(pool->buf);
+    long pid = mbedtls_platform_process_id();
+    unsigned char *p;
+    size_t fill = 0;
+    int ret;
+
+    *olen = 0;
+
+    /* Never hand out bytes that another process may also hand out. */
+    if (pool->len != 0 && pool->pid != pid) {
+        mbedtls_platform_zeroize(pool->buf, size);
+        pool->len = 0;
+    }
+
+    if (pool->len == 0) {
+        ret = mbedtls_platform_entropy_poll(NULL, pool->buf, size, &fill);
+        if (ret != 0) {
+            mbedtls_platform_zeroize(pool->buf, size);
+            return ret;
+        }
+        if (fill == 0 || fill > size) {
+            mbedtls_platform_zeroize(pool->buf, size);
+            return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+        }
+        /* Unread bytes are kept at the end of the buffer. */
+        if (fill < size) {
+            memmove(pool->buf + size - fill, pool->buf, fill);
+            mbedtls_platform_zeroize(pool->buf, size - fill);
+        }
+        pool->len = fill;
+        pool->pid = pid;
+    }
+
+    if (len > pool->len) {
+        len = pool->len;
+    }
+
+    p = pool->buf + size - pool->len;
+    memcpy(output, p, len);
+    mbedtls_platform_zeroize(p, len);
+    pool->len -= len;
+    *olen = len;
+
+    return 0;
+}
+#endif /* MBEDTLS_ENTROPY_PLATFORM_BUFFERED */
 #endif /* !MBEDTLS_NO_PLATFORM_ENTROPY */
 
 #if defined(MBEDTLS_ENTROPY_NV_SEED)
@@ -12,6 +12,8 @@
 
 #include "mbedtls/build_info.h"
 
+#include "mbedtls/entropy.h"
+
 #include <stddef.h>
 
 #ifdef __cplusplus
@@ -34,6 +36,30 @@ int mbedtls_platform_entropy_poll(void *data,
                                   unsigned char *output, size_t len, size_t *olen);
 #endif
 
+#if defined(MBEDTLS_ENTROPY_PLATFORM_BUFFERED)
+/**
+ * \brief           Buffered platform entropy poll callback
+ *
+ *                  Serve entropy from \p data, refilling it with a single
+ *                  call to mbedtls_platform_entropy_poll() when it is empty.
+ *                  If the current process is not the one that filled the
+ *                  buffer (i.e. after fork()), the buffer is discarded and
+ *                  refilled so that parent and child never share output.
+ *
+ * \param data      The buffer (mbedtls_entropy_platform_buffer *).
+ *                  It must have been zeroed before the first call.
+ * \param output    Data to fill
+ * \param len       Maximum size to provide
+ * \param olen      The actual amount of bytes put into the buffer
+ *
+ * \return          0 on success,
+ *                  MBEDTLS_ERR_ENTROPY_SOURCE_FAILED otherwise
+ */
+int mbedtls_platform_entropy_poll_buffered(void *data,
+                                           unsigned char *output, size_t len,
+                                           size_t *olen);
+#endif
+
 #if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
 /**
  * \brief           Entropy poll callback for a hardware source
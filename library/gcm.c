@@ -24,6 +24,8 @@
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
 #include "mbedtls/constant_time.h"
+#include "gcm_invasive.h"
+#include "cpu_accel_internal.h"
 
 #if defined(MBEDTLS_BLOCK_CIPHER_C)
 #include "block_cipher_internal.h"
@@ -63,6 +65,10 @@ static inline void gcm_set_acceleration(mbedtls_gcm_context *ctx)
     ctx->acceleration = MBEDTLS_GCM_ACC_SMALLTABLE;
 #endif
 
+    if (MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_GHASH)) {
+        return;
+    }
+
 #if defined(MBEDTLS_AESNI_HAVE_CODE)
     /* With CLMUL support, we need only h, not the rest of the table */
     if (mbedtls_aesni_has_support(MBEDTLS_AESNI_CLMUL)) {
@@ -71,12 +77,34 @@ static inline void gcm_set_acceleration(mbedtls_gcm_context *ctx)
 #endif
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
-    if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+    if (MBEDTLS_AESCE_CPU_HAS_SUPPORT()) {
         ctx->acceleration = MBEDTLS_GCM_ACC_AESCE;
     }
 #endif
 }
 
+/*
+ * Name of the implementation that keys set now would use
+ */
+const char *mbedtls_gcm_cpu_accel_implementation(void)
+{
+    mbedtls_gcm_context ctx;
+
+    gcm_set_acceleration(&ctx);
+    switch (ctx.acceleration) {
+#if defined(MBEDTLS_AESNI_HAVE_CODE)
+        case MBEDTLS_GCM_ACC_AESNI:
+            return "aesni";
+#endif
+#if defined(MBEDTLS_AESCE_HAVE_CODE)
+        case MBEDTLS_GCM_ACC_AESCE:
+            return "aesce";
+#endif
+        default:
+            return MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+    }
+}
+
 static inline void gcm_gen_table_rightshift(uint64_t dst[2], const uint64_t src[2])
 {
     uint8_t *u8Dst = (uint8_t *) dst;
@@ -126,6 +154,12 @@ static int gcm_gen_table(mbedtls_gcm_context *ctx)
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
         case MBEDTLS_GCM_ACC_AESCE:
+            /* H^(i+1) in H[i] for mbedtls_aesce_gcm_ghash_blocks() */
+            memcpy(ctx->H[0], h, 16);
+            for (i = 1; i < 4; i++) {
+                mbedtls_aesce_gcm_mult((unsigned char *) ctx->H[i],
+                                       (unsigned char *) ctx->H[i - 1], h);
+            }
             return 0;
 #endif
 
@@ -344,8 +378,9 @@ static void gcm_mult_smalltable(uint8_t *output, const uint8_t *x, uint64_t H[16
  * Sets output to x times H using the precomputed tables.
  * x and output are seen as elements of GF(2^128) as in [MGV].
  */
-static void gcm_mult(mbedtls_gcm_context *ctx, const unsigned char x[16],
-                     unsigned char output[16])
+MBEDTLS_STATIC_TESTABLE
+void mbedtls_gcm_mult(mbedtls_gcm_context *ctx, const unsigned char x[16],
+                      unsigned char output[16])
 {
     switch (ctx->acceleration) {
 #if defined(MBEDTLS_AESNI_HAVE_CODE)
@@ -374,6 +409,26 @@ static void gcm_mult(mbedtls_gcm_context *ctx, const unsigned char x[16],
     return;
 }
 
+/*
+ * Absorbs nblocks full blocks of input into the GHASH state ctx->buf.
+ */
+static void gcm_ghash_blocks(mbedtls_gcm_context *ctx,
+                             const unsigned char *input, size_t nblocks)
+{
+#if defined(MBEDTLS_AESCE_HAVE_CODE)
+    if (ctx->acceleration == MBEDTLS_GCM_ACC_AESCE) {
+        mbedtls_aesce_gcm_ghash_blocks(ctx->buf, (unsigned char *) ctx->H,
+                                       input, nblocks);
+        return;
+    }
+#endif
+
+    for (; nblocks > 0; nblocks--, input += 16) {
+        mbedtls_xor(ctx->buf, ctx->buf, input, 16);
+        mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
+    }
+}
+
 int mbedtls_gcm_starts(mbedtls_gcm_context *ctx,
                        int mode,
                        const unsigned char *iv, size_t iv_len)
@@ -423,7 +478,7 @@ int mbedtls_gcm_starts(mbedtls_gcm_context *ctx,
 #pragma GCC diagnostic pop
 #endif
 
-            gcm_mult(ctx, ctx->y, ctx->y);
+            mbedtls_gcm_mult(ctx, ctx->y, ctx->y);
 
             iv_len -= use_len;
             p += use_len;
@@ -431,7 +486,7 @@ int mbedtls_gcm_starts(mbedtls_gcm_context *ctx,
 
         mbedtls_xor(ctx->y, ctx->y, work_buf, 16);
 
-        gcm_mult(ctx, ctx->y, ctx->y);
+        mbedtls_gcm_mult(ctx, ctx->y, ctx->y);
     }
 
 
@@ -495,7 +550,7 @@ int mbedtls_gcm_update_ad(mbedtls_gcm_context *ctx,
         mbedtls_xor(ctx->buf + offset, ctx->buf + offset, p, use_len);
 
         if (offset + use_len == 16) {
-            gcm_mult(ctx, ctx->buf, ctx->buf);
+            mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
         }
 
         ctx->add_len += use_len;
@@ -505,13 +560,10 @@ int mbedtls_gcm_update_ad(mbedtls_gcm_context *ctx,
 
     ctx->add_len += add_len;
 
-    while (add_len >= 16) {
-        mbedtls_xor(ctx->buf, ctx->buf, p, 16);
-
-        gcm_mult(ctx, ctx->buf, ctx->buf);
-
-        add_len -= 16;
-        p += 16;
+    if (add_len >= 16) {
+        gcm_ghash_blocks(ctx, p, add_len / 16);
+        p += add_len - add_len % 16;
+        add_len %= 16;
     }
 
     if (add_len > 0) {
@@ -529,6 +581,28 @@ static void gcm_incr(unsigned char y[16])
     MBEDTLS_PUT_UINT32_BE(x, y, 12);
 }
 
+/* Maximum number of counter blocks that mbedtls_gcm_update() encrypts
+ * in one go. */
+#define GCM_BATCH_BLOCKS 8
+
+/* Apply the encryption mask ectr and add the ciphertext to the GHASH input.
+ * Process use_len bytes of data, starting at position offset in the mask
+ * block. */
+static void gcm_apply_mask(mbedtls_gcm_context *ctx,
+                           const unsigned char ectr[16],
+                           size_t offset, size_t use_len,
+                           const unsigned char *input,
+                           unsigned char *output)
+{
+    if (ctx->mode == MBEDTLS_GCM_DECRYPT) {
+        mbedtls_xor(ctx->buf + offset, ctx->buf + offset, input, use_len);
+    }
+    mbedtls_xor(output, ectr + offset, input, use_len);
+    if (ctx->mode == MBEDTLS_GCM_ENCRYPT) {
+        mbedtls_xor(ctx->buf + offset, ctx->buf + offset, output, use_len);
+    }
+}
+
 /* Calculate and apply the encryption mask. Process use_len bytes of data,
  * starting at position offset in the mask block. */
 static int gcm_mask(mbedtls_gcm_context *ctx,
@@ -550,15 +624,39 @@ static int gcm_mask(mbedtls_gcm_context *ctx,
         return ret;
     }
 
-    if (ctx->mode == MBEDTLS_GCM_DECRYPT) {
-        mbedtls_xor(ctx->buf + offset, ctx->buf + offset, input, use_len);
+    gcm_apply_mask(ctx, ectr, offset, use_len, input, output);
+
+    return 0;
+}
+
+/* Calculate the encryption masks for the next nblocks blocks, incrementing
+ * the counter before each one. All the counter blocks are passed to the
+ * block cipher at once, so that it can process them in parallel. */
+static int gcm_masks(mbedtls_gcm_context *ctx,
+                     unsigned char *ectr,
+                     size_t nblocks)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t i;
+
+    for (i = 0; i < nblocks; i++) {
+        gcm_incr(ctx->y);
+        memcpy(ectr + 16 * i, ctx->y, 16);
     }
-    mbedtls_xor(output, ectr + offset, input, use_len);
-    if (ctx->mode == MBEDTLS_GCM_ENCRYPT) {
-        mbedtls_xor(ctx->buf + offset, ctx->buf + offset, output, use_len);
+
+#if defined(MBEDTLS_BLOCK_CIPHER_C)
+    ret = mbedtls_block_cipher_encrypt_blocks(&ctx->block_cipher_ctx,
+                                              16 * nblocks, ectr, ectr);
+#else
+    size_t olen = 0;
+    ret = mbedtls_cipher_update(&ctx->cipher_ctx, ectr, 16 * nblocks,
+                                ectr, &olen);
+#endif
+    if (ret != 0) {
+        mbedtls_platform_zeroize(ectr, 16 * nblocks);
     }
 
-    return 0;
+    return ret;
 }
 
 int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
@@ -570,7 +668,7 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
     const unsigned char *p = input;
     unsigned char *out_p = output;
     size_t offset;
-    unsigned char ectr[16] = { 0 };
+    unsigned char ectr[16 * GCM_BATCH_BLOCKS] = { 0 };
 
     if (output_size < input_length) {
         return MBEDTLS_ERR_GCM_BUFFER_TOO_SMALL;
@@ -597,7 +695,7 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
     }
 
     if (ctx->len == 0 && ctx->add_len % 16 != 0) {
-        gcm_mult(ctx, ctx->buf, ctx->buf);
+        mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
     }
 
     offset = ctx->len % 16;
@@ -612,7 +710,7 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
         }
 
         if (offset + use_len == 16) {
-            gcm_mult(ctx, ctx->buf, ctx->buf);
+            mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
         }
 
         ctx->len += use_len;
@@ -624,16 +722,28 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
     ctx->len += input_length;
 
     while (input_length >= 16) {
-        gcm_incr(ctx->y);
-        if ((ret = gcm_mask(ctx, ectr, 0, 16, p, out_p)) != 0) {
+        size_t nblocks = input_length / 16;
+        if (nblocks > GCM_BATCH_BLOCKS) {
+            nblocks = GCM_BATCH_BLOCKS;
+        }
+
+        if ((ret = gcm_masks(ctx, ectr, nblocks)) != 0) {
             return ret;
         }
 
-        gcm_mult(ctx, ctx->buf, ctx->buf);
+        /* Hash the ciphertext before it is overwritten if decrypting in
+         * place. */
+        if (ctx->mode == MBEDTLS_GCM_DECRYPT) {
+            gcm_ghash_blocks(ctx, p, nblocks);
+        }
+        mbedtls_xor(out_p, ectr, p, 16 * nblocks);
+        if (ctx->mode == MBEDTLS_GCM_ENCRYPT) {
+            gcm_ghash_blocks(ctx, out_p, nblocks);
+        }
 
-        input_length -= 16;
-        p += 16;
-        out_p += 16;
+        input_length -= 16 * nblocks;
+        p += 16 * nblocks;
+        out_p += 16 * nblocks;
     }
 
     if (input_length > 0) {
@@ -669,7 +779,7 @@ int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
     orig_add_len = ctx->add_len * 8;
 
     if (ctx->len == 0 && ctx->add_len % 16 != 0) {
-        gcm_mult(ctx, ctx->buf, ctx->buf);
+        mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
     }
 
     if (tag_len > 16 || tag_len < 4) {
@@ -677,7 +787,7 @@ int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
     }
 
     if (ctx->len % 16 != 0) {
-        gcm_mult(ctx, ctx->buf, ctx->buf);
+        mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
     }
 
     memcpy(tag, ctx->base_ectr, tag_len);
@@ -692,7 +802,7 @@ int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
 
         mbedtls_xor(ctx->buf, ctx->buf, work_buf, 16);
 
-        gcm_mult(ctx, ctx->buf, ctx->buf);
+        mbedtls_gcm_mult(ctx, ctx->buf, ctx->buf);
 
         mbedtls_xor(tag, tag, ctx->buf, tag_len);
     }
@@ -1034,7 +1144,7 @@ int mbedtls_gcm_self_test(int verbose)
 #endif
 
 #if defined(MBEDTLS_AESCE_HAVE_CODE)
-        if (MBEDTLS_AESCE_HAS_SUPPORT()) {
+        if (MBEDTLS_AESCE_CPU_HAS_SUPPORT()) {
             mbedtls_printf("  GCM note: using AESCE.\n");
         } else
 #endif
@@ -0,0 +1,38 @@
+/**
+ * \file gcm_invasive.h
+ *
+ * \brief GCM module: interfaces for invasive testing only.
+ *
+ * The interfaces in this file are intended for testing purposes only.
+ * They SHOULD NOT be made available in library integrations except when
+ * building the library for testing.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_GCM_INVASIVE_H
+#define MBEDTLS_GCM_INVASIVE_H
+
+#include "common.h"
+#include "mbedtls/gcm.h"
+
+#if defined(MBEDTLS_TEST_HOOKS) && defined(MBEDTLS_GCM_C) && !defined(MBEDTLS_GCM_ALT)
+
+/** Multiply by the hash subkey in GF(2^128): `output = x * H`.
+ *
+ * This uses whichever implementation mbedtls_gcm_setkey() selected for
+ * \p ctx: the AESNI or AESCE carry-less multiplication, or the 4-bit or
+ * 8-bit precomputed tables.
+ *
+ * \param[in] ctx       A GCM context with a key set.
+ * \param[in] x         The multiplicand.
+ * \param[out] output   The product. This may alias \p x.
+ */
+MBEDTLS_STATIC_TESTABLE
+void mbedtls_gcm_mult(mbedtls_gcm_context *ctx, const unsigned char x[16],
+                      unsigned char output[16]);
+
+#endif /* MBEDTLS_TEST_HOOKS && MBEDTLS_GCM_C && !MBEDTLS_GCM_ALT */
+
+#endif /* MBEDTLS_GCM_INVASIVE_H */
@@ -18,6 +18,7 @@
 #include "mbedtls/hmac_drbg.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -105,7 +106,7 @@ int mbedtls_hmac_drbg_seed_buf(mbedtls_hmac_drbg_context *ctx,
     }
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "hmac_drbg");
 #endif
 
     /*
@@ -235,7 +236,7 @@ int mbedtls_hmac_drbg_seed(mbedtls_hmac_drbg_context *ctx,
 
     /* The mutex is initialized iff the md context is set up. */
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "hmac_drbg");
 #endif
 
     md_size = mbedtls_md_get_size(md_info);
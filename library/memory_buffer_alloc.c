@@ -14,6 +14,7 @@
    is dependent upon MBEDTLS_PLATFORM_C */
 #include "mbedtls/platform.h"
 #include "mbedtls/platform_util.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -564,7 +565,7 @@ void mbedtls_memory_buffer_alloc_init(unsigned char *buf, size_t len)
     memset(&heap, 0, sizeof(buffer_alloc_ctx));
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&heap.mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&heap.mutex, "memory_buffer_alloc");
     mbedtls_platform_set_calloc_free(buffer_alloc_calloc_mutexed,
                                      buffer_alloc_free_mutexed);
 #else
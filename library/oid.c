@@ -464,6 +464,12 @@ static const oid_sig_alg_t oid_sig_alg[] =
         MBEDTLS_MD_NONE,     MBEDTLS_PK_RSASSA_PSS,
     },
 #endif /* MBEDTLS_RSA_C */
+#if defined(MBEDTLS_ED25519_C)
+    {
+        OID_DESCRIPTOR(MBEDTLS_OID_ED25519,           "Ed25519",              "Ed25519"),
+        MBEDTLS_MD_NONE,     MBEDTLS_PK_ED25519,
+    },
+#endif /* MBEDTLS_ED25519_C */
     {
         NULL_OID_DESCRIPTOR,
         MBEDTLS_MD_NONE, MBEDTLS_PK_NONE,
@@ -517,6 +523,12 @@ static const oid_pk_alg_t oid_pk_alg[] =
         OID_DESCRIPTOR(MBEDTLS_OID_EC_ALG_ECDH,         "id-ecDH",          "EC key for ECDH"),
         MBEDTLS_PK_ECKEY_DH,
     },
+#if defined(MBEDTLS_ED25519_C)
+    {
+        OID_DESCRIPTOR(MBEDTLS_OID_ED25519,             "id-Ed25519",       "Ed25519 key"),
+        MBEDTLS_PK_ED25519,
+    },
+#endif /* MBEDTLS_ED25519_C */
     {
         NULL_OID_DESCRIPTOR,
         MBEDTLS_PK_NONE,
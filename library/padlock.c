@@ -16,6 +16,7 @@
 #if defined(MBEDTLS_PADLOCK_C)
 
 #include "padlock.h"
+#include "cpu_accel_internal.h"
 
 #include <string.h>
 
@@ -48,6 +49,11 @@ int mbedtls_padlock_has_support(int feature)
         flags = edx;
     }
 
+    if ((feature & MBEDTLS_PADLOCK_ACE) != 0 &&
+        MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_AES)) {
+        return 0;
+    }
+
     return flags & feature;
 }
 
@@ -128,6 +128,10 @@ const mbedtls_pk_info_t *mbedtls_pk_info_from_type(mbedtls_pk_type_t pk_type)
         case MBEDTLS_PK_ECDSA:
             return &mbedtls_ecdsa_info;
 #endif /* MBEDTLS_PK_CAN_ECDSA_SOME */
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_PK_ED25519:
+            return &mbedtls_ed25519_info;
+#endif /* MBEDTLS_ED25519_C */
         /* MBEDTLS_PK_RSA_ALT omitted on purpose */
         default:
             return NULL;
@@ -175,7 +179,9 @@ int mbedtls_pk_setup_opaque(mbedtls_pk_context *ctx,
     psa_reset_key_attributes(&attributes);
 
 #if defined(MBEDTLS_PK_HAVE_ECC_KEYS)
-    if (PSA_KEY_TYPE_IS_ECC_KEY_PAIR(type)) {
+    /* Opaque keys are only wrapped for ECDSA, not for EdDSA. */
+    if (PSA_KEY_TYPE_IS_ECC_KEY_PAIR(type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(type) != PSA_ECC_FAMILY_TWISTED_EDWARDS) {
         info = &mbedtls_ecdsa_opaque_info;
     } else
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
@@ -514,6 +520,29 @@ int mbedtls_pk_get_psa_attributes(const mbedtls_pk_context *pk,
         }
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
 
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_PK_ED25519:
+        {
+            const mbedtls_ed25519_context *ed = mbedtls_pk_ed25519(*pk);
+            switch (usage) {
+                case PSA_KEY_USAGE_SIGN_MESSAGE:
+                case PSA_KEY_USAGE_VERIFY_MESSAGE:
+                    break;
+                default:
+                    return MBEDTLS_ERR_PK_TYPE_MISMATCH;
+            }
+            if (want_private && !ed->has_priv) {
+                return MBEDTLS_ERR_PK_TYPE_MISMATCH;
+            }
+            psa_set_key_type(attributes, (want_private ?
+                                          PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_TWISTED_EDWARDS) :
+                                          PSA_KEY_TYPE_ECC_PUBLIC_KEY(PSA_ECC_FAMILY_TWISTED_EDWARDS)));
+            psa_set_key_bits(attributes, 255);
+            psa_set_key_algorithm(attributes, PSA_ALG_PURE_EDDSA);
+            break;
+        }
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_PK_RSA_ALT_SUPPORT)
         case MBEDTLS_PK_RSA_ALT:
             return MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE;
@@ -726,6 +755,31 @@ static int import_pair_into_psa(const mbedtls_pk_context *pk,
         }
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
 
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_PK_ED25519:
+        {
+            unsigned char key_buffer[MBEDTLS_ED25519_KEY_SIZE];
+            size_t key_length = 0;
+            if (psa_get_key_type(attributes) !=
+                PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_TWISTED_EDWARDS)) {
+                return MBEDTLS_ERR_PK_TYPE_MISMATCH;
+            }
+            int ret = mbedtls_ed25519_write_private_key(mbedtls_pk_ed25519(*pk),
+                                                        key_buffer,
+                                                        sizeof(key_buffer),
+                                                        &key_length);
+            if (ret != 0) {
+                /* Only the public key is set. */
+                return MBEDTLS_ERR_PK_TYPE_MISMATCH;
+            }
+            ret = PSA_PK_TO_MBEDTLS_ERR(psa_import_key(attributes,
+                                                       key_buffer, key_length,
+                                                       key_id));
+            mbedtls_platform_zeroize(key_buffer, key_length);
+            return ret;
+        }
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
         case MBEDTLS_PK_OPAQUE:
             return copy_into_psa(pk->priv_id, attributes, key_id);
@@ -805,6 +859,19 @@ static int import_public_into_psa(const mbedtls_pk_context *pk,
         }
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
 
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_PK_ED25519:
+        {
+            if (psa_type !=
+                PSA_KEY_TYPE_ECC_PUBLIC_KEY(PSA_ECC_FAMILY_TWISTED_EDWARDS)) {
+                return MBEDTLS_ERR_PK_TYPE_MISMATCH;
+            }
+            key_data = mbedtls_pk_ed25519(*pk)->pub;
+            key_length = MBEDTLS_ED25519_KEY_SIZE;
+            break;
+        }
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
         case MBEDTLS_PK_OPAQUE:
         {
@@ -26,6 +26,10 @@
 #include "mbedtls/ecdsa.h"
 #endif
 
+#if defined(MBEDTLS_ED25519_C)
+#include "mbedtls/ed25519.h"
+#endif
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
 #include "psa_util_internal.h"
 #include "psa/crypto.h"
@@ -1271,6 +1275,116 @@ const mbedtls_pk_info_t mbedtls_ecdsa_info = {
 #endif /* MBEDTLS_PK_CAN_ECDSA_SOME */
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
 
+#if defined(MBEDTLS_ED25519_C)
+/*
+ * Ed25519 (PureEdDSA): the "hash" passed through the pk interface is the
+ * whole message and md_alg must be MBEDTLS_MD_NONE.
+ */
+static int ed25519_can_do(mbedtls_pk_type_t type)
+{
+    return type == MBEDTLS_PK_ED25519;
+}
+
+static size_t ed25519_get_bitlen(mbedtls_pk_context *pk)
+{
+    (void) pk;
+    return 255;
+}
+
+static int ed25519_verify_wrap(mbedtls_pk_context *pk, mbedtls_md_type_t md_alg,
+                               const unsigned char *hash, size_t hash_len,
+                               const unsigned char *sig, size_t sig_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if (md_alg != MBEDTLS_MD_NONE) {
+        return MBEDTLS_ERR_PK_BAD_INPUT_DATA;
+    }
+
+    ret = mbedtls_ed25519_verify(pk->pk_ctx, hash, hash_len, sig, sig_len);
+    if (ret == MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH) {
+        return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+
+    return ret;
+}
+
+static int ed25519_sign_wrap(mbedtls_pk_context *pk, mbedtls_md_type_t md_alg,
+                             const unsigned char *hash, size_t hash_len,
+                             unsigned char *sig, size_t sig_size, size_t *sig_len,
+                             int (*f_rng)(void *, unsigned char *, size_t),
+                             void *p_rng)
+{
+    /* Ed25519 signatures are deterministic. */
+    (void) f_rng;
+    (void) p_rng;
+
+    if (md_alg != MBEDTLS_MD_NONE) {
+        return MBEDTLS_ERR_PK_BAD_INPUT_DATA;
+    }
+
+    return mbedtls_ed25519_sign(pk->pk_ctx, hash, hash_len,
+                                sig, sig_size, sig_len);
+}
+
+static int ed25519_check_pair_wrap(mbedtls_pk_context *pub,
+                                   mbedtls_pk_context *prv,
+                                   int (*f_rng)(void *, unsigned char *, size_t),
+                                   void *p_rng)
+{
+    (void) f_rng;
+    (void) p_rng;
+
+    return mbedtls_ed25519_check_pub_priv(pub->pk_ctx, prv->pk_ctx);
+}
+
+static void *ed25519_alloc_wrap(void)
+{
+    void *ctx = mbedtls_calloc(1, sizeof(mbedtls_ed25519_context));
+
+    if (ctx != NULL) {
+        mbedtls_ed25519_init(ctx);
+    }
+
+    return ctx;
+}
+
+static void ed25519_free_wrap(void *ctx)
+{
+    mbedtls_ed25519_free((mbedtls_ed25519_context *) ctx);
+    mbedtls_free(ctx);
+}
+
+static void ed25519_debug(mbedtls_pk_context *pk, mbedtls_pk_debug_item *items)
+{
+    /* The debug module has no item type for a bare point encoding:
+     * report no items rather than an invalid context. */
+    (void) pk;
+    (void) items;
+}
+
+const mbedtls_pk_info_t mbedtls_ed25519_info = {
+    .type = MBEDTLS_PK_ED25519,
+    .name = "Ed25519",
+    .get_bitlen = ed25519_get_bitlen,
+    .can_do = ed25519_can_do,
+    .verify_func = ed25519_verify_wrap,
+    .sign_func = ed25519_sign_wrap,
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    .verify_rs_func = NULL,
+    .sign_rs_func = NULL,
+    .rs_alloc_func = NULL,
+    .rs_free_func = NULL,
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
+    .decrypt_func = NULL,
+    .encrypt_func = NULL,
+    .check_pair_func = ed25519_check_pair_wrap,
+    .ctx_alloc_func = ed25519_alloc_wrap,
+    .ctx_free_func = ed25519_free_wrap,
+    .debug_func = ed25519_debug,
+};
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_PK_RSA_ALT_SUPPORT)
 /*
  * Support for alternative RSA-private implementations
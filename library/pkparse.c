@@ -506,6 +506,14 @@ static int pk_get_pk_alg(unsigned char **p,
         return MBEDTLS_ERR_PK_INVALID_ALG;
     }
 
+    /*
+     * Parameters must be absent with Ed25519 (RFC 8410 §3)
+     */
+    if (*pk_alg == MBEDTLS_PK_ED25519 &&
+        (params->tag != 0 || params->len != 0)) {
+        return MBEDTLS_ERR_PK_INVALID_ALG;
+    }
+
     return 0;
 }
 
@@ -583,6 +591,17 @@ int mbedtls_pk_parse_subpubkey(unsigned char **p, const unsigned char *end,
         }
     } else
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
+#if defined(MBEDTLS_ED25519_C)
+    if (pk_alg == MBEDTLS_PK_ED25519) {
+        ret = mbedtls_ed25519_set_public_key(mbedtls_pk_ed25519(*pk),
+                                             *p, (size_t) (end - *p));
+        if (ret == 0) {
+            *p += end - *p;
+        } else {
+            ret = MBEDTLS_ERR_PK_INVALID_PUBKEY;
+        }
+    } else
+#endif /* MBEDTLS_ED25519_C */
     ret = MBEDTLS_ERR_PK_UNKNOWN_PK_ALG;
 
     if (ret == 0 && *p != end) {
@@ -841,6 +860,27 @@ static int pk_parse_key_pkcs8_unencrypted_der(
         }
     } else
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
+#if defined(MBEDTLS_ED25519_C)
+    if (pk_alg == MBEDTLS_PK_ED25519) {
+        /* CurvePrivateKey ::= OCTET STRING (RFC 8410 §7) */
+        unsigned char *q = p;
+        size_t seed_len;
+
+        if ((ret = mbedtls_asn1_get_tag(&q, p + len, &seed_len,
+                                        MBEDTLS_ASN1_OCTET_STRING)) != 0 ||
+            q + seed_len != p + len) {
+            mbedtls_pk_free(pk);
+            return MBEDTLS_ERROR_ADD(MBEDTLS_ERR_PK_KEY_INVALID_FORMAT,
+                                     ret != 0 ? ret :
+                                     MBEDTLS_ERR_ASN1_LENGTH_MISMATCH);
+        }
+        if ((ret = mbedtls_ed25519_set_private_key(mbedtls_pk_ed25519(*pk),
+                                                   q, seed_len)) != 0) {
+            mbedtls_pk_free(pk);
+            return MBEDTLS_ERR_PK_KEY_INVALID_FORMAT;
+        }
+    } else
+#endif /* MBEDTLS_ED25519_C */
     return MBEDTLS_ERR_PK_UNKNOWN_PK_ALG;
 
     end = p + len;
@@ -211,6 +211,24 @@ struct tm *mbedtls_platform_gmtime_r(const mbedtls_time_t *tt,
 }
 #endif /* MBEDTLS_HAVE_TIME_DATE && MBEDTLS_PLATFORM_GMTIME_R_ALT */
 
+#if !(defined(_WIN32) && !defined(EFIX64) && !defined(EFI32)) && \
+    (defined(unix) || defined(__unix) || defined(__unix__) || \
+    (defined(__APPLE__) && defined(__MACH__)) || defined(__QNXNTO__) || \
+    defined(__HAIKU__) || defined(__midipix__) || defined(__MVS__))
+#include <unistd.h>
+#define PLATFORM_UTIL_HAVE_GETPID
+#endif
+
+long mbedtls_platform_process_id(void)
+{
+#if defined(PLATFORM_UTIL_HAVE_GETPID)
+    return (long) getpid();
+#else
+    /* No fork() here, so the state of this process is never shared. */
+    return 1;
+#endif
+}
+
 #if defined(MBEDTLS_TEST_HOOKS)
 void (*mbedtls_test_hook_test_fail)(const char *, int, const char *);
 #endif /* MBEDTLS_TEST_HOOKS */
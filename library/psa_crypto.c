@@ -57,6 +57,7 @@
 #include "mbedtls/des.h"
 #include "mbedtls/ecdh.h"
 #include "mbedtls/ecp.h"
+#include "mbedtls/ed25519.h"
 #include "mbedtls/entropy.h"
 #include "mbedtls/error.h"
 #include "mbedtls/gcm.h"
@@ -537,7 +538,7 @@ psa_status_t mbedtls_to_psa_error(int ret)
             return PSA_ERROR_INSUFFICIENT_ENTROPY;
 #endif
 
-#if defined(MBEDTLS_ECP_LIGHT)
+#if defined(MBEDTLS_ECP_LIGHT) || defined(MBEDTLS_ED25519_C)
         case MBEDTLS_ERR_ECP_BAD_INPUT_DATA:
         case MBEDTLS_ERR_ECP_INVALID_KEY:
             return PSA_ERROR_INVALID_ARGUMENT;
@@ -776,6 +777,21 @@ psa_status_t psa_import_key_into_slot(
         }
 #endif /* defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_DH_KEY_PAIR_IMPORT) ||
         * defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_DH_PUBLIC_KEY) */
+        if (PSA_KEY_TYPE_IS_ECC(type) &&
+            PSA_KEY_TYPE_ECC_GET_FAMILY(type) ==
+            PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+#if defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255)
+            return mbedtls_psa_eddsa_import_key(attributes,
+                                                data, data_length,
+                                                key_buffer, key_buffer_size,
+                                                key_buffer_length,
+                                                bits);
+#else
+            /* Edwards keys are not Weierstrass keys: don't let the ECP
+             * import reject them as malformed. */
+            return PSA_ERROR_NOT_SUPPORTED;
+#endif /* MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255 */
+        }
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_IMPORT) || \
         defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_PUBLIC_KEY)
         if (PSA_KEY_TYPE_IS_ECC(type)) {
@@ -1175,8 +1191,39 @@ static psa_status_t psa_get_and_lock_transparent_key_slot_with_policy(
     return PSA_SUCCESS;
 }
 
+/* Free the parsed form of the key data that a built-in driver left in
+ * a key slot (see psa_key_slot_put_parsed()). */
+static void psa_free_parsed_key(psa_key_type_t type, void *parsed)
+{
+#if defined(MBEDTLS_RSA_C)
+    if (PSA_KEY_TYPE_IS_RSA(type)) {
+        mbedtls_rsa_free(parsed);
+    }
+#endif
+#if defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255)
+    if (PSA_KEY_TYPE_IS_ECC(type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(type) == PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+        mbedtls_ed25519_free(parsed);
+        mbedtls_free(parsed);
+        return;
+    }
+#endif
+#if defined(MBEDTLS_ECP_LIGHT)
+    if (PSA_KEY_TYPE_IS_ECC(type)) {
+        mbedtls_ecp_keypair_free(parsed);
+    }
+#endif
+    (void) type;
+    mbedtls_free(parsed);
+}
+
 psa_status_t psa_remove_key_data_from_memory(psa_key_slot_t *slot)
 {
+    if (slot->parsed != NULL) {
+        psa_free_parsed_key(slot->attr.type, slot->parsed);
+        slot->parsed = NULL;
+    }
+
     if (slot->key.data != NULL) {
         mbedtls_zeroize_and_free(slot->key.data, slot->key.bytes);
     }
@@ -1552,6 +1599,17 @@ psa_status_t psa_export_public_key_internal(
 #endif /* defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_RSA_KEY_PAIR_EXPORT) ||
         * defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_RSA_PUBLIC_KEY) */
     } else if (PSA_KEY_TYPE_IS_ECC(type)) {
+#if defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255)
+        if (PSA_KEY_TYPE_ECC_GET_FAMILY(type) ==
+            PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+            return mbedtls_psa_eddsa_export_public_key(attributes,
+                                                       key_buffer,
+                                                       key_buffer_size,
+                                                       data,
+                                                       data_size,
+                                                       data_length);
+        }
+#endif /* MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255 */
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_EXPORT) || \
         defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_PUBLIC_KEY)
         return mbedtls_psa_ecp_export_public_key(attributes,
@@ -3077,6 +3135,18 @@ psa_status_t psa_sign_message_builtin(
             signature, signature_size, signature_length);
     }
 
+#if defined(MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA)
+    if (alg == PSA_ALG_PURE_EDDSA &&
+        PSA_KEY_TYPE_IS_ECC(attributes->type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(attributes->type) ==
+        PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+        return mbedtls_psa_eddsa_sign_message(
+            attributes, key_buffer, key_buffer_size,
+            alg, input, input_length,
+            signature, signature_size, signature_length);
+    }
+#endif /* MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA */
+
     return PSA_ERROR_NOT_SUPPORTED;
 }
 
@@ -3136,6 +3206,18 @@ psa_status_t psa_verify_message_builtin(
             signature, signature_length);
     }
 
+#if defined(MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA)
+    if (alg == PSA_ALG_PURE_EDDSA &&
+        PSA_KEY_TYPE_IS_ECC(attributes->type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(attributes->type) ==
+        PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+        return mbedtls_psa_eddsa_verify_message(
+            attributes, key_buffer, key_buffer_size,
+            alg, input, input_length,
+            signature, signature_length);
+    }
+#endif /* MBEDTLS_PSA_BUILTIN_ALG_PURE_EDDSA */
+
     return PSA_ERROR_NOT_SUPPORTED;
 }
 
@@ -6347,6 +6429,20 @@ static psa_status_t psa_generate_derived_key_internal(
             if (status != PSA_SUCCESS) {
                 goto exit;
             }
+        } else if (curve == PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+            /* Twisted Edwards curve: the private key is a seed of
+             * unstructured bytes (RFC 8032 §5.1.5). */
+            if (bits != 255) {
+                return PSA_ERROR_NOT_SUPPORTED;
+            }
+            data = mbedtls_calloc(1, bytes);
+            if (data == NULL) {
+                return PSA_ERROR_INSUFFICIENT_MEMORY;
+            }
+            status = psa_key_derivation_output_bytes(operation, data, bytes);
+            if (status != PSA_SUCCESS) {
+                goto exit;
+            }
         } else {
             /* Montgomery elliptic curve */
             status = psa_generate_derived_ecc_key_montgomery_helper(bits, operation, &data);
@@ -7835,6 +7931,15 @@ static psa_status_t psa_validate_key_type_and_size_for_key_generation(
     } else
 #endif /* defined(PSA_WANT_KEY_TYPE_RSA_KEY_PAIR_GENERATE) */
 
+#if defined(PSA_WANT_ECC_TWISTED_EDWARDS_255)
+    if (PSA_KEY_TYPE_IS_ECC_KEY_PAIR(type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(type) == PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+        if (bits != 255) {
+            return PSA_ERROR_NOT_SUPPORTED;
+        }
+    } else
+#endif /* defined(PSA_WANT_ECC_TWISTED_EDWARDS_255) */
+
 #if defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
     if (PSA_KEY_TYPE_IS_ECC(type) && PSA_KEY_TYPE_IS_KEY_PAIR(type)) {
         /* To avoid empty block, return successfully here. */
@@ -7891,6 +7996,16 @@ psa_status_t psa_generate_key_internal(
     } else
 #endif /* defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_RSA_KEY_PAIR_GENERATE) */
 
+#if defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255)
+    if (PSA_KEY_TYPE_IS_ECC_KEY_PAIR(type) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY(type) == PSA_ECC_FAMILY_TWISTED_EDWARDS) {
+        return mbedtls_psa_eddsa_generate_key(attributes,
+                                              key_buffer,
+                                              key_buffer_size,
+                                              key_buffer_length);
+    } else
+#endif /* defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255) */
+
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
     if (PSA_KEY_TYPE_IS_ECC(type) && PSA_KEY_TYPE_IS_KEY_PAIR(type)) {
         return mbedtls_psa_ecp_generate_key(attributes,
@@ -8061,6 +8176,10 @@ void mbedtls_psa_crypto_free(void)
         global_data.initialized &= ~PSA_CRYPTO_SUBSYSTEM_KEY_SLOTS_INITIALIZED;
     }
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+    mbedtls_psa_ecdsa_forget_nonce_pools();
+#endif
+
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_mutex_unlock(&mbedtls_threading_psa_globaldata_mutex);
 #endif /* defined(MBEDTLS_THREADING_C) */
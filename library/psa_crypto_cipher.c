@@ -464,19 +464,21 @@ static psa_status_t psa_cipher_update_ecb(
         }
     }
 
-    while (input_length >= block_size) {
-        /* Run all full blocks we have, one by one */
+    if (input_length >= block_size) {
+        /* Run all full blocks we have in one go */
+        size_t full_length = input_length - input_length % block_size;
+
         status = mbedtls_to_psa_error(
             mbedtls_cipher_update(ctx, input,
-                                  block_size,
+                                  full_length,
                                   output, &internal_output_length));
 
         if (status != PSA_SUCCESS) {
             goto exit;
         }
 
-        input_length -= block_size;
-        input += block_size;
+        input_length -= full_length;
+        input += full_length;
 
         output += internal_output_length;
         *output_length += internal_output_length;
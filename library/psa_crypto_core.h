@@ -114,6 +114,16 @@ typedef struct {
         uint8_t *data;
         size_t bytes;
     } key;
+
+    /* Parsed form of the key data, owned by the slot, or NULL.
+     *
+     * A built-in driver may keep the object it parsed from key.data here so
+     * that later operations on the same key do not have to parse it again
+     * (see psa_key_slot_take_parsed()). Its type depends on attr.type and
+     * it is freed by psa_remove_key_data_from_memory().
+     *
+     * This field is protected by the key slot mutex. */
+    void *parsed;
 } psa_key_slot_t;
 
 #if defined(MBEDTLS_THREADING_C)
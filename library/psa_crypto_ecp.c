@@ -14,6 +14,7 @@
 #include "psa_crypto_core.h"
 #include "psa_crypto_ecp.h"
 #include "psa_crypto_random_impl.h"
+#include "psa_crypto_slot_management.h"
 #include "mbedtls/psa_util.h"
 
 #include <stdlib.h>
@@ -23,7 +24,9 @@
 #include <mbedtls/ecdsa.h>
 #include <mbedtls/ecdh.h>
 #include <mbedtls/ecp.h>
+#include <mbedtls/ed25519.h>
 #include <mbedtls/error.h>
+#include <mbedtls/threading.h>
 
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_BASIC) || \
     defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_IMPORT) || \
@@ -202,6 +205,59 @@ exit:
         * defined(MBEDTLS_PSA_BUILTIN_ALG_DETERMINISTIC_ECDSA) ||
         * defined(MBEDTLS_PSA_BUILTIN_ALG_ECDH) */
 
+#if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_IMPORT) || \
+    defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_EXPORT) || \
+    defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_PUBLIC_KEY) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_ECDSA) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_DETERMINISTIC_ECDSA) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_ECDH)
+/* Get a keypair for a one-shot operation with the key in key_buffer.
+ *
+ * If key_buffer is the key data of a key slot, reuse the keypair that an
+ * earlier operation left in the slot, if any. Besides the parsing and the
+ * validation of the key, this keeps the public point once it has been
+ * computed, and the comb table that mbedtls_ecp_mul() stores in the group
+ * when the curve has no static one. Otherwise load key_buffer.
+ *
+ * The caller has exclusive use of the keypair until it calls
+ * psa_ecp_release_representation(). Multi-part operations must not use
+ * this, since they keep the keypair after the key slot is released. */
+static psa_status_t psa_ecp_acquire_representation(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    mbedtls_ecp_keypair **p_ecp)
+{
+    *p_ecp = psa_key_slot_take_parsed(key_buffer);
+    if (*p_ecp != NULL) {
+        return PSA_SUCCESS;
+    }
+
+    return mbedtls_psa_ecp_load_representation(attributes->type,
+                                               attributes->bits,
+                                               key_buffer,
+                                               key_buffer_size,
+                                               p_ecp);
+}
+
+/* Release a keypair obtained from psa_ecp_acquire_representation(),
+ * leaving it in the key slot for the next operation if possible. */
+static void psa_ecp_release_representation(const uint8_t *key_buffer,
+                                           mbedtls_ecp_keypair *ecp)
+{
+    if (ecp == NULL || psa_key_slot_put_parsed(key_buffer, ecp)) {
+        return;
+    }
+
+    mbedtls_ecp_keypair_free(ecp);
+    mbedtls_free(ecp);
+}
+#endif /* defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_IMPORT) ||
+        * defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_EXPORT) ||
+        * defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_PUBLIC_KEY) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_ECDSA) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_DETERMINISTIC_ECDSA) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_ECDH) */
+
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_IMPORT) || \
     defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_KEY_PAIR_EXPORT) || \
     defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_ECC_PUBLIC_KEY)
@@ -295,9 +351,9 @@ psa_status_t mbedtls_psa_ecp_export_public_key(
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
     mbedtls_ecp_keypair *ecp = NULL;
 
-    status = mbedtls_psa_ecp_load_representation(
-        attributes->type, attributes->bits,
-        key_buffer, key_buffer_size, &ecp);
+    status = psa_ecp_acquire_representation(attributes,
+                                            key_buffer, key_buffer_size,
+                                            &ecp);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -307,8 +363,7 @@ psa_status_t mbedtls_psa_ecp_export_public_key(
             PSA_KEY_TYPE_ECC_GET_FAMILY(attributes->type)),
         ecp, data, data_size, data_length);
 
-    mbedtls_ecp_keypair_free(ecp);
-    mbedtls_free(ecp);
+    psa_ecp_release_representation(key_buffer, ecp);
 
     return status;
 }
@@ -360,8 +415,62 @@ psa_status_t mbedtls_psa_ecp_generate_key(
 /* ECDSA sign/verify */
 /****************************************************************/
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+/* Nonce pools for randomized ECDSA, indexed by curve. Protected by
+ * mbedtls_threading_psa_globaldata_mutex. */
+static mbedtls_ecdsa_nonce_pool *psa_ecdsa_nonce_pools[MBEDTLS_ECP_DP_MAX];
+
+psa_status_t mbedtls_psa_ecdsa_set_nonce_pool(mbedtls_ecp_group_id grp_id,
+                                              mbedtls_ecdsa_nonce_pool *pool)
+{
+    if (grp_id <= MBEDTLS_ECP_DP_NONE || grp_id >= MBEDTLS_ECP_DP_MAX) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    if (pool != NULL && pool->grp.id != grp_id) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_lock(&mbedtls_threading_psa_globaldata_mutex);
+#endif /* defined(MBEDTLS_THREADING_C) */
+
+    psa_ecdsa_nonce_pools[grp_id] = pool;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock(&mbedtls_threading_psa_globaldata_mutex);
+#endif /* defined(MBEDTLS_THREADING_C) */
+
+    return PSA_SUCCESS;
+}
+
+void mbedtls_psa_ecdsa_forget_nonce_pools(void)
+{
+    memset(psa_ecdsa_nonce_pools, 0, sizeof(psa_ecdsa_nonce_pools));
+}
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_ECDSA) || \
     defined(MBEDTLS_PSA_BUILTIN_ALG_DETERMINISTIC_ECDSA)
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+static mbedtls_ecdsa_nonce_pool *psa_ecdsa_get_nonce_pool(
+    mbedtls_ecp_group_id grp_id)
+{
+    mbedtls_ecdsa_nonce_pool *pool;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_lock(&mbedtls_threading_psa_globaldata_mutex);
+#endif /* defined(MBEDTLS_THREADING_C) */
+
+    pool = psa_ecdsa_nonce_pools[grp_id];
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock(&mbedtls_threading_psa_globaldata_mutex);
+#endif /* defined(MBEDTLS_THREADING_C) */
+
+    return pool;
+}
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 psa_status_t mbedtls_psa_ecdsa_sign_hash(
     const psa_key_attributes_t *attributes,
     const uint8_t *key_buffer, size_t key_buffer_size,
@@ -373,12 +482,13 @@ psa_status_t mbedtls_psa_ecdsa_sign_hash(
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
     size_t curve_bytes;
     mbedtls_mpi r, s;
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+    mbedtls_ecdsa_nonce_pool *pool;
+#endif
 
-    status = mbedtls_psa_ecp_load_representation(attributes->type,
-                                                 attributes->bits,
-                                                 key_buffer,
-                                                 key_buffer_size,
-                                                 &ecp);
+    status = psa_ecp_acquire_representation(attributes,
+                                            key_buffer, key_buffer_size,
+                                            &ecp);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -408,10 +518,23 @@ psa_status_t mbedtls_psa_ecdsa_sign_hash(
 #endif /* defined(MBEDTLS_PSA_BUILTIN_ALG_DETERMINISTIC_ECDSA) */
     } else {
         (void) alg;
-        MBEDTLS_MPI_CHK(mbedtls_ecdsa_sign(&ecp->grp, &r, &s, &ecp->d,
-                                           hash, hash_length,
-                                           mbedtls_psa_get_random,
-                                           MBEDTLS_PSA_RANDOM_STATE));
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+        pool = psa_ecdsa_get_nonce_pool(ecp->grp.id);
+        if (pool != NULL) {
+            MBEDTLS_MPI_CHK(mbedtls_ecdsa_sign_pooled(&ecp->grp, &r, &s,
+                                                      &ecp->d,
+                                                      hash, hash_length,
+                                                      pool,
+                                                      mbedtls_psa_get_random,
+                                                      MBEDTLS_PSA_RANDOM_STATE));
+        } else
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+        {
+            MBEDTLS_MPI_CHK(mbedtls_ecdsa_sign(&ecp->grp, &r, &s, &ecp->d,
+                                               hash, hash_length,
+                                               mbedtls_psa_get_random,
+                                               MBEDTLS_PSA_RANDOM_STATE));
+        }
     }
 
     MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&r,
@@ -427,8 +550,7 @@ cleanup:
         *signature_length = 2 * curve_bytes;
     }
 
-    mbedtls_ecp_keypair_free(ecp);
-    mbedtls_free(ecp);
+    psa_ecp_release_representation(key_buffer, ecp);
 
     return mbedtls_to_psa_error(ret);
 }
@@ -461,11 +583,9 @@ psa_status_t mbedtls_psa_ecdsa_verify_hash(
 
     (void) alg;
 
-    status = mbedtls_psa_ecp_load_representation(attributes->type,
-                                                 attributes->bits,
-                                                 key_buffer,
-                                                 key_buffer_size,
-                                                 &ecp);
+    status = psa_ecp_acquire_representation(attributes,
+                                            key_buffer, key_buffer_size,
+                                            &ecp);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -504,8 +624,7 @@ psa_status_t mbedtls_psa_ecdsa_verify_hash(
 cleanup:
     mbedtls_mpi_free(&r);
     mbedtls_mpi_free(&s);
-    mbedtls_ecp_keypair_free(ecp);
-    mbedtls_free(ecp);
+    psa_ecp_release_representation(key_buffer, ecp);
 
     return status;
 }
@@ -531,12 +650,9 @@ psa_status_t mbedtls_psa_key_agreement_ecdh(
         return PSA_ERROR_INVALID_ARGUMENT;
     }
     mbedtls_ecp_keypair *ecp = NULL;
-    status = mbedtls_psa_ecp_load_representation(
-        attributes->type,
-        attributes->bits,
-        key_buffer,
-        key_buffer_size,
-        &ecp);
+    status = psa_ecp_acquire_representation(attributes,
+                                            key_buffer, key_buffer_size,
+                                            &ecp);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -586,11 +702,221 @@ exit:
     mbedtls_ecdh_free(&ecdh);
     mbedtls_ecp_keypair_free(their_key);
     mbedtls_free(their_key);
-    mbedtls_ecp_keypair_free(ecp);
-    mbedtls_free(ecp);
+    psa_ecp_release_representation(key_buffer, ecp);
     return status;
 }
 #endif /* MBEDTLS_PSA_BUILTIN_ALG_ECDH */
 
+/****************************************************************/
+/* EdDSA */
+/****************************************************************/
+
+#if defined(MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255)
+/* Load an Ed25519 key from its PSA representation: the 32-byte secret seed
+ * of RFC 8032 for a key pair, the 32-byte encoding of the point for a
+ * public key. */
+static psa_status_t psa_eddsa_load_representation(
+    psa_key_type_t type, size_t bits,
+    const uint8_t *data, size_t data_length,
+    mbedtls_ed25519_context *ctx)
+{
+    if (bits != 0 && bits != 255) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+    if (data_length != MBEDTLS_ED25519_KEY_SIZE) {
+        return bits == 0 ? PSA_ERROR_NOT_SUPPORTED :
+               PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (PSA_KEY_TYPE_IS_KEY_PAIR(type)) {
+        return mbedtls_to_psa_error(
+            mbedtls_ed25519_set_private_key(ctx, data, data_length));
+    } else {
+        return mbedtls_to_psa_error(
+            mbedtls_ed25519_set_public_key(ctx, data, data_length));
+    }
+}
+
+/* Like psa_ecp_acquire_representation(), for Ed25519 keys. Deriving the
+ * public key and the expanded secret costs a hash and a scalar
+ * multiplication, so it is worth keeping in the key slot. */
+static psa_status_t psa_eddsa_acquire_representation(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    mbedtls_ed25519_context **p_ctx)
+{
+    psa_status_t status;
+
+    *p_ctx = psa_key_slot_take_parsed(key_buffer);
+    if (*p_ctx != NULL) {
+        return PSA_SUCCESS;
+    }
+
+    *p_ctx = mbedtls_calloc(1, sizeof(mbedtls_ed25519_context));
+    if (*p_ctx == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+    mbedtls_ed25519_init(*p_ctx);
+
+    status = psa_eddsa_load_representation(attributes->type,
+                                           attributes->bits,
+                                           key_buffer, key_buffer_size,
+                                           *p_ctx);
+    if (status != PSA_SUCCESS) {
+        mbedtls_ed25519_free(*p_ctx);
+        mbedtls_free(*p_ctx);
+        *p_ctx = NULL;
+    }
+
+    return status;
+}
+
+static void psa_eddsa_release_representation(const uint8_t *key_buffer,
+                                             mbedtls_ed25519_context *ctx)
+{
+    if (ctx == NULL || psa_key_slot_put_parsed(key_buffer, ctx)) {
+        return;
+    }
+
+    mbedtls_ed25519_free(ctx);
+    mbedtls_free(ctx);
+}
+
+psa_status_t mbedtls_psa_eddsa_import_key(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *data, size_t data_length,
+    uint8_t *key_buffer, size_t key_buffer_size,
+    size_t *key_buffer_length, size_t *bits)
+{
+    psa_status_t status;
+    mbedtls_ed25519_context ctx;
+
+    mbedtls_ed25519_init(&ctx);
+    status = psa_eddsa_load_representation(attributes->type,
+                                           attributes->bits,
+                                           data, data_length, &ctx);
+    mbedtls_ed25519_free(&ctx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (key_buffer_size < data_length) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+    memcpy(key_buffer, data, data_length);
+    *key_buffer_length = data_length;
+    *bits = 255;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t mbedtls_psa_eddsa_export_public_key(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    uint8_t *data, size_t data_size, size_t *data_length)
+{
+    psa_status_t status;
+    mbedtls_ed25519_context *ctx = NULL;
+
+    status = psa_eddsa_acquire_representation(attributes,
+                                              key_buffer, key_buffer_size,
+                                              &ctx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = mbedtls_to_psa_error(
+        mbedtls_ed25519_write_public_key(ctx, data, data_size, data_length));
+
+    psa_eddsa_release_representation(key_buffer, ctx);
+
+    return status;
+}
+
+psa_status_t mbedtls_psa_eddsa_generate_key(
+    const psa_key_attributes_t *attributes,
+    uint8_t *key_buffer, size_t key_buffer_size, size_t *key_buffer_length)
+{
+    psa_status_t status;
+    mbedtls_ed25519_context ctx;
+
+    if (attributes->bits != 255) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    mbedtls_ed25519_init(&ctx);
+    status = mbedtls_to_psa_error(
+        mbedtls_ed25519_genkey(&ctx, mbedtls_psa_get_random,
+                               MBEDTLS_PSA_RANDOM_STATE));
+    if (status == PSA_SUCCESS) {
+        status = mbedtls_to_psa_error(
+            mbedtls_ed25519_write_private_key(&ctx, key_buffer,
+                                              key_buffer_size,
+                                              key_buffer_length));
+    }
+    mbedtls_ed25519_free(&ctx);
+
+    return status;
+}
+
+psa_status_t mbedtls_psa_eddsa_sign_message(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length)
+{
+    psa_status_t status;
+    mbedtls_ed25519_context *ctx = NULL;
+
+    if (alg != PSA_ALG_PURE_EDDSA) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = psa_eddsa_acquire_representation(attributes,
+                                              key_buffer, key_buffer_size,
+                                              &ctx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = mbedtls_to_psa_error(
+        mbedtls_ed25519_sign(ctx, input, input_length,
+                             signature, signature_size, signature_length));
+
+    psa_eddsa_release_representation(key_buffer, ctx);
+
+    return status;
+}
+
+psa_status_t mbedtls_psa_eddsa_verify_message(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length)
+{
+    psa_status_t status;
+    mbedtls_ed25519_context *ctx = NULL;
+
+    if (alg != PSA_ALG_PURE_EDDSA) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = psa_eddsa_acquire_representation(attributes,
+                                              key_buffer, key_buffer_size,
+                                              &ctx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = mbedtls_to_psa_error(
+        mbedtls_ed25519_verify(ctx, input, input_length,
+                               signature, signature_length));
+
+    psa_eddsa_release_representation(key_buffer, ctx);
+
+    return status;
+}
+#endif /* MBEDTLS_PSA_BUILTIN_ECC_TWISTED_EDWARDS_255 */
+
 
 #endif /* MBEDTLS_PSA_CRYPTO_C */
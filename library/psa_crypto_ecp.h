@@ -264,4 +264,142 @@ psa_status_t mbedtls_psa_key_agreement_ecdh(
     psa_algorithm_t alg, const uint8_t *peer_key, size_t peer_key_length,
     uint8_t *shared_secret, size_t shared_secret_size,
     size_t *shared_secret_length);
+
+/** Import an Ed25519 key.
+ *
+ * \note The signature of this function is that of a PSA driver
+ *       import_key entry point.
+ *
+ * The representation of a key pair is the 32-byte secret seed of
+ * RFC 8032, that of a public key is the 32-byte encoding of the point.
+ *
+ * \param[in]  attributes       The attributes for the key to import.
+ * \param[in]  data             The buffer containing the key data.
+ * \param[in]  data_length      Size of the \p data buffer in bytes.
+ * \param[out] key_buffer       The buffer to write the key data to.
+ * \param[in]  key_buffer_size  Size of \p key_buffer in bytes.
+ * \param[out] key_buffer_length  The length of the data written in
+ *                                \p key_buffer in bytes.
+ * \param[out] bits             The key size in number of bits.
+ *
+ * \retval #PSA_SUCCESS  The key was imported successfully.
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ *         The key data is not a valid Ed25519 key.
+ * \retval #PSA_ERROR_NOT_SUPPORTED \emptydescription
+ */
+psa_status_t mbedtls_psa_eddsa_import_key(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *data, size_t data_length,
+    uint8_t *key_buffer, size_t key_buffer_size,
+    size_t *key_buffer_length, size_t *bits);
+
+/** Export the public part of an Ed25519 key pair.
+ *
+ * \note The signature of this function is that of a PSA driver
+ *       export_public_key entry point.
+ *
+ * \param[in]  attributes       The attributes for the key to export.
+ * \param[in]  key_buffer       Material or context of the key to export.
+ * \param[in]  key_buffer_size  Size of the \p key_buffer buffer in bytes.
+ * \param[out] data             The buffer to write the public key to.
+ * \param[in]  data_size        Size of the \p data buffer in bytes.
+ * \param[out] data_length      On success, the number of bytes written in
+ *                              \p data.
+ *
+ * \retval #PSA_SUCCESS  The public key was exported successfully.
+ * \retval #PSA_ERROR_BUFFER_TOO_SMALL \emptydescription
+ * \retval #PSA_ERROR_INSUFFICIENT_MEMORY \emptydescription
+ */
+psa_status_t mbedtls_psa_eddsa_export_public_key(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    uint8_t *data, size_t data_size, size_t *data_length);
+
+/** Generate an Ed25519 key pair.
+ *
+ * \note The signature of the function is that of a PSA driver generate_key
+ *       entry point.
+ *
+ * \param[in]  attributes         The attributes for the key to generate.
+ * \param[out] key_buffer         Buffer where the key data is to be written.
+ * \param[in]  key_buffer_size    Size of \p key_buffer in bytes.
+ * \param[out] key_buffer_length  On success, the number of bytes written in
+ *                                \p key_buffer.
+ *
+ * \retval #PSA_SUCCESS
+ *         The key was successfully generated.
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ *         Key length not supported.
+ * \retval #PSA_ERROR_BUFFER_TOO_SMALL
+ *         The size of \p key_buffer is too small.
+ */
+psa_status_t mbedtls_psa_eddsa_generate_key(
+    const psa_key_attributes_t *attributes,
+    uint8_t *key_buffer, size_t key_buffer_size, size_t *key_buffer_length);
+
+/** Sign a message with PureEdDSA on edwards25519 (Ed25519).
+ *
+ * \note The signature of this function is that of a PSA driver
+ *       sign_message entry point.
+ *
+ * \param[in]  attributes       The attributes of the key to use.
+ * \param[in]  key_buffer       The buffer containing the key pair.
+ * \param[in]  key_buffer_size  Size of the \p key_buffer buffer in bytes.
+ * \param[in]  alg              #PSA_ALG_PURE_EDDSA.
+ * \param[in]  input            The message to sign.
+ * \param[in]  input_length     Size of the \p input buffer in bytes.
+ * \param[out] signature        Buffer where the signature is to be written.
+ * \param[in]  signature_size   Size of the \p signature buffer in bytes.
+ * \param[out] signature_length On success, the number of bytes
+ *                              that make up the returned signature value.
+ *
+ * \retval #PSA_SUCCESS \emptydescription
+ * \retval #PSA_ERROR_BUFFER_TOO_SMALL \emptydescription
+ * \retval #PSA_ERROR_NOT_SUPPORTED \emptydescription
+ * \retval #PSA_ERROR_INSUFFICIENT_MEMORY \emptydescription
+ */
+psa_status_t mbedtls_psa_eddsa_sign_message(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length);
+
+/** Verify a PureEdDSA signature on edwards25519 (Ed25519).
+ *
+ * \note The signature of this function is that of a PSA driver
+ *       verify_message entry point.
+ *
+ * \param[in]  attributes       The attributes of the key to use.
+ * \param[in]  key_buffer       The buffer containing the key.
+ * \param[in]  key_buffer_size  Size of the \p key_buffer buffer in bytes.
+ * \param[in]  alg              #PSA_ALG_PURE_EDDSA.
+ * \param[in]  input            The message whose signature is to be
+ *                              verified.
+ * \param[in]  input_length     Size of the \p input buffer in bytes.
+ * \param[in]  signature        Buffer containing the signature to verify.
+ * \param[in]  signature_length Size of the \p signature buffer in bytes.
+ *
+ * \retval #PSA_SUCCESS
+ *         The signature is valid.
+ * \retval #PSA_ERROR_INVALID_SIGNATURE
+ *         The calculation was performed successfully, but the passed
+ *         signature is not a valid signature.
+ * \retval #PSA_ERROR_NOT_SUPPORTED \emptydescription
+ * \retval #PSA_ERROR_INSUFFICIENT_MEMORY \emptydescription
+ */
+psa_status_t mbedtls_psa_eddsa_verify_message(
+    const psa_key_attributes_t *attributes,
+    const uint8_t *key_buffer, size_t key_buffer_size,
+    psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length);
+
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+/** Forget the nonce pools set with mbedtls_psa_ecdsa_set_nonce_pool().
+ *
+ * \note If multi-threading is enabled, the caller must hold
+ *       #mbedtls_threading_psa_globaldata_mutex.
+ */
+void mbedtls_psa_ecdsa_forget_nonce_pools(void);
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
 #endif /* PSA_CRYPTO_ECP_H */
@@ -15,6 +15,7 @@
 #include "psa_crypto_core.h"
 #include "psa_crypto_random_impl.h"
 #include "psa_crypto_rsa.h"
+#include "psa_crypto_slot_management.h"
 #include "psa_crypto_hash.h"
 #include "mbedtls/psa_util.h"
 
@@ -276,6 +277,63 @@ psa_status_t mbedtls_psa_rsa_generate_key(
 }
 #endif /* defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_RSA_KEY_PAIR_GENERATE) */
 
+#if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_SIGN) || \
+    defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PSS)
+
+/* Get an RSA context for an operation with the key in key_buffer.
+ *
+ * If key_buffer is the key data of a key slot, reuse the context that an
+ * earlier operation left in the slot, if any. This saves parsing the key
+ * and, for private keys, recomputing the blinding values and the
+ * Montgomery constants. Otherwise parse key_buffer.
+ *
+ * The caller has exclusive use of the context until it calls
+ * psa_rsa_release_representation(), so it may change the padding mode.
+ * Since that mode outlives the operation, it must always set it. */
+static psa_status_t psa_rsa_acquire_representation(
+    psa_key_type_t type, const uint8_t *key_buffer, size_t key_buffer_size,
+    mbedtls_rsa_context **p_rsa)
+{
+    psa_status_t status;
+
+    *p_rsa = psa_key_slot_take_parsed(key_buffer);
+    if (*p_rsa != NULL) {
+        return PSA_SUCCESS;
+    }
+
+    status = mbedtls_psa_rsa_load_representation(type,
+                                                 key_buffer,
+                                                 key_buffer_size,
+                                                 p_rsa);
+    if (status != PSA_SUCCESS) {
+        mbedtls_rsa_free(*p_rsa);
+        mbedtls_free(*p_rsa);
+        *p_rsa = NULL;
+    }
+
+    return status;
+}
+
+/* Release a context obtained from psa_rsa_acquire_representation(),
+ * leaving it in the key slot for the next operation if possible. */
+static void psa_rsa_release_representation(const uint8_t *key_buffer,
+                                           mbedtls_rsa_context *rsa)
+{
+    if (rsa == NULL || psa_key_slot_put_parsed(key_buffer, rsa)) {
+        return;
+    }
+
+    mbedtls_rsa_free(rsa);
+    mbedtls_free(rsa);
+}
+
+#endif /* defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_SIGN) ||
+        * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PSS) */
+
 /****************************************************************/
 /* Sign/verify hashes */
 /****************************************************************/
@@ -325,10 +383,10 @@ psa_status_t mbedtls_psa_rsa_sign_hash(
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
     mbedtls_md_type_t md_alg;
 
-    status = mbedtls_psa_rsa_load_representation(attributes->type,
-                                                 key_buffer,
-                                                 key_buffer_size,
-                                                 &rsa);
+    status = psa_rsa_acquire_representation(attributes->type,
+                                            key_buffer,
+                                            key_buffer_size,
+                                            &rsa);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -384,8 +442,7 @@ psa_status_t mbedtls_psa_rsa_sign_hash(
     status = mbedtls_to_psa_error(ret);
 
 exit:
-    mbedtls_rsa_free(rsa);
-    mbedtls_free(rsa);
+    psa_rsa_release_representation(key_buffer, rsa);
 
     return status;
 }
@@ -424,10 +481,10 @@ psa_status_t mbedtls_psa_rsa_verify_hash(
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
     mbedtls_md_type_t md_alg;
 
-    status = mbedtls_psa_rsa_load_representation(attributes->type,
-                                                 key_buffer,
-                                                 key_buffer_size,
-                                                 &rsa);
+    status = psa_rsa_acquire_representation(attributes->type,
+                                            key_buffer,
+                                            key_buffer_size,
+                                            &rsa);
     if (status != PSA_SUCCESS) {
         goto exit;
     }
@@ -483,8 +540,7 @@ psa_status_t mbedtls_psa_rsa_verify_hash(
              mbedtls_to_psa_error(ret);
 
 exit:
-    mbedtls_rsa_free(rsa);
-    mbedtls_free(rsa);
+    psa_rsa_release_representation(key_buffer, rsa);
 
     return status;
 }
@@ -540,10 +596,10 @@ psa_status_t mbedtls_psa_asymmetric_encrypt(const psa_key_attributes_t *attribut
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) || \
         defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP)
         mbedtls_rsa_context *rsa = NULL;
-        status = mbedtls_psa_rsa_load_representation(attributes->type,
-                                                     key_buffer,
-                                                     key_buffer_size,
-                                                     &rsa);
+        status = psa_rsa_acquire_representation(attributes->type,
+                                                key_buffer,
+                                                key_buffer_size,
+                                                &rsa);
         if (status != PSA_SUCCESS) {
             goto rsa_exit;
         }
@@ -556,6 +612,13 @@ psa_status_t mbedtls_psa_asymmetric_encrypt(const psa_key_attributes_t *attribut
         * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP) */
         if (alg == PSA_ALG_RSA_PKCS1V15_CRYPT) {
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT)
+            status = mbedtls_to_psa_error(
+                mbedtls_rsa_set_padding(rsa, MBEDTLS_RSA_PKCS_V15,
+                                        MBEDTLS_MD_NONE));
+            if (status != PSA_SUCCESS) {
+                goto rsa_exit;
+            }
+
             status = mbedtls_to_psa_error(
                 mbedtls_rsa_pkcs1_encrypt(rsa,
                                           mbedtls_psa_get_random,
@@ -596,8 +659,7 @@ rsa_exit:
             *output_length = mbedtls_rsa_get_len(rsa);
         }
 
-        mbedtls_rsa_free(rsa);
-        mbedtls_free(rsa);
+        psa_rsa_release_representation(key_buffer, rsa);
 #endif /* defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) ||
         * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP) */
     } else {
@@ -636,10 +698,10 @@ psa_status_t mbedtls_psa_asymmetric_decrypt(const psa_key_attributes_t *attribut
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) || \
         defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP)
         mbedtls_rsa_context *rsa = NULL;
-        status = mbedtls_psa_rsa_load_representation(attributes->type,
-                                                     key_buffer,
-                                                     key_buffer_size,
-                                                     &rsa);
+        status = psa_rsa_acquire_representation(attributes->type,
+                                                key_buffer,
+                                                key_buffer_size,
+                                                &rsa);
         if (status != PSA_SUCCESS) {
             goto rsa_exit;
         }
@@ -653,6 +715,13 @@ psa_status_t mbedtls_psa_asymmetric_decrypt(const psa_key_attributes_t *attribut
 
         if (alg == PSA_ALG_RSA_PKCS1V15_CRYPT) {
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT)
+            status = mbedtls_to_psa_error(
+                mbedtls_rsa_set_padding(rsa, MBEDTLS_RSA_PKCS_V15,
+                                        MBEDTLS_MD_NONE));
+            if (status != PSA_SUCCESS) {
+                goto rsa_exit;
+            }
+
             status = mbedtls_to_psa_error(
                 mbedtls_rsa_pkcs1_decrypt(rsa,
                                           mbedtls_psa_get_random,
@@ -692,8 +761,7 @@ psa_status_t mbedtls_psa_asymmetric_decrypt(const psa_key_attributes_t *attribut
 #if defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) || \
         defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP)
 rsa_exit:
-        mbedtls_rsa_free(rsa);
-        mbedtls_free(rsa);
+        psa_rsa_release_representation(key_buffer, rsa);
 #endif /* defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_PKCS1V15_CRYPT) ||
         * defined(MBEDTLS_PSA_BUILTIN_ALG_RSA_OAEP) */
     } else {
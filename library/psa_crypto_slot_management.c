@@ -499,6 +499,73 @@ psa_status_t psa_unregister_read_under_mutex(psa_key_slot_t *slot)
     return status;
 }
 
+/* Find the slot in use whose key data is key_buffer.
+ * The key slot mutex must be held. */
+static psa_key_slot_t *psa_get_key_slot_by_key_buffer(const uint8_t *key_buffer)
+{
+    size_t slot_idx;
+
+    if (key_buffer == NULL || !global_data.key_slots_initialized) {
+        return NULL;
+    }
+
+    for (slot_idx = 0; slot_idx < MBEDTLS_PSA_KEY_SLOT_COUNT; slot_idx++) {
+        psa_key_slot_t *slot = &global_data.key_slots[slot_idx];
+        if (slot->state == PSA_SLOT_FULL && slot->key.data == key_buffer) {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+void *psa_key_slot_take_parsed(const uint8_t *key_buffer)
+{
+    psa_key_slot_t *slot;
+    void *parsed = NULL;
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_lock(&mbedtls_threading_key_slot_mutex) != 0) {
+        return NULL;
+    }
+#endif
+    slot = psa_get_key_slot_by_key_buffer(key_buffer);
+    if (slot != NULL) {
+        parsed = slot->parsed;
+        slot->parsed = NULL;
+    }
+#if defined(MBEDTLS_THREADING_C)
+    /* The caller owns parsed from now on, so there is nothing to undo if
+     * unlocking fails. */
+    (void) mbedtls_mutex_unlock(&mbedtls_threading_key_slot_mutex);
+#endif
+
+    return parsed;
+}
+
+int psa_key_slot_put_parsed(const uint8_t *key_buffer, void *parsed)
+{
+    psa_key_slot_t *slot;
+    int kept = 0;
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_lock(&mbedtls_threading_key_slot_mutex) != 0) {
+        return 0;
+    }
+#endif
+    slot = psa_get_key_slot_by_key_buffer(key_buffer);
+    if (slot != NULL && slot->parsed == NULL) {
+        slot->parsed = parsed;
+        kept = 1;
+    }
+#if defined(MBEDTLS_THREADING_C)
+    /* As in psa_key_slot_take_parsed(), ownership has already moved. */
+    (void) mbedtls_mutex_unlock(&mbedtls_threading_key_slot_mutex);
+#endif
+
+    return kept;
+}
+
 psa_status_t psa_validate_key_location(psa_key_lifetime_t lifetime,
                                        psa_se_drv_table_entry_t **p_drv)
 {
@@ -226,6 +226,42 @@ psa_status_t psa_unregister_read(psa_key_slot_t *slot);
  */
 psa_status_t psa_unregister_read_under_mutex(psa_key_slot_t *slot);
 
+/** Take the parsed representation cached in the key slot whose key data
+ *  is \p key_buffer.
+ *
+ * Built-in drivers use this to avoid parsing the key data of a slot for
+ * every operation. The caller gets exclusive use of the returned object
+ * until it hands it back with psa_key_slot_put_parsed(). Meanwhile, other
+ * operations on the same key find nothing cached and parse their own copy.
+ *
+ * This function takes the key slot mutex, so the caller must not hold it.
+ *
+ * \param[in] key_buffer   The key data passed to the driver.
+ *
+ * \return The cached object, or \c NULL if there is none or if
+ *         \p key_buffer is not the key data of a slot in memory.
+ */
+void *psa_key_slot_take_parsed(const uint8_t *key_buffer);
+
+/** Hand a parsed representation of its key data over to a key slot.
+ *
+ * This function takes the key slot mutex, so the caller must not hold it.
+ *
+ * \param[in] key_buffer   The key data that \p parsed was obtained from,
+ *                         as passed to the driver.
+ * \param[in] parsed       The parsed representation of \p key_buffer.
+ *                         Its type must be the one that
+ *                         psa_remove_key_data_from_memory() expects for
+ *                         the type of the key.
+ *
+ * \retval 1   The slot now owns \p parsed. The caller must not use it
+ *             any more.
+ * \retval 0   The slot did not take \p parsed, because it already holds
+ *             one or because \p key_buffer is not the key data of a key
+ *             slot in use. The caller must free it.
+ */
+int psa_key_slot_put_parsed(const uint8_t *key_buffer, void *parsed);
+
 /** Test whether a lifetime designates a key in an external cryptoprocessor.
  *
  * \param lifetime      The lifetime to test.
@@ -38,6 +38,7 @@
 #include "constant_time_internal.h"
 #include "mbedtls/constant_time.h"
 #include "md_psa.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -960,7 +961,7 @@ void mbedtls_rsa_init(mbedtls_rsa_context *ctx)
     /* Set ctx->ver to nonzero to indicate that the mutex has been
      * initialized and will need to be freed. */
     ctx->ver = 1;
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "rsa");
 #endif
 }
 
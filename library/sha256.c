@@ -54,6 +54,8 @@
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
 
+#include "cpu_accel_internal.h"
+
 #include <string.h>
 
 #include "mbedtls/platform.h"
@@ -604,6 +606,10 @@ static int mbedtls_a64_crypto_sha256_has_support(void)
     static int done = 0;
     static int supported = 0;
 
+    if (MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_SHA256)) {
+        return 0;
+    }
+
     if (!done) {
         supported = mbedtls_a64_crypto_sha256_determine_support();
         done = 1;
@@ -761,6 +767,21 @@ exit:
     return ret;
 }
 
+/*
+ * Name of the implementation of the compression function in use
+ */
+const char *mbedtls_sha256_cpu_accel_implementation(void)
+{
+#if defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_ONLY)
+    return "armv8-a-crypto";
+#elif defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT)
+    return mbedtls_a64_crypto_sha256_has_support() ?
+           "armv8-a-crypto" : MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+#else
+    return MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+#endif
+}
+
 #endif /* !MBEDTLS_SHA256_ALT */
 
 /*
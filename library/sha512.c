@@ -34,6 +34,8 @@
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
 
+#include "cpu_accel_internal.h"
+
 #if defined(_MSC_VER) || defined(__WATCOMC__)
   #define UL64(x) x##ui64
 #else
@@ -724,6 +726,10 @@ static int mbedtls_a64_crypto_sha512_has_support(void)
     static int done = 0;
     static int supported = 0;
 
+    if (MBEDTLS_CPU_ACCEL_IS_PORTABLE(MBEDTLS_CPU_ACCEL_SHA512)) {
+        return 0;
+    }
+
     if (!done) {
         supported = mbedtls_a64_crypto_sha512_determine_support();
         done = 1;
@@ -879,6 +885,21 @@ exit:
     return ret;
 }
 
+/*
+ * Name of the implementation of the compression function in use
+ */
+const char *mbedtls_sha512_cpu_accel_implementation(void)
+{
+#if defined(MBEDTLS_SHA512_USE_A64_CRYPTO_ONLY)
+    return "armv8-a-crypto";
+#elif defined(MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT)
+    return mbedtls_a64_crypto_sha512_has_support() ?
+           "armv8-a-crypto" : MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+#else
+    return MBEDTLS_CPU_ACCEL_PORTABLE_NAME;
+#endif
+}
+
 #endif /* !MBEDTLS_SHA512_ALT */
 
 /*
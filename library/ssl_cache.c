@@ -18,6 +18,7 @@
 #include "mbedtls/ssl_cache.h"
 #include "ssl_misc.h"
 #include "mbedtls/error.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -29,7 +30,7 @@ void mbedtls_ssl_cache_init(mbedtls_ssl_cache_context *cache)
     cache->max_entries = MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES;
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&cache->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&cache->mutex, "ssl_cache");
 #endif
 }
 
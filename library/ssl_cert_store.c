@@ -0,0 +1,756 @@
+/*
+ *  SNI certificate store
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+/*
+ * Every DNS name of every certificate is a node in a chained hash table,
+ * keyed by the lower-case name. A wildcard name "*.example.com" is stored
+ * as such, and since it can only stand for a single label (RFC 6125 6.4.3),
+ * the wildcard candidate for a server name is found with a second lookup
+ * of "*" followed by the name without its first label.
+ *
+ * Parsed private keys are on a doubly linked LRU list. Entries matched by
+ * the SNI callback carry a reference count until the end of the handshake,
+ * and the keys of referenced entries are never freed.
+ */
+
+#include "common.h"
+
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+
+#include "mbedtls/platform.h"
+
+#include "mbedtls/ssl_cert_store.h"
+#include "ssl_misc.h"
+#include "debug_internal.h"
+#include "mbedtls/error.h"
+#include "mbedtls/oid.h"
+#include "mbedtls/platform_util.h"
+#include "threading_internal.h"
+
+#include <string.h>
+
+#define SSL_CERT_STORE_INITIAL_SIZE     64
+
+struct mbedtls_ssl_cert_store_name {
+    mbedtls_ssl_cert_store_name *next;          /*!< next in hash bucket     */
+    mbedtls_ssl_cert_store_entry *entry;        /*!< certificate entry       */
+    const unsigned char *p;                     /*!< name, inside the crt    */
+    size_t len;                                 /*!< name length             */
+    uint32_t hash;                              /*!< hash of the name        */
+};
+
+struct mbedtls_ssl_cert_store_entry {
+    mbedtls_x509_crt crt;                       /*!< certificate chain       */
+    mbedtls_ssl_cert_store_name *names;         /*!< index nodes of the crt  */
+    size_t names_count;
+
+    unsigned char *key_data;                    /*!< encoded key, or NULL    */
+    size_t key_len;
+#if defined(MBEDTLS_FS_IO)
+    char *key_path;                             /*!< key file, or NULL       */
+#endif
+    unsigned char *pwd;                         /*!< null-terminated, or NULL */
+    size_t pwd_len;
+
+    mbedtls_pk_context *key;                    /*!< parsed key, or NULL     */
+    unsigned int refs;                          /*!< handshakes using it     */
+    mbedtls_ssl_cert_store_entry *lru_prev;
+    mbedtls_ssl_cert_store_entry *lru_next;
+
+    mbedtls_ssl_cert_store_entry *next;         /*!< chain of all entries    */
+};
+
+#define SSL_CERT_STORE_LOWER(c)   ((c) >= 'A' && (c) <= 'Z' ? (c) + 'a' - 'A' : (c))
+
+/* FNV-1a of the lower-case name, continuing from h */
+static uint32_t ssl_cert_store_hash(uint32_t h, const unsigned char *p, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        h ^= (uint32_t) SSL_CERT_STORE_LOWER(p[i]);
+        h *= 16777619;
+    }
+
+    return h;
+}
+
+#define SSL_CERT_STORE_HASH_INIT  2166136261u
+
+static int ssl_cert_store_name_eq(const unsigned char *a,
+                                  const unsigned char *b, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        if (SSL_CERT_STORE_LOWER(a[i]) != SSL_CERT_STORE_LOWER(b[i])) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void mbedtls_ssl_cert_store_init(mbedtls_ssl_cert_store *store)
+{
+    memset(store, 0, sizeof(mbedtls_ssl_cert_store));
+
+    store->max_keys = MBEDTLS_SSL_CERT_STORE_DEFAULT_MAX_KEYS;
+
+#if defined(MBEDTLS_THREADING_C)
+    MBEDTLS_MUTEX_INIT_NAMED(&store->mutex, "ssl_cert_store");
+#endif
+}
+
+void mbedtls_ssl_cert_store_set_max_keys(mbedtls_ssl_cert_store *store,
+                                         size_t max)
+{
+    store->max_keys = max;
+}
+
+/*
+ * Entries and their keys
+ */
+static void ssl_cert_store_free_key(mbedtls_ssl_cert_store_entry *entry)
+{
+    mbedtls_pk_free(entry->key);
+    mbedtls_free(entry->key);
+    entry->key = NULL;
+}
+
+static void ssl_cert_store_entry_free(mbedtls_ssl_cert_store_entry *entry)
+{
+    if (entry == NULL) {
+        return;
+    }
+
+    mbedtls_x509_crt_free(&entry->crt);
+    mbedtls_free(entry->names);
+    if (entry->key_data != NULL) {
+        mbedtls_zeroize_and_free(entry->key_data, entry->key_len);
+    }
+#if defined(MBEDTLS_FS_IO)
+    mbedtls_free(entry->key_path);
+#endif
+    if (entry->pwd != NULL) {
+        mbedtls_zeroize_and_free(entry->pwd, entry->pwd_len + 1);
+    }
+    if (entry->key != NULL) {
+        ssl_cert_store_free_key(entry);
+    }
+
+    mbedtls_free(entry);
+}
+
+static void ssl_cert_store_lru_unlink(mbedtls_ssl_cert_store *store,
+                                      mbedtls_ssl_cert_store_entry *entry)
+{
+    if (entry->lru_prev != NULL) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        store->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next != NULL) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        store->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void ssl_cert_store_lru_push(mbedtls_ssl_cert_store *store,
+                                    mbedtls_ssl_cert_store_entry *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = store->lru_head;
+    if (store->lru_head != NULL) {
+        store->lru_head->lru_prev = entry;
+    } else {
+        store->lru_tail = entry;
+    }
+    store->lru_head = entry;
+}
+
+/* Free the least recently used keys that no handshake holds until there
+ * are at most max_keys of them. Must be called with the mutex held. */
+static void ssl_cert_store_evict(mbedtls_ssl_cert_store *store)
+{
+    mbedtls_ssl_cert_store_entry *cur = store->lru_tail, *prev;
+
+    while (store->max_keys != 0 && store->keys > store->max_keys &&
+           cur != NULL) {
+        prev = cur->lru_prev;
+        if (cur->refs == 0) {
+            ssl_cert_store_lru_unlink(store, cur);
+            ssl_cert_store_free_key(cur);
+            store->keys--;
+        }
+        cur = prev;
+    }
+}
+
+/* Make sure the key of entry is parsed and mark it as the most recently
+ * used. Must be called with the mutex held. */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int ssl_cert_store_load_key(mbedtls_ssl_cert_store *store,
+                                   mbedtls_ssl_cert_store_entry *entry,
+                                   int (*f_rng)(void *, unsigned char *, size_t),
+                                   void *p_rng)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_pk_context *key;
+
+    if (entry->key != NULL) {
+        ssl_cert_store_lru_unlink(store, entry);
+        ssl_cert_store_lru_push(store, entry);
+        return 0;
+    }
+
+    if ((key = mbedtls_calloc(1, sizeof(mbedtls_pk_context))) == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    mbedtls_pk_init(key);
+
+#if defined(MBEDTLS_FS_IO)
+    if (entry->key_path != NULL) {
+        ret = mbedtls_pk_parse_keyfile(key, entry->key_path,
+                                       (const char *) entry->pwd,
+                                       f_rng, p_rng);
+    } else
+#endif
+    ret = mbedtls_pk_parse_key(key, entry->key_data, entry->key_len,
+                               entry->pwd, entry->pwd_len, f_rng, p_rng);
+    if (ret != 0) {
+        mbedtls_pk_free(key);
+        mbedtls_free(key);
+        return ret;
+    }
+
+    entry->key = key;
+    ssl_cert_store_lru_push(store, entry);
+    store->keys++;
+
+    return 0;
+}
+
+/*
+ * Name index
+ */
+
+/* Count the DNS names of the leaf certificate, the same ones that
+ * mbedtls_x509_crt_verify() checks a server name against, and record
+ * them in nodes unless it is NULL. */
+static size_t ssl_cert_store_crt_names(mbedtls_ssl_cert_store_entry *entry,
+                                       mbedtls_ssl_cert_store_name *nodes)
+{
+    const mbedtls_x509_crt *crt = &entry->crt;
+    const mbedtls_x509_sequence *san;
+    const mbedtls_x509_name *name;
+    size_t n = 0;
+
+    if (crt->ext_types & MBEDTLS_X509_EXT_SUBJECT_ALT_NAME) {
+        for (san = &crt->subject_alt_names; san != NULL; san = san->next) {
+            if ((san->buf.tag & MBEDTLS_ASN1_TAG_VALUE_MASK) !=
+                MBEDTLS_X509_SAN_DNS_NAME || san->buf.len == 0) {
+                continue;
+            }
+            if (nodes != NULL) {
+                nodes[n].p = san->buf.p;
+                nodes[n].len = san->buf.len;
+            }
+            n++;
+        }
+    } else {
+        for (name = &crt->subject; name != NULL; name = name->next) {
+            if (MBEDTLS_OID_CMP(MBEDTLS_OID_AT_CN, &name->oid) != 0 ||
+                name->val.len == 0) {
+                continue;
+            }
+            if (nodes != NULL) {
+                nodes[n].p = name->val.p;
+                nodes[n].len = name->val.len;
+            }
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/* Append node to its bucket, keeping insertion order within a bucket */
+static void ssl_cert_store_bucket_append(mbedtls_ssl_cert_store_name **table,
+                                         size_t size,
+                                         mbedtls_ssl_cert_store_name *node)
+{
+    mbedtls_ssl_cert_store_name **cur = &table[node->hash & (size - 1)];
+
+    while (*cur != NULL) {
+        cur = &(*cur)->next;
+    }
+    node->next = NULL;
+    *cur = node;
+}
+
+/* Make room for n more names. Must be called with the mutex held. */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int ssl_cert_store_grow(mbedtls_ssl_cert_store *store, size_t n)
+{
+    mbedtls_ssl_cert_store_name **table, *cur, *next;
+    size_t size = store->names_size, i;
+
+    if (size == 0) {
+        size = SSL_CERT_STORE_INITIAL_SIZE;
+    }
+    while (store->names_count + n > size) {
+        size *= 2;
+    }
+    if (size == store->names_size) {
+        return 0;
+    }
+
+    table = mbedtls_calloc(size, sizeof(mbedtls_ssl_cert_store_name *));
+    if (table == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+
+    for (i = 0; i < store->names_size; i++) {
+        for (cur = store->names[i]; cur != NULL; cur = next) {
+            next = cur->next;
+            ssl_cert_store_bucket_append(table, size, cur);
+        }
+    }
+
+    mbedtls_free(store->names);
+    store->names = table;
+    store->names_size = size;
+
+    return 0;
+}
+
+/* Index entry and add it to the store. On failure, the store is unchanged
+ * and the caller still owns entry. */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int ssl_cert_store_insert(mbedtls_ssl_cert_store *store,
+                                 mbedtls_ssl_cert_store_entry *entry)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t i;
+
+    entry->names_count = ssl_cert_store_crt_names(entry, NULL);
+    if (entry->names_count == 0) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+
+    entry->names = mbedtls_calloc(entry->names_count,
+                                  sizeof(mbedtls_ssl_cert_store_name));
+    if (entry->names == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    ssl_cert_store_crt_names(entry, entry->names);
+
+    for (i = 0; i < entry->names_count; i++) {
+        entry->names[i].entry = entry;
+        entry->names[i].hash = ssl_cert_store_hash(SSL_CERT_STORE_HASH_INIT,
+                                                   entry->names[i].p,
+                                                   entry->names[i].len);
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if ((ret = mbedtls_mutex_lock(&store->mutex)) != 0) {
+        return ret;
+    }
+#endif
+
+    ret = ssl_cert_store_grow(store, entry->names_count);
+    if (ret != 0) {
+        goto exit;
+    }
+
+    for (i = 0; i < entry->names_count; i++) {
+        ssl_cert_store_bucket_append(store->names, store->names_size,
+                                     &entry->names[i]);
+    }
+    store->names_count += entry->names_count;
+
+    entry->next = store->entries;
+    store->entries = entry;
+
+exit:
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_unlock(&store->mutex) != 0) {
+        ret = MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+    }
+#endif
+
+    return ret;
+}
+
+/* Look up the entries for a server name, exact names first, then the
+ * wildcard name covering it. Must be called with the mutex held. */
+static size_t ssl_cert_store_lookup(const mbedtls_ssl_cert_store *store,
+                                    const unsigned char *name, size_t name_len,
+                                    mbedtls_ssl_cert_store_entry **matches)
+{
+    const mbedtls_ssl_cert_store_name *cur;
+    const unsigned char *parent;
+    uint32_t hash;
+    size_t n = 0;
+
+    if (store->names_size == 0 || name_len == 0) {
+        return 0;
+    }
+
+    hash = ssl_cert_store_hash(SSL_CERT_STORE_HASH_INIT, name, name_len);
+    for (cur = store->names[hash & (store->names_size - 1)];
+         cur != NULL && n < MBEDTLS_SSL_CERT_STORE_MAX_MATCHES;
+         cur = cur->next) {
+        if (cur->hash == hash && cur->len == name_len &&
+            ssl_cert_store_name_eq(cur->p, name, name_len)) {
+            matches[n++] = cur->entry;
+        }
+    }
+    if (n != 0) {
+        return n;
+    }
+
+    /* "*.example.com" covers "www.example.com" but neither "example.com"
+     * nor "a.www.example.com" */
+    parent = memchr(name, '.', name_len);
+    if (parent == NULL || parent == name || parent == name + name_len - 1) {
+        return 0;
+    }
+    name_len -= parent - name;
+
+    hash = ssl_cert_store_hash(SSL_CERT_STORE_HASH_INIT,
+                               (const unsigned char *) "*", 1);
+    hash = ssl_cert_store_hash(hash, parent, name_len);
+    for (cur = store->names[hash & (store->names_size - 1)];
+         cur != NULL && n < MBEDTLS_SSL_CERT_STORE_MAX_MATCHES;
+         cur = cur->next) {
+        if (cur->hash == hash && cur->len == name_len + 1 &&
+            cur->p[0] == '*' &&
+            ssl_cert_store_name_eq(cur->p + 1, parent, name_len)) {
+            matches[n++] = cur->entry;
+        }
+    }
+
+    return n;
+}
+
+/*
+ * Adding certificates
+ */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int ssl_cert_store_set_pwd(mbedtls_ssl_cert_store_entry *entry,
+                                  const unsigned char *pwd, size_t pwd_len)
+{
+    if (pwd == NULL) {
+        return 0;
+    }
+
+    /* Keep a null terminator for mbedtls_pk_parse_keyfile() */
+    if ((entry->pwd = mbedtls_calloc(1, pwd_len + 1)) == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    memcpy(entry->pwd, pwd, pwd_len);
+    entry->pwd_len = pwd_len;
+
+    return 0;
+}
+
+int mbedtls_ssl_cert_store_add(mbedtls_ssl_cert_store *store,
+                               const unsigned char *crt, size_t crt_len,
+                               const unsigned char *key, size_t key_len,
+                               const unsigned char *pwd, size_t pwd_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_ssl_cert_store_entry *entry;
+
+    if (key == NULL || key_len == 0) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+
+    if ((entry = mbedtls_calloc(1, sizeof(*entry))) == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    mbedtls_x509_crt_init(&entry->crt);
+
+    if ((ret = mbedtls_x509_crt_parse(&entry->crt, crt, crt_len)) != 0) {
+        goto cleanup;
+    }
+
+    if ((entry->key_data = mbedtls_calloc(1, key_len)) == NULL) {
+        ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        goto cleanup;
+    }
+    memcpy(entry->key_data, key, key_len);
+    entry->key_len = key_len;
+
+    if ((ret = ssl_cert_store_set_pwd(entry, pwd, pwd_len)) != 0) {
+        goto cleanup;
+    }
+
+    ret = ssl_cert_store_insert(store, entry);
+
+cleanup:
+    if (ret != 0) {
+        ssl_cert_store_entry_free(entry);
+    }
+
+    return ret;
+}
+
+#if defined(MBEDTLS_FS_IO)
+int mbedtls_ssl_cert_store_add_file(mbedtls_ssl_cert_store *store,
+                                    const char *crt_path,
+                                    const char *key_path,
+                                    const char *pwd)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_ssl_cert_store_entry *entry;
+    size_t path_len;
+
+    if (key_path == NULL) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+
+    if ((entry = mbedtls_calloc(1, sizeof(*entry))) == NULL) {
+        return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+    }
+    mbedtls_x509_crt_init(&entry->crt);
+
+    if ((ret = mbedtls_x509_crt_parse_file(&entry->crt, crt_path)) != 0) {
+        goto cleanup;
+    }
+
+    path_len = strlen(key_path);
+    if ((entry->key_path = mbedtls_calloc(1, path_len + 1)) == NULL) {
+        ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        goto cleanup;
+    }
+    memcpy(entry->key_path, key_path, path_len);
+
+    if (pwd != NULL) {
+        ret = ssl_cert_store_set_pwd(entry, (const unsigned char *) pwd,
+                                     strlen(pwd));
+        if (ret != 0) {
+            goto cleanup;
+        }
+    }
+
+    ret = ssl_cert_store_insert(store, entry);
+
+cleanup:
+    if (ret != 0) {
+        ssl_cert_store_entry_free(entry);
+    }
+
+    return ret;
+}
+#endif /* MBEDTLS_FS_IO */
+
+/*
+ * Handshake integration
+ */
+int mbedtls_ssl_cert_store_sni(void *p_store, mbedtls_ssl_context *ssl,
+                               const unsigned char *name, size_t name_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_ssl_cert_store *store = (mbedtls_ssl_cert_store *) p_store;
+    mbedtls_ssl_handshake_params *handshake = ssl->handshake;
+    size_t i, n;
+
+    /* The ClientHello that follows a HelloRetryRequest carries the same
+     * server name, so keep the matches of the first one. */
+    if (handshake->cert_store != NULL) {
+        return 0;
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if ((ret = mbedtls_mutex_lock(&store->mutex)) != 0) {
+        return ret;
+    }
+#endif
+
+    n = ssl_cert_store_lookup(store, name, name_len,
+                              handshake->cert_store_matches);
+    for (i = 0; i < n; i++) {
+        handshake->cert_store_matches[i]->refs++;
+    }
+    ret = 0;
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_unlock(&store->mutex) != 0) {
+        ret = MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+    }
+#endif
+
+    if (n != 0) {
+        handshake->cert_store = store;
+        handshake->cert_store_match_count = (unsigned char) n;
+    } else if (ret == 0) {
+        MBEDTLS_SSL_DEBUG_BUF(3, "no certificate in store for server name",
+                              name, name_len);
+        if (ssl->conf->key_cert == NULL) {
+            ret = MBEDTLS_ERR_SSL_UNRECOGNIZED_NAME;
+        }
+    }
+
+    return ret;
+}
+
+/* Whether the certificate key can be used with one of the client's
+ * signature algorithms */
+static int ssl_cert_store_entry_is_usable(const mbedtls_ssl_context *ssl,
+                                          const mbedtls_ssl_cert_store_entry *entry)
+{
+#if defined(MBEDTLS_SSL_HANDSHAKE_WITH_CERT_ENABLED)
+    const uint16_t *sig_alg;
+    mbedtls_pk_type_t pk_type;
+    mbedtls_md_type_t md_alg;
+
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2) && defined(MBEDTLS_KEY_EXCHANGE_RSA_ENABLED)
+    /* The RSA key exchange decrypts with the key and signs nothing */
+    if (ssl->tls_version == MBEDTLS_SSL_VERSION_TLS1_2 &&
+        mbedtls_pk_can_do(&entry->crt.pk, MBEDTLS_PK_RSA)) {
+        return 1;
+    }
+#endif
+
+    for (sig_alg = ssl->handshake->received_sig_algs;
+         *sig_alg != MBEDTLS_TLS_SIG_NONE; sig_alg++) {
+        if (mbedtls_ssl_get_pk_type_and_md_alg_from_sig_alg(*sig_alg, &pk_type,
+                                                            &md_alg) == 0 &&
+            mbedtls_pk_can_do(&entry->crt.pk, pk_type)) {
+            return 1;
+        }
+    }
+
+    return 0;
+#else
+    (void) ssl;
+    (void) entry;
+    return 1;
+#endif /* MBEDTLS_SSL_HANDSHAKE_WITH_CERT_ENABLED */
+}
+
+int mbedtls_ssl_cert_store_select(mbedtls_ssl_context *ssl)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_ssl_handshake_params *handshake = ssl->handshake;
+    mbedtls_ssl_cert_store *store = handshake->cert_store;
+    mbedtls_ssl_cert_store_entry *entry;
+    unsigned char usable[MBEDTLS_SSL_CERT_STORE_MAX_MATCHES];
+    size_t i, n = handshake->cert_store_match_count, n_usable = 0, n_set = 0;
+    int parse_ret = 0;
+
+    /* Nothing matched, or already done for the first ClientHello */
+    if (store == NULL || handshake->sni_key_cert != NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        usable[i] = (unsigned char) ssl_cert_store_entry_is_usable(
+            ssl, handshake->cert_store_matches[i]);
+        n_usable += usable[i];
+    }
+
+    /* Let the certificate selection report the mismatch */
+    if (n_usable == 0) {
+        memset(usable, 1, sizeof(usable));
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if ((ret = mbedtls_mutex_lock(&store->mutex)) != 0) {
+        return ret;
+    }
+#endif
+
+    for (i = 0; i < n; i++) {
+        entry = handshake->cert_store_matches[i];
+        if (!usable[i]) {
+            MBEDTLS_SSL_DEBUG_CRT(3, "skipping certificate: no usable signature algorithm",
+                                  &entry->crt);
+            continue;
+        }
+
+        ret = ssl_cert_store_load_key(store, entry,
+                                      ssl->conf->f_rng, ssl->conf->p_rng);
+        if (ret != 0) {
+            MBEDTLS_SSL_DEBUG_RET(1, "ssl_cert_store_load_key", ret);
+            parse_ret = ret;
+            continue;
+        }
+
+        ret = mbedtls_ssl_set_hs_own_cert(ssl, &entry->crt, entry->key);
+        if (ret != 0) {
+            goto exit;
+        }
+        n_set++;
+    }
+
+    ssl_cert_store_evict(store);
+    ret = n_set != 0 ? 0 : parse_ret;
+
+exit:
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_unlock(&store->mutex) != 0) {
+        ret = MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+    }
+#endif
+
+    return ret;
+}
+
+void mbedtls_ssl_cert_store_release(mbedtls_ssl_context *ssl)
+{
+    mbedtls_ssl_handshake_params *handshake = ssl->handshake;
+    mbedtls_ssl_cert_store *store = handshake->cert_store;
+    size_t i;
+
+    if (store == NULL) {
+        return;
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_lock(&store->mutex) != 0) {
+        return;
+    }
+#endif
+
+    for (i = 0; i < handshake->cert_store_match_count; i++) {
+        handshake->cert_store_matches[i]->refs--;
+    }
+    ssl_cert_store_evict(store);
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock(&store->mutex);
+#endif
+
+    handshake->cert_store = NULL;
+    handshake->cert_store_match_count = 0;
+}
+
+void mbedtls_ssl_cert_store_free(mbedtls_ssl_cert_store *store)
+{
+    mbedtls_ssl_cert_store_entry *cur, *next;
+
+    for (cur = store->entries; cur != NULL; cur = next) {
+        next = cur->next;
+        ssl_cert_store_entry_free(cur);
+    }
+
+    mbedtls_free(store->names);
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_free(&store->mutex);
+#endif
+
+    mbedtls_platform_zeroize(store, sizeof(mbedtls_ssl_cert_store));
+}
+
+#endif /* MBEDTLS_SSL_CERT_STORE_C */
@@ -20,6 +20,7 @@
 #include "mbedtls/error.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/constant_time.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -72,7 +73,7 @@ void mbedtls_ssl_cookie_init(mbedtls_ssl_cookie_ctx *ctx)
 
 #if !defined(MBEDTLS_USE_PSA_CRYPTO)
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "ssl_cookie");
 #endif
 #endif /* !MBEDTLS_USE_PSA_CRYPTO */
 }
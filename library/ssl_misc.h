@@ -44,7 +44,11 @@
 #endif
 
 #include "mbedtls/pk.h"
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+#include "mbedtls/ssl_cert_store.h"
+#endif
 #include "ssl_ciphersuites_internal.h"
+#include "mps_reader.h"
 #include "x509_internal.h"
 #include "pk_internal.h"
 #include "common.h"
@@ -755,6 +759,8 @@ struct mbedtls_ssl_handshake_params {
     uint16_t hrr_selected_group;
 #if defined(MBEDTLS_SSL_SESSION_TICKETS)
     uint16_t new_session_tickets_count;         /*!< number of session tickets */
+    uint8_t new_session_tickets_deferred;       /*!< tickets still to be sent
+                                                     after the handshake */
 #endif
 #endif /* MBEDTLS_SSL_SRV_C */
 
@@ -830,6 +836,11 @@ struct mbedtls_ssl_handshake_params {
     mbedtls_x509_crt *sni_ca_chain;     /*!< trusted CAs from SNI callback  */
     mbedtls_x509_crl *sni_ca_crl;       /*!< trusted CAs CRLs from SNI      */
 #endif /* MBEDTLS_SSL_SERVER_NAME_INDICATION */
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+    mbedtls_ssl_cert_store *cert_store; /*!< store matched by SNI callback  */
+    mbedtls_ssl_cert_store_entry *cert_store_matches[MBEDTLS_SSL_CERT_STORE_MAX_MATCHES];
+    unsigned char cert_store_match_count;
+#endif /* MBEDTLS_SSL_CERT_STORE_C */
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #if defined(MBEDTLS_X509_CRT_PARSE_C) &&        \
@@ -1263,6 +1274,22 @@ struct mbedtls_ssl_flight_item {
 };
 #endif /* MBEDTLS_SSL_PROTO_DTLS */
 
+/*
+ * TLS handshake message being reassembled from several records,
+ * see ssl_hs_reasm_feed() in ssl_msg.c
+ */
+struct mbedtls_ssl_hs_reasm {
+    mbedtls_mps_reader rd;  /*!< reader accumulating the fragments      */
+    unsigned char hdr[4];   /*!< handshake header, until it is complete */
+    unsigned char *msg;     /*!< message, including handshake header    */
+    size_t len;             /*!< length of msg, 0 until hdr is complete */
+    size_t filled;          /*!< bytes of the message received so far   */
+    size_t rec_offset;      /*!< offset of the last record's content
+                                 in in_buf, once the message is complete */
+    size_t rec_len;         /*!< length of the last record's content    */
+    size_t rec_used;        /*!< bytes of the last record in the message */
+};
+
 #if defined(MBEDTLS_SSL_PROTO_TLS1_2)
 /**
  * \brief Given an SSL context and its associated configuration, write the TLS
@@ -1356,6 +1383,22 @@ int mbedtls_ssl_prepare_handshake_record(mbedtls_ssl_context *ssl);
 MBEDTLS_CHECK_RETURN_CRITICAL
 int mbedtls_ssl_update_handshake_status(mbedtls_ssl_context *ssl);
 
+/*
+ * Free the TLS handshake message being reassembled, if any.
+ */
+void mbedtls_ssl_hs_reasm_free(mbedtls_ssl_context *ssl);
+
+/*
+ * Whether ssl->in_msg is a handshake message reassembled from several
+ * records, rather than a pointer into ssl->in_buf.
+ */
+static inline int mbedtls_ssl_hs_reasm_is_complete(const mbedtls_ssl_context *ssl)
+{
+    return ssl->in_hs_reasm != NULL &&
+           ssl->in_hs_reasm->len != 0 &&
+           ssl->in_hs_reasm->filled == ssl->in_hs_reasm->len;
+}
+
 /**
  * \brief       Update record layer
  *
@@ -2403,6 +2446,11 @@ static inline int mbedtls_ssl_tls13_sig_alg_for_cert_verify_is_supported(
 #endif /* PSA_WANT_ALG_SHA_512 && MBEDTLS_ECP_DP_SECP521R1_ENABLED */
 #endif /* MBEDTLS_PK_CAN_ECDSA_SOME */
 
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_TLS1_3_SIG_ED25519:
+            break;
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_PKCS1_V21)
 #if defined(PSA_WANT_ALG_SHA_256)
         case MBEDTLS_TLS1_3_SIG_RSA_PSS_RSAE_SHA256:
@@ -2502,6 +2550,13 @@ static inline int mbedtls_ssl_get_pk_type_and_md_alg_from_sig_alg(
             break;
 #endif /* MBEDTLS_MD_CAN_SHA512 */
 #endif /* MBEDTLS_PKCS1_V21 */
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_TLS1_3_SIG_ED25519:
+            /* EdDSA signs the message itself, there is no separate hash. */
+            *md_alg = MBEDTLS_MD_NONE;
+            *pk_type = MBEDTLS_PK_ED25519;
+            break;
+#endif /* MBEDTLS_ED25519_C */
         default:
             return MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
     }
@@ -2770,6 +2825,21 @@ int mbedtls_ssl_parse_server_name_ext(mbedtls_ssl_context *ssl,
                                       const unsigned char *end);
 #endif /* MBEDTLS_SSL_SERVER_NAME_INDICATION */
 
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+/*
+ * Hand the certificates that mbedtls_ssl_cert_store_sni() matched, and that
+ * suit the client's signature algorithms, to the handshake. Called once the
+ * ClientHello has been processed, before the certificate selection.
+ */
+MBEDTLS_CHECK_RETURN_CRITICAL
+int mbedtls_ssl_cert_store_select(mbedtls_ssl_context *ssl);
+
+/*
+ * Let the store free the keys used by the handshake again.
+ */
+void mbedtls_ssl_cert_store_release(mbedtls_ssl_context *ssl);
+#endif /* MBEDTLS_SSL_CERT_STORE_C */
+
 #if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
 #define MBEDTLS_SSL_RECORD_SIZE_LIMIT_EXTENSION_DATA_LENGTH (2)
 #define MBEDTLS_SSL_RECORD_SIZE_LIMIT_MIN (64)      /* As defined in RFC 8449 */
@@ -27,6 +27,12 @@
 
 #include <string.h>
 
+#if defined(MBEDTLS_SSL_SOME_SUITES_USE_MAC)
+#include "mbedtls/sha1.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#endif
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
 #include "psa_util_internal.h"
 #include "psa/crypto.h"
@@ -50,6 +56,342 @@ static int local_err_translation(psa_status_t status)
 
 #if defined(MBEDTLS_SSL_SOME_SUITES_USE_MAC)
 
+#if (defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)) ||     \
+    (defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)) || \
+    (defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT))
+#define MBEDTLS_SSL_CT_HMAC_RAW_HASH
+#endif
+
+#if defined(MBEDTLS_SSL_CT_HMAC_RAW_HASH)
+
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+#define SSL_CT_HASH_MAX_BLOCK_SIZE 128
+#else
+#define SSL_CT_HASH_MAX_BLOCK_SIZE 64
+#endif
+
+/*
+ * Direct access to a built-in hash implementation: its context, its
+ * compression function and its internal state. This lets us feed it
+ * blocks whose contents depend on a secret length without branching.
+ */
+typedef struct {
+    mbedtls_md_type_t md_alg;
+    size_t block_size;
+    size_t block_size_log2;
+    size_t length_size;     /* Size of the length field in the padding */
+    size_t hash_size;
+    union {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        mbedtls_sha1_context sha1;
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        mbedtls_sha256_context sha256;
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        mbedtls_sha512_context sha512;
+#endif
+    } ctx;
+} ssl_ct_hash_context;
+
+/* Returns MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE if there is no built-in
+ * implementation of md_alg that we can drive directly. */
+static int ssl_ct_hash_setup(ssl_ct_hash_context *hash,
+                             mbedtls_md_type_t md_alg)
+{
+    hash->md_alg = md_alg;
+    switch (md_alg) {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        case MBEDTLS_MD_SHA1:
+            hash->block_size = 64;
+            hash->block_size_log2 = 6;
+            hash->length_size = 8;
+            hash->hash_size = 20;
+            mbedtls_sha1_init(&hash->ctx.sha1);
+            return mbedtls_sha1_starts(&hash->ctx.sha1);
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        case MBEDTLS_MD_SHA256:
+            hash->block_size = 64;
+            hash->block_size_log2 = 6;
+            hash->length_size = 8;
+            hash->hash_size = 32;
+            mbedtls_sha256_init(&hash->ctx.sha256);
+            return mbedtls_sha256_starts(&hash->ctx.sha256, 0);
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        case MBEDTLS_MD_SHA384:
+            hash->block_size = 128;
+            hash->block_size_log2 = 7;
+            hash->length_size = 16;
+            hash->hash_size = 48;
+            mbedtls_sha512_init(&hash->ctx.sha512);
+            return mbedtls_sha512_starts(&hash->ctx.sha512, 1);
+#endif
+        default:
+            hash->md_alg = MBEDTLS_MD_NONE;
+            return MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+    }
+}
+
+static void ssl_ct_hash_free(ssl_ct_hash_context *hash)
+{
+    switch (hash->md_alg) {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        case MBEDTLS_MD_SHA1:
+            mbedtls_sha1_free(&hash->ctx.sha1);
+            break;
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        case MBEDTLS_MD_SHA256:
+            mbedtls_sha256_free(&hash->ctx.sha256);
+            break;
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        case MBEDTLS_MD_SHA384:
+            mbedtls_sha512_free(&hash->ctx.sha512);
+            break;
+#endif
+        default:
+            break;
+    }
+    hash->md_alg = MBEDTLS_MD_NONE;
+}
+
+static int ssl_ct_hash_update(ssl_ct_hash_context *hash,
+                              const unsigned char *input, size_t ilen)
+{
+    switch (hash->md_alg) {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        case MBEDTLS_MD_SHA1:
+            return mbedtls_sha1_update(&hash->ctx.sha1, input, ilen);
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        case MBEDTLS_MD_SHA256:
+            return mbedtls_sha256_update(&hash->ctx.sha256, input, ilen);
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        case MBEDTLS_MD_SHA384:
+            return mbedtls_sha512_update(&hash->ctx.sha512, input, ilen);
+#endif
+        default:
+            return MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    }
+}
+
+/* Get the number of bytes hashed so far and the partial block that has
+ * not been fed to the compression function yet. */
+static const unsigned char *ssl_ct_hash_get_buffer(const ssl_ct_hash_context *hash,
+                                                   uint64_t *total)
+{
+    switch (hash->md_alg) {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        case MBEDTLS_MD_SHA1:
+            *total = ((uint64_t) hash->ctx.sha1.total[1] << 32) |
+                     hash->ctx.sha1.total[0];
+            return hash->ctx.sha1.buffer;
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        case MBEDTLS_MD_SHA256:
+            *total = ((uint64_t) hash->ctx.sha256.total[1] << 32) |
+                     hash->ctx.sha256.total[0];
+            return hash->ctx.sha256.buffer;
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        case MBEDTLS_MD_SHA384:
+            /* We never hash anywhere near 2^64 bytes, so total[1] is 0. */
+            *total = hash->ctx.sha512.total[0];
+            return hash->ctx.sha512.buffer;
+#endif
+        default:
+            *total = 0;
+            return NULL;
+    }
+}
+
+/* Run the compression function on one block, then write out the
+ * chaining value as it would appear in the digest. */
+static int ssl_ct_hash_process(ssl_ct_hash_context *hash,
+                               const unsigned char *block,
+                               unsigned char *state)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t i;
+
+    switch (hash->md_alg) {
+#if defined(MBEDTLS_SHA1_C) && !defined(MBEDTLS_SHA1_ALT)
+        case MBEDTLS_MD_SHA1:
+            ret = mbedtls_internal_sha1_process(&hash->ctx.sha1, block);
+            for (i = 0; i < 5; i++) {
+                MBEDTLS_PUT_UINT32_BE(hash->ctx.sha1.state[i], state, 4 * i);
+            }
+            break;
+#endif
+#if defined(MBEDTLS_SHA256_C) && !defined(MBEDTLS_SHA256_ALT)
+        case MBEDTLS_MD_SHA256:
+            ret = mbedtls_internal_sha256_process(&hash->ctx.sha256, block);
+            for (i = 0; i < 8; i++) {
+                MBEDTLS_PUT_UINT32_BE(hash->ctx.sha256.state[i], state, 4 * i);
+            }
+            break;
+#endif
+#if defined(MBEDTLS_SHA384_C) && !defined(MBEDTLS_SHA512_ALT)
+        case MBEDTLS_MD_SHA384:
+            ret = mbedtls_internal_sha512_process(&hash->ctx.sha512, block);
+            for (i = 0; i < 6; i++) {
+                MBEDTLS_PUT_UINT64_BE(hash->ctx.sha512.state[i], state, 8 * i);
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+    return ret;
+}
+
+#endif /* MBEDTLS_SSL_CT_HMAC_RAW_HASH */
+
+/*
+ * Compute the inner hash of HMAC, HASH(ikey + add_data + data), where only
+ * the first data_len_secret bytes of data are hashed, in constant flow.
+ *
+ * The public prefix ikey + add_data + data[:min_data_len] is hashed
+ * normally. For the rest, we build every block that would be hashed if the
+ * data were max_data_len bytes long, masking out the bytes that are beyond
+ * data_len_secret and inserting the final padding and length at the secret
+ * position, and we keep the chaining value after the block that contains
+ * the length. This costs one compression function call per block of the
+ * variable-length part, instead of a full hash finalisation per byte.
+ * The technique is the one used in BoringSSL and s2n.
+ *
+ * Returns MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE if md_alg does not have a
+ * built-in implementation whose compression function we can call, in which
+ * case nothing has been computed and the caller needs to fall back to a
+ * generic method.
+ */
+static int ssl_ct_hmac_inner_hash(mbedtls_md_type_t md_alg,
+                                  const unsigned char *ikey,
+                                  const unsigned char *add_data,
+                                  size_t add_data_len,
+                                  const unsigned char *data,
+                                  size_t data_len_secret,
+                                  size_t min_data_len,
+                                  size_t max_data_len,
+                                  unsigned char *output)
+{
+#if defined(MBEDTLS_SSL_CT_HMAC_RAW_HASH)
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    ssl_ct_hash_context hash;
+    unsigned char block[SSL_CT_HASH_MAX_BLOCK_SIZE];
+    unsigned char state[MBEDTLS_MD_MAX_SIZE];
+    unsigned char length_bytes[8];
+    const unsigned char *partial;
+    uint64_t total;
+    size_t buffered, max_blocks, last_block, input_idx, i, j;
+
+    /* Only the tail of data beyond min_data_len has a secret length. */
+    const unsigned char * const tail = data + min_data_len;
+    const size_t tail_len_secret = data_len_secret - min_data_len;
+    const size_t tail_max_len = max_data_len - min_data_len;
+
+    ret = ssl_ct_hash_setup(&hash, md_alg);
+    if (ret != 0) {
+        return ret;
+    }
+
+    ret = ssl_ct_hash_update(&hash, ikey, hash.block_size);
+    if (ret != 0) {
+        goto cleanup;
+    }
+    ret = ssl_ct_hash_update(&hash, add_data, add_data_len);
+    if (ret != 0) {
+        goto cleanup;
+    }
+    ret = ssl_ct_hash_update(&hash, data, min_data_len);
+    if (ret != 0) {
+        goto cleanup;
+    }
+
+    partial = ssl_ct_hash_get_buffer(&hash, &total);
+    buffered = (size_t) (total & (hash.block_size - 1));
+
+    /* Number of blocks that would be processed if the tail were as long as
+     * possible (public), and index of the block that actually contains the
+     * end of the padding (secret). The block size is a power of 2: use a
+     * shift rather than a division, which may not be constant-time. */
+    max_blocks = (buffered + tail_max_len + 1 + hash.length_size +
+                  hash.block_size - 1) >> hash.block_size_log2;
+    last_block = ((buffered + tail_len_secret + 1 + hash.length_size +
+                   hash.block_size - 1) >> hash.block_size_log2) - 1;
+
+    /* Length in bits of the whole message. For SHA-384, the upper 8 bytes
+     * of the 16-byte length field are always 0. */
+    MBEDTLS_PUT_UINT64_BE((total + tail_len_secret) << 3, length_bytes, 0);
+
+    memset(block, 0, sizeof(block));
+    input_idx = 0;
+    for (i = 0; i < max_blocks; i++) {
+        mbedtls_ct_condition_t is_last_block;
+        size_t block_start = 0;
+
+        /* Fill the block as if we were hashing max_data_len bytes of data.
+         * Bytes beyond that are masked out below. */
+        if (i == 0) {
+            memcpy(block, partial, buffered);
+            block_start = buffered;
+        }
+        if (input_idx < tail_max_len) {
+            size_t to_copy = hash.block_size - block_start;
+            if (to_copy > tail_max_len - input_idx) {
+                to_copy = tail_max_len - input_idx;
+            }
+            memcpy(block + block_start, tail + input_idx, to_copy);
+        }
+
+        /* Zero any bytes beyond the secret length and add the 0x80 byte */
+        for (j = block_start; j < hash.block_size; j++) {
+            size_t idx = input_idx + j - block_start;
+            mbedtls_ct_condition_t in_bounds = mbedtls_ct_uint_lt(idx, tail_len_secret);
+            mbedtls_ct_condition_t is_padding = mbedtls_ct_uint_eq(idx, tail_len_secret);
+            block[j] = (unsigned char) (mbedtls_ct_uint_if_else_0(in_bounds, block[j]) |
+                                        mbedtls_ct_uint_if_else_0(is_padding, 0x80));
+        }
+        input_idx += hash.block_size - block_start;
+
+        /* Add the length if this is the final block */
+        is_last_block = mbedtls_ct_uint_eq(i, last_block);
+        for (j = 0; j < sizeof(length_bytes); j++) {
+            block[hash.block_size - sizeof(length_bytes) + j] |=
+                (unsigned char) mbedtls_ct_uint_if_else_0(is_last_block, length_bytes[j]);
+        }
+
+        /* Keep only the chaining value after the final block */
+        ret = ssl_ct_hash_process(&hash, block, state);
+        if (ret != 0) {
+            goto cleanup;
+        }
+        mbedtls_ct_memcpy_if(is_last_block, output, state, NULL, hash.hash_size);
+    }
+
+cleanup:
+    mbedtls_platform_zeroize(block, sizeof(block));
+    mbedtls_platform_zeroize(state, sizeof(state));
+    ssl_ct_hash_free(&hash);
+    return ret;
+#else /* MBEDTLS_SSL_CT_HMAC_RAW_HASH */
+    (void) md_alg;
+    (void) ikey;
+    (void) add_data;
+    (void) add_data_len;
+    (void) data;
+    (void) data_len_secret;
+    (void) min_data_len;
+    (void) max_data_len;
+    (void) output;
+    return MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+#endif /* MBEDTLS_SSL_CT_HMAC_RAW_HASH */
+}
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
 
 #if defined(PSA_WANT_ALG_SHA_384)
@@ -79,10 +421,12 @@ int mbedtls_ct_hmac(mbedtls_svc_key_id_t key,
      * concatenation, and okey/ikey are the XOR of the key with some fixed bit
      * patterns (see RFC 2104, sec. 2).
      *
-     * We'll first compute ikey/okey, then inner_hash = HASH(ikey + msg) by
-     * hashing up to minlen, then cloning the context, and for each byte up
-     * to maxlen finishing up the hash computation, keeping only the
-     * correct result.
+     * We'll first compute ikey/okey, then inner_hash = HASH(ikey + msg).
+     * If we have a built-in implementation of the hash, this is done with
+     * ssl_ct_hmac_inner_hash(), which calls the compression function a
+     * number of times that only depends on maxlen. Otherwise, we hash up to
+     * minlen, then clone the context, and for each byte up to maxlen finish
+     * up the hash computation, keeping only the correct result.
      *
      * Then we only need to compute HASH(okey + inner_hash) and we're done.
      */
@@ -97,6 +441,7 @@ int mbedtls_ct_hmac(mbedtls_svc_key_id_t key,
     psa_hash_operation_t aux_operation = PSA_HASH_OPERATION_INIT;
     size_t offset;
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
 
     size_t mac_key_length;
     size_t i;
@@ -123,35 +468,47 @@ int mbedtls_ct_hmac(mbedtls_svc_key_id_t key,
         key_buf[i] = 0x36;
     }
 
-    PSA_CHK(psa_hash_setup(&operation, hash_alg));
-
-    /* Now compute inner_hash = HASH(ikey + msg) */
-    PSA_CHK(psa_hash_update(&operation, key_buf, block_size));
-    PSA_CHK(psa_hash_update(&operation, add_data, add_data_len));
-    PSA_CHK(psa_hash_update(&operation, data, min_data_len));
-
     /* Fill the hash buffer in advance with something that is
      * not a valid hash (barring an attack on the hash and
      * deliberately-crafted input), in case the caller doesn't
      * check the return status properly. */
     memset(output, '!', hash_size);
 
-    /* For each possible length, compute the hash up to that point */
-    for (offset = min_data_len; offset <= max_data_len; offset++) {
-        PSA_CHK(psa_hash_clone(&operation, &aux_operation));
-        PSA_CHK(psa_hash_finish(&aux_operation, aux_out,
-                                PSA_HASH_MAX_SIZE, &hash_length));
-        /* Keep only the correct inner_hash in the output buffer */
-        mbedtls_ct_memcpy_if(mbedtls_ct_uint_eq(offset, data_len_secret),
-                             output, aux_out, NULL, hash_size);
-
-        if (offset < max_data_len) {
-            PSA_CHK(psa_hash_update(&operation, data + offset, 1));
+    /* Now compute inner_hash = HASH(ikey + msg), directly with the
+     * compression function if we have a built-in implementation. */
+    ret = ssl_ct_hmac_inner_hash(mbedtls_md_type_from_psa_alg(hash_alg),
+                                 key_buf, add_data, add_data_len,
+                                 data, data_len_secret,
+                                 min_data_len, max_data_len, output);
+    if (ret == MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE) {
+        /* Otherwise, hash up to min_data_len, then for each byte up to
+         * max_data_len, finish up a clone of the hash computation, keeping
+         * only the correct result. */
+        PSA_CHK(psa_hash_setup(&operation, hash_alg));
+
+        PSA_CHK(psa_hash_update(&operation, key_buf, block_size));
+        PSA_CHK(psa_hash_update(&operation, add_data, add_data_len));
+        PSA_CHK(psa_hash_update(&operation, data, min_data_len));
+
+        /* For each possible length, compute the hash up to that point */
+        for (offset = min_data_len; offset <= max_data_len; offset++) {
+            PSA_CHK(psa_hash_clone(&operation, &aux_operation));
+            PSA_CHK(psa_hash_finish(&aux_operation, aux_out,
+                                    PSA_HASH_MAX_SIZE, &hash_length));
+            /* Keep only the correct inner_hash in the output buffer */
+            mbedtls_ct_memcpy_if(mbedtls_ct_uint_eq(offset, data_len_secret),
+                                 output, aux_out, NULL, hash_size);
+
+            if (offset < max_data_len) {
+                PSA_CHK(psa_hash_update(&operation, data + offset, 1));
+            }
         }
-    }
 
-    /* Abort current operation to prepare for final operation */
-    PSA_CHK(psa_hash_abort(&operation));
+        /* Abort current operation to prepare for final operation */
+        PSA_CHK(psa_hash_abort(&operation));
+    } else if (ret != 0) {
+        goto cleanup;
+    }
 
     /* Calculate okey */
     for (i = 0; i < mac_key_length; i++) {
@@ -175,6 +532,9 @@ cleanup:
 
     psa_hash_abort(&operation);
     psa_hash_abort(&aux_operation);
+    if (ret != 0 && ret != MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE) {
+        return ret;
+    }
     return PSA_TO_MBEDTLS_ERR(status);
 }
 
@@ -199,9 +559,12 @@ int mbedtls_ct_hmac(mbedtls_md_context_t *ctx,
      * concatenation, and okey/ikey are the XOR of the key with some fixed bit
      * patterns (see RFC 2104, sec. 2), which are stored in ctx->hmac_ctx.
      *
-     * We'll first compute inner_hash = HASH(ikey + msg) by hashing up to
-     * minlen, then cloning the context, and for each byte up to maxlen
-     * finishing up the hash computation, keeping only the correct result.
+     * We'll first compute inner_hash = HASH(ikey + msg). If we have a
+     * built-in implementation of the hash, this is done with
+     * ssl_ct_hmac_inner_hash(), which calls the compression function a
+     * number of times that only depends on maxlen. Otherwise, we hash up to
+     * minlen, then clone the context, and for each byte up to maxlen finish
+     * up the hash computation, keeping only the correct result.
      *
      * Then we only need to compute HASH(okey + inner_hash) and we're done.
      */
@@ -227,34 +590,41 @@ int mbedtls_ct_hmac(mbedtls_md_context_t *ctx,
         goto cleanup;   \
     } while (0)
 
-    MD_CHK(mbedtls_md_setup(&aux, ctx->md_info, 0));
-
-    /* After hmac_start() of hmac_reset(), ikey has already been hashed,
-     * so we can start directly with the message */
-    MD_CHK(mbedtls_md_update(ctx, add_data, add_data_len));
-    MD_CHK(mbedtls_md_update(ctx, data, min_data_len));
-
     /* Fill the hash buffer in advance with something that is
      * not a valid hash (barring an attack on the hash and
      * deliberately-crafted input), in case the caller doesn't
      * check the return status properly. */
     memset(output, '!', hash_size);
 
-    /* For each possible length, compute the hash up to that point */
-    for (offset = min_data_len; offset <= max_data_len; offset++) {
-        MD_CHK(mbedtls_md_clone(&aux, ctx));
-        MD_CHK(mbedtls_md_finish(&aux, aux_out));
-        /* Keep only the correct inner_hash in the output buffer */
-        mbedtls_ct_memcpy_if(mbedtls_ct_uint_eq(offset, data_len_secret),
-                             output, aux_out, NULL, hash_size);
-
-        if (offset < max_data_len) {
-            MD_CHK(mbedtls_md_update(ctx, data + offset, 1));
+    ret = ssl_ct_hmac_inner_hash(md_alg, ikey, add_data, add_data_len,
+                                 data, data_len_secret,
+                                 min_data_len, max_data_len, output);
+    if (ret == MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE) {
+        MD_CHK(mbedtls_md_setup(&aux, ctx->md_info, 0));
+
+        /* After hmac_start() of hmac_reset(), ikey has already been hashed,
+         * so we can start directly with the message */
+        MD_CHK(mbedtls_md_update(ctx, add_data, add_data_len));
+        MD_CHK(mbedtls_md_update(ctx, data, min_data_len));
+
+        /* For each possible length, compute the hash up to that point */
+        for (offset = min_data_len; offset <= max_data_len; offset++) {
+            MD_CHK(mbedtls_md_clone(&aux, ctx));
+            MD_CHK(mbedtls_md_finish(&aux, aux_out));
+            /* Keep only the correct inner_hash in the output buffer */
+            mbedtls_ct_memcpy_if(mbedtls_ct_uint_eq(offset, data_len_secret),
+                                 output, aux_out, NULL, hash_size);
+
+            if (offset < max_data_len) {
+                MD_CHK(mbedtls_md_update(ctx, data + offset, 1));
+            }
         }
-    }
 
-    /* The context needs to finish() before it starts() again */
-    MD_CHK(mbedtls_md_finish(ctx, aux_out));
+        /* The context needs to finish() before it starts() again */
+        MD_CHK(mbedtls_md_finish(ctx, aux_out));
+    } else if (ret != 0) {
+        goto cleanup;
+    }
 
     /* Now compute HASH(okey + inner_hash) */
     MD_CHK(mbedtls_md_starts(ctx));
@@ -3218,8 +3588,196 @@ static uint32_t ssl_get_hs_total_len(mbedtls_ssl_context const *ssl)
     return MBEDTLS_GET_UINT24_BE(ssl->in_msg, 1);
 }
 
+void mbedtls_ssl_hs_reasm_free(mbedtls_ssl_context *ssl)
+{
+    mbedtls_ssl_hs_reasm *reasm = ssl->in_hs_reasm;
+
+    if (reasm == NULL) {
+        return;
+    }
+
+    (void) mbedtls_mps_reader_free(&reasm->rd);
+    if (reasm->msg != NULL) {
+        mbedtls_zeroize_and_free(reasm->msg, reasm->len);
+    }
+    mbedtls_zeroize_and_free(reasm, sizeof(mbedtls_ssl_hs_reasm));
+    ssl->in_hs_reasm = NULL;
+}
+
+/*
+ * With TLS, a handshake message may span several records. Tell whether the
+ * current record holds (the start of) such a message, or the continuation
+ * of one. Messages that fit in the record are processed in place.
+ */
+static int ssl_hs_needs_reassembly(mbedtls_ssl_context const *ssl)
+{
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    if (ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM) {
+        return 0;
+    }
+#endif /* MBEDTLS_SSL_PROTO_DTLS */
+
+    if (ssl->in_hs_reasm != NULL) {
+        return !mbedtls_ssl_hs_reasm_is_complete(ssl);
+    }
+
+    /* Empty handshake records are rejected by the caller. */
+    if (ssl->in_msglen == 0) {
+        return 0;
+    }
+
+    return ssl->in_msglen < mbedtls_ssl_hs_hdr_len(ssl) ||
+           ssl->in_msglen - mbedtls_ssl_hs_hdr_len(ssl) < ssl_get_hs_total_len(ssl);
+}
+
+/*
+ * Add the current handshake record, or what is left of it after previous
+ * messages, to the message being reassembled.
+ *
+ * The fragments are fed to an MPS reader whose accumulator is a buffer of
+ * exactly the length of the message, allocated once its header is known.
+ * The header itself, which may also be split, is first collected in
+ * reasm->hdr and fed to the reader as the first fragment.
+ *
+ * Return MBEDTLS_ERR_SSL_CONTINUE_PROCESSING once the record has been
+ * consumed and more are needed, or 0 when the message is complete, in which
+ * case in_msg, in_msglen and in_hslen describe the reassembled message
+ * until ssl_consume_current_message() gets back to the current record.
+ */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int ssl_hs_reasm_feed(mbedtls_ssl_context *ssl)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_ssl_hs_reasm *reasm = ssl->in_hs_reasm;
+    unsigned char *frag = ssl->in_msg;
+    size_t frag_len = ssl->in_msglen;
+    unsigned char *msg;
+    size_t used = 0;
+    int paused;
+
+    if (reasm == NULL) {
+        reasm = mbedtls_calloc(1, sizeof(mbedtls_ssl_hs_reasm));
+        if (reasm == NULL) {
+            MBEDTLS_SSL_DEBUG_MSG(1, ("alloc(%" MBEDTLS_PRINTF_SIZET
+                                      " bytes) failed",
+                                      sizeof(mbedtls_ssl_hs_reasm)));
+            return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        }
+        ssl->in_hs_reasm = reasm;
+    }
+
+    if (reasm->len == 0) {
+        used = sizeof(reasm->hdr) - reasm->filled;
+        if (used > frag_len) {
+            used = frag_len;
+        }
+
+        memcpy(reasm->hdr + reasm->filled, frag, used);
+        reasm->filled += used;
+        if (reasm->filled < sizeof(reasm->hdr)) {
+            goto need_more;
+        }
+
+        reasm->len = sizeof(reasm->hdr) + MBEDTLS_GET_UINT24_BE(reasm->hdr, 1);
+
+        MBEDTLS_SSL_DEBUG_MSG(2, ("reassembling handshake message: type = %u, hslen = %"
+                                  MBEDTLS_PRINTF_SIZET, reasm->hdr[0], reasm->len));
+
+        if (reasm->len > MBEDTLS_SSL_IN_HS_MAX_LEN) {
+            MBEDTLS_SSL_DEBUG_MSG(1, ("handshake message too long: %" MBEDTLS_PRINTF_SIZET
+                                      " > %d", reasm->len, MBEDTLS_SSL_IN_HS_MAX_LEN));
+            /* Not filled in: don't let mbedtls_ssl_hs_reasm_free() look
+             * for a message buffer of that length. */
+            reasm->len = 0;
+            return MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+        }
+
+        reasm->msg = mbedtls_calloc(1, reasm->len);
+        if (reasm->msg == NULL) {
+            MBEDTLS_SSL_DEBUG_MSG(1, ("alloc(%" MBEDTLS_PRINTF_SIZET " bytes) failed",
+                                      reasm->len));
+            reasm->len = 0;
+            return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        }
+
+        if (reasm->len == sizeof(reasm->hdr)) {
+            /* Empty message body, e.g. ServerHelloDone */
+            memcpy(reasm->msg, reasm->hdr, sizeof(reasm->hdr));
+            goto done;
+        }
+
+        /* Asking for the whole message right away pauses the reader, with
+         * the header already copied to the accumulator. */
+        (void) mbedtls_mps_reader_init(&reasm->rd, reasm->msg, reasm->len);
+        if (mbedtls_mps_reader_feed(&reasm->rd, reasm->hdr, sizeof(reasm->hdr)) != 0 ||
+            mbedtls_mps_reader_get(&reasm->rd, reasm->len, &msg, NULL) !=
+            MBEDTLS_ERR_MPS_READER_OUT_OF_DATA ||
+            mbedtls_mps_reader_reclaim(&reasm->rd, &paused) != 0 || paused == 0) {
+            MBEDTLS_SSL_DEBUG_MSG(1, ("should never happen"));
+            return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
+
+        frag += used;
+        frag_len -= used;
+    }
+
+    ret = mbedtls_mps_reader_feed(&reasm->rd, frag, frag_len);
+    if (ret == MBEDTLS_ERR_MPS_READER_NEED_MORE) {
+        reasm->filled += frag_len;
+        goto need_more;
+    }
+    if (ret != 0) {
+        MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_mps_reader_feed", ret);
+        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    }
+
+    used += reasm->len - reasm->filled;
+    reasm->filled = reasm->len;
+
+    /* Served from the accumulator, that is reasm->msg */
+    ret = mbedtls_mps_reader_get(&reasm->rd, reasm->len, &msg, NULL);
+    if (ret != 0 || msg != reasm->msg) {
+        MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_mps_reader_get", ret);
+        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    }
+    (void) mbedtls_mps_reader_commit(&reasm->rd);
+
+done:
+    MBEDTLS_SSL_DEBUG_MSG(2, ("handshake message reassembled, %" MBEDTLS_PRINTF_SIZET
+                              " of %" MBEDTLS_PRINTF_SIZET " bytes left in record",
+                              ssl->in_msglen - used, ssl->in_msglen));
+
+    reasm->filled = reasm->len;
+    reasm->rec_offset = (size_t) (ssl->in_msg - ssl->in_buf);
+    reasm->rec_len = ssl->in_msglen;
+    reasm->rec_used = used;
+
+    ssl->in_msg = reasm->msg;
+    ssl->in_msglen = reasm->len;
+    ssl->in_hslen = reasm->len;
+
+    return 0;
+
+need_more:
+    MBEDTLS_SSL_DEBUG_MSG(3, ("handshake message incomplete: %" MBEDTLS_PRINTF_SIZET
+                              " bytes received", reasm->filled));
+
+    /* The whole record went into the message being reassembled. */
+    ssl->in_msglen = 0;
+    ssl->in_hslen = 0;
+
+    return MBEDTLS_ERR_SSL_CONTINUE_PROCESSING;
+}
+
 int mbedtls_ssl_prepare_handshake_record(mbedtls_ssl_context *ssl)
 {
+    if (ssl_hs_needs_reassembly(ssl)) {
+        int ret = ssl_hs_reasm_feed(ssl);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
     if (ssl->in_msglen < mbedtls_ssl_hs_hdr_len(ssl)) {
         MBEDTLS_SSL_DEBUG_MSG(1, ("handshake message too short: %" MBEDTLS_PRINTF_SIZET,
                                   ssl->in_msglen));
@@ -3292,10 +3850,10 @@ int mbedtls_ssl_prepare_handshake_record(mbedtls_ssl_context *ssl)
         }
     } else
 #endif /* MBEDTLS_SSL_PROTO_DTLS */
-    /* With TLS we don't handle fragmentation (for now) */
+    /* With TLS, messages spanning several records have been reassembled */
     if (ssl->in_msglen < ssl->in_hslen) {
-        MBEDTLS_SSL_DEBUG_MSG(1, ("TLS handshake fragmentation not supported"));
-        return MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+        MBEDTLS_SSL_DEBUG_MSG(1, ("should never happen"));
+        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
     }
 
     return 0;
@@ -4661,6 +5219,16 @@ static int ssl_consume_current_message(mbedtls_ssl_context *ssl)
          *     bounds after handling a DTLS message with an unexpected
          *     sequence number, see mbedtls_ssl_prepare_handshake_record.
          */
+
+        /* A message reassembled from several records ends within the
+         * record that held its last fragment: get back to that record. */
+        if (mbedtls_ssl_hs_reasm_is_complete(ssl)) {
+            ssl->in_msg    = ssl->in_buf + ssl->in_hs_reasm->rec_offset;
+            ssl->in_msglen = ssl->in_hs_reasm->rec_len;
+            ssl->in_hslen  = ssl->in_hs_reasm->rec_used;
+            mbedtls_ssl_hs_reasm_free(ssl);
+        }
+
         if (ssl->in_hslen < ssl->in_msglen) {
             ssl->in_msglen -= ssl->in_hslen;
             memmove(ssl->in_msg, ssl->in_msg + ssl->in_hslen,
@@ -5028,6 +5596,18 @@ int mbedtls_ssl_handle_message_type(mbedtls_ssl_context *ssl)
 {
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
 
+    /*
+     * Handshake messages must not be interleaved with other record types
+     * (RFC 8446, section 5.1), but let alerts through.
+     */
+    if (ssl->in_hs_reasm != NULL &&
+        ssl->in_msgtype != MBEDTLS_SSL_MSG_HANDSHAKE &&
+        ssl->in_msgtype != MBEDTLS_SSL_MSG_ALERT) {
+        MBEDTLS_SSL_DEBUG_MSG(1, ("record of type %d within a fragmented handshake message",
+                                  ssl->in_msgtype));
+        return MBEDTLS_ERR_SSL_UNEXPECTED_MESSAGE;
+    }
+
     /*
      * Handle particular types of records
      */
@@ -5423,6 +6003,15 @@ int mbedtls_ssl_check_pending(const mbedtls_ssl_context *ssl)
         return 1;
     }
 
+    /* in_msg is a reassembled handshake message: the record that held its
+     * last fragment may have more content. */
+    if (mbedtls_ssl_hs_reasm_is_complete(ssl) &&
+        ssl->in_hs_reasm->rec_used < ssl->in_hs_reasm->rec_len) {
+        MBEDTLS_SSL_DEBUG_MSG(3,
+                              ("ssl_check_pending: more handshake messages after reassembled message"));
+        return 1;
+    }
+
     /*
      * Case D: An application data message is being processed
      */
@@ -5968,6 +6557,79 @@ int mbedtls_ssl_read_early_data(mbedtls_ssl_context *ssl,
 }
 #endif /* MBEDTLS_SSL_SRV_C && MBEDTLS_SSL_EARLY_DATA */
 
+/*
+ * Dynamic record sizing: keep application data records small enough to fit
+ * in a single TCP segment at the start of the connection and after an idle
+ * period, so that the peer can decrypt the first bytes as soon as they
+ * arrive instead of waiting for a full 16 KiB record, and ramp up to
+ * full-size records once enough data has been sent.
+ */
+static size_t ssl_dynamic_record_limit(const mbedtls_ssl_context *ssl,
+                                       size_t max_len)
+{
+    const mbedtls_ssl_config *conf = ssl->conf;
+    int expansion;
+
+    if (conf->record_size_initial == 0 ||
+        conf->transport != MBEDTLS_SSL_TRANSPORT_STREAM ||
+        ssl->out_ramp_len >= conf->record_size_ramp) {
+        return max_len;
+    }
+
+    expansion = mbedtls_ssl_get_record_expansion(ssl);
+    if (expansion < 0 || (size_t) expansion >= conf->record_size_initial) {
+        return max_len;
+    }
+
+    if (max_len > conf->record_size_initial - (size_t) expansion) {
+        max_len = conf->record_size_initial - (size_t) expansion;
+    }
+
+    return max_len;
+}
+
+/*
+ * Start with small records again if nothing was sent for a while. This must
+ * only be called for new data, not when retrying a partial write, so that
+ * the retry uses the same record length.
+ */
+static void ssl_dynamic_record_check_idle(mbedtls_ssl_context *ssl)
+{
+#if defined(MBEDTLS_HAVE_TIME)
+    const mbedtls_ssl_config *conf = ssl->conf;
+
+    if (conf->record_size_initial != 0 && conf->record_size_idle != 0 &&
+        ssl->out_ramp_len != 0 &&
+        mbedtls_ms_time() - ssl->out_last_time >
+        (mbedtls_ms_time_t) conf->record_size_idle) {
+        MBEDTLS_SSL_DEBUG_MSG(3, ("connection was idle, "
+                                  "using small records again"));
+        ssl->out_ramp_len = 0;
+    }
+#else
+    ((void) ssl);
+#endif
+}
+
+static void ssl_dynamic_record_update(mbedtls_ssl_context *ssl, size_t len)
+{
+    const mbedtls_ssl_config *conf = ssl->conf;
+
+    if (conf->record_size_initial == 0) {
+        return;
+    }
+
+    if (ssl->out_ramp_len < conf->record_size_ramp) {
+        ssl->out_ramp_len += len;
+    }
+
+#if defined(MBEDTLS_HAVE_TIME)
+    if (conf->record_size_idle != 0) {
+        ssl->out_last_time = mbedtls_ms_time();
+    }
+#endif
+}
+
 /*
  * Send application data to be encrypted by the SSL layer, taking care of max
  * fragment length and buffer size.
@@ -5985,13 +6647,18 @@ static int ssl_write_real(mbedtls_ssl_context *ssl,
                           const unsigned char *buf, size_t len)
 {
     int ret = mbedtls_ssl_get_max_out_record_payload(ssl);
-    const size_t max_len = (size_t) ret;
+    size_t max_len = (size_t) ret;
 
     if (ret < 0) {
         MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_ssl_get_max_out_record_payload", ret);
         return ret;
     }
 
+    if (ssl->out_left == 0) {
+        ssl_dynamic_record_check_idle(ssl);
+    }
+    max_len = ssl_dynamic_record_limit(ssl, max_len);
+
     if (len > max_len) {
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
         if (ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM) {
@@ -6034,6 +6701,8 @@ static int ssl_write_real(mbedtls_ssl_context *ssl,
         }
     }
 
+    ssl_dynamic_record_update(ssl, len);
+
     return (int) len;
 }
 
@@ -6066,6 +6735,23 @@ int mbedtls_ssl_write(mbedtls_ssl_context *ssl, const unsigned char *buf, size_t
 
     ret = ssl_write_real(ssl, buf, len);
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && \
+    defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_SSL_PROTO_TLS1_3)
+    /* Deferred tickets are sent right after the first application data.
+     * If they cannot be sent completely now, the handshake state machine
+     * resumes with them in the next call to mbedtls_ssl_read() or
+     * mbedtls_ssl_write(), which also report any error. */
+    if (ret >= 0 && ssl->handshake != NULL &&
+        ssl->handshake->new_session_tickets_deferred) {
+        int ticket_ret = mbedtls_ssl_send_new_session_tickets(ssl);
+        if (ticket_ret != 0) {
+            MBEDTLS_SSL_DEBUG_RET(2, "mbedtls_ssl_send_new_session_tickets",
+                                  ticket_ret);
+        }
+    }
+#endif
+
     MBEDTLS_SSL_DEBUG_MSG(2, ("<= write"));
 
     return ret;
@@ -15,6 +15,7 @@
 #include "mbedtls/ssl_ticket.h"
 #include "mbedtls/error.h"
 #include "mbedtls/platform_util.h"
+#include "threading_internal.h"
 
 #include <string.h>
 
@@ -38,7 +39,7 @@ void mbedtls_ssl_ticket_init(mbedtls_ssl_ticket_context *ctx)
     memset(ctx, 0, sizeof(mbedtls_ssl_ticket_context));
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init(&ctx->mutex);
+    MBEDTLS_MUTEX_INIT_NAMED(&ctx->mutex, "ssl_ticket");
 #endif
 }
 
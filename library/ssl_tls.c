@@ -25,6 +25,7 @@
 #include "mbedtls/platform_util.h"
 #include "mbedtls/version.h"
 #include "mbedtls/constant_time.h"
+#include "md_wrap.h"
 
 #include <string.h>
 
@@ -344,10 +345,14 @@ static void handle_buffer_resizing(mbedtls_ssl_context *ssl, int downsizing,
                                    size_t out_buf_new_len)
 {
     int modified = 0;
+    int in_msg_reassembled = mbedtls_ssl_hs_reasm_is_complete(ssl);
     size_t written_in = 0, iv_offset_in = 0, len_offset_in = 0;
     size_t written_out = 0, iv_offset_out = 0, len_offset_out = 0;
     if (ssl->in_buf != NULL) {
-        written_in = ssl->in_msg - ssl->in_buf;
+        /* A reassembled handshake message lives outside of in_buf. */
+        if (!in_msg_reassembled) {
+            written_in = ssl->in_msg - ssl->in_buf;
+        }
         iv_offset_in = ssl->in_iv - ssl->in_buf;
         len_offset_in = ssl->in_len - ssl->in_buf;
         if (downsizing ?
@@ -388,7 +393,11 @@ static void handle_buffer_resizing(mbedtls_ssl_context *ssl, int downsizing,
         ssl->out_len = ssl->out_buf + len_offset_out;
         ssl->out_iv = ssl->out_buf + iv_offset_out;
 
-        ssl->in_msg = ssl->in_buf + written_in;
+        if (in_msg_reassembled) {
+            ssl->in_msg = ssl->in_hs_reasm->msg;
+        } else {
+            ssl->in_msg = ssl->in_buf + written_in;
+        }
         ssl->in_len = ssl->in_buf + len_offset_in;
         ssl->in_iv = ssl->in_buf + iv_offset_in;
     }
@@ -1303,6 +1312,7 @@ static int ssl_cookie_check_dummy(void *ctx,
 void mbedtls_ssl_init(mbedtls_ssl_context *ssl)
 {
     memset(ssl, 0, sizeof(mbedtls_ssl_context));
+    ssl->dbg_threshold = -1;
 }
 
 MBEDTLS_CHECK_RETURN_CRITICAL
@@ -1505,6 +1515,7 @@ void mbedtls_ssl_session_reset_msg_layer(mbedtls_ssl_context *ssl,
     ssl->in_msgtype = 0;
     ssl->in_msglen  = 0;
     ssl->in_hslen   = 0;
+    mbedtls_ssl_hs_reasm_free(ssl);
     ssl->keep_current_message = 0;
     ssl->transform_in  = NULL;
 
@@ -1525,6 +1536,7 @@ void mbedtls_ssl_session_reset_msg_layer(mbedtls_ssl_context *ssl,
     ssl->out_msgtype = 0;
     ssl->out_msglen  = 0;
     ssl->out_left    = 0;
+    ssl->out_ramp_len = 0;
     memset(ssl->out_buf, 0, out_buf_len);
     memset(ssl->cur_out_ctr, 0, sizeof(ssl->cur_out_ctr));
     ssl->transform_out = NULL;
@@ -1693,6 +1705,19 @@ void mbedtls_ssl_conf_dbg(mbedtls_ssl_config *conf,
     conf->p_dbg      = p_dbg;
 }
 
+void mbedtls_ssl_conf_dbg_event(mbedtls_ssl_config *conf,
+                                mbedtls_ssl_dbg_event_t *f_dbg,
+                                void *p_dbg)
+{
+    conf->f_dbg_event = f_dbg;
+    conf->p_dbg_event = p_dbg;
+}
+
+void mbedtls_ssl_set_dbg_threshold(mbedtls_ssl_context *ssl, int threshold)
+{
+    ssl->dbg_threshold = threshold < 0 ? -1 : threshold;
+}
+
 void mbedtls_ssl_set_bio(mbedtls_ssl_context *ssl,
                          void *p_bio,
                          mbedtls_ssl_send_t *f_send,
@@ -2983,6 +3008,20 @@ int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *conf, unsigned char mfl_co
 }
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+void mbedtls_ssl_conf_dynamic_record_size(mbedtls_ssl_config *conf,
+                                          uint16_t record_size,
+                                          uint32_t ramp_bytes,
+                                          uint32_t idle_ms)
+{
+    conf->record_size_initial = record_size;
+    conf->record_size_ramp    = ramp_bytes;
+#if defined(MBEDTLS_HAVE_TIME)
+    conf->record_size_idle    = idle_ms;
+#else
+    ((void) idle_ms);
+#endif
+}
+
 void mbedtls_ssl_conf_legacy_renegotiation(mbedtls_ssl_config *conf, int allow_legacy)
 {
     conf->allow_legacy_renegotiation = allow_legacy;
@@ -3022,6 +3061,12 @@ void mbedtls_ssl_conf_new_session_tickets(mbedtls_ssl_config *conf,
 {
     conf->new_session_tickets_count = num_tickets;
 }
+
+void mbedtls_ssl_conf_new_session_tickets_timing(mbedtls_ssl_config *conf,
+                                                 int timing)
+{
+    conf->new_session_tickets_timing = (uint8_t) timing;
+}
 #endif
 
 void mbedtls_ssl_conf_session_tickets_cb(mbedtls_ssl_config *conf,
@@ -4873,6 +4918,10 @@ void mbedtls_ssl_handshake_free(mbedtls_ssl_context *ssl)
     ssl_key_cert_free(handshake->sni_key_cert);
 #endif /* MBEDTLS_X509_CRT_PARSE_C && MBEDTLS_SSL_SERVER_NAME_INDICATION */
 
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+    mbedtls_ssl_cert_store_release(ssl);
+#endif
+
 #if defined(MBEDTLS_SSL_ECP_RESTARTABLE_ENABLED)
     mbedtls_x509_crt_restart_free(&handshake->ecrs_ctx);
     if (handshake->ecrs_peer_cert != NULL) {
@@ -5551,6 +5600,8 @@ void mbedtls_ssl_free(mbedtls_ssl_context *ssl)
         ssl->in_buf = NULL;
     }
 
+    mbedtls_ssl_hs_reasm_free(ssl);
+
     if (ssl->transform) {
         mbedtls_ssl_transform_free(ssl->transform);
         mbedtls_free(ssl->transform);
@@ -5683,6 +5734,10 @@ static const uint16_t ssl_preset_default_sig_algs[] = {
     // == MBEDTLS_SSL_TLS12_SIG_AND_HASH_ALG(MBEDTLS_SSL_SIG_ECDSA, MBEDTLS_SSL_HASH_SHA512)
 #endif
 
+#if defined(MBEDTLS_SSL_PROTO_TLS1_3) && defined(MBEDTLS_ED25519_C)
+    MBEDTLS_TLS1_3_SIG_ED25519,
+#endif
+
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT) && defined(MBEDTLS_MD_CAN_SHA512)
     MBEDTLS_TLS1_3_SIG_RSA_PSS_RSAE_SHA512,
 #endif
@@ -6831,6 +6886,37 @@ static int tls_prf_generic(mbedtls_md_type_t md_type,
 #if defined(MBEDTLS_MD_C) &&       \
     (defined(MBEDTLS_MD_CAN_SHA256) || \
     defined(MBEDTLS_MD_CAN_SHA384))
+/*
+ * Compute HMAC(secret, data1 + data2) from the keyed inner and outer hash
+ * states: this only hashes the data and the inner hash, without going
+ * through ikey and okey again.
+ */
+MBEDTLS_CHECK_RETURN_CRITICAL
+static int tls_prf_hmac(mbedtls_md_context_t *work,
+                        const mbedtls_md_context_t *inner,
+                        const mbedtls_md_context_t *outer,
+                        const unsigned char *data1, size_t len1,
+                        const unsigned char *data2, size_t len2,
+                        unsigned char *output, size_t md_len)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if ((ret = mbedtls_md_clone(work, inner)) != 0 ||
+        (ret = mbedtls_md_update(work, data1, len1)) != 0 ||
+        (ret = mbedtls_md_update(work, data2, len2)) != 0 ||
+        (ret = mbedtls_md_finish(work, output)) != 0) {
+        return ret;
+    }
+
+    if ((ret = mbedtls_md_clone(work, outer)) != 0 ||
+        (ret = mbedtls_md_update(work, output, md_len)) != 0 ||
+        (ret = mbedtls_md_finish(work, output)) != 0) {
+        return ret;
+    }
+
+    return 0;
+}
+
 MBEDTLS_CHECK_RETURN_CRITICAL
 static int tls_prf_generic(mbedtls_md_type_t md_type,
                            const unsigned char *secret, size_t slen,
@@ -6838,22 +6924,26 @@ static int tls_prf_generic(mbedtls_md_type_t md_type,
                            const unsigned char *random, size_t rlen,
                            unsigned char *dstbuf, size_t dlen)
 {
-    size_t nb;
-    size_t i, j, k, md_len;
+    size_t nb, block_size;
+    size_t i, k, md_len;
     unsigned char *tmp;
     size_t tmp_len = 0;
     unsigned char h_i[MBEDTLS_MD_MAX_SIZE];
+    unsigned char pad[MBEDTLS_MD_MAX_BLOCK_SIZE];
     const mbedtls_md_info_t *md_info;
-    mbedtls_md_context_t md_ctx;
+    mbedtls_md_context_t md_ctx, inner, outer;
     int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
 
     mbedtls_md_init(&md_ctx);
+    mbedtls_md_init(&inner);
+    mbedtls_md_init(&outer);
 
     if ((md_info = mbedtls_md_info_from_type(md_type)) == NULL) {
         return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
     }
 
     md_len = mbedtls_md_get_size(md_info);
+    block_size = md_info->block_size;
 
     tmp_len = md_len + strlen(label) + rlen;
     tmp = mbedtls_calloc(1, tmp_len);
@@ -6869,66 +6959,85 @@ static int tls_prf_generic(mbedtls_md_type_t md_type,
 
     /*
      * Compute P_<hash>(secret, label + random)[0..dlen]
+     *
+     * Every block costs two HMAC computations with the same key. Rather
+     * than restarting HMAC each time, keep the hash states right after
+     * ikey and okey have been absorbed, and clone them for each HMAC.
      */
-    if ((ret = mbedtls_md_setup(&md_ctx, md_info, 1)) != 0) {
+    if ((ret = mbedtls_md_setup(&md_ctx, md_info, 0)) != 0 ||
+        (ret = mbedtls_md_setup(&inner, md_info, 0)) != 0 ||
+        (ret = mbedtls_md_setup(&outer, md_info, 0)) != 0) {
         goto exit;
     }
 
-    ret = mbedtls_md_hmac_starts(&md_ctx, secret, slen);
-    if (ret != 0) {
+    if (slen > block_size) {
+        ret = mbedtls_md(md_info, secret, slen, h_i);
+        if (ret != 0) {
+            goto exit;
+        }
+        secret = h_i;
+        slen = md_len;
+    }
+
+    /* inner = H(ikey || ...), outer = H(okey || ...) */
+    memset(pad, 0x36, block_size);
+    mbedtls_xor(pad, pad, secret, slen);
+    if ((ret = mbedtls_md_starts(&inner)) != 0 ||
+        (ret = mbedtls_md_update(&inner, pad, block_size)) != 0) {
         goto exit;
     }
-    ret = mbedtls_md_hmac_update(&md_ctx, tmp + md_len, nb);
-    if (ret != 0) {
+
+    memset(pad, 0x5C, block_size);
+    mbedtls_xor(pad, pad, secret, slen);
+    if ((ret = mbedtls_md_starts(&outer)) != 0 ||
+        (ret = mbedtls_md_update(&outer, pad, block_size)) != 0) {
         goto exit;
     }
-    ret = mbedtls_md_hmac_finish(&md_ctx, tmp);
+
+    /* A(1) = HMAC(secret, label + random) */
+    ret = tls_prf_hmac(&md_ctx, &inner, &outer,
+                       tmp + md_len, nb, NULL, 0,
+                       tmp, md_len);
     if (ret != 0) {
         goto exit;
     }
 
     for (i = 0; i < dlen; i += md_len) {
-        ret = mbedtls_md_hmac_reset(&md_ctx);
-        if (ret != 0) {
-            goto exit;
-        }
-        ret = mbedtls_md_hmac_update(&md_ctx, tmp, md_len + nb);
-        if (ret != 0) {
-            goto exit;
-        }
-        ret = mbedtls_md_hmac_finish(&md_ctx, h_i);
+        /* HMAC(secret, A(i) + label + random) */
+        ret = tls_prf_hmac(&md_ctx, &inner, &outer,
+                           tmp, md_len, tmp + md_len, nb,
+                           h_i, md_len);
         if (ret != 0) {
             goto exit;
         }
 
-        ret = mbedtls_md_hmac_reset(&md_ctx);
-        if (ret != 0) {
-            goto exit;
-        }
-        ret = mbedtls_md_hmac_update(&md_ctx, tmp, md_len);
-        if (ret != 0) {
-            goto exit;
+        k = (i + md_len > dlen) ? dlen % md_len : md_len;
+        memcpy(dstbuf + i, h_i, k);
+
+        if (i + md_len >= dlen) {
+            break;
         }
-        ret = mbedtls_md_hmac_finish(&md_ctx, tmp);
+
+        /* A(i+1) = HMAC(secret, A(i)) */
+        ret = tls_prf_hmac(&md_ctx, &inner, &outer,
+                           tmp, md_len, NULL, 0,
+                           tmp, md_len);
         if (ret != 0) {
             goto exit;
         }
-
-        k = (i + md_len > dlen) ? dlen % md_len : md_len;
-
-        for (j = 0; j < k; j++) {
-            dstbuf[i + j]  = h_i[j];
-        }
     }
 
 exit:
     mbedtls_md_free(&md_ctx);
+    mbedtls_md_free(&inner);
+    mbedtls_md_free(&outer);
 
     if (tmp != NULL) {
         mbedtls_platform_zeroize(tmp, tmp_len);
     }
 
     mbedtls_platform_zeroize(h_i, sizeof(h_i));
+    mbedtls_platform_zeroize(pad, sizeof(pad));
 
     mbedtls_free(tmp);
 
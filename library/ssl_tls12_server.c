@@ -1003,6 +1003,9 @@ read_record_header:
 #endif
     {
         if (ssl->keep_current_message) {
+            /* Set by mbedtls_ssl_read_record() in the TLS 1.3 code, which
+             * may have reassembled the message from several records. */
+            msg_len = ssl->in_msglen;
             ssl->keep_current_message = 0;
         } else {
             if (msg_len > MBEDTLS_SSL_IN_CONTENT_LEN) {
@@ -1578,6 +1581,12 @@ read_record_header:
     /*
      * Server certification selection (after processing TLS extensions)
      */
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+    if ((ret = mbedtls_ssl_cert_store_select(ssl)) != 0) {
+        MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_ssl_cert_store_select", ret);
+        return ret;
+    }
+#endif
     if (ssl->conf->f_cert_cb && (ret = ssl->conf->f_cert_cb(ssl)) != 0) {
         MBEDTLS_SSL_DEBUG_RET(1, "f_cert_cb", ret);
         return ret;
@@ -227,6 +227,8 @@ static int ssl_tls13_parse_certificate_verify(mbedtls_ssl_context *ssl,
     psa_algorithm_t hash_alg = PSA_ALG_NONE;
     unsigned char verify_hash[PSA_HASH_MAX_SIZE];
     size_t verify_hash_len;
+    const unsigned char *signed_data;
+    size_t signed_len;
 
     void const *options = NULL;
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT)
@@ -272,9 +274,12 @@ static int ssl_tls13_parse_certificate_verify(mbedtls_ssl_context *ssl,
         goto error;
     }
 
-    hash_alg = mbedtls_md_psa_alg_from_type(md_alg);
-    if (hash_alg == 0) {
-        goto error;
+    /* Pure EdDSA is the only scheme signing the verify structure itself. */
+    if (md_alg != MBEDTLS_MD_NONE) {
+        hash_alg = mbedtls_md_psa_alg_from_type(md_alg);
+        if (hash_alg == 0) {
+            goto error;
+        }
     }
 
     MBEDTLS_SSL_DEBUG_MSG(3, ("Certificate Verify: Signature algorithm ( %04x )",
@@ -293,18 +298,25 @@ static int ssl_tls13_parse_certificate_verify(mbedtls_ssl_context *ssl,
     p += 2;
     MBEDTLS_SSL_CHK_BUF_READ_PTR(p, end, signature_len);
 
-    status = psa_hash_compute(hash_alg,
-                              verify_buffer,
-                              verify_buffer_len,
-                              verify_hash,
-                              sizeof(verify_hash),
-                              &verify_hash_len);
-    if (status != PSA_SUCCESS) {
-        MBEDTLS_SSL_DEBUG_RET(1, "hash computation PSA error", status);
-        goto error;
-    }
+    if (hash_alg == PSA_ALG_NONE) {
+        signed_data = verify_buffer;
+        signed_len = verify_buffer_len;
+    } else {
+        status = psa_hash_compute(hash_alg,
+                                  verify_buffer,
+                                  verify_buffer_len,
+                                  verify_hash,
+                                  sizeof(verify_hash),
+                                  &verify_hash_len);
+        if (status != PSA_SUCCESS) {
+            MBEDTLS_SSL_DEBUG_RET(1, "hash computation PSA error", status);
+            goto error;
+        }
 
-    MBEDTLS_SSL_DEBUG_BUF(3, "verify hash", verify_hash, verify_hash_len);
+        MBEDTLS_SSL_DEBUG_BUF(3, "verify hash", verify_hash, verify_hash_len);
+        signed_data = verify_hash;
+        signed_len = verify_hash_len;
+    }
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT)
     if (sig_alg == MBEDTLS_PK_RSASSA_PSS) {
         rsassa_pss_options.mgf1_hash_id = md_alg;
@@ -316,7 +328,7 @@ static int ssl_tls13_parse_certificate_verify(mbedtls_ssl_context *ssl,
 
     if ((ret = mbedtls_pk_verify_ext(sig_alg, options,
                                      &ssl->session_negotiate->peer_cert->pk,
-                                     md_alg, verify_hash, verify_hash_len,
+                                     md_alg, signed_data, signed_len,
                                      p, signature_len)) == 0) {
         return 0;
     }
@@ -960,6 +972,12 @@ int mbedtls_ssl_tls13_check_sig_alg_cert_key_match(uint16_t sig_alg,
     mbedtls_pk_type_t pk_type = (mbedtls_pk_type_t) mbedtls_ssl_sig_from_pk(key);
     size_t key_size = mbedtls_pk_get_bitlen(key);
 
+#if defined(MBEDTLS_ED25519_C)
+    if (mbedtls_pk_get_type(key) == MBEDTLS_PK_ED25519) {
+        return sig_alg == MBEDTLS_TLS1_3_SIG_ED25519;
+    }
+#endif /* MBEDTLS_ED25519_C */
+
     switch (pk_type) {
         case MBEDTLS_SSL_SIG_ECDSA:
             switch (key_size) {
@@ -1057,6 +1075,8 @@ static int ssl_tls13_write_certificate_verify_body(mbedtls_ssl_context *ssl,
         psa_algorithm_t psa_algorithm = PSA_ALG_NONE;
         unsigned char verify_hash[PSA_HASH_MAX_SIZE];
         size_t verify_hash_len;
+        const unsigned char *signed_data = verify_hash;
+        size_t signed_len;
 
         if (!mbedtls_ssl_sig_alg_is_offered(ssl, *sig_alg)) {
             continue;
@@ -1075,21 +1095,28 @@ static int ssl_tls13_write_certificate_verify_body(mbedtls_ssl_context *ssl,
             return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
         }
 
-        /* Hash verify buffer with indicated hash function */
-        psa_algorithm = mbedtls_md_psa_alg_from_type(md_alg);
-        status = psa_hash_compute(psa_algorithm,
-                                  verify_buffer,
-                                  verify_buffer_len,
-                                  verify_hash, sizeof(verify_hash),
-                                  &verify_hash_len);
-        if (status != PSA_SUCCESS) {
-            return PSA_TO_MBEDTLS_ERR(status);
-        }
+        if (md_alg == MBEDTLS_MD_NONE) {
+            /* Pure EdDSA signs the verify buffer itself. */
+            signed_data = verify_buffer;
+            signed_len = verify_buffer_len;
+        } else {
+            /* Hash verify buffer with indicated hash function */
+            psa_algorithm = mbedtls_md_psa_alg_from_type(md_alg);
+            status = psa_hash_compute(psa_algorithm,
+                                      verify_buffer,
+                                      verify_buffer_len,
+                                      verify_hash, sizeof(verify_hash),
+                                      &verify_hash_len);
+            if (status != PSA_SUCCESS) {
+                return PSA_TO_MBEDTLS_ERR(status);
+            }
 
-        MBEDTLS_SSL_DEBUG_BUF(3, "verify hash", verify_hash, verify_hash_len);
+            MBEDTLS_SSL_DEBUG_BUF(3, "verify hash", verify_hash, verify_hash_len);
+            signed_len = verify_hash_len;
+        }
 
         if ((ret = mbedtls_pk_sign_ext(pk_type, own_key,
-                                       md_alg, verify_hash, verify_hash_len,
+                                       md_alg, signed_data, signed_len,
                                        p + 4, (size_t) (end - (p + 4)), &signature_len,
                                        ssl->conf->f_rng, ssl->conf->p_rng)) != 0) {
             MBEDTLS_SSL_DEBUG_MSG(2, ("CertificateVerify signature failed with %s",
@@ -143,19 +143,55 @@ int mbedtls_ssl_tls13_hkdf_expand_label(
     const unsigned char *label, size_t label_len,
     const unsigned char *ctx, size_t ctx_len,
     unsigned char *buf, size_t buf_len)
+{
+    const mbedtls_ssl_tls13_hkdf_label output =
+    { label, label_len, buf, buf_len };
+
+    return mbedtls_ssl_tls13_hkdf_expand_labels(hash_alg,
+                                                secret, secret_len,
+                                                ctx, ctx_len,
+                                                &output, 1);
+}
+
+/*
+ * HKDF-Expand (RFC 5869) is computed here on top of the hash rather than
+ * through a PSA key derivation operation. This way the HMAC key schedule,
+ * i.e. hashing the padded secret into the inner and outer states, is done
+ * once per secret; each output block then only clones the keyed states:
+ *
+ *   T(0) = empty string
+ *   T(i) = HMAC(Secret, T(i-1) | HkdfLabel | i)
+ */
+int mbedtls_ssl_tls13_hkdf_expand_labels(
+    psa_algorithm_t hash_alg,
+    const unsigned char *secret, size_t secret_len,
+    const unsigned char *ctx, size_t ctx_len,
+    const mbedtls_ssl_tls13_hkdf_label *labels, size_t count)
 {
     unsigned char hkdf_label[SSL_TLS1_3_KEY_SCHEDULE_MAX_HKDF_LABEL_LEN];
     size_t hkdf_label_len = 0;
+    unsigned char pad[PSA_HMAC_MAX_HASH_BLOCK_SIZE];
+    unsigned char t[PSA_HASH_MAX_SIZE];
+    size_t t_len = 0;
+    size_t block_len, offset, use_len, i, j;
+    unsigned char counter;
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
-    psa_status_t abort_status = PSA_ERROR_CORRUPTION_DETECTED;
-    psa_key_derivation_operation_t operation =
-        PSA_KEY_DERIVATION_OPERATION_INIT;
+    psa_hash_operation_t inner = PSA_HASH_OPERATION_INIT;
+    psa_hash_operation_t outer = PSA_HASH_OPERATION_INIT;
+    psa_hash_operation_t operation = PSA_HASH_OPERATION_INIT;
+
+    for (i = 0; i < count; i++) {
+        if (labels[i].label_len > MBEDTLS_SSL_TLS1_3_KEY_SCHEDULE_MAX_LABEL_LEN) {
+            /* Should never happen since this is an internal
+             * function, and we know statically which labels
+             * are allowed. */
+            return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
 
-    if (label_len > MBEDTLS_SSL_TLS1_3_KEY_SCHEDULE_MAX_LABEL_LEN) {
-        /* Should never happen since this is an internal
-         * function, and we know statically which labels
-         * are allowed. */
-        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        if (labels[i].buf_len > MBEDTLS_SSL_TLS1_3_KEY_SCHEDULE_MAX_EXPANSION_LEN) {
+            /* Should not happen, as above. */
+            return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
     }
 
     if (ctx_len > MBEDTLS_SSL_TLS1_3_KEY_SCHEDULE_MAX_CONTEXT_LEN) {
@@ -163,57 +199,107 @@ int mbedtls_ssl_tls13_hkdf_expand_label(
         return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
     }
 
-    if (buf_len > MBEDTLS_SSL_TLS1_3_KEY_SCHEDULE_MAX_EXPANSION_LEN) {
-        /* Should not happen, as above. */
-        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
-    }
-
     if (!PSA_ALG_IS_HASH(hash_alg)) {
         return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
     }
 
-    ssl_tls13_hkdf_encode_label(buf_len,
-                                label, label_len,
-                                ctx, ctx_len,
-                                hkdf_label,
-                                &hkdf_label_len);
+    /* As with PSA_ALG_HKDF_EXPAND, the secret must be a pseudorandom key
+     * of the size of the hash, so it always fits in a block. */
+    block_len = PSA_HASH_BLOCK_LENGTH(hash_alg);
+    if (secret_len != PSA_HASH_LENGTH(hash_alg) ||
+        block_len < secret_len || block_len > sizeof(pad)) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
 
-    status = psa_key_derivation_setup(&operation, PSA_ALG_HKDF_EXPAND(hash_alg));
+    memset(pad, 0, block_len);
+    memcpy(pad, secret, secret_len);
 
+    for (j = 0; j < block_len; j++) {
+        pad[j] ^= 0x36;
+    }
+    status = psa_hash_setup(&inner, hash_alg);
     if (status != PSA_SUCCESS) {
         goto cleanup;
     }
-
-    status = psa_key_derivation_input_bytes(&operation,
-                                            PSA_KEY_DERIVATION_INPUT_SECRET,
-                                            secret,
-                                            secret_len);
-
+    status = psa_hash_update(&inner, pad, block_len);
     if (status != PSA_SUCCESS) {
         goto cleanup;
     }
 
-    status = psa_key_derivation_input_bytes(&operation,
-                                            PSA_KEY_DERIVATION_INPUT_INFO,
-                                            hkdf_label,
-                                            hkdf_label_len);
-
+    for (j = 0; j < block_len; j++) {
+        pad[j] ^= 0x36 ^ 0x5C;
+    }
+    status = psa_hash_setup(&outer, hash_alg);
     if (status != PSA_SUCCESS) {
         goto cleanup;
     }
-
-    status = psa_key_derivation_output_bytes(&operation,
-                                             buf,
-                                             buf_len);
-
+    status = psa_hash_update(&outer, pad, block_len);
     if (status != PSA_SUCCESS) {
         goto cleanup;
     }
 
+    for (i = 0; i < count; i++) {
+        ssl_tls13_hkdf_encode_label(labels[i].buf_len,
+                                    labels[i].label, labels[i].label_len,
+                                    ctx, ctx_len,
+                                    hkdf_label,
+                                    &hkdf_label_len);
+
+        t_len = 0;
+        counter = 1;
+        for (offset = 0; offset < labels[i].buf_len; offset += use_len) {
+            status = psa_hash_clone(&inner, &operation);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_update(&operation, t, t_len);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_update(&operation, hkdf_label, hkdf_label_len);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_update(&operation, &counter, 1);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_finish(&operation, t, sizeof(t), &t_len);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+
+            status = psa_hash_clone(&outer, &operation);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_update(&operation, t, t_len);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+            status = psa_hash_finish(&operation, t, sizeof(t), &t_len);
+            if (status != PSA_SUCCESS) {
+                goto cleanup;
+            }
+
+            use_len = labels[i].buf_len - offset;
+            if (use_len > t_len) {
+                use_len = t_len;
+            }
+            memcpy(labels[i].buf + offset, t, use_len);
+            counter++;
+        }
+    }
+
+    status = PSA_SUCCESS;
+
 cleanup:
-    abort_status = psa_key_derivation_abort(&operation);
-    status = (status == PSA_SUCCESS ? abort_status : status);
-    mbedtls_platform_zeroize(hkdf_label, hkdf_label_len);
+    psa_hash_abort(&operation);
+    psa_hash_abort(&inner);
+    psa_hash_abort(&outer);
+    mbedtls_platform_zeroize(pad, sizeof(pad));
+    mbedtls_platform_zeroize(t, sizeof(t));
+    mbedtls_platform_zeroize(hkdf_label, sizeof(hkdf_label));
     return PSA_TO_MBEDTLS_ERR(status);
 }
 
@@ -224,25 +310,16 @@ static int ssl_tls13_make_traffic_key(
     unsigned char *key, size_t key_len,
     unsigned char *iv, size_t iv_len)
 {
-    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
-
-    ret = mbedtls_ssl_tls13_hkdf_expand_label(
-        hash_alg,
-        secret, secret_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(key),
-        NULL, 0,
-        key, key_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    ret = mbedtls_ssl_tls13_hkdf_expand_label(
-        hash_alg,
-        secret, secret_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(iv),
-        NULL, 0,
-        iv, iv_len);
-    return ret;
+    const mbedtls_ssl_tls13_hkdf_label outputs[] = {
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(key), key, key_len },
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(iv), iv, iv_len },
+    };
+
+    return mbedtls_ssl_tls13_hkdf_expand_labels(hash_alg,
+                                                secret, secret_len,
+                                                NULL, 0,
+                                                outputs,
+                                                ARRAY_LENGTH(outputs));
 }
 
 /*
@@ -426,8 +503,13 @@ int mbedtls_ssl_tls13_derive_early_secrets(
     unsigned char const *transcript, size_t transcript_len,
     mbedtls_ssl_tls13_early_secrets *derived)
 {
-    int ret;
     size_t const hash_len = PSA_HASH_LENGTH(hash_alg);
+    const mbedtls_ssl_tls13_hkdf_label outputs[] = {
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_e_traffic),
+          derived->client_early_traffic_secret, hash_len },
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(e_exp_master),
+          derived->early_exporter_master_secret, hash_len },
+    };
 
     /* We should never call this function with an unknown hash,
      * but add an assertion anyway. */
@@ -449,33 +531,11 @@ int mbedtls_ssl_tls13_derive_early_secrets(
      *            v
      */
 
-    /* Create client_early_traffic_secret */
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        early_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_e_traffic),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->client_early_traffic_secret,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    /* Create early exporter */
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        early_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(e_exp_master),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->early_exporter_master_secret,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    return 0;
+    return mbedtls_ssl_tls13_hkdf_expand_labels(hash_alg,
+                                                early_secret, hash_len,
+                                                transcript, transcript_len,
+                                                outputs,
+                                                ARRAY_LENGTH(outputs));
 }
 
 int mbedtls_ssl_tls13_derive_handshake_secrets(
@@ -484,8 +544,13 @@ int mbedtls_ssl_tls13_derive_handshake_secrets(
     unsigned char const *transcript, size_t transcript_len,
     mbedtls_ssl_tls13_handshake_secrets *derived)
 {
-    int ret;
     size_t const hash_len = PSA_HASH_LENGTH(hash_alg);
+    const mbedtls_ssl_tls13_hkdf_label outputs[] = {
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_hs_traffic),
+          derived->client_handshake_traffic_secret, hash_len },
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(s_hs_traffic),
+          derived->server_handshake_traffic_secret, hash_len },
+    };
 
     /* We should never call this function with an unknown hash,
      * but add an assertion anyway. */
@@ -507,41 +572,11 @@ int mbedtls_ssl_tls13_derive_handshake_secrets(
      *
      */
 
-    /*
-     * Compute client_handshake_traffic_secret with
-     * Derive-Secret( ., "c hs traffic", ClientHello...ServerHello )
-     */
-
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        handshake_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_hs_traffic),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->client_handshake_traffic_secret,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    /*
-     * Compute server_handshake_traffic_secret with
-     * Derive-Secret( ., "s hs traffic", ClientHello...ServerHello )
-     */
-
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        handshake_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(s_hs_traffic),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->server_handshake_traffic_secret,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    return 0;
+    return mbedtls_ssl_tls13_hkdf_expand_labels(hash_alg,
+                                                handshake_secret, hash_len,
+                                                transcript, transcript_len,
+                                                outputs,
+                                                ARRAY_LENGTH(outputs));
 }
 
 int mbedtls_ssl_tls13_derive_application_secrets(
@@ -550,8 +585,15 @@ int mbedtls_ssl_tls13_derive_application_secrets(
     unsigned char const *transcript, size_t transcript_len,
     mbedtls_ssl_tls13_application_secrets *derived)
 {
-    int ret;
     size_t const hash_len = PSA_HASH_LENGTH(hash_alg);
+    const mbedtls_ssl_tls13_hkdf_label outputs[] = {
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_ap_traffic),
+          derived->client_application_traffic_secret_N, hash_len },
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(s_ap_traffic),
+          derived->server_application_traffic_secret_N, hash_len },
+        { MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(exp_master),
+          derived->exporter_master_secret, hash_len },
+    };
 
     /* We should never call this function with an unknown hash,
      * but add an assertion anyway. */
@@ -577,43 +619,11 @@ int mbedtls_ssl_tls13_derive_application_secrets(
      *
      */
 
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        application_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(c_ap_traffic),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->client_application_traffic_secret_N,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        application_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(s_ap_traffic),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->server_application_traffic_secret_N,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    ret = mbedtls_ssl_tls13_derive_secret(
-        hash_alg,
-        application_secret, hash_len,
-        MBEDTLS_SSL_TLS1_3_LBL_WITH_LEN(exp_master),
-        transcript, transcript_len,
-        MBEDTLS_SSL_TLS1_3_CONTEXT_HASHED,
-        derived->exporter_master_secret,
-        hash_len);
-    if (ret != 0) {
-        return ret;
-    }
-
-    return 0;
+    return mbedtls_ssl_tls13_hkdf_expand_labels(hash_alg,
+                                                application_secret, hash_len,
+                                                transcript, transcript_len,
+                                                outputs,
+                                                ARRAY_LENGTH(outputs));
 }
 
 /* Generate resumption_master_secret for use with the ticket exchange.
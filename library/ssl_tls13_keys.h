@@ -115,6 +115,47 @@ int mbedtls_ssl_tls13_hkdf_expand_label(
     const unsigned char *ctx, size_t ctx_len,
     unsigned char *buf, size_t buf_len);
 
+/**
+ * \brief            One output of mbedtls_ssl_tls13_hkdf_expand_labels().
+ */
+typedef struct {
+    const unsigned char *label; /*!< The \c Label, without "tls13 " prefix */
+    size_t label_len;           /*!< The length of \c label in Bytes */
+    unsigned char *buf;         /*!< The destination buffer */
+    size_t buf_len;             /*!< The desired output length in Bytes */
+} mbedtls_ssl_tls13_hkdf_label;
+
+/**
+ * \brief            Compute \c HKDF-Expand-Label for several labels with
+ *                   the same secret and context.
+ *
+ *                   This is equivalent to calling
+ *                   mbedtls_ssl_tls13_hkdf_expand_label() once for each
+ *                   entry of \p labels, but the HMAC key derived from
+ *                   \p secret is only set up once.
+ *
+ * \param hash_alg   The identifier for the hash algorithm to use.
+ * \param secret     The \c Secret argument to \c HKDF-Expand-Label.
+ *                   This must be a readable buffer of length
+ *                   \p secret_len Bytes.
+ * \param secret_len The length of \p secret in Bytes.
+ * \param ctx        The \c Context argument to \c HKDF-Expand-Label.
+ *                   This must be a readable buffer of length \p ctx_len Bytes.
+ * \param ctx_len    The length of \p context in Bytes.
+ * \param labels     The labels and destination buffers.
+ *                   This must be a readable array of \p count entries.
+ * \param count      The number of entries in \p labels.
+ *
+ * \returns          \c 0 on success.
+ * \return           A negative error code on failure.
+ */
+MBEDTLS_CHECK_RETURN_CRITICAL
+int mbedtls_ssl_tls13_hkdf_expand_labels(
+    psa_algorithm_t hash_alg,
+    const unsigned char *secret, size_t secret_len,
+    const unsigned char *ctx, size_t ctx_len,
+    const mbedtls_ssl_tls13_hkdf_label *labels, size_t count);
+
 /**
  * \brief           This function is part of the TLS 1.3 key schedule.
  *                  It extracts key and IV for the actual client/server traffic
@@ -205,7 +246,7 @@ int mbedtls_ssl_tls13_derive_secret(
 /**
  * \brief Derive TLS 1.3 early data key material from early secret.
  *
- *        This is a small wrapper invoking mbedtls_ssl_tls13_derive_secret()
+ *        This is a small wrapper invoking mbedtls_ssl_tls13_hkdf_expand_labels()
  *        with the appropriate labels.
  *
  * <tt>
@@ -254,7 +295,7 @@ int mbedtls_ssl_tls13_derive_early_secrets(
 /**
  * \brief Derive TLS 1.3 handshake key material from the handshake secret.
  *
- *        This is a small wrapper invoking mbedtls_ssl_tls13_derive_secret()
+ *        This is a small wrapper invoking mbedtls_ssl_tls13_hkdf_expand_labels()
  *        with the appropriate labels from the standard.
  *
  * <tt>
@@ -300,7 +341,7 @@ int mbedtls_ssl_tls13_derive_handshake_secrets(
 /**
  * \brief Derive TLS 1.3 application key material from the master secret.
  *
- *        This is a small wrapper invoking mbedtls_ssl_tls13_derive_secret()
+ *        This is a small wrapper invoking mbedtls_ssl_tls13_hkdf_expand_labels()
  *        with the appropriate labels from the standard.
  *
  * <tt>
@@ -1166,15 +1166,18 @@ static int ssl_tls13_pick_key_cert(mbedtls_ssl_context *ssl)
                                    mbedtls_ssl_sig_alg_to_str(*sig_alg),
                                    *sig_alg));
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
+            /* Pure EdDSA has no hash-and-sign PSA algorithm for
+             * mbedtls_pk_can_do_ext() to check; the key type match suffices. */
             psa_alg = ssl_tls13_iana_sig_alg_to_psa_alg(*sig_alg);
 #endif /* MBEDTLS_USE_PSA_CRYPTO */
 
             if (mbedtls_ssl_tls13_check_sig_alg_cert_key_match(
                     *sig_alg, &key_cert->cert->pk)
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
-                && psa_alg != PSA_ALG_NONE &&
-                mbedtls_pk_can_do_ext(&key_cert->cert->pk, psa_alg,
-                                      PSA_KEY_USAGE_SIGN_HASH) == 1
+                && (*sig_alg == MBEDTLS_TLS1_3_SIG_ED25519 ||
+                    (psa_alg != PSA_ALG_NONE &&
+                     mbedtls_pk_can_do_ext(&key_cert->cert->pk, psa_alg,
+                                           PSA_KEY_USAGE_SIGN_HASH) == 1))
 #endif /* MBEDTLS_USE_PSA_CRYPTO */
                 ) {
                 ssl->handshake->key_cert = key_cert;
@@ -1886,6 +1889,12 @@ static int ssl_tls13_postprocess_client_hello(mbedtls_ssl_context *ssl,
     /*
      * Server certificate selection
      */
+#if defined(MBEDTLS_SSL_CERT_STORE_C)
+    if ((ret = mbedtls_ssl_cert_store_select(ssl)) != 0) {
+        MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_ssl_cert_store_select", ret);
+        return ret;
+    }
+#endif
     if (ssl->conf->f_cert_cb && (ret = ssl->conf->f_cert_cb(ssl)) != 0) {
         MBEDTLS_SSL_DEBUG_RET(1, "f_cert_cb", ret);
         return ret;
@@ -3097,8 +3106,16 @@ static int ssl_tls13_handshake_wrapup(mbedtls_ssl_context *ssl)
  */
     /* Sent NewSessionTicket message only when client supports PSK */
     if (mbedtls_ssl_tls13_is_some_psk_supported(ssl)) {
-        mbedtls_ssl_handshake_set_state(
-            ssl, MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET);
+        if (ssl->conf->new_session_tickets_timing ==
+            MBEDTLS_SSL_TLS1_3_TICKETS_DEFERRED) {
+            /* See mbedtls_ssl_send_new_session_tickets() */
+            MBEDTLS_SSL_DEBUG_MSG(2, ("NewSessionTicket: deferred"));
+            ssl->handshake->new_session_tickets_deferred = 1;
+            mbedtls_ssl_handshake_set_state(ssl, MBEDTLS_SSL_HANDSHAKE_OVER);
+        } else {
+            mbedtls_ssl_handshake_set_state(
+                ssl, MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET);
+        }
     } else
 #endif
     {
@@ -3387,6 +3404,10 @@ static int ssl_tls13_write_new_session_ticket_body(mbedtls_ssl_context *ssl,
 
 /*
  * Handler for MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET
+ *
+ * The tickets still to be sent are coalesced into the same record as long as
+ * they fit in the maximum record payload, and flushed together in
+ * MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET_FLUSH.
  */
 static int ssl_tls13_write_new_session_ticket(mbedtls_ssl_context *ssl)
 {
@@ -3396,32 +3417,65 @@ static int ssl_tls13_write_new_session_ticket(mbedtls_ssl_context *ssl)
 
     if (ret == SSL_NEW_SESSION_TICKET_WRITE) {
         unsigned char ticket_nonce[MBEDTLS_SSL_TLS1_3_TICKET_NONCE_LENGTH];
-        unsigned char *buf;
-        size_t buf_len, msg_len;
+        unsigned char *buf = ssl->out_msg;
+        /* The first ticket may use the whole buffer, as it did before
+         * tickets were batched. */
+        unsigned char *end = ssl->out_msg + MBEDTLS_SSL_OUT_CONTENT_LEN;
+        unsigned char *batch_end;
+        size_t msg_len = 0;
+        unsigned int batched = 0;
+
+        ret = mbedtls_ssl_get_max_out_record_payload(ssl);
+        if (ret < 0) {
+            MBEDTLS_SSL_DEBUG_RET(1, "mbedtls_ssl_get_max_out_record_payload", ret);
+            goto cleanup;
+        }
+        batch_end = ssl->out_msg + ret;
+
+        do {
+            MBEDTLS_SSL_PROC_CHK(ssl_tls13_prepare_new_session_ticket(
+                                     ssl, ticket_nonce, sizeof(ticket_nonce)));
+
+            ret = ssl_tls13_write_new_session_ticket_body(
+                ssl, buf + 4, end, &msg_len,
+                ticket_nonce, sizeof(ticket_nonce));
+            if (ret == MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL && batched > 0) {
+                /* Send the remaining tickets in the next record */
+                ret = 0;
+                break;
+            }
+            if (ret != 0) {
+                goto cleanup;
+            }
 
-        MBEDTLS_SSL_PROC_CHK(ssl_tls13_prepare_new_session_ticket(
-                                 ssl, ticket_nonce, sizeof(ticket_nonce)));
+            buf[0] = MBEDTLS_SSL_HS_NEW_SESSION_TICKET;
+            MBEDTLS_PUT_UINT24_BE(msg_len, buf, 1);
+            buf += 4 + msg_len;
+            batched++;
 
-        MBEDTLS_SSL_PROC_CHK(mbedtls_ssl_start_handshake_msg(
-                                 ssl, MBEDTLS_SSL_HS_NEW_SESSION_TICKET,
-                                 &buf, &buf_len));
+            /* Limit session tickets count to one when resumption connection.
+             *
+             * See document of mbedtls_ssl_conf_new_session_tickets.
+             */
+            if (ssl->handshake->resume == 1) {
+                ssl->handshake->new_session_tickets_count = 0;
+            } else {
+                ssl->handshake->new_session_tickets_count--;
+            }
 
-        MBEDTLS_SSL_PROC_CHK(ssl_tls13_write_new_session_ticket_body(
-                                 ssl, buf, buf + buf_len, &msg_len,
-                                 ticket_nonce, sizeof(ticket_nonce)));
+            end = batch_end;
 
-        MBEDTLS_SSL_PROC_CHK(mbedtls_ssl_finish_handshake_msg(
-                                 ssl, buf_len, msg_len));
+            /* Tickets of a connection have the same size in practice, so
+             * only try another one if a ticket of the same size still fits. */
+        } while (ssl->handshake->new_session_tickets_count > 0 &&
+                 buf < end && (size_t) (end - buf) >= 4 + msg_len);
 
-        /* Limit session tickets count to one when resumption connection.
-         *
-         * See document of mbedtls_ssl_conf_new_session_tickets.
-         */
-        if (ssl->handshake->resume == 1) {
-            ssl->handshake->new_session_tickets_count = 0;
-        } else {
-            ssl->handshake->new_session_tickets_count--;
-        }
+        MBEDTLS_SSL_DEBUG_MSG(2, ("NewSessionTicket: %u message(s) in record",
+                                  batched));
+
+        ssl->out_msgtype = MBEDTLS_SSL_MSG_HANDSHAKE;
+        ssl->out_msglen = (size_t) (buf - ssl->out_msg);
+        MBEDTLS_SSL_PROC_CHK(mbedtls_ssl_write_record(ssl, 0));
 
         mbedtls_ssl_handshake_set_state(
             ssl, MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET_FLUSH);
@@ -3433,6 +3487,31 @@ cleanup:
 
     return ret;
 }
+
+int mbedtls_ssl_send_new_session_tickets(mbedtls_ssl_context *ssl)
+{
+    if (ssl == NULL || ssl->conf == NULL ||
+        ssl->conf->endpoint != MBEDTLS_SSL_IS_SERVER) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+
+    if (ssl->handshake != NULL &&
+        ssl->handshake->new_session_tickets_deferred) {
+        MBEDTLS_SSL_DEBUG_MSG(2, ("NewSessionTicket: sending deferred tickets"));
+        ssl->handshake->new_session_tickets_deferred = 0;
+        mbedtls_ssl_handshake_set_state(
+            ssl, MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET);
+    }
+
+    /* Complete the sending of the tickets, if they are in progress, with the
+     * handshake state machine. */
+    if (ssl->state != MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET &&
+        ssl->state != MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET_FLUSH) {
+        return 0;
+    }
+
+    return mbedtls_ssl_handshake(ssl);
+}
 #endif /* MBEDTLS_SSL_SESSION_TICKETS */
 
 /*
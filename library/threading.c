@@ -19,6 +19,11 @@
 
 #include "mbedtls/threading.h"
 
+#if defined(MBEDTLS_THREADING_STATS)
+#include <string.h>
+#include <time.h>
+#endif
+
 #if defined(MBEDTLS_HAVE_TIME_DATE) && !defined(MBEDTLS_PLATFORM_GMTIME_R_ALT)
 
 #if !defined(_WIN32) && (defined(unix) || \
@@ -50,6 +55,92 @@
 #endif /* MBEDTLS_HAVE_TIME_DATE && !MBEDTLS_PLATFORM_GMTIME_R_ALT */
 
 #if defined(MBEDTLS_THREADING_PTHREAD)
+
+#if defined(MBEDTLS_THREADING_STATS)
+/*
+ * Mutex statistics
+ *
+ * Each mutex keeps its own counters, which are only updated by the thread
+ * holding it. To report on all of them, the mutexes initialized with
+ * mbedtls_mutex_init() are kept in a list, and the counters of the ones
+ * that are freed are added to a small table of totals per name. The global
+ * mutexes are statically initialized, so they are listed separately.
+ */
+#define THREADING_STATS_MAX_RETIRED 32
+
+static pthread_mutex_t threading_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static mbedtls_threading_mutex_t threading_stats_live = {
+    PTHREAD_MUTEX_INITIALIZER, 0, NULL, 0, 0, 0, 0, 0,
+    &threading_stats_live, &threading_stats_live
+};
+static mbedtls_threading_stats_t threading_stats_retired[THREADING_STATS_MAX_RETIRED];
+static size_t threading_stats_retired_count;
+
+static const char *threading_stats_name(const mbedtls_threading_mutex_t *mutex)
+{
+    return mutex->name != NULL ? mutex->name : "unnamed";
+}
+
+static uint64_t threading_stats_now(void)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/* Add counters to the entry for name in stats[0..*count), appending an
+ * entry if there is room. Return 0 if there was no room. */
+static int threading_stats_add(mbedtls_threading_stats_t *stats,
+                               size_t size, size_t *count,
+                               const char *name,
+                               uint64_t acquisitions, uint64_t contended,
+                               uint64_t wait_ns, uint64_t hold_ns)
+{
+    size_t i;
+
+    for (i = 0; i < *count; i++) {
+        if (strcmp(stats[i].name, name) == 0) {
+            break;
+        }
+    }
+    if (i == *count) {
+        if (i >= size) {
+            return 0;
+        }
+        memset(&stats[i], 0, sizeof(stats[i]));
+        stats[i].name = name;
+        (*count)++;
+    }
+
+    stats[i].acquisitions += acquisitions;
+    stats[i].contended += contended;
+    stats[i].wait_ns += wait_ns;
+    stats[i].hold_ns += hold_ns;
+    return 1;
+}
+
+static int threading_stats_add_mutex(mbedtls_threading_stats_t *stats,
+                                     size_t size, size_t *count,
+                                     const mbedtls_threading_mutex_t *mutex)
+{
+    return threading_stats_add(stats, size, count,
+                               threading_stats_name(mutex),
+                               mutex->acquisitions, mutex->contended,
+                               mutex->wait_ns, mutex->hold_ns);
+}
+
+static void threading_stats_clear(mbedtls_threading_mutex_t *mutex)
+{
+    mutex->acquisitions = 0;
+    mutex->contended = 0;
+    mutex->wait_ns = 0;
+    mutex->hold_ns = 0;
+}
+#endif /* MBEDTLS_THREADING_STATS */
+
 static void threading_mutex_init_pthread(mbedtls_threading_mutex_t *mutex)
 {
     if (mutex == NULL) {
@@ -63,6 +154,17 @@ static void threading_mutex_init_pthread(mbedtls_threading_mutex_t *mutex)
      * variable. Please make sure any new mutex that gets added is exercised in
      * tests; see tests/src/threading_helpers.c for more details. */
     (void) pthread_mutex_init(&mutex->mutex, NULL);
+
+#if defined(MBEDTLS_THREADING_STATS)
+    mutex->name = NULL;
+    threading_stats_clear(mutex);
+    (void) pthread_mutex_lock(&threading_stats_lock);
+    mutex->next = threading_stats_live.next;
+    mutex->prev = &threading_stats_live;
+    threading_stats_live.next->prev = mutex;
+    threading_stats_live.next = mutex;
+    (void) pthread_mutex_unlock(&threading_stats_lock);
+#endif
 }
 
 static void threading_mutex_free_pthread(mbedtls_threading_mutex_t *mutex)
@@ -71,6 +173,31 @@ static void threading_mutex_free_pthread(mbedtls_threading_mutex_t *mutex)
         return;
     }
 
+#if defined(MBEDTLS_THREADING_STATS)
+    (void) pthread_mutex_lock(&threading_stats_lock);
+    /* A mutex is listed from mbedtls_mutex_init() to mbedtls_mutex_free(),
+     * except for the statically initialized global mutexes. */
+    if (mutex->prev != NULL) {
+        if (!threading_stats_add_mutex(threading_stats_retired,
+                                       THREADING_STATS_MAX_RETIRED - 1,
+                                       &threading_stats_retired_count,
+                                       mutex)) {
+            /* The last entry collects the names that did not fit. */
+            (void) threading_stats_add(threading_stats_retired,
+                                       THREADING_STATS_MAX_RETIRED,
+                                       &threading_stats_retired_count,
+                                       "other",
+                                       mutex->acquisitions, mutex->contended,
+                                       mutex->wait_ns, mutex->hold_ns);
+        }
+        mutex->prev->next = mutex->next;
+        mutex->next->prev = mutex->prev;
+        mutex->prev = NULL;
+        mutex->next = NULL;
+    }
+    (void) pthread_mutex_unlock(&threading_stats_lock);
+#endif
+
     (void) pthread_mutex_destroy(&mutex->mutex);
 }
 
@@ -80,9 +207,25 @@ static int threading_mutex_lock_pthread(mbedtls_threading_mutex_t *mutex)
         return MBEDTLS_ERR_THREADING_BAD_INPUT_DATA;
     }
 
+#if defined(MBEDTLS_THREADING_STATS)
+    if (pthread_mutex_trylock(&mutex->mutex) == 0) {
+        mutex->locked_at_ns = threading_stats_now();
+    } else {
+        uint64_t start = threading_stats_now();
+
+        if (pthread_mutex_lock(&mutex->mutex) != 0) {
+            return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+        }
+        mutex->locked_at_ns = threading_stats_now();
+        mutex->contended++;
+        mutex->wait_ns += mutex->locked_at_ns - start;
+    }
+    mutex->acquisitions++;
+#else
     if (pthread_mutex_lock(&mutex->mutex) != 0) {
         return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
     }
+#endif
 
     return 0;
 }
@@ -93,6 +236,10 @@ static int threading_mutex_unlock_pthread(mbedtls_threading_mutex_t *mutex)
         return MBEDTLS_ERR_THREADING_BAD_INPUT_DATA;
     }
 
+#if defined(MBEDTLS_THREADING_STATS)
+    mutex->hold_ns += threading_stats_now() - mutex->locked_at_ns;
+#endif
+
     if (pthread_mutex_unlock(&mutex->mutex) != 0) {
         return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
     }
@@ -108,7 +255,11 @@ int (*mbedtls_mutex_unlock)(mbedtls_threading_mutex_t *) = threading_mutex_unloc
 /*
  * With pthreads we can statically initialize mutexes
  */
-#define MUTEX_INIT  = { PTHREAD_MUTEX_INITIALIZER, 1 }
+#if defined(MBEDTLS_THREADING_STATS)
+#define MUTEX_INIT(name)  = { PTHREAD_MUTEX_INITIALIZER, 1, name, 0, 0, 0, 0, 0, NULL, NULL }
+#else
+#define MUTEX_INIT(name)  = { PTHREAD_MUTEX_INITIALIZER, 1 }
+#endif
 
 #endif /* MBEDTLS_THREADING_PTHREAD */
 
@@ -178,18 +329,98 @@ void mbedtls_threading_free_alt(void)
  * Define global mutexes
  */
 #ifndef MUTEX_INIT
-#define MUTEX_INIT
+#define MUTEX_INIT(name)
 #endif
 #if defined(MBEDTLS_FS_IO)
-mbedtls_threading_mutex_t mbedtls_threading_readdir_mutex MUTEX_INIT;
+mbedtls_threading_mutex_t mbedtls_threading_readdir_mutex MUTEX_INIT("readdir");
 #endif
 #if defined(THREADING_USE_GMTIME)
-mbedtls_threading_mutex_t mbedtls_threading_gmtime_mutex MUTEX_INIT;
+mbedtls_threading_mutex_t mbedtls_threading_gmtime_mutex MUTEX_INIT("gmtime");
 #endif
 #if defined(MBEDTLS_PSA_CRYPTO_C)
-mbedtls_threading_mutex_t mbedtls_threading_key_slot_mutex MUTEX_INIT;
-mbedtls_threading_mutex_t mbedtls_threading_psa_globaldata_mutex MUTEX_INIT;
-mbedtls_threading_mutex_t mbedtls_threading_psa_rngdata_mutex MUTEX_INIT;
+mbedtls_threading_mutex_t mbedtls_threading_key_slot_mutex MUTEX_INIT("psa_key_slot");
+mbedtls_threading_mutex_t mbedtls_threading_psa_globaldata_mutex MUTEX_INIT("psa_globaldata");
+mbedtls_threading_mutex_t mbedtls_threading_psa_rngdata_mutex MUTEX_INIT("psa_rngdata");
 #endif
 
+#if defined(MBEDTLS_THREADING_STATS)
+static mbedtls_threading_mutex_t *const threading_global_mutexes[] = {
+#if defined(MBEDTLS_FS_IO)
+    &mbedtls_threading_readdir_mutex,
+#endif
+#if defined(THREADING_USE_GMTIME)
+    &mbedtls_threading_gmtime_mutex,
+#endif
+#if defined(MBEDTLS_PSA_CRYPTO_C)
+    &mbedtls_threading_key_slot_mutex,
+    &mbedtls_threading_psa_globaldata_mutex,
+    &mbedtls_threading_psa_rngdata_mutex,
+#endif
+    NULL
+};
+
+void mbedtls_threading_mutex_set_name(mbedtls_threading_mutex_t *mutex,
+                                      const char *name)
+{
+    if (mutex != NULL) {
+        mutex->name = name;
+    }
+}
+
+size_t mbedtls_threading_get_stats(mbedtls_threading_stats_t *stats,
+                                   size_t size)
+{
+    size_t count = 0, overflow = 0, i;
+    const mbedtls_threading_mutex_t *mutex;
+
+    (void) pthread_mutex_lock(&threading_stats_lock);
+
+    for (i = 0; threading_global_mutexes[i] != NULL; i++) {
+        if (!threading_stats_add_mutex(stats, size, &count,
+                                       threading_global_mutexes[i])) {
+            overflow++;
+        }
+    }
+    for (mutex = threading_stats_live.next; mutex != &threading_stats_live;
+         mutex = mutex->next) {
+        if (!threading_stats_add_mutex(stats, size, &count, mutex)) {
+            overflow++;
+        }
+    }
+    for (i = 0; i < threading_stats_retired_count; i++) {
+        const mbedtls_threading_stats_t *r = &threading_stats_retired[i];
+        if (!threading_stats_add(stats, size, &count, r->name,
+                                 r->acquisitions, r->contended,
+                                 r->wait_ns, r->hold_ns)) {
+            overflow++;
+        }
+    }
+
+    (void) pthread_mutex_unlock(&threading_stats_lock);
+
+    /* Entries that did not fit may share names; this is an upper bound,
+     * enough to tell the caller to retry with a larger array. */
+    return count + overflow;
+}
+
+void mbedtls_threading_reset_stats(void)
+{
+    size_t i;
+    mbedtls_threading_mutex_t *mutex;
+
+    (void) pthread_mutex_lock(&threading_stats_lock);
+
+    for (i = 0; threading_global_mutexes[i] != NULL; i++) {
+        threading_stats_clear(threading_global_mutexes[i]);
+    }
+    for (mutex = threading_stats_live.next; mutex != &threading_stats_live;
+         mutex = mutex->next) {
+        threading_stats_clear(mutex);
+    }
+    threading_stats_retired_count = 0;
+
+    (void) pthread_mutex_unlock(&threading_stats_lock);
+}
+#endif /* MBEDTLS_THREADING_STATS */
+
 #endif /* MBEDTLS_THREADING_C */
@@ -0,0 +1,33 @@
+/**
+ * \file threading_internal.h
+ *
+ * \brief Threading helpers that are internal to the library.
+ */
+/*
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+#ifndef MBEDTLS_THREADING_INTERNAL_H
+#define MBEDTLS_THREADING_INTERNAL_H
+
+#include "common.h"
+
+#include "mbedtls/threading.h"
+
+/** Initialize a mutex and give it the name under which
+ *  mbedtls_threading_get_stats() reports it.
+ *
+ * \param mutex     The mutex to initialize.
+ * \param name      A string literal naming the mutex.
+ */
+#if defined(MBEDTLS_THREADING_STATS)
+#define MBEDTLS_MUTEX_INIT_NAMED(mutex, name)                   \
+    do {                                                        \
+        mbedtls_mutex_init(mutex);                              \
+        mbedtls_threading_mutex_set_name(mutex, name);          \
+    } while (0)
+#else
+#define MBEDTLS_MUTEX_INIT_NAMED(mutex, name) mbedtls_mutex_init(mutex)
+#endif
+
+#endif /* MBEDTLS_THREADING_INTERNAL_H */
@@ -237,9 +237,72 @@ static int x509_profile_check_key(const mbedtls_x509_crt_profile *profile,
     }
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS */
 
+#if defined(MBEDTLS_ED25519_C)
+    /* Ed25519 keys have a single size, at the 128-bit security level */
+    if (pk_alg == MBEDTLS_PK_ED25519) {
+        return 0;
+    }
+#endif /* MBEDTLS_ED25519_C */
+
     return -1;
 }
 
+/*
+ * Get the data that the signature over tbs is computed on: the hash of tbs
+ * for hash-and-sign algorithms, or tbs itself for PureEdDSA.
+ * Return 0 on success; hash errors can only happen after an internal error.
+ */
+static int x509_crt_signed_data(mbedtls_md_type_t sig_md,
+                                mbedtls_pk_type_t sig_pk,
+                                const mbedtls_x509_buf *tbs,
+                                unsigned char hash[MBEDTLS_MD_MAX_SIZE],
+                                const unsigned char **data, size_t *data_len)
+{
+#if defined(MBEDTLS_ED25519_C)
+    if (sig_pk == MBEDTLS_PK_ED25519) {
+        *data = tbs->p;
+        *data_len = tbs->len;
+        return 0;
+    }
+#else
+    (void) sig_pk;
+#endif /* MBEDTLS_ED25519_C */
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    if (psa_hash_compute(mbedtls_md_psa_alg_from_type(sig_md),
+                         tbs->p, tbs->len,
+                         hash, MBEDTLS_MD_MAX_SIZE,
+                         data_len) != PSA_SUCCESS) {
+        return MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+    }
+#else
+    const mbedtls_md_info_t *md_info = mbedtls_md_info_from_type(sig_md);
+    *data_len = mbedtls_md_get_size(md_info);
+    if (mbedtls_md(md_info, tbs->p, tbs->len, hash) != 0) {
+        return -1;
+    }
+#endif /* MBEDTLS_USE_PSA_CRYPTO */
+
+    *data = hash;
+    return 0;
+}
+
+/*
+ * Check a signature algorithm against profile
+ * Return 0 if its hash is acceptable for this profile, -1 otherwise
+ */
+static int x509_profile_check_sig_md(const mbedtls_x509_crt_profile *profile,
+                                     mbedtls_md_type_t sig_md,
+                                     mbedtls_pk_type_t sig_pk)
+{
+    /* PureEdDSA has no separate hash to restrict */
+    if (sig_pk == MBEDTLS_PK_ED25519) {
+        return 0;
+    }
+
+    return x509_profile_check_md_alg(profile, sig_md);
+}
+
 /*
  * Like memcmp, but case-insensitive and always returns -1 if different
  */
@@ -2012,12 +2075,8 @@ static int x509_crt_verifycrl(mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
 {
     int flags = 0;
     unsigned char hash[MBEDTLS_MD_MAX_SIZE];
-#if defined(MBEDTLS_USE_PSA_CRYPTO)
-    psa_algorithm_t psa_algorithm;
-#else
-    const mbedtls_md_info_t *md_info;
-#endif /* MBEDTLS_USE_PSA_CRYPTO */
-    size_t hash_length;
+    const unsigned char *signed_data;
+    size_t signed_length;
 
     if (ca == NULL) {
         return flags;
@@ -2042,7 +2101,8 @@ static int x509_crt_verifycrl(mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
         /*
          * Check if CRL is correctly signed by the trusted CA
          */
-        if (x509_profile_check_md_alg(profile, crl_list->sig_md) != 0) {
+        if (x509_profile_check_sig_md(profile, crl_list->sig_md,
+                                      crl_list->sig_pk) != 0) {
             flags |= MBEDTLS_X509_BADCRL_BAD_MD;
         }
 
@@ -2050,37 +2110,20 @@ static int x509_crt_verifycrl(mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
             flags |= MBEDTLS_X509_BADCRL_BAD_PK;
         }
 
-#if defined(MBEDTLS_USE_PSA_CRYPTO)
-        psa_algorithm = mbedtls_md_psa_alg_from_type(crl_list->sig_md);
-        if (psa_hash_compute(psa_algorithm,
-                             crl_list->tbs.p,
-                             crl_list->tbs.len,
-                             hash,
-                             sizeof(hash),
-                             &hash_length) != PSA_SUCCESS) {
-            /* Note: this can't happen except after an internal error */
-            flags |= MBEDTLS_X509_BADCRL_NOT_TRUSTED;
-            break;
-        }
-#else
-        md_info = mbedtls_md_info_from_type(crl_list->sig_md);
-        hash_length = mbedtls_md_get_size(md_info);
-        if (mbedtls_md(md_info,
-                       crl_list->tbs.p,
-                       crl_list->tbs.len,
-                       hash) != 0) {
+        if (x509_crt_signed_data(crl_list->sig_md, crl_list->sig_pk,
+                                 &crl_list->tbs, hash,
+                                 &signed_data, &signed_length) != 0) {
             /* Note: this can't happen except after an internal error */
             flags |= MBEDTLS_X509_BADCRL_NOT_TRUSTED;
             break;
         }
-#endif /* MBEDTLS_USE_PSA_CRYPTO */
 
         if (x509_profile_check_key(profile, &ca->pk) != 0) {
             flags |= MBEDTLS_X509_BADCERT_BAD_KEY;
         }
 
         if (mbedtls_pk_verify_ext(crl_list->sig_pk, crl_list->sig_opts, &ca->pk,
-                                  crl_list->sig_md, hash, hash_length,
+                                  crl_list->sig_md, signed_data, signed_length,
                                   crl_list->sig.p, crl_list->sig.len) != 0) {
             flags |= MBEDTLS_X509_BADCRL_NOT_TRUSTED;
             break;
@@ -2123,32 +2166,17 @@ static int x509_crt_check_signature(const mbedtls_x509_crt *child,
                                     mbedtls_x509_crt *parent,
                                     mbedtls_x509_crt_restart_ctx *rs_ctx)
 {
-    size_t hash_len;
+    size_t signed_len;
     unsigned char hash[MBEDTLS_MD_MAX_SIZE];
-#if !defined(MBEDTLS_USE_PSA_CRYPTO)
-    const mbedtls_md_info_t *md_info;
-    md_info = mbedtls_md_info_from_type(child->sig_md);
-    hash_len = mbedtls_md_get_size(md_info);
+    const unsigned char *signed_data;
+    int ret;
 
-    /* Note: hash errors can happen only after an internal error */
-    if (mbedtls_md(md_info, child->tbs.p, child->tbs.len, hash) != 0) {
-        return -1;
-    }
-#else
-    psa_algorithm_t hash_alg = mbedtls_md_psa_alg_from_type(child->sig_md);
-    psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
-
-    status = psa_hash_compute(hash_alg,
-                              child->tbs.p,
-                              child->tbs.len,
-                              hash,
-                              sizeof(hash),
-                              &hash_len);
-    if (status != PSA_SUCCESS) {
-        return MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+    ret = x509_crt_signed_data(child->sig_md, child->sig_pk, &child->tbs,
+                               hash, &signed_data, &signed_len);
+    if (ret != 0) {
+        return ret;
     }
 
-#endif /* MBEDTLS_USE_PSA_CRYPTO */
     /* Skip expensive computation on obvious mismatch */
     if (!mbedtls_pk_can_do(&parent->pk, child->sig_pk)) {
         return -1;
@@ -2157,7 +2185,7 @@ static int x509_crt_check_signature(const mbedtls_x509_crt *child,
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
     if (rs_ctx != NULL && child->sig_pk == MBEDTLS_PK_ECDSA) {
         return mbedtls_pk_verify_restartable(&parent->pk,
-                                             child->sig_md, hash, hash_len,
+                                             child->sig_md, signed_data, signed_len,
                                              child->sig.p, child->sig.len, &rs_ctx->pk);
     }
 #else
@@ -2165,7 +2193,7 @@ static int x509_crt_check_signature(const mbedtls_x509_crt *child,
 #endif
 
     return mbedtls_pk_verify_ext(child->sig_pk, child->sig_opts, &parent->pk,
-                                 child->sig_md, hash, hash_len,
+                                 child->sig_md, signed_data, signed_len,
                                  child->sig.p, child->sig.len);
 }
 
@@ -2577,7 +2605,8 @@ static int x509_crt_verify_chain(
         }
 
         /* Check signature algorithm: MD & PK algs */
-        if (x509_profile_check_md_alg(profile, child->sig_md) != 0) {
+        if (x509_profile_check_sig_md(profile, child->sig_md,
+                                      child->sig_pk) != 0) {
             *flags |= MBEDTLS_X509_BADCERT_BAD_MD;
         }
 
@@ -0,0 +1,571 @@
+/*
+ *  TLS 1.2 handshake benchmark
+ *
+ *  Runs full and resumed TLS 1.2 handshakes between a client and a server
+ *  in the same process, over an in-memory transport, so that the timings
+ *  reflect the cost of the handshake computations rather than the network.
+ *  Pre-shared key ciphersuites are used so that the symmetric part of the
+ *  handshake (PRF, transcript hashing, Finished computation) is not hidden
+ *  behind public-key operations.
+ *
+ *  Several threads can run handshakes at the same time, sharing the
+ *  configuration, session cache and random generator as a server would.
+ *  Combined with MBEDTLS_THREADING_STATS, this shows which locks are
+ *  contended.
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+#include "mbedtls/build_info.h"
+
+#include "mbedtls/platform.h"
+
+#if !defined(MBEDTLS_ENTROPY_C) || !defined(MBEDTLS_CTR_DRBG_C) || \
+    !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) ||  \
+    !defined(MBEDTLS_SSL_PROTO_TLS1_2) ||                          \
+    !defined(MBEDTLS_KEY_EXCHANGE_PSK_ENABLED) ||                  \
+    !defined(MBEDTLS_SSL_CACHE_C) || !defined(MBEDTLS_TIMING_C)
+int main(void)
+{
+    mbedtls_printf("MBEDTLS_ENTROPY_C and/or MBEDTLS_CTR_DRBG_C and/or "
+                   "MBEDTLS_SSL_CLI_C and/or MBEDTLS_SSL_SRV_C and/or "
+                   "MBEDTLS_SSL_PROTO_TLS1_2 and/or "
+                   "MBEDTLS_KEY_EXCHANGE_PSK_ENABLED and/or "
+                   "MBEDTLS_SSL_CACHE_C and/or MBEDTLS_TIMING_C "
+                   "not defined.\n");
+    mbedtls_exit(0);
+}
+#else
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ciphersuites.h"
+#include "mbedtls/timing.h"
+#include "mbedtls/threading.h"
+
+#define DFL_ITERATIONS  1000
+#define QUEUE_SIZE      4096    /* larger records are passed in pieces */
+#define HEADER_FORMAT   "  %-44s :  "
+
+#define MAX_THREADS     64
+
+#define USAGE                                                           \
+    "\n usage: ssl_handshake_bench [iterations [threads]]\n"           \
+    "\n The default number of iterations is %d, per thread.\n"        \
+    " Running several threads (at most %d) needs\n"                    \
+    " MBEDTLS_THREADING_PTHREAD. With MBEDTLS_THREADING_STATS,\n"      \
+    " lock statistics are shown at the end.\n\n"
+
+static const unsigned char psk[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const char psk_id[] = "Client_identity";
+
+static const char *ciphersuites[] = {
+    "TLS-PSK-WITH-AES-128-GCM-SHA256",
+    "TLS-PSK-WITH-AES-256-GCM-SHA384",
+    "TLS-PSK-WITH-AES-128-CBC-SHA256",
+    NULL
+};
+
+/*
+ * One direction of the in-memory transport
+ */
+typedef struct {
+    unsigned char buf[QUEUE_SIZE];
+    size_t len;
+} queue_t;
+
+typedef struct {
+    queue_t *in;
+    queue_t *out;
+} endpoint_io_t;
+
+static int queue_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    queue_t *q = ((endpoint_io_t *) ctx)->out;
+
+    if (len > sizeof(q->buf) - q->len) {
+        len = sizeof(q->buf) - q->len;
+    }
+    if (len == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+
+    memcpy(q->buf + q->len, buf, len);
+    q->len += len;
+
+    return (int) len;
+}
+
+static int queue_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    queue_t *q = ((endpoint_io_t *) ctx)->in;
+
+    if (q->len == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (len > q->len) {
+        len = q->len;
+    }
+
+    memcpy(buf, q->buf, len);
+    memmove(q->buf, q->buf + len, q->len - len);
+    q->len -= len;
+
+    return (int) len;
+}
+
+static int is_pending(int ret)
+{
+    return ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+/*
+ * Drive both sides until the handshake is over on each of them.
+ */
+static int do_handshake(mbedtls_ssl_context *cli, mbedtls_ssl_context *srv)
+{
+    int ret;
+
+    while (!mbedtls_ssl_is_handshake_over(cli) ||
+           !mbedtls_ssl_is_handshake_over(srv)) {
+        if (!mbedtls_ssl_is_handshake_over(cli)) {
+            ret = mbedtls_ssl_handshake(cli);
+            if (ret != 0 && !is_pending(ret)) {
+                return ret;
+            }
+        }
+        if (!mbedtls_ssl_is_handshake_over(srv)) {
+            ret = mbedtls_ssl_handshake(srv);
+            if (ret != 0 && !is_pending(ret)) {
+                return ret;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * A client and a server connected by an in-memory transport. With several
+ * threads, each thread drives its own pair, but all pairs share the
+ * configurations, the server's session cache and the random generator.
+ */
+typedef struct {
+    queue_t c2s;
+    queue_t s2c;
+    endpoint_io_t cli_io;
+    endpoint_io_t srv_io;
+    mbedtls_ssl_context cli;
+    mbedtls_ssl_context srv;
+    mbedtls_ssl_session session;
+    unsigned long iterations;
+    int resume;
+    int ret;
+} pair_t;
+
+static int pair_setup(pair_t *pair,
+                      const mbedtls_ssl_config *cli_conf,
+                      const mbedtls_ssl_config *srv_conf)
+{
+    int ret;
+
+    pair->cli_io.in = &pair->s2c;
+    pair->cli_io.out = &pair->c2s;
+    pair->srv_io.in = &pair->c2s;
+    pair->srv_io.out = &pair->s2c;
+
+    if ((ret = mbedtls_ssl_setup(&pair->cli, cli_conf)) != 0 ||
+        (ret = mbedtls_ssl_setup(&pair->srv, srv_conf)) != 0) {
+        return ret;
+    }
+    mbedtls_ssl_set_bio(&pair->cli, &pair->cli_io,
+                        queue_send, queue_recv, NULL);
+    mbedtls_ssl_set_bio(&pair->srv, &pair->srv_io,
+                        queue_send, queue_recv, NULL);
+
+    return 0;
+}
+
+static int reset_pair(pair_t *pair)
+{
+    int ret;
+
+    pair->c2s.len = 0;
+    pair->s2c.len = 0;
+
+    if ((ret = mbedtls_ssl_session_reset(&pair->cli)) != 0) {
+        return ret;
+    }
+    return mbedtls_ssl_session_reset(&pair->srv);
+}
+
+/*
+ * Run pair->iterations handshakes, all resuming pair->session if
+ * pair->resume is set. Keep the session of the last one.
+ */
+static void *pair_run(void *arg)
+{
+    pair_t *pair = arg;
+    unsigned long i;
+
+    for (i = 0; i < pair->iterations; i++) {
+        if ((pair->ret = reset_pair(pair)) != 0 ||
+            (pair->resume &&
+             (pair->ret = mbedtls_ssl_set_session(&pair->cli,
+                                                  &pair->session)) != 0) ||
+            (pair->ret = do_handshake(&pair->cli, &pair->srv)) != 0) {
+            return NULL;
+        }
+    }
+
+    if (!pair->resume) {
+        mbedtls_ssl_session_free(&pair->session);
+        mbedtls_ssl_session_init(&pair->session);
+        pair->ret = mbedtls_ssl_get_session(&pair->cli, &pair->session);
+    }
+
+    return NULL;
+}
+
+/*
+ * Run pair_run() on all pairs, each in its own thread if there are several,
+ * and return the elapsed time in milliseconds.
+ */
+static int run_pairs(pair_t *pairs, unsigned threads, int resume,
+                     unsigned long iterations, unsigned long *ms)
+{
+    unsigned t;
+    struct mbedtls_timing_hr_time timer;
+
+    for (t = 0; t < threads; t++) {
+        pairs[t].iterations = iterations;
+        pairs[t].resume = resume;
+        pairs[t].ret = 0;
+    }
+
+    (void) mbedtls_timing_get_timer(&timer, 1);
+#if defined(MBEDTLS_THREADING_PTHREAD)
+    if (threads > 1) {
+        pthread_t tids[MAX_THREADS];
+        unsigned started;
+
+        for (started = 0; started < threads; started++) {
+            if (pthread_create(&tids[started], NULL,
+                               pair_run, &pairs[started]) != 0) {
+                pairs[started].ret = MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+                break;
+            }
+        }
+        for (t = 0; t < started; t++) {
+            (void) pthread_join(tids[t], NULL);
+        }
+    } else
+#endif /* MBEDTLS_THREADING_PTHREAD */
+    {
+        (void) pair_run(&pairs[0]);
+    }
+    *ms = mbedtls_timing_get_timer(&timer, 0);
+
+    for (t = 0; t < threads; t++) {
+        if (pairs[t].ret != 0) {
+            return pairs[t].ret;
+        }
+    }
+    return 0;
+}
+
+static void print_rate(const char *title, unsigned long count,
+                       unsigned long ms, const char *unit)
+{
+    mbedtls_printf(HEADER_FORMAT, title);
+    mbedtls_printf("%9lu %s/s\n", count * 1000 / (ms > 0 ? ms : 1), unit);
+}
+
+/*
+ * Time full and resumed handshakes with one ciphersuite.
+ */
+static int bench_ciphersuite(const char *name, unsigned long iterations,
+                             unsigned threads,
+                             mbedtls_ctr_drbg_context *ctr_drbg)
+{
+    int ret = 1;
+    int suites[2];
+    unsigned long ms;
+    unsigned t;
+    char title[64];
+    pair_t *pairs = NULL;
+    mbedtls_ssl_config cli_conf, srv_conf;
+    mbedtls_ssl_cache_context cache;
+
+    mbedtls_ssl_config_init(&cli_conf);
+    mbedtls_ssl_config_init(&srv_conf);
+    mbedtls_ssl_cache_init(&cache);
+
+    suites[0] = mbedtls_ssl_get_ciphersuite_id(name);
+    suites[1] = 0;
+    if (suites[0] == 0) {
+        /* Not enabled in this configuration */
+        ret = 0;
+        goto exit;
+    }
+
+    pairs = mbedtls_calloc(threads, sizeof(*pairs));
+    if (pairs == NULL) {
+        ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        goto exit;
+    }
+    for (t = 0; t < threads; t++) {
+        mbedtls_ssl_init(&pairs[t].cli);
+        mbedtls_ssl_init(&pairs[t].srv);
+        mbedtls_ssl_session_init(&pairs[t].session);
+    }
+
+    if ((ret = mbedtls_ssl_config_defaults(&cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                                           MBEDTLS_SSL_TRANSPORT_STREAM,
+                                           MBEDTLS_SSL_PRESET_DEFAULT)) != 0 ||
+        (ret = mbedtls_ssl_config_defaults(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+                                           MBEDTLS_SSL_TRANSPORT_STREAM,
+                                           MBEDTLS_SSL_PRESET_DEFAULT)) != 0) {
+        goto exit;
+    }
+
+    mbedtls_ssl_conf_rng(&cli_conf, mbedtls_ctr_drbg_random, ctr_drbg);
+    mbedtls_ssl_conf_rng(&srv_conf, mbedtls_ctr_drbg_random, ctr_drbg);
+    mbedtls_ssl_conf_max_tls_version(&cli_conf, MBEDTLS_SSL_VERSION_TLS1_2);
+    mbedtls_ssl_conf_max_tls_version(&srv_conf, MBEDTLS_SSL_VERSION_TLS1_2);
+    mbedtls_ssl_conf_ciphersuites(&cli_conf, suites);
+    mbedtls_ssl_conf_ciphersuites(&srv_conf, suites);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    /* Resume through the server's session cache */
+    mbedtls_ssl_conf_session_tickets(&cli_conf,
+                                     MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+#endif
+    mbedtls_ssl_conf_session_cache(&srv_conf, &cache,
+                                   mbedtls_ssl_cache_get,
+                                   mbedtls_ssl_cache_set);
+
+    if ((ret = mbedtls_ssl_conf_psk(&cli_conf, psk, sizeof(psk),
+                                    (const unsigned char *) psk_id,
+                                    sizeof(psk_id) - 1)) != 0 ||
+        (ret = mbedtls_ssl_conf_psk(&srv_conf, psk, sizeof(psk),
+                                    (const unsigned char *) psk_id,
+                                    sizeof(psk_id) - 1)) != 0) {
+        goto exit;
+    }
+
+    for (t = 0; t < threads; t++) {
+        if ((ret = pair_setup(&pairs[t], &cli_conf, &srv_conf)) != 0) {
+            goto exit;
+        }
+    }
+
+    /* Full handshakes */
+    if ((ret = run_pairs(pairs, threads, 0, iterations, &ms)) != 0) {
+        goto exit;
+    }
+
+    mbedtls_snprintf(title, sizeof(title), "%s full", name);
+    print_rate(title, iterations * threads, ms, "handshakes");
+
+    /* Resumed handshakes, each from its pair's last full handshake */
+    if ((ret = run_pairs(pairs, threads, 1, iterations, &ms)) != 0) {
+        goto exit;
+    }
+
+    mbedtls_snprintf(title, sizeof(title), "%s resumed", name);
+    print_rate(title, iterations * threads, ms, "handshakes");
+
+    ret = 0;
+
+exit:
+    if (ret != 0) {
+        mbedtls_printf("%s: handshake failed: -0x%04x\n",
+                       name, (unsigned int) -ret);
+    }
+
+    if (pairs != NULL) {
+        for (t = 0; t < threads; t++) {
+            mbedtls_ssl_session_free(&pairs[t].session);
+            mbedtls_ssl_free(&pairs[t].cli);
+            mbedtls_ssl_free(&pairs[t].srv);
+        }
+        mbedtls_free(pairs);
+    }
+    mbedtls_ssl_config_free(&cli_conf);
+    mbedtls_ssl_config_free(&srv_conf);
+    mbedtls_ssl_cache_free(&cache);
+
+    return ret;
+}
+
+#if defined(MBEDTLS_THREADING_STATS)
+/*
+ * Show which mutexes the handshakes above used, and how much they waited.
+ */
+static void print_mutex_stats(void)
+{
+    mbedtls_threading_stats_t stats[32];
+    size_t count, i;
+
+    count = mbedtls_threading_get_stats(stats, sizeof(stats) / sizeof(stats[0]));
+    if (count > sizeof(stats) / sizeof(stats[0])) {
+        count = sizeof(stats) / sizeof(stats[0]);
+    }
+
+    mbedtls_printf("  %-20s %12s %12s %12s %12s\n", "mutex", "locks",
+                   "contended", "wait (us)", "held (us)");
+    for (i = 0; i < count; i++) {
+        if (stats[i].acquisitions == 0) {
+            continue;
+        }
+        mbedtls_printf("  %-20s %12llu %12llu %12llu %12llu\n",
+                       stats[i].name,
+                       (unsigned long long) stats[i].acquisitions,
+                       (unsigned long long) stats[i].contended,
+                       (unsigned long long) (stats[i].wait_ns / 1000),
+                       (unsigned long long) (stats[i].hold_ns / 1000));
+    }
+    mbedtls_printf("\n");
+}
+#endif /* MBEDTLS_THREADING_STATS */
+
+/*
+ * Time the PRF on its own, with the output lengths used for the master
+ * secret and for the key block of an AES-128-CBC-SHA256 ciphersuite.
+ */
+static int bench_prf(mbedtls_tls_prf_types type, const char *name,
+                     unsigned long iterations)
+{
+    int ret;
+    unsigned long i, ms;
+    unsigned char secret[48];
+    unsigned char randbytes[64];
+    unsigned char out[2 * (32 + 16 + 16)];
+    char title[64];
+    struct mbedtls_timing_hr_time timer;
+    static const struct {
+        const char *label;
+        size_t len;
+    } outputs[] = {
+        { "master secret", 48 },
+        { "key expansion", sizeof(out) },
+    };
+    size_t j;
+
+    memset(secret, 0x2a, sizeof(secret));
+    memset(randbytes, 0x5c, sizeof(randbytes));
+
+    for (j = 0; j < sizeof(outputs) / sizeof(outputs[0]); j++) {
+        (void) mbedtls_timing_get_timer(&timer, 1);
+        for (i = 0; i < iterations * 10; i++) {
+            ret = mbedtls_ssl_tls_prf(type, secret, sizeof(secret),
+                                      outputs[j].label,
+                                      randbytes, sizeof(randbytes),
+                                      out, outputs[j].len);
+            if (ret == MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE) {
+                return 0;
+            }
+            if (ret != 0) {
+                return ret;
+            }
+        }
+        ms = mbedtls_timing_get_timer(&timer, 0);
+
+        mbedtls_snprintf(title, sizeof(title), "PRF %s %s (%u bytes)",
+                         name, outputs[j].label, (unsigned) outputs[j].len);
+        print_rate(title, iterations * 10, ms, "calls");
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int ret = 1;
+    int exit_code = MBEDTLS_EXIT_FAILURE;
+    unsigned long iterations = DFL_ITERATIONS;
+    unsigned long threads = 1;
+    const char *pers = "ssl_handshake_bench";
+    const char **name;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctr_drbg);
+
+    if (argc > 3 ||
+        (argc >= 2 && (iterations = strtoul(argv[1], NULL, 10)) == 0) ||
+        (argc >= 3 && (threads = strtoul(argv[2], NULL, 10)) == 0) ||
+        threads > MAX_THREADS) {
+        mbedtls_printf(USAGE, DFL_ITERATIONS, MAX_THREADS);
+        goto exit;
+    }
+#if !defined(MBEDTLS_THREADING_PTHREAD)
+    if (threads > 1) {
+        mbedtls_printf("MBEDTLS_THREADING_PTHREAD not defined, "
+                       "running a single thread.\n");
+        threads = 1;
+    }
+#endif
+
+#if defined(MBEDTLS_PSA_CRYPTO_C)
+    if (psa_crypto_init() != PSA_SUCCESS) {
+        mbedtls_printf("Failed to initialize PSA Crypto\n");
+        goto exit;
+    }
+#endif /* MBEDTLS_PSA_CRYPTO_C */
+
+    if ((ret = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
+                                     (const unsigned char *) pers,
+                                     strlen(pers))) != 0) {
+        mbedtls_printf("mbedtls_ctr_drbg_seed returned -0x%04x\n",
+                       (unsigned int) -ret);
+        goto exit;
+    }
+
+    mbedtls_printf("\n");
+
+    for (name = ciphersuites; *name != NULL; name++) {
+        if (bench_ciphersuite(*name, iterations, (unsigned) threads,
+                              &ctr_drbg) != 0) {
+            goto exit;
+        }
+    }
+
+    if (bench_prf(MBEDTLS_SSL_TLS_PRF_SHA256, "SHA-256", iterations) != 0 ||
+        bench_prf(MBEDTLS_SSL_TLS_PRF_SHA384, "SHA-384", iterations) != 0) {
+        goto exit;
+    }
+
+    mbedtls_printf("\n");
+
+#if defined(MBEDTLS_THREADING_STATS)
+    print_mutex_stats();
+#endif
+
+    exit_code = MBEDTLS_EXIT_SUCCESS;
+
+exit:
+    mbedtls_ctr_drbg_free(&ctr_drbg);
+    mbedtls_entropy_free(&entropy);
+#if defined(MBEDTLS_PSA_CRYPTO_C)
+    mbedtls_psa_crypto_free();
+#endif /* MBEDTLS_PSA_CRYPTO_C */
+
+    mbedtls_exit(exit_code);
+}
+
+#endif /* MBEDTLS_ENTROPY_C && MBEDTLS_CTR_DRBG_C && MBEDTLS_SSL_CLI_C &&
+          MBEDTLS_SSL_SRV_C && MBEDTLS_SSL_PROTO_TLS1_2 &&
+          MBEDTLS_KEY_EXCHANGE_PSK_ENABLED && MBEDTLS_SSL_CACHE_C &&
+          MBEDTLS_TIMING_C */
@@ -49,6 +49,11 @@ int main(void)
 #define SNI_OPTION
 #endif
 
+#if defined(MBEDTLS_SSL_CERT_STORE_C) && defined(MBEDTLS_FS_IO)
+#include "mbedtls/ssl_cert_store.h"
+#define SNI_STORE_OPTION
+#endif
+
 #if defined(_WIN32)
 #include <windows.h>
 #endif
@@ -110,8 +115,12 @@ int main(void)
 #define DFL_CERT_REQ_CA_LIST    MBEDTLS_SSL_CERT_REQ_CA_LIST_ENABLED
 #define DFL_CERT_REQ_DN_HINT    0
 #define DFL_MFL_CODE            MBEDTLS_SSL_MAX_FRAG_LEN_NONE
+#define DFL_DYN_RECORD_SIZE     0
+#define DFL_DYN_RECORD_RAMP     65536
+#define DFL_DYN_RECORD_IDLE     1000
 #define DFL_TRUNC_HMAC          -1
 #define DFL_TICKETS             MBEDTLS_SSL_SESSION_TICKETS_ENABLED
+#define DFL_TICKETS_DEFERRED    0
 #define DFL_DUMMY_TICKET        0
 #define DFL_TICKET_ROTATE       0
 #define DFL_TICKET_TIMEOUT      86400
@@ -120,6 +129,7 @@ int main(void)
 #define DFL_CACHE_TIMEOUT       -1
 #define DFL_CACHE_REMOVE        0
 #define DFL_SNI                 NULL
+#define DFL_SNI_STORE           NULL
 #define DFL_ALPN_STRING         NULL
 #define DFL_GROUPS              NULL
 #define DFL_EARLY_DATA          -1
@@ -284,6 +294,8 @@ int main(void)
 #if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
 #define USAGE_TICKETS                                       \
     "    tickets=%%d          default: 1 (enabled)\n"       \
+    "    tickets_deferred=%%d default: 0 (disabled)\n"      \
+    "                        TLS 1.3: send the tickets after the first response\n" \
     "    ticket_rotate=%%d    default: 0 (disabled)\n"      \
     "    ticket_timeout=%%d   default: 86400 (one day)\n"   \
     "    ticket_aead=%%s      default: \"AES-256-GCM\"\n"
@@ -341,6 +353,15 @@ int main(void)
 #define USAGE_SNI ""
 #endif /* SNI_OPTION */
 
+#if defined(SNI_STORE_OPTION)
+#define USAGE_SNI_STORE                                                     \
+    "    sni_store=%%s        cert1,key1[,...] served by name from a\n"    \
+    "                        certificate store (overrides sni)\n"          \
+    "                        default: disabled\n"
+#else
+#define USAGE_SNI_STORE ""
+#endif /* SNI_STORE_OPTION */
+
 #if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
 #define USAGE_MAX_FRAG_LEN                                      \
     "    max_frag_len=%%d     default: 16384 (tls default)\n"   \
@@ -514,6 +535,12 @@ int main(void)
     "    response_size=%%d    default: about 152 (basic response)\n" \
     "                          (minimum: 0, max: 16384)\n" \
     "                          increases buffer_size if bigger\n" \
+    "    dyn_record_size=%%d  default: 0 (always full-size records)\n" \
+    "                        size of the first records, overhead included\n" \
+    "    dyn_record_ramp=%%d  default: 65536\n" \
+    "                        bytes to send before using full-size records\n" \
+    "    dyn_record_idle=%%d  default: 1000 (ms)\n" \
+    "                        idle time after which records are small again\n" \
     "    nbio=%%d             default: 0 (blocking I/O)\n"  \
     "                        options: 1 (non-blocking), 2 (added delays)\n" \
     "    event=%%d            default: 0 (loop)\n"                            \
@@ -570,6 +597,7 @@ int main(void)
 #define USAGE4 \
     USAGE_SSL_ASYNC                                         \
     USAGE_SNI                                               \
+    USAGE_SNI_STORE                                         \
     "    allow_sha1=%%d       default: 0\n"                                   \
     "    min_version=%%s      default: (library default: tls12)\n"            \
     "    max_version=%%s      default: (library default: tls12)\n"            \
@@ -611,6 +639,9 @@ struct options {
     int event;                  /* loop or event-driven IO? level or edge triggered? */
     uint32_t read_timeout;      /* timeout on mbedtls_ssl_read() in milliseconds    */
     int response_size;          /* pad response with header to requested size */
+    int dyn_record_size;        /* size of the first application data records */
+    uint32_t dyn_record_ramp;   /* bytes sent before full-size records      */
+    uint32_t dyn_record_idle;   /* idle time before small records again (ms) */
     uint16_t buffer_size;       /* IO buffer size */
     const char *ca_file;        /* the file with the CA certificate(s)      */
     const char *ca_path;        /* the path with the CA certificate(s) reside */
@@ -658,6 +689,7 @@ struct options {
     unsigned char mfl_code;     /* code for maximum fragment length         */
     int trunc_hmac;             /* accept truncated hmac?                   */
     int tickets;                /* enable / disable session tickets         */
+    int tickets_deferred;       /* TLS 1.3: defer NewSessionTicket messages */
     int dummy_ticket;           /* enable / disable dummy ticket generator  */
     int ticket_rotate;          /* session ticket rotate (code coverage)    */
     int ticket_timeout;         /* session ticket lifetime                  */
@@ -668,6 +700,7 @@ struct options {
 #endif
     int cache_remove;           /* enable / disable cache entry removal     */
     char *sni;                  /* string describing sni information        */
+    char *sni_store;            /* certificates for the certificate store   */
     const char *groups;         /* list of supported groups                 */
     const char *sig_algs;       /* supported TLS 1.3 signature algorithms   */
     const char *alpn_string;    /* ALPN supported protocols                 */
@@ -937,6 +970,42 @@ int cert_callback(mbedtls_ssl_context *ssl)
 
 #endif /* SNI_OPTION */
 
+#if defined(SNI_STORE_OPTION)
+/*
+ * Add the pairs of certificate and key files in the comma-separated list
+ * cert1,key1[,cert2,key2[,...]] to a certificate store.
+ *
+ * Modifies the input string! This is not production quality!
+ */
+int sni_store_parse(mbedtls_ssl_cert_store *store, char *sni_string)
+{
+    int ret;
+    char *p = sni_string;
+    char *end = p;
+    char *crt_file, *key_file;
+
+    while (*end != '\0') {
+        ++end;
+    }
+    *end = ',';
+
+    while (p <= end) {
+        GET_ITEM(crt_file);
+        GET_ITEM(key_file);
+
+        ret = mbedtls_ssl_cert_store_add_file(store, crt_file, key_file, NULL);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+#endif /* SNI_STORE_OPTION */
+
 #if defined(MBEDTLS_SSL_HANDSHAKE_WITH_PSK_ENABLED)
 
 typedef struct _psk_entry psk_entry;
@@ -1558,6 +1627,9 @@ int main(int argc, char *argv[])
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_context cache;
 #endif
+#if defined(SNI_STORE_OPTION)
+    mbedtls_ssl_cert_store cert_store;
+#endif
 #if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
     mbedtls_ssl_ticket_context ticket_ctx;
 #endif /* MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_TICKET_C */
@@ -1649,6 +1721,9 @@ int main(int argc, char *argv[])
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_init(&cache);
 #endif
+#if defined(SNI_STORE_OPTION)
+    mbedtls_ssl_cert_store_init(&cert_store);
+#endif
 #if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
     mbedtls_ssl_ticket_init(&ticket_ctx);
 #endif
@@ -1684,6 +1759,9 @@ int main(int argc, char *argv[])
     opt.debug_level         = DFL_DEBUG_LEVEL;
     opt.event               = DFL_EVENT;
     opt.response_size       = DFL_RESPONSE_SIZE;
+    opt.dyn_record_size     = DFL_DYN_RECORD_SIZE;
+    opt.dyn_record_ramp     = DFL_DYN_RECORD_RAMP;
+    opt.dyn_record_idle     = DFL_DYN_RECORD_IDLE;
     opt.nbio                = DFL_NBIO;
     opt.cid_enabled         = DFL_CID_ENABLED;
     opt.cid_enabled_renego  = DFL_CID_ENABLED_RENEGO;
@@ -1736,6 +1814,7 @@ int main(int argc, char *argv[])
     opt.mfl_code            = DFL_MFL_CODE;
     opt.trunc_hmac          = DFL_TRUNC_HMAC;
     opt.tickets             = DFL_TICKETS;
+    opt.tickets_deferred    = DFL_TICKETS_DEFERRED;
     opt.dummy_ticket        = DFL_DUMMY_TICKET;
     opt.ticket_rotate       = DFL_TICKET_ROTATE;
     opt.ticket_timeout      = DFL_TICKET_TIMEOUT;
@@ -1746,6 +1825,7 @@ int main(int argc, char *argv[])
 #endif
     opt.cache_remove        = DFL_CACHE_REMOVE;
     opt.sni                 = DFL_SNI;
+    opt.sni_store           = DFL_SNI_STORE;
     opt.alpn_string         = DFL_ALPN_STRING;
     opt.groups              = DFL_GROUPS;
 #if defined(MBEDTLS_SSL_EARLY_DATA)
@@ -1881,6 +1961,15 @@ usage:
             if (opt.buffer_size < opt.response_size) {
                 opt.buffer_size = opt.response_size;
             }
+        } else if (strcmp(p, "dyn_record_size") == 0) {
+            opt.dyn_record_size = atoi(q);
+            if (opt.dyn_record_size < 0 || opt.dyn_record_size > 0xFFFF) {
+                goto usage;
+            }
+        } else if (strcmp(p, "dyn_record_ramp") == 0) {
+            opt.dyn_record_ramp = atoi(q);
+        } else if (strcmp(p, "dyn_record_idle") == 0) {
+            opt.dyn_record_idle = atoi(q);
         } else if (strcmp(p, "ca_file") == 0) {
             opt.ca_file = q;
         } else if (strcmp(p, "ca_path") == 0) {
@@ -2174,6 +2263,11 @@ usage:
             if (opt.tickets < 0) {
                 goto usage;
             }
+        } else if (strcmp(p, "tickets_deferred") == 0) {
+            opt.tickets_deferred = atoi(q);
+            if (opt.tickets_deferred < 0 || opt.tickets_deferred > 1) {
+                goto usage;
+            }
         } else if (strcmp(p, "dummy_ticket") == 0) {
             opt.dummy_ticket = atoi(q);
             if (opt.dummy_ticket < 0) {
@@ -2252,6 +2346,8 @@ usage:
             }
         } else if (strcmp(p, "sni") == 0) {
             opt.sni = q;
+        } else if (strcmp(p, "sni_store") == 0) {
+            opt.sni_store = q;
         } else if (strcmp(p, "query_config") == 0) {
             opt.query_config_mode = 1;
             query_config_ret = query_config(q);
@@ -2778,6 +2874,21 @@ usage:
     }
 #endif /* SNI_OPTION */
 
+#if defined(SNI_STORE_OPTION)
+    if (opt.sni_store != NULL) {
+        mbedtls_printf("  . Setting up the certificate store...");
+        fflush(stdout);
+
+        if ((ret = sni_store_parse(&cert_store, opt.sni_store)) != 0) {
+            mbedtls_printf(" failed\n  !  sni_store_parse returned -0x%x\n\n",
+                           (unsigned int) -ret);
+            goto exit;
+        }
+
+        mbedtls_printf(" ok\n");
+    }
+#endif /* SNI_STORE_OPTION */
+
     /*
      * 2. Setup stuff
      */
@@ -2812,6 +2923,13 @@ usage:
         mbedtls_ssl_conf_cert_req_ca_list(&conf, opt.cert_req_ca_list);
     }
 
+    if (opt.dyn_record_size != DFL_DYN_RECORD_SIZE) {
+        mbedtls_ssl_conf_dynamic_record_size(&conf,
+                                             (uint16_t) opt.dyn_record_size,
+                                             opt.dyn_record_ramp,
+                                             opt.dyn_record_idle);
+    }
+
 #if defined(MBEDTLS_SSL_EARLY_DATA)
     if (opt.early_data != DFL_EARLY_DATA) {
         mbedtls_ssl_conf_early_data(&conf, opt.early_data);
@@ -2979,6 +3097,9 @@ usage:
 
 #if defined(MBEDTLS_SSL_PROTO_TLS1_3)
         mbedtls_ssl_conf_new_session_tickets(&conf, opt.tickets);
+        mbedtls_ssl_conf_new_session_tickets_timing(
+            &conf, opt.tickets_deferred ? MBEDTLS_SSL_TLS1_3_TICKETS_DEFERRED :
+            MBEDTLS_SSL_TLS1_3_TICKETS_AFTER_HANDSHAKE);
 #endif
         /* exercise manual ticket rotation (not required for typical use)
          * (used for external synchronization of session ticket encryption keys)
@@ -3159,6 +3280,12 @@ usage:
     }
 #endif
 
+#if defined(SNI_STORE_OPTION)
+    if (opt.sni_store != NULL) {
+        mbedtls_ssl_conf_sni(&conf, mbedtls_ssl_cert_store_sni, &cert_store);
+    }
+#endif
+
 #if defined(MBEDTLS_PK_HAVE_ECC_KEYS) || \
     (defined(MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_SOME_EPHEMERAL_ENABLED) && \
     defined(PSA_WANT_ALG_FFDH))
@@ -4205,6 +4332,9 @@ exit:
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_free(&cache);
 #endif
+#if defined(SNI_STORE_OPTION)
+    mbedtls_ssl_cert_store_free(&cert_store);
+#endif
 #if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
     mbedtls_ssl_ticket_free(&ticket_ctx);
 #endif
@@ -307,6 +307,9 @@ uint16_t ssl_sig_algs_for_test[] = {
 #if defined(MBEDTLS_RSA_C) && defined(MBEDTLS_MD_CAN_SHA256)
     MBEDTLS_TLS1_3_SIG_RSA_PSS_RSAE_SHA256,
 #endif /* MBEDTLS_RSA_C && MBEDTLS_MD_CAN_SHA256 */
+#if defined(MBEDTLS_SSL_PROTO_TLS1_3) && defined(MBEDTLS_ED25519_C)
+    MBEDTLS_TLS1_3_SIG_ED25519,
+#endif /* MBEDTLS_SSL_PROTO_TLS1_3 && MBEDTLS_ED25519_C */
 #if defined(MBEDTLS_MD_CAN_SHA1)
     /* Allow SHA-1 as we use it extensively in tests. */
     MBEDTLS_SSL_SIG_ALG(MBEDTLS_SSL_HASH_SHA1)
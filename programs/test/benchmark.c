@@ -38,12 +38,14 @@ int main(void)
 #include "mbedtls/cmac.h"
 #include "mbedtls/poly1305.h"
 
+#include "mbedtls/entropy.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/hmac_drbg.h"
 
 #include "mbedtls/rsa.h"
 #include "mbedtls/dhm.h"
 #include "mbedtls/ecdsa.h"
+#include "mbedtls/ed25519.h"
 #include "mbedtls/ecdh.h"
 
 #include "mbedtls/error.h"
@@ -103,6 +105,8 @@ static unsigned long mbedtls_timing_hardclock(void);
 #define HEAP_SIZE       (1u << 16)  /* 64k */
 
 #define BUFSIZE         1024
+#define ECDSA_POOL_SIZE 512
+#define EDDSA_BATCH_SIZE 64
 #define HEADER_FORMAT   "  %-24s :  "
 #define TITLE_LEN       25
 
@@ -112,8 +116,9 @@ static unsigned long mbedtls_timing_hardclock(void);
     "des3, des, camellia, chacha20,\n"                                       \
     "aes_cbc, aes_cfb128, aes_cfb8, aes_gcm, aes_ccm, aes_xts, chachapoly\n" \
     "aes_cmac, des3_cmac, poly1305\n"                                        \
-    "ctr_drbg, hmac_drbg\n"                                                  \
-    "rsa, dhm, ecdsa, ecdh.\n"
+    "ctr_drbg, hmac_drbg, entropy\n"                                         \
+    "rsa, dhm, ecdsa, ecdh, eddsa.\n"                                         \
+    "Add \"heap\" to also report heap allocations per operation.\n"
 
 #if defined(MBEDTLS_ERROR_C)
 #define PRINT_ERROR                                                     \
@@ -124,6 +129,106 @@ static unsigned long mbedtls_timing_hardclock(void);
     mbedtls_printf("FAILED: -0x%04x\n", (unsigned int) -ret);
 #endif
 
+/*
+ * Heap profiling, enabled with the "heap" option. All allocations made by
+ * the library go through a wrapper around the standard allocator, which
+ * counts them. This needs the allocator to be settable at runtime, and is
+ * not offered on top of MBEDTLS_MEMORY_BUFFER_ALLOC_C, which has its own
+ * statistics (see MEMORY_MEASURE_PRINT).
+ */
+#if defined(MBEDTLS_PLATFORM_MEMORY) &&                                 \
+    !(defined(MBEDTLS_PLATFORM_CALLOC_MACRO) &&                         \
+    defined(MBEDTLS_PLATFORM_FREE_MACRO)) &&                            \
+    defined(MBEDTLS_PLATFORM_STD_CALLOC) &&                             \
+    defined(MBEDTLS_PLATFORM_STD_FREE) &&                               \
+    !defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
+#define HAVE_HEAP_PROFILE
+
+/* Each block is preceded by its size, padded to keep the alignment
+ * guaranteed by the underlying allocator. */
+typedef union {
+    size_t size;
+    long double ld;
+    long long ll;
+    void *p;
+} heap_profile_header_t;
+
+static int heap_profile = 0;
+
+static struct {
+    size_t allocs;      /* allocations since the last reset */
+    size_t bytes;       /* bytes allocated since the last reset */
+    size_t in_use;      /* bytes currently allocated */
+    size_t base;        /* bytes allocated at the last reset */
+    size_t peak;        /* maximum of in_use since the last reset */
+} heap_stats;
+
+static void *heap_profile_calloc(size_t n, size_t size)
+{
+    heap_profile_header_t *header;
+
+    if (size != 0 && n > (SIZE_MAX - sizeof(*header)) / size) {
+        return NULL;
+    }
+    size *= n;
+
+    header = MBEDTLS_PLATFORM_STD_CALLOC(1, sizeof(*header) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+
+    heap_stats.allocs++;
+    heap_stats.bytes += size;
+    heap_stats.in_use += size;
+    if (heap_stats.in_use > heap_stats.peak) {
+        heap_stats.peak = heap_stats.in_use;
+    }
+
+    return header + 1;
+}
+
+static void heap_profile_free(void *ptr)
+{
+    heap_profile_header_t *header;
+
+    if (ptr == NULL) {
+        return;
+    }
+    header = (heap_profile_header_t *) ptr - 1;
+    heap_stats.in_use -= header->size;
+    MBEDTLS_PLATFORM_STD_FREE(header);
+}
+
+static void heap_profile_reset(void)
+{
+    heap_stats.allocs = 0;
+    heap_stats.bytes = 0;
+    heap_stats.base = heap_stats.in_use;
+    heap_stats.peak = heap_stats.in_use;
+}
+
+/* Print the average number of allocations and of bytes allocated per
+ * operation, and the largest amount of memory held at once on top of what
+ * was allocated before the first operation. */
+static void heap_profile_print(unsigned long ops)
+{
+    if (!heap_profile || ops == 0) {
+        return;
+    }
+    mbedtls_printf(",  %7.1f allocs/op, %8.0f bytes/op, %7u peak bytes",
+                   (double) heap_stats.allocs / ops,
+                   (double) heap_stats.bytes / ops,
+                   (unsigned) (heap_stats.peak - heap_stats.base));
+}
+
+#define HEAP_PROFILE_RESET() heap_profile_reset()
+#define HEAP_PROFILE_PRINT(ops) heap_profile_print(ops)
+#else
+#define HEAP_PROFILE_RESET()
+#define HEAP_PROFILE_PRINT(ops)
+#endif /* HAVE_HEAP_PROFILE */
+
 #define TIME_AND_TSC(TITLE, CODE)                                     \
     do {                                                                    \
         unsigned long ii, jj, tsc;                                          \
@@ -138,6 +243,7 @@ static unsigned long mbedtls_timing_hardclock(void);
             ret = CODE;                                                     \
         }                                                                   \
                                                                         \
+        HEAP_PROFILE_RESET();                                               \
         tsc = mbedtls_timing_hardclock();                                   \
         for (jj = 0; ret == 0 && jj < 1024; jj++)                          \
         {                                                                   \
@@ -150,10 +256,12 @@ static unsigned long mbedtls_timing_hardclock(void);
         }                                                                   \
         else                                                                \
         {                                                                   \
-            mbedtls_printf("%9lu KiB/s,  %9lu cycles/byte\n",              \
+            mbedtls_printf("%9lu KiB/s,  %9lu cycles/byte",                \
                            ii * BUFSIZE / 1024,                           \
                            (mbedtls_timing_hardclock() - tsc)           \
                            / (jj * BUFSIZE));                          \
+            HEAP_PROFILE_PRINT(jj);                                         \
+            mbedtls_printf("\n");                                         \
         }                                                                   \
     } while (0)
 
@@ -207,6 +315,7 @@ static unsigned long mbedtls_timing_hardclock(void);
         mbedtls_printf(HEADER_FORMAT, TITLE);                             \
         fflush(stdout);                                                   \
         mbedtls_set_alarm(3);                                             \
+        HEAP_PROFILE_RESET();                                               \
                                                                         \
         ret = 0;                                                            \
         for (ii = 1; !mbedtls_timing_alarmed && !ret; ii++)             \
@@ -228,6 +337,7 @@ static unsigned long mbedtls_timing_hardclock(void);
         {                                                                   \
             mbedtls_printf("%6lu " TYPE "/s", ii / 3);                    \
             MEMORY_MEASURE_PRINT(sizeof(TYPE) + 1);                     \
+            HEAP_PROFILE_PRINT(ii - 1);                                     \
             mbedtls_printf("\n");                                         \
         }                                                                   \
     } while (0)
@@ -509,8 +619,8 @@ typedef struct {
          aes_cmac, des3_cmac,
          aria, camellia, chacha20,
          poly1305,
-         ctr_drbg, hmac_drbg,
-         rsa, dhm, ecdsa, ecdh;
+         ctr_drbg, hmac_drbg, entropy,
+         rsa, dhm, ecdsa, ecdh, eddsa;
 } todo_list;
 
 
@@ -520,6 +630,7 @@ int main(int argc, char *argv[])
     unsigned char tmp[200];
     char title[TITLE_LEN];
     todo_list todo;
+    int heap_option = 0;
 #if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
     unsigned char alloc_buf[HEAP_SIZE] = { 0 };
 #endif
@@ -535,7 +646,14 @@ int main(int argc, char *argv[])
     (void) curve_list; /* Unused in some configurations where no benchmark uses ECC */
 #endif
 
-    if (argc <= 1) {
+    /* "heap" selects a mode, not a benchmark. */
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "heap") == 0) {
+            heap_option = 1;
+        }
+    }
+
+    if (argc <= 1 + heap_option) {
         memset(&todo, 1, sizeof(todo));
     } else {
         memset(&todo, 0, sizeof(todo));
@@ -595,6 +713,8 @@ int main(int argc, char *argv[])
                 todo.ctr_drbg = 1;
             } else if (strcmp(argv[i], "hmac_drbg") == 0) {
                 todo.hmac_drbg = 1;
+            } else if (strcmp(argv[i], "entropy") == 0) {
+                todo.entropy = 1;
             } else if (strcmp(argv[i], "rsa") == 0) {
                 todo.rsa = 1;
             } else if (strcmp(argv[i], "dhm") == 0) {
@@ -603,6 +723,10 @@ int main(int argc, char *argv[])
                 todo.ecdsa = 1;
             } else if (strcmp(argv[i], "ecdh") == 0) {
                 todo.ecdh = 1;
+            } else if (strcmp(argv[i], "eddsa") == 0) {
+                todo.eddsa = 1;
+            } else if (strcmp(argv[i], "heap") == 0) {
+                /* Handled above */
             }
 #if defined(MBEDTLS_ECP_C)
             else if (set_ecp_curve(argv[i], single_curve)) {
@@ -621,6 +745,15 @@ int main(int argc, char *argv[])
 #if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
     mbedtls_memory_buffer_alloc_init(alloc_buf, sizeof(alloc_buf));
 #endif
+    if (heap_option) {
+#if defined(HAVE_HEAP_PROFILE)
+        heap_profile = 1;
+        mbedtls_platform_set_calloc_free(heap_profile_calloc, heap_profile_free);
+#else
+        mbedtls_printf("Heap profiling requires MBEDTLS_PLATFORM_MEMORY "
+                       "and no MBEDTLS_MEMORY_BUFFER_ALLOC_C.\n\n");
+#endif
+    }
     memset(buf, 0xAA, sizeof(buf));
     memset(tmp, 0xBB, sizeof(tmp));
 
@@ -733,6 +866,18 @@ int main(int argc, char *argv[])
             TIME_AND_TSC(title,
                          mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT, BUFSIZE, tmp, buf, buf));
         }
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+        for (keysize = 128; keysize <= 256; keysize += 64) {
+            mbedtls_snprintf(title, sizeof(title), "AES-CBC-%d dec", keysize);
+
+            memset(buf, 0, sizeof(buf));
+            memset(tmp, 0, sizeof(tmp));
+            CHECK_AND_CONTINUE(mbedtls_aes_setkey_dec(&aes, tmp, keysize));
+
+            TIME_AND_TSC(title,
+                         mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_DECRYPT, BUFSIZE, tmp, buf, buf));
+        }
+#endif
         mbedtls_aes_free(&aes);
     }
 #endif
@@ -1040,6 +1185,31 @@ int main(int argc, char *argv[])
     }
 #endif /* MBEDTLS_HMAC_DRBG_C && ( MBEDTLS_SHA1_C || MBEDTLS_SHA256_C ) */
 
+#if defined(MBEDTLS_ENTROPY_C)
+    if (todo.entropy) {
+        mbedtls_entropy_context entropy;
+
+        mbedtls_entropy_init(&entropy);
+        TIME_PUBLIC("Entropy", "seed",
+                    ret = mbedtls_entropy_func(&entropy, tmp,
+                                               MBEDTLS_ENTROPY_BLOCK_SIZE));
+
+#if defined(MBEDTLS_CTR_DRBG_C)
+        mbedtls_ctr_drbg_context ctr_drbg;
+
+        mbedtls_ctr_drbg_init(&ctr_drbg);
+        if (mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
+                                  NULL, 0) != 0) {
+            mbedtls_exit(1);
+        }
+        TIME_PUBLIC("CTR_DRBG reseed", "reseed",
+                    ret = mbedtls_ctr_drbg_reseed(&ctr_drbg, NULL, 0));
+        mbedtls_ctr_drbg_free(&ctr_drbg);
+#endif
+        mbedtls_entropy_free(&entropy);
+    }
+#endif
+
 #if defined(MBEDTLS_RSA_C) && defined(MBEDTLS_GENPRIME)
     if (todo.rsa) {
         int keysize;
@@ -1160,6 +1330,51 @@ int main(int argc, char *argv[])
             mbedtls_ecdsa_free(&ecdsa);
         }
 
+#if defined(MBEDTLS_ECDSA_NONCE_POOL)
+        /* Signing latency once the nonces have been precomputed; the time
+         * spent filling the pool is not counted. */
+        for (curve_info = curve_list;
+             curve_info->grp_id != MBEDTLS_ECP_DP_NONE;
+             curve_info++) {
+            mbedtls_ecdsa_nonce_pool pool;
+            unsigned long ii, tsc;
+
+            if (!mbedtls_ecdsa_can_do(curve_info->grp_id)) {
+                continue;
+            }
+
+            mbedtls_ecdsa_init(&ecdsa);
+            mbedtls_ecdsa_nonce_pool_init(&pool);
+
+            if (mbedtls_ecdsa_genkey(&ecdsa, curve_info->grp_id, myrand, NULL) != 0 ||
+                mbedtls_ecdsa_nonce_pool_setup(&pool, curve_info->grp_id,
+                                               ECDSA_POOL_SIZE) != 0 ||
+                mbedtls_ecdsa_nonce_pool_fill(&pool, ECDSA_POOL_SIZE,
+                                              myrand, NULL) != 0) {
+                mbedtls_exit(1);
+            }
+
+            mbedtls_snprintf(title, sizeof(title), "ECDSA-%s",
+                             curve_info->name);
+            mbedtls_printf(HEADER_FORMAT, title);
+            fflush(stdout);
+
+            tsc = mbedtls_timing_hardclock();
+            for (ii = 0; ii < ECDSA_POOL_SIZE; ii++) {
+                if (mbedtls_ecdsa_write_signature_pooled(&ecdsa, buf, curve_info->bit_size,
+                                                         tmp, sizeof(tmp), &sig_len,
+                                                         &pool, myrand, NULL) != 0) {
+                    mbedtls_exit(1);
+                }
+            }
+            mbedtls_printf("%9lu cycles/sign (pooled)\n",
+                           (mbedtls_timing_hardclock() - tsc) / ii);
+
+            mbedtls_ecdsa_nonce_pool_free(&pool);
+            mbedtls_ecdsa_free(&ecdsa);
+        }
+#endif /* MBEDTLS_ECDSA_NONCE_POOL */
+
         for (curve_info = curve_list;
              curve_info->grp_id != MBEDTLS_ECP_DP_NONE;
              curve_info++) {
@@ -1186,6 +1401,53 @@ int main(int argc, char *argv[])
     }
 #endif
 
+#if defined(MBEDTLS_ED25519_C)
+    if (todo.eddsa) {
+        mbedtls_ed25519_context ed25519[EDDSA_BATCH_SIZE];
+        mbedtls_ed25519_batch_entry batch[EDDSA_BATCH_SIZE];
+        unsigned char sigs[EDDSA_BATCH_SIZE][MBEDTLS_ED25519_SIGNATURE_SIZE];
+        size_t sig_len, j;
+
+        /* Distinct keys and messages, as a server checking a batch of
+         * certificates or handshakes would see. */
+        memset(buf, 0x2A, sizeof(buf));
+        for (j = 0; j < EDDSA_BATCH_SIZE; j++) {
+            buf[j] = (unsigned char) j;
+        }
+
+        for (j = 0; j < EDDSA_BATCH_SIZE; j++) {
+            mbedtls_ed25519_init(&ed25519[j]);
+            if (mbedtls_ed25519_genkey(&ed25519[j], myrand, NULL) != 0 ||
+                mbedtls_ed25519_sign(&ed25519[j], buf + j, 32, sigs[j],
+                                     sizeof(sigs[j]), &sig_len) != 0) {
+                mbedtls_exit(1);
+            }
+            batch[j].ctx = &ed25519[j];
+            batch[j].msg = buf + j;
+            batch[j].msg_len = 32;
+            batch[j].sig = sigs[j];
+            batch[j].sig_len = sig_len;
+        }
+
+        TIME_PUBLIC("Ed25519", "sign",
+                    ret = mbedtls_ed25519_sign(&ed25519[0], buf, 32,
+                                               tmp, sizeof(tmp), &sig_len));
+        TIME_PUBLIC("Ed25519", "verify",
+                    ret = mbedtls_ed25519_verify(&ed25519[0], buf, 32,
+                                                 sigs[0], sig_len));
+
+        mbedtls_snprintf(title, sizeof(title), "Ed25519 batch of %d",
+                         EDDSA_BATCH_SIZE);
+        TIME_PUBLIC(title, "batch",
+                    ret = mbedtls_ed25519_verify_batch(batch, EDDSA_BATCH_SIZE,
+                                                       myrand, NULL));
+
+        for (j = 0; j < EDDSA_BATCH_SIZE; j++) {
+            mbedtls_ed25519_free(&ed25519[j]);
+        }
+    }
+#endif
+
 #if defined(MBEDTLS_ECDH_C)
     if (todo.ecdh) {
         mbedtls_ecdh_context ecdh_srv, ecdh_cli;
@@ -0,0 +1,242 @@
+/*
+ *  Report which implementation of each primitive is in use, and compare
+ *  the throughput of processor acceleration with the portable code
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+#include "mbedtls/build_info.h"
+
+#include "mbedtls/platform.h"
+
+#include "mbedtls/cpu_accel.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/platform_time.h"
+
+#include <string.h>
+
+#define USAGE \
+    "\n usage: cpu_accel [portable=<list>] [compare]\n"                        \
+    "\n acceptable parameters:\n"                                              \
+    "    portable=<list>  force the portable implementation of the listed\n"   \
+    "                     primitives: a comma-separated list of\n"             \
+    "                     aes, ghash, sha256, sha512, or all\n"                \
+    "    compare          measure the throughput of each primitive with\n"     \
+    "                     the selected implementation and with the\n"          \
+    "                     portable one (needs MBEDTLS_HAVE_TIME)\n"            \
+    "\n"
+
+/* Amount of data processed by each throughput measurement */
+#define COMPARE_BUFSIZE 1024
+#define COMPARE_MS      500
+
+static const struct {
+    const char *name;
+    unsigned int primitive;
+} primitives[] = {
+    { "aes", MBEDTLS_CPU_ACCEL_AES },
+    { "ghash", MBEDTLS_CPU_ACCEL_GHASH },
+    { "sha256", MBEDTLS_CPU_ACCEL_SHA256 },
+    { "sha512", MBEDTLS_CPU_ACCEL_SHA512 },
+};
+#define PRIMITIVE_COUNT (sizeof(primitives) / sizeof(primitives[0]))
+
+static int parse_primitives(const char *list, unsigned int *mask)
+{
+    const char *p = list;
+    size_t len, i;
+
+    *mask = 0;
+    while (*p != '\0') {
+        len = strcspn(p, ",");
+        if (len == 3 && memcmp(p, "all", 3) == 0) {
+            *mask |= MBEDTLS_CPU_ACCEL_ALL;
+        } else {
+            for (i = 0; i < PRIMITIVE_COUNT; i++) {
+                if (strlen(primitives[i].name) == len &&
+                    memcmp(p, primitives[i].name, len) == 0) {
+                    *mask |= primitives[i].primitive;
+                    break;
+                }
+            }
+            if (i == PRIMITIVE_COUNT) {
+                mbedtls_printf("Unknown primitive: %.*s\n", (int) len, p);
+                return -1;
+            }
+        }
+        p += len;
+        if (*p == ',') {
+            p++;
+        }
+    }
+
+    return 0;
+}
+
+#if defined(MBEDTLS_HAVE_TIME)
+static unsigned char buf[COMPARE_BUFSIZE];
+static unsigned char out[COMPARE_BUFSIZE];
+static const unsigned char key[32] = { 0x2b, 0x7e, 0x15, 0x16 };
+
+/* Process COMPARE_BUFSIZE bytes with the given primitive, set up from
+ * scratch so that the current implementation is selected. Return the
+ * number of bytes processed per millisecond, or a negative value if the
+ * primitive is not available. */
+static double throughput(unsigned int primitive)
+{
+    mbedtls_ms_time_t start, elapsed;
+    unsigned long bytes = 0;
+    int ret = 0;
+#if defined(MBEDTLS_AES_C)
+    mbedtls_aes_context aes;
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    mbedtls_gcm_context gcm;
+#endif
+
+#if defined(MBEDTLS_AES_C)
+    mbedtls_aes_init(&aes);
+    ret |= mbedtls_aes_setkey_enc(&aes, key, 128);
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    mbedtls_gcm_init(&gcm);
+    ret |= mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, 128);
+    ret |= mbedtls_gcm_starts(&gcm, MBEDTLS_GCM_ENCRYPT, key, 12);
+#endif
+    if (ret != 0) {
+        return -1;
+    }
+
+    start = mbedtls_ms_time();
+    do {
+        switch (primitive) {
+#if defined(MBEDTLS_AES_C)
+            case MBEDTLS_CPU_ACCEL_AES:
+            {
+                size_t i;
+                for (i = 0; i < COMPARE_BUFSIZE; i += 16) {
+                    ret |= mbedtls_aes_crypt_ecb(&aes, MBEDTLS_AES_ENCRYPT,
+                                                 buf + i, out + i);
+                }
+                break;
+            }
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+            case MBEDTLS_CPU_ACCEL_GHASH:
+                /* Additional data goes through GHASH only. */
+                ret |= mbedtls_gcm_update_ad(&gcm, buf, sizeof(buf));
+                break;
+#endif
+#if defined(MBEDTLS_SHA256_C)
+            case MBEDTLS_CPU_ACCEL_SHA256:
+                ret |= mbedtls_sha256(buf, sizeof(buf), out, 0);
+                break;
+#endif
+#if defined(MBEDTLS_SHA512_C)
+            case MBEDTLS_CPU_ACCEL_SHA512:
+                ret |= mbedtls_sha512(buf, sizeof(buf), out, 0);
+                break;
+#endif
+            default:
+                ret = -1;
+        }
+        bytes += COMPARE_BUFSIZE;
+        elapsed = mbedtls_ms_time() - start;
+    } while (ret == 0 && elapsed < COMPARE_MS);
+
+#if defined(MBEDTLS_AES_C)
+    mbedtls_aes_free(&aes);
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    mbedtls_gcm_free(&gcm);
+#endif
+
+    if (ret != 0) {
+        return -1;
+    }
+    return (double) bytes / (double) elapsed;
+}
+#endif /* MBEDTLS_HAVE_TIME */
+
+int main(int argc, char *argv[])
+{
+    int exit_code = MBEDTLS_EXIT_FAILURE;
+    unsigned int portable = 0;
+    int compare = 0;
+    const char *name;
+    size_t i;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if (strncmp(argv[arg], "portable=", 9) == 0) {
+            if (parse_primitives(argv[arg] + 9, &portable) != 0) {
+                goto usage;
+            }
+        } else if (strcmp(argv[arg], "compare") == 0) {
+            compare = 1;
+        } else {
+            goto usage;
+        }
+    }
+
+    if (mbedtls_cpu_accel_set_portable(portable) != 0) {
+        mbedtls_printf("Cannot force the portable implementation of:");
+        for (i = 0; i < PRIMITIVE_COUNT; i++) {
+            if ((portable & primitives[i].primitive) != 0 &&
+                mbedtls_cpu_accel_set_portable(primitives[i].primitive) != 0) {
+                mbedtls_printf(" %s", primitives[i].name);
+            }
+        }
+        mbedtls_printf("\n");
+        goto exit;
+    }
+
+    for (i = 0; i < PRIMITIVE_COUNT; i++) {
+        name = mbedtls_cpu_accel_get_implementation(primitives[i].primitive);
+        mbedtls_printf("%-8s %s\n", primitives[i].name,
+                       name == NULL ? "(not built)" : name);
+    }
+
+    if (compare) {
+#if defined(MBEDTLS_HAVE_TIME)
+        double selected, reference;
+
+        mbedtls_printf("\n%-8s %14s %14s %8s\n",
+                       "", "selected MB/s", "portable MB/s", "speedup");
+        for (i = 0; i < PRIMITIVE_COUNT; i++) {
+            mbedtls_cpu_accel_set_portable(portable);
+            selected = throughput(primitives[i].primitive);
+            if (selected < 0) {
+                continue;
+            }
+            if (mbedtls_cpu_accel_set_portable(portable |
+                                               primitives[i].primitive) != 0) {
+                mbedtls_printf("%-8s %14.1f %14s\n", primitives[i].name,
+                               selected / 1000, "(unavailable)");
+                continue;
+            }
+            reference = throughput(primitives[i].primitive);
+            mbedtls_printf("%-8s %14.1f %14.1f %7.2fx\n", primitives[i].name,
+                           selected / 1000, reference / 1000,
+                           reference > 0 ? selected / reference : 0);
+        }
+        mbedtls_cpu_accel_set_portable(portable);
+#else
+        mbedtls_printf("compare needs MBEDTLS_HAVE_TIME\n");
+        goto exit;
+#endif
+    }
+
+    exit_code = MBEDTLS_EXIT_SUCCESS;
+    goto exit;
+
+usage:
+    mbedtls_printf(USAGE);
+
+exit:
+    mbedtls_exit(exit_code);
+}
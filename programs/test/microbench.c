@@ -0,0 +1,949 @@
+/*
+ *  Micro-benchmarks of internal primitives
+ *
+ *  Unlike benchmark.c, which measures the throughput of the public APIs on
+ *  large buffers, this program measures the cost of a single call to the
+ *  kernels those APIs are built on, so that a regression in one of them is
+ *  not hidden by the surrounding code. It reaches library internals, so it
+ *  requires MBEDTLS_TEST_HOOKS.
+ *
+ *  Copyright The Mbed TLS Contributors
+ *  SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+ */
+
+/* for clock_gettime() */
+#define _POSIX_C_SOURCE 200112L
+
+/* for the library internals, such as the TLS record HMAC */
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include "mbedtls/build_info.h"
+
+#include "mbedtls/platform.h"
+
+#if !defined(MBEDTLS_TEST_HOOKS) || !defined(MBEDTLS_HAVE_TIME)
+int main(void)
+{
+    mbedtls_printf("MBEDTLS_TEST_HOOKS and/or MBEDTLS_HAVE_TIME not defined.\n");
+    mbedtls_exit(0);
+}
+#else
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/aes.h"
+#include "mbedtls/asn1.h"
+#include "mbedtls/constant_time.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha1.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/x509_crt.h"
+
+#include "common.h"
+#include "bignum_core.h"
+#include "constant_time_internal.h"
+#include "ecp_invasive.h"
+#include "gcm_invasive.h"
+#if defined(MBEDTLS_SSL_TLS_C)
+#include "ssl_misc.h"
+#endif
+
+#include "test/certs.h"
+
+#define USAGE                                                               \
+    "\n usage: microbench [--json] [--reps=N] [name ...]\n"                 \
+    "\n Runs the micro-benchmarks whose name starts with one of the given\n" \
+    " names, or all of them. Each benchmark is run N times (default %d)\n"  \
+    " and the time per call is reported in " MICROBENCH_UNIT ".\n"          \
+    "\n --json    print the results as a JSON object\n"                     \
+    " --reps=N  number of timed repetitions, 1 to %d\n\n"
+
+#define DEFAULT_REPS    25
+#define MAX_REPS        1000
+#define WARMUP_BATCHES  4
+
+/* Each timed repetition runs enough calls to last at least this many
+ * clock ticks, so that the clock resolution and the cost of reading it
+ * are negligible. */
+#define MIN_BATCH_TICKS 100000
+#define MAX_BATCH       (1u << 24)
+
+/*
+ * Clock. On x86 this is the time stamp counter, which on modern processors
+ * counts reference cycles at a fixed rate rather than core cycles: disable
+ * frequency scaling for stable results. Elsewhere, fall back to a monotonic
+ * clock in nanoseconds.
+ */
+#if defined(MBEDTLS_HAVE_ASM) && defined(__GNUC__) && \
+    (defined(__i386__) || defined(__amd64__) || defined(__x86_64__))
+
+#define MICROBENCH_UNIT "cycles"
+
+static uint64_t microbench_clock(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+
+#include <intrin.h>
+
+#define MICROBENCH_UNIT "cycles"
+
+static uint64_t microbench_clock(void)
+{
+    return __rdtsc();
+}
+
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+#define MICROBENCH_UNIT "ns"
+
+static uint64_t microbench_clock(void)
+{
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+    return (uint64_t) (now.QuadPart / freq.QuadPart) * 1000000000u +
+           (uint64_t) (now.QuadPart % freq.QuadPart) * 1000000000u /
+           (uint64_t) freq.QuadPart;
+}
+
+#else
+
+#include <time.h>
+
+#define MICROBENCH_UNIT "ns"
+
+static uint64_t microbench_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+#endif
+
+/*
+ * Measurement harness
+ */
+
+typedef int (*bench_fn_t)(void *ctx);
+
+static struct {
+    int json;
+    unsigned reps;
+    int count;              /* number of results printed so far */
+    char **names;
+    int name_count;
+} opt;
+
+static double samples[MAX_REPS];
+
+static int bench_selected(const char *name)
+{
+    int i;
+
+    if (opt.name_count == 0) {
+        return 1;
+    }
+    for (i = 0; i < opt.name_count; i++) {
+        if (strncmp(name, opt.names[i], strlen(opt.names[i])) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static double quantile(const double *sorted, unsigned n, unsigned num, unsigned den)
+{
+    unsigned lo = (n - 1) * num / den;
+    unsigned rem = (n - 1) * num % den;
+
+    if (rem == 0) {
+        return sorted[lo];
+    }
+    return sorted[lo] + (sorted[lo + 1] - sorted[lo]) * rem / den;
+}
+
+static int run_batch(bench_fn_t fn, void *ctx, unsigned long batch,
+                     uint64_t *ticks)
+{
+    unsigned long i;
+    int ret = 0;
+    uint64_t start = microbench_clock();
+
+    for (i = 0; i < batch && ret == 0; i++) {
+        ret = fn(ctx);
+    }
+    *ticks = microbench_clock() - start;
+    return ret;
+}
+
+static void print_failure(const char *name, int ret)
+{
+    if (opt.json) {
+        mbedtls_printf("%s\n    {\"name\": \"%s\", \"error\": %d}",
+                       opt.count == 0 ? "" : ",", name, ret);
+        opt.count++;
+    } else {
+        mbedtls_printf("  %-36s FAILED: -0x%04x\n", name, (unsigned int) -ret);
+    }
+}
+
+/*
+ * Time fn(ctx): first double the batch size until a batch lasts at least
+ * MIN_BATCH_TICKS, then run a few batches to warm up caches and branch
+ * predictors, then time opt.reps batches and report statistics of the
+ * time per call over the repetitions.
+ */
+static void measure(const char *name, bench_fn_t fn, void *ctx)
+{
+    unsigned long batch = 1;
+    uint64_t ticks;
+    unsigned r;
+    double sum = 0;
+    int ret;
+
+    while ((ret = run_batch(fn, ctx, batch, &ticks)) == 0 &&
+           ticks < MIN_BATCH_TICKS && batch < MAX_BATCH) {
+        batch *= 2;
+    }
+    for (r = 0; ret == 0 && r < WARMUP_BATCHES; r++) {
+        ret = run_batch(fn, ctx, batch, &ticks);
+    }
+    for (r = 0; ret == 0 && r < opt.reps; r++) {
+        ret = run_batch(fn, ctx, batch, &ticks);
+        samples[r] = (double) ticks / batch;
+        sum += samples[r];
+    }
+    if (ret != 0) {
+        print_failure(name, ret);
+        return;
+    }
+
+    qsort(samples, opt.reps, sizeof(samples[0]), compare_double);
+
+    if (opt.json) {
+        mbedtls_printf("%s\n    {\"name\": \"%s\", \"calls\": %lu, \"reps\": %u, "
+                       "\"min\": %.1f, \"q1\": %.1f, \"median\": %.1f, "
+                       "\"q3\": %.1f, \"max\": %.1f, \"mean\": %.1f}",
+                       opt.count == 0 ? "" : ",", name, batch, opt.reps,
+                       samples[0], quantile(samples, opt.reps, 1, 4),
+                       quantile(samples, opt.reps, 1, 2),
+                       quantile(samples, opt.reps, 3, 4),
+                       samples[opt.reps - 1], sum / opt.reps);
+    } else {
+        mbedtls_printf("  %-36s %12.1f %12.1f %12.1f %12.1f\n", name,
+                       samples[0], quantile(samples, opt.reps, 1, 2),
+                       sum / opt.reps, samples[opt.reps - 1]);
+    }
+    opt.count++;
+}
+
+/*
+ * Deterministic filler, so that runs are comparable.
+ */
+static uint32_t fill_state = 0x2545f491;
+
+static void fill(void *buf, size_t len)
+{
+    unsigned char *p = buf;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        fill_state ^= fill_state << 13;
+        fill_state ^= fill_state >> 17;
+        fill_state ^= fill_state << 5;
+        p[i] = (unsigned char) fill_state;
+    }
+}
+
+/*
+ * Bignum
+ */
+
+#if defined(MBEDTLS_BIGNUM_C)
+typedef struct {
+    mbedtls_mpi_uint *X, *A, *B, *N, *T;
+    size_t limbs;
+    mbedtls_mpi_uint mm;
+    size_t count;
+    size_t index;
+} bench_mpi_t;
+
+static int bench_montmul(void *ctx)
+{
+    bench_mpi_t *b = ctx;
+    mbedtls_mpi_core_montmul(b->X, b->A, b->B, b->limbs, b->N, b->limbs,
+                             b->mm, b->T);
+    return 0;
+}
+
+static int bench_table_lookup(void *ctx)
+{
+    bench_mpi_t *b = ctx;
+    mbedtls_mpi_core_ct_uint_table_lookup(b->X, b->T, b->limbs, b->count,
+                                          b->index);
+    b->index = (b->index + 1) % b->count;
+    return 0;
+}
+
+static void bench_mpi(void)
+{
+    static const size_t bits[] = { 256, 384, 521, 2048, 3072, 4096 };
+    char name[64];
+    size_t i;
+
+    for (i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+        bench_mpi_t b;
+        size_t table_limbs;
+
+        memset(&b, 0, sizeof(b));
+        b.limbs = BITS_TO_LIMBS(bits[i]);
+        b.count = (size_t) 1 << MBEDTLS_MPI_WINDOW_SIZE;
+        table_limbs = b.count * b.limbs;
+        if (table_limbs < 2 * b.limbs + 1) {
+            table_limbs = 2 * b.limbs + 1;
+        }
+
+        b.X = mbedtls_calloc(b.limbs, sizeof(mbedtls_mpi_uint));
+        b.A = mbedtls_calloc(b.limbs, sizeof(mbedtls_mpi_uint));
+        b.B = mbedtls_calloc(b.limbs, sizeof(mbedtls_mpi_uint));
+        b.N = mbedtls_calloc(b.limbs, sizeof(mbedtls_mpi_uint));
+        b.T = mbedtls_calloc(table_limbs, sizeof(mbedtls_mpi_uint));
+        if (b.X == NULL || b.A == NULL || b.B == NULL || b.N == NULL ||
+            b.T == NULL) {
+            print_failure("mpi_core", MBEDTLS_ERR_MPI_ALLOC_FAILED);
+            goto next;
+        }
+
+        /* An odd modulus of exactly bits[i] bits, and operands below it. */
+        fill(b.N, b.limbs * sizeof(mbedtls_mpi_uint));
+        fill(b.A, b.limbs * sizeof(mbedtls_mpi_uint));
+        fill(b.B, b.limbs * sizeof(mbedtls_mpi_uint));
+        b.N[0] |= 1;
+        if (bits[i] % biL != 0) {
+            b.N[b.limbs - 1] &= ((mbedtls_mpi_uint) 1 << (bits[i] % biL)) - 1;
+        }
+        b.N[b.limbs - 1] |= (mbedtls_mpi_uint) 1 << ((bits[i] - 1) % biL);
+        b.A[b.limbs - 1] &= b.N[b.limbs - 1] >> 1;
+        b.B[b.limbs - 1] &= b.N[b.limbs - 1] >> 1;
+        b.mm = mbedtls_mpi_core_montmul_init(b.N);
+
+        mbedtls_snprintf(name, sizeof(name), "mpi_core_montmul %u",
+                         (unsigned) bits[i]);
+        if (bench_selected(name)) {
+            measure(name, bench_montmul, &b);
+        }
+
+        fill(b.T, table_limbs * sizeof(mbedtls_mpi_uint));
+        mbedtls_snprintf(name, sizeof(name), "mpi_core_table_lookup %ux%u",
+                         (unsigned) bits[i], (unsigned) b.count);
+        if (bench_selected(name)) {
+            measure(name, bench_table_lookup, &b);
+        }
+
+next:
+        mbedtls_free(b.X);
+        mbedtls_free(b.A);
+        mbedtls_free(b.B);
+        mbedtls_free(b.N);
+        mbedtls_free(b.T);
+    }
+}
+#endif /* MBEDTLS_BIGNUM_C */
+
+/*
+ * Elliptic curve point arithmetic
+ */
+
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED)
+typedef struct {
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R;
+    mbedtls_mpi tmp[4];
+} bench_ecp_t;
+
+static int bench_double_jac(void *ctx)
+{
+    bench_ecp_t *b = ctx;
+    return mbedtls_ecp_double_jac(&b->grp, &b->R, &b->R, b->tmp);
+}
+
+static int bench_add_mixed(void *ctx)
+{
+    bench_ecp_t *b = ctx;
+    return mbedtls_ecp_add_mixed(&b->grp, &b->R, &b->R, &b->grp.G, b->tmp);
+}
+
+static void bench_ecp(void)
+{
+    static const mbedtls_ecp_group_id ids[] = {
+        MBEDTLS_ECP_DP_SECP256R1,
+        MBEDTLS_ECP_DP_SECP384R1,
+        MBEDTLS_ECP_DP_SECP521R1,
+        MBEDTLS_ECP_DP_SECP256K1,
+        MBEDTLS_ECP_DP_BP256R1,
+    };
+    const mbedtls_ecp_curve_info *info;
+    char name[64];
+    size_t i, j;
+    int ret;
+
+    for (i = 0; i < sizeof(ids) / sizeof(ids[0]); i++) {
+        bench_ecp_t b;
+
+        info = mbedtls_ecp_curve_info_from_grp_id(ids[i]);
+        if (info == NULL) {
+            continue;
+        }
+
+        mbedtls_ecp_group_init(&b.grp);
+        mbedtls_ecp_point_init(&b.R);
+        for (j = 0; j < 4; j++) {
+            mbedtls_mpi_init(&b.tmp[j]);
+        }
+
+        /* Start from 2G, so that R is not normalized and the mixed
+         * addition never hits the doubling or zero special cases. */
+        if ((ret = mbedtls_ecp_group_load(&b.grp, ids[i])) != 0 ||
+            (ret = mbedtls_ecp_double_jac(&b.grp, &b.R, &b.grp.G, b.tmp)) != 0) {
+            print_failure(info->name, ret);
+            goto next;
+        }
+
+        mbedtls_snprintf(name, sizeof(name), "ecp_double_jac %s", info->name);
+        if (bench_selected(name)) {
+            measure(name, bench_double_jac, &b);
+        }
+
+        mbedtls_snprintf(name, sizeof(name), "ecp_add_mixed %s", info->name);
+        if (bench_selected(name)) {
+            measure(name, bench_add_mixed, &b);
+        }
+
+next:
+        mbedtls_ecp_group_free(&b.grp);
+        mbedtls_ecp_point_free(&b.R);
+        for (j = 0; j < 4; j++) {
+            mbedtls_mpi_free(&b.tmp[j]);
+        }
+    }
+}
+#endif /* MBEDTLS_ECP_C && MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED */
+
+/*
+ * Symmetric primitives
+ */
+
+#if defined(MBEDTLS_AES_C)
+typedef struct {
+    mbedtls_aes_context aes;
+    unsigned char key[32];
+    unsigned int keybits;
+    unsigned char block[16];
+} bench_aes_t;
+
+static int bench_aes_setkey_enc(void *ctx)
+{
+    bench_aes_t *b = ctx;
+    return mbedtls_aes_setkey_enc(&b->aes, b->key, b->keybits);
+}
+
+static int bench_aes_encrypt(void *ctx)
+{
+    bench_aes_t *b = ctx;
+    return mbedtls_aes_crypt_ecb(&b->aes, MBEDTLS_AES_ENCRYPT, b->block, b->block);
+}
+
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+static int bench_aes_setkey_dec(void *ctx)
+{
+    bench_aes_t *b = ctx;
+    return mbedtls_aes_setkey_dec(&b->aes, b->key, b->keybits);
+}
+
+static int bench_aes_decrypt(void *ctx)
+{
+    bench_aes_t *b = ctx;
+    return mbedtls_aes_crypt_ecb(&b->aes, MBEDTLS_AES_DECRYPT, b->block, b->block);
+}
+#endif /* !MBEDTLS_BLOCK_CIPHER_NO_DECRYPT */
+
+static void bench_aes(void)
+{
+    static const unsigned int keybits[] = { 128, 256 };
+    char name[64];
+    size_t i;
+    int ret;
+
+    for (i = 0; i < sizeof(keybits) / sizeof(keybits[0]); i++) {
+        bench_aes_t b;
+
+        mbedtls_aes_init(&b.aes);
+        b.keybits = keybits[i];
+        fill(b.key, sizeof(b.key));
+        fill(b.block, sizeof(b.block));
+
+        mbedtls_snprintf(name, sizeof(name), "aes_setkey_enc %u", b.keybits);
+        if (bench_selected(name)) {
+            measure(name, bench_aes_setkey_enc, &b);
+        }
+#if !defined(MBEDTLS_BLOCK_CIPHER_NO_DECRYPT)
+        mbedtls_snprintf(name, sizeof(name), "aes_setkey_dec %u", b.keybits);
+        if (bench_selected(name)) {
+            measure(name, bench_aes_setkey_dec, &b);
+        }
+        mbedtls_snprintf(name, sizeof(name), "aes_decrypt_block %u", b.keybits);
+        if (bench_selected(name)) {
+            measure(name, bench_aes_decrypt, &b);
+        }
+#endif
+        mbedtls_snprintf(name, sizeof(name), "aes_encrypt_block %u", b.keybits);
+        if (bench_selected(name)) {
+            if ((ret = mbedtls_aes_setkey_enc(&b.aes, b.key, b.keybits)) != 0) {
+                print_failure(name, ret);
+            } else {
+                measure(name, bench_aes_encrypt, &b);
+            }
+        }
+
+        mbedtls_aes_free(&b.aes);
+    }
+}
+#endif /* MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_GCM_C) && !defined(MBEDTLS_GCM_ALT)
+typedef struct {
+    mbedtls_gcm_context gcm;
+    unsigned char x[16];
+} bench_gcm_t;
+
+static int bench_gcm_mult(void *ctx)
+{
+    bench_gcm_t *b = ctx;
+    mbedtls_gcm_mult(&b->gcm, b->x, b->x);
+    return 0;
+}
+
+static void bench_gcm(void)
+{
+    const char *name = "gcm_mult";
+    unsigned char key[16];
+    bench_gcm_t b;
+    int ret;
+
+    if (!bench_selected(name)) {
+        return;
+    }
+
+    mbedtls_gcm_init(&b.gcm);
+    fill(key, sizeof(key));
+    fill(b.x, sizeof(b.x));
+    if ((ret = mbedtls_gcm_setkey(&b.gcm, MBEDTLS_CIPHER_ID_AES, key, 128)) != 0) {
+        print_failure(name, ret);
+    } else {
+        measure(name, bench_gcm_mult, &b);
+    }
+    mbedtls_gcm_free(&b.gcm);
+}
+#endif /* MBEDTLS_GCM_C && !MBEDTLS_GCM_ALT */
+
+#if defined(MBEDTLS_SHA1_C)
+static int bench_sha1_process(void *ctx)
+{
+    static unsigned char data[64];
+    return mbedtls_internal_sha1_process(ctx, data);
+}
+#endif
+
+#if defined(MBEDTLS_SHA256_C)
+static int bench_sha256_process(void *ctx)
+{
+    static unsigned char data[64];
+    return mbedtls_internal_sha256_process(ctx, data);
+}
+#endif
+
+#if defined(MBEDTLS_SHA512_C)
+static int bench_sha512_process(void *ctx)
+{
+    static unsigned char data[128];
+    return mbedtls_internal_sha512_process(ctx, data);
+}
+#endif
+
+static void bench_sha(void)
+{
+#if defined(MBEDTLS_SHA1_C)
+    if (bench_selected("sha1_process")) {
+        mbedtls_sha1_context sha1;
+        mbedtls_sha1_init(&sha1);
+        mbedtls_sha1_starts(&sha1);
+        measure("sha1_process", bench_sha1_process, &sha1);
+        mbedtls_sha1_free(&sha1);
+    }
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    if (bench_selected("sha256_process")) {
+        mbedtls_sha256_context sha256;
+        mbedtls_sha256_init(&sha256);
+        mbedtls_sha256_starts(&sha256, 0);
+        measure("sha256_process", bench_sha256_process, &sha256);
+        mbedtls_sha256_free(&sha256);
+    }
+#endif
+#if defined(MBEDTLS_SHA512_C)
+    if (bench_selected("sha512_process")) {
+        mbedtls_sha512_context sha512;
+        mbedtls_sha512_init(&sha512);
+        mbedtls_sha512_starts(&sha512, 0);
+        measure("sha512_process", bench_sha512_process, &sha512);
+        mbedtls_sha512_free(&sha512);
+    }
+#endif
+}
+
+/*
+ * Constant-time helpers
+ */
+
+typedef struct {
+    unsigned char a[256];
+    unsigned char b[256];
+    unsigned char out[256];
+    size_t offset;
+    int result;
+} bench_ct_t;
+
+static int bench_ct_memcmp(void *ctx)
+{
+    bench_ct_t *b = ctx;
+    b->result = mbedtls_ct_memcmp(b->a, b->b, 64);
+    return 0;
+}
+
+static int bench_ct_memcpy_if(void *ctx)
+{
+    bench_ct_t *b = ctx;
+    mbedtls_ct_memcpy_if(mbedtls_ct_bool(b->a[0] & 1), b->out, b->a, b->b, 64);
+    return 0;
+}
+
+static int bench_ct_memcpy_offset(void *ctx)
+{
+    bench_ct_t *b = ctx;
+    mbedtls_ct_memcpy_offset(b->out, b->a, b->offset, 0, 256 - 32, 32);
+    b->offset = (b->offset + 7) % (256 - 32 + 1);
+    return 0;
+}
+
+#if defined(MBEDTLS_PKCS1_V15) && defined(MBEDTLS_RSA_C) && !defined(MBEDTLS_RSA_ALT)
+static int bench_ct_memmove_left(void *ctx)
+{
+    bench_ct_t *b = ctx;
+    mbedtls_ct_memmove_left(b->out, sizeof(b->out), b->offset);
+    b->offset = (b->offset + 7) % sizeof(b->out);
+    return 0;
+}
+#endif
+
+static void bench_ct(void)
+{
+    bench_ct_t b;
+
+    memset(&b, 0, sizeof(b));
+    fill(b.a, sizeof(b.a));
+    memcpy(b.b, b.a, sizeof(b.b));
+
+    if (bench_selected("ct_memcmp 64")) {
+        measure("ct_memcmp 64", bench_ct_memcmp, &b);
+    }
+    if (bench_selected("ct_memcpy_if 64")) {
+        measure("ct_memcpy_if 64", bench_ct_memcpy_if, &b);
+    }
+    if (bench_selected("ct_memcpy_offset 32/256")) {
+        measure("ct_memcpy_offset 32/256", bench_ct_memcpy_offset, &b);
+    }
+#if defined(MBEDTLS_PKCS1_V15) && defined(MBEDTLS_RSA_C) && !defined(MBEDTLS_RSA_ALT)
+    if (bench_selected("ct_memmove_left 256")) {
+        measure("ct_memmove_left 256", bench_ct_memmove_left, &b);
+    }
+#endif
+}
+
+/*
+ * Constant-flow HMAC of TLS 1.2 CBC records (Lucky 13 countermeasure)
+ */
+
+#if defined(MBEDTLS_SSL_TLS_C) && defined(MBEDTLS_SSL_SOME_SUITES_USE_MAC)
+typedef struct {
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    mbedtls_svc_key_id_t key;
+    psa_algorithm_t alg;
+#else
+    mbedtls_md_context_t md_ctx;
+#endif
+    unsigned char add_data[13];
+    unsigned char data[1024];
+    unsigned char mac[MBEDTLS_MD_MAX_SIZE];
+} bench_ct_hmac_t;
+
+/* A 1024-byte record whose last 256 bytes may be padding, so that the
+ * length of the MAC'd data is secret. */
+static int bench_ct_hmac(void *ctx)
+{
+    bench_ct_hmac_t *b = ctx;
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    return mbedtls_ct_hmac(b->key, b->alg,
+#else
+    return mbedtls_ct_hmac(&b->md_ctx,
+#endif
+                           b->add_data, sizeof(b->add_data),
+                           b->data, sizeof(b->data) - 128,
+                           sizeof(b->data) - 256, sizeof(b->data), b->mac);
+}
+
+static void bench_tls_cbc_hmac(void)
+{
+    static const struct {
+        mbedtls_md_type_t md;
+        const char *name;
+    } mds[] = {
+        { MBEDTLS_MD_SHA1, "ct_hmac SHA-1 1024" },
+        { MBEDTLS_MD_SHA256, "ct_hmac SHA-256 1024" },
+        { MBEDTLS_MD_SHA384, "ct_hmac SHA-384 1024" },
+    };
+    bench_ct_hmac_t b;
+    unsigned char key[MBEDTLS_MD_MAX_SIZE];
+    size_t i;
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+
+    if (psa_crypto_init() != PSA_SUCCESS) {
+        print_failure("ct_hmac", MBEDTLS_ERR_ERROR_GENERIC_ERROR);
+        return;
+    }
+#else
+    const mbedtls_md_info_t *md_info;
+#endif
+
+    memset(&b, 0, sizeof(b));
+    fill(b.add_data, sizeof(b.add_data));
+    fill(b.data, sizeof(b.data));
+    fill(key, sizeof(key));
+
+    for (i = 0; i < sizeof(mds) / sizeof(mds[0]); i++) {
+        if (!bench_selected(mds[i].name)) {
+            continue;
+        }
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+        b.alg = PSA_ALG_HMAC(mbedtls_md_psa_alg_from_type(mds[i].md));
+        psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_EXPORT |
+                                PSA_KEY_USAGE_SIGN_MESSAGE);
+        psa_set_key_algorithm(&attributes, b.alg);
+        psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+        if (psa_import_key(&attributes, key, PSA_HASH_LENGTH(b.alg),
+                           &b.key) != PSA_SUCCESS) {
+            continue;
+        }
+        measure(mds[i].name, bench_ct_hmac, &b);
+        psa_destroy_key(b.key);
+#else
+        md_info = mbedtls_md_info_from_type(mds[i].md);
+        if (md_info == NULL) {
+            continue;
+        }
+        mbedtls_md_init(&b.md_ctx);
+        if (mbedtls_md_setup(&b.md_ctx, md_info, 1) == 0 &&
+            mbedtls_md_hmac_starts(&b.md_ctx, key,
+                                   mbedtls_md_get_size(md_info)) == 0) {
+            measure(mds[i].name, bench_ct_hmac, &b);
+        }
+        mbedtls_md_free(&b.md_ctx);
+#endif
+    }
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO)
+    mbedtls_psa_crypto_free();
+#endif
+}
+#endif /* MBEDTLS_SSL_TLS_C && MBEDTLS_SSL_SOME_SUITES_USE_MAC */
+
+/*
+ * ASN.1 and X.509 parsing
+ */
+
+#if defined(MBEDTLS_ASN1_PARSE_C)
+typedef struct {
+    const unsigned char *der;
+    size_t len;
+} bench_der_t;
+
+/* Visit every TLV of a DER structure, descending into constructed ones. */
+static int asn1_walk(unsigned char **p, const unsigned char *end, int depth)
+{
+    size_t len;
+    int ret;
+
+    while (*p < end) {
+        unsigned char tag = **p;
+
+        (*p)++;
+        if ((ret = mbedtls_asn1_get_len(p, end, &len)) != 0) {
+            return ret;
+        }
+        if ((tag & MBEDTLS_ASN1_CONSTRUCTED) != 0 && depth < 16) {
+            if ((ret = asn1_walk(p, *p + len, depth + 1)) != 0) {
+                return ret;
+            }
+        } else {
+            *p += len;
+        }
+    }
+    return 0;
+}
+
+static int bench_asn1_walk(void *ctx)
+{
+    bench_der_t *b = ctx;
+    unsigned char *p = (unsigned char *) b->der;
+    return asn1_walk(&p, b->der + b->len, 0);
+}
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+static int bench_x509_crt_parse(void *ctx)
+{
+    bench_der_t *b = ctx;
+    mbedtls_x509_crt crt;
+    int ret;
+
+    mbedtls_x509_crt_init(&crt);
+    ret = mbedtls_x509_crt_parse_der_nocopy(&crt, b->der, b->len);
+    mbedtls_x509_crt_free(&crt);
+    return ret;
+}
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
+
+static void bench_parse(void)
+{
+    static const struct {
+        const char *name;
+        const unsigned char *der;
+        const size_t *len;
+    } certs[] = {
+#if defined(MBEDTLS_RSA_C)
+        { "RSA CA", mbedtls_test_ca_crt_rsa_sha256_der,
+          &mbedtls_test_ca_crt_rsa_sha256_der_len },
+#endif
+#if defined(MBEDTLS_PK_HAVE_ECC_KEYS)
+        { "EC CA", mbedtls_test_ca_crt_ec_der,
+          &mbedtls_test_ca_crt_ec_der_len },
+#endif
+        { NULL, NULL, NULL }
+    };
+    char name[64];
+    size_t i;
+
+    for (i = 0; certs[i].name != NULL; i++) {
+        bench_der_t b;
+
+        b.der = certs[i].der;
+        b.len = *certs[i].len;
+        mbedtls_snprintf(name, sizeof(name), "asn1_walk %s", certs[i].name);
+        if (bench_selected(name)) {
+            measure(name, bench_asn1_walk, &b);
+        }
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+        mbedtls_snprintf(name, sizeof(name), "x509_crt_parse %s", certs[i].name);
+        if (bench_selected(name)) {
+            measure(name, bench_x509_crt_parse, &b);
+        }
+#endif
+    }
+}
+#endif /* MBEDTLS_ASN1_PARSE_C */
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    opt.reps = DEFAULT_REPS;
+    opt.names = mbedtls_calloc((size_t) argc, sizeof(char *));
+    if (opt.names == NULL) {
+        mbedtls_exit(MBEDTLS_EXIT_FAILURE);
+    }
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            opt.json = 1;
+        } else if (strncmp(argv[i], "--reps=", 7) == 0) {
+            int reps = atoi(argv[i] + 7);
+            if (reps < 1 || reps > MAX_REPS) {
+                mbedtls_printf(USAGE, DEFAULT_REPS, MAX_REPS);
+                mbedtls_exit(MBEDTLS_EXIT_FAILURE);
+            }
+            opt.reps = (unsigned) reps;
+        } else if (argv[i][0] == '-') {
+            mbedtls_printf(USAGE, DEFAULT_REPS, MAX_REPS);
+            mbedtls_exit(strcmp(argv[i], "--help") == 0 ?
+                         MBEDTLS_EXIT_SUCCESS : MBEDTLS_EXIT_FAILURE);
+        } else {
+            opt.names[opt.name_count++] = argv[i];
+        }
+    }
+
+    if (opt.json) {
+        mbedtls_printf("{\n  \"unit\": \"%s\",\n  \"results\": [", MICROBENCH_UNIT);
+    } else {
+        mbedtls_printf("\n  %-36s %12s %12s %12s %12s\n", MICROBENCH_UNIT " per call",
+                       "min", "median", "mean", "max");
+    }
+
+#if defined(MBEDTLS_BIGNUM_C)
+    bench_mpi();
+#endif
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_SHORT_WEIERSTRASS_ENABLED)
+    bench_ecp();
+#endif
+#if defined(MBEDTLS_AES_C)
+    bench_aes();
+#endif
+#if defined(MBEDTLS_GCM_C) && !defined(MBEDTLS_GCM_ALT)
+    bench_gcm();
+#endif
+    bench_sha();
+    bench_ct();
+#if defined(MBEDTLS_SSL_TLS_C) && defined(MBEDTLS_SSL_SOME_SUITES_USE_MAC)
+    bench_tls_cbc_hmac();
+#endif
+#if defined(MBEDTLS_ASN1_PARSE_C)
+    bench_parse();
+#endif
+
+    if (opt.json) {
+        mbedtls_printf("\n  ]\n}\n");
+    } else {
+        mbedtls_printf("\n");
+    }
+
+    mbedtls_free(opt.names);
+    mbedtls_exit(MBEDTLS_EXIT_SUCCESS);
+}
+
+#endif /* MBEDTLS_TEST_HOOKS && MBEDTLS_HAVE_TIME */
@@ -34,6 +34,7 @@
 #include "mbedtls/pkcs5.h"
 #include "mbedtls/ecp.h"
 #include "mbedtls/ecjpake.h"
+#include "mbedtls/ed25519.h"
 #include "mbedtls/timing.h"
 #include "mbedtls/nist_kw.h"
 #include "mbedtls/debug.h"
@@ -350,6 +351,9 @@ const selftest_t selftests[] =
 #if defined(MBEDTLS_ECJPAKE_C)
     { "ecjpake", mbedtls_ecjpake_self_test },
 #endif
+#if defined(MBEDTLS_ED25519_C)
+    { "ed25519", mbedtls_ed25519_self_test },
+#endif
 #if defined(MBEDTLS_DHM_C)
     { "dhm", mbedtls_dhm_self_test },
 #endif
@@ -210,6 +210,7 @@ EXCLUDE_FROM_FULL = frozenset([
     'MBEDTLS_SHA256_USE_A64_CRYPTO_IF_PRESENT', # setting *_USE_ARMV8_A_CRYPTO is sufficient
     'MBEDTLS_TEST_CONSTANT_FLOW_MEMSAN', # build dependency (clang+memsan)
     'MBEDTLS_TEST_CONSTANT_FLOW_VALGRIND', # build dependency (valgrind headers)
+    'MBEDTLS_THREADING_STATS', # profiling, slows down every lock
     'MBEDTLS_X509_REMOVE_INFO', # removes a feature
 ])
 
@@ -269,6 +270,7 @@ EXCLUDE_FROM_BAREMETAL = frozenset([
     'MBEDTLS_PSA_ITS_FILE_C', # requires a filesystem
     'MBEDTLS_THREADING_C', # requires a threading interface
     'MBEDTLS_THREADING_PTHREAD', # requires pthread
+    'MBEDTLS_THREADING_STATS', # requires pthread
     'MBEDTLS_TIMING_C', # requires a clock
     'MBEDTLS_SHA256_USE_A64_CRYPTO_IF_PRESENT', # requires an OS for runtime-detection
     'MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT', # requires an OS for runtime-detection
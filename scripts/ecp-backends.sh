@@ -0,0 +1,55 @@
+#!/bin/sh
+
+# Compare the performance of the two ECP backends: the generic bignum
+# coordinate arithmetic, and the fixed-size field arithmetic that is used
+# with MBEDTLS_ECP_WITH_MPI_UINT.
+#
+# Usage:
+# cmake -D CMAKE_BUILD_TYPE=Release .
+# scripts/ecp-backends.sh | tee ecp-backends.log
+#
+# Copyright The Mbed TLS Contributors
+# SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+
+set -eu
+
+CONFIG_H='include/mbedtls/mbedtls_config.h'
+
+if [ -r $CONFIG_H ]; then :; else
+    echo "$CONFIG_H not found" >&2
+    exit 1
+fi
+
+if grep -i cmake Makefile >/dev/null; then :; else
+    echo "Needs Cmake" >&2
+    exit 1
+fi
+
+if git status | grep -F $CONFIG_H >/dev/null 2>&1; then
+    echo "mbedtls_config.h not clean" >&2
+    exit 1
+fi
+
+CONFIG_BAK=${CONFIG_H}.bak
+cp $CONFIG_H $CONFIG_BAK
+
+# microbench needs the test hooks to reach the point arithmetic
+scripts/config.py set MBEDTLS_TEST_HOOKS
+
+for B in generic fixed-size; do
+    if [ $B = generic ]; then
+        scripts/config.py unset MBEDTLS_ECP_WITH_MPI_UINT
+    else
+        scripts/config.py set MBEDTLS_ECP_WITH_MPI_UINT
+    fi
+    make benchmark microbench >/dev/null 2>&1
+    echo "ECP backend: $B"
+    echo "--------------------------------------------"
+    programs/test/benchmark ecdsa ecdh
+    programs/test/microbench ecp_
+done
+
+# cleanup
+
+mv $CONFIG_BAK $CONFIG_H
+make clean
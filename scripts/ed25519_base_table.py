@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Purpose
+
+This script generates the table of multiples of the Ed25519 base point
+(`ed25519_base_table` in library/ed25519.c). Row k holds 1..8 times
+2^(16k) B in the affine form (y + x, y - x, 2dxy) that ge_madd() uses,
+with each coordinate reduced mod p and split into the 26/25-bit limbs of
+the `fe` type.
+
+Usage: scripts/ed25519_base_table.py > table.c
+Then replace the definition of `ed25519_base_table` in library/ed25519.c
+with the output.
+"""
+
+# Copyright The Mbed TLS Contributors
+# SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later
+
+import sys
+
+P = 2**255 - 19
+D = -121665 * pow(121666, P - 2, P) % P
+
+# RFC 8032, section 5.1
+BASE_Y = 4 * pow(5, P - 2, P) % P
+BASE_X = 15112221349535400772501151409588531511454012693041857206046113283949847762202
+
+ROWS = 16
+ROW_STRIDE = 16
+MULTIPLES = 8
+
+
+def point_add(p, q):
+    """Add two points in affine coordinates."""
+    x1, y1 = p
+    x2, y2 = q
+    dxy = D * x1 * x2 * y1 * y2 % P
+    x3 = (x1 * y2 + y1 * x2) * pow(1 + dxy, P - 2, P) % P
+    y3 = (y1 * y2 + x1 * x2) * pow(1 - dxy, P - 2, P) % P
+    return x3, y3
+
+
+def fe_limbs(v):
+    """Split v into ten limbs of alternately 26 and 25 bits."""
+    limbs = []
+    for i in range(10):
+        bits = 26 - (i & 1)
+        limbs.append(v & ((1 << bits) - 1))
+        v >>= bits
+    return limbs
+
+
+def format_fe(v, last):
+    limbs = [str(x) for x in fe_limbs(v)]
+    return ('            {{ {},\n'
+            '              {} }}{}\n').format(', '.join(limbs[:5]),
+                                             ', '.join(limbs[5:]),
+                                             '' if last else ',')
+
+
+def row_comment(k):
+    if k == 0:
+        return 'B .. 8 B'
+    return '2^{0} B .. 8 * 2^{0} B'.format(ROW_STRIDE * k)
+
+
+def main():
+    out = sys.stdout
+    out.write('static const ge_precomp ed25519_base_table'
+              '[{}][{}] = {{\n'.format(ROWS, MULTIPLES))
+    base = (BASE_X, BASE_Y)
+    for k in range(ROWS):
+        out.write('    {{   /* {} */\n'.format(row_comment(k)))
+        point = base
+        for _ in range(MULTIPLES):
+            x, y = point
+            out.write('        {\n')
+            out.write(format_fe((y + x) % P, False))
+            out.write(format_fe((y - x) % P, False))
+            out.write(format_fe(2 * D * x * y % P, True))
+            out.write('        },\n')
+            point = point_add(point, base)
+        out.write('    },\n')
+        for _ in range(ROW_STRIDE):
+            base = point_add(base, base)
+    out.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -1042,6 +1042,23 @@ run_test    "TLS 1.3 O->m: resumption" \
             -s "key exchange mode: psk" \
             -s "Select PSK ciphersuite"
 
+requires_openssl_tls1_3_with_compatible_ephemeral
+requires_all_configs_enabled MBEDTLS_SSL_SESSION_TICKETS MBEDTLS_SSL_SRV_C \
+                             MBEDTLS_SSL_TICKET_C MBEDTLS_DEBUG_C \
+                             MBEDTLS_SSL_TLS1_3_COMPATIBILITY_MODE \
+                             MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+requires_any_configs_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_PSK_ENABLED \
+                             MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_PSK_EPHEMERAL_ENABLED
+run_test    "TLS 1.3 O->m: deferred and batched NewSessionTicket" \
+            "$P_SRV debug_level=2 tickets=3 tickets_deferred=1" \
+            "$O_NEXT_CLI -msg -tls1_3" \
+            0 \
+            -s "Protocol is TLSv1.3" \
+            -s "NewSessionTicket: deferred" \
+            -s "NewSessionTicket: sending deferred tickets" \
+            -s "NewSessionTicket: 3 message(s) in record" \
+            -c "NewSessionTicket"
+
 requires_gnutls_tls1_3
 requires_all_configs_enabled MBEDTLS_SSL_SESSION_TICKETS MBEDTLS_HAVE_TIME \
                              MBEDTLS_SSL_SRV_C MBEDTLS_DEBUG_C \
@@ -1211,6 +1211,43 @@ component_test_default_cmake_gcc_asan_new_bignum () {
     tests/context-info.sh
 }
 
+component_test_new_bignum_no_nist_optim () {
+    # Without MBEDTLS_ECP_NIST_OPTIM, the NIST curves have no fixed-size
+    # reduction and keep the generic coordinate arithmetic, while other
+    # curves use the fixed-size one.
+    msg "build: cmake, gcc, ASan, new bignum, !MBEDTLS_ECP_NIST_OPTIM"
+    scripts/config.py set MBEDTLS_ECP_WITH_MPI_UINT
+    scripts/config.py unset MBEDTLS_ECP_NIST_OPTIM
+    CC=gcc cmake -D CMAKE_BUILD_TYPE:String=Asan .
+    make
+
+    msg "test: main suites (inc. selftests) (ASan build, new bignum, !MBEDTLS_ECP_NIST_OPTIM)"
+    make test
+
+    msg "test: selftest (ASan build, new bignum, !MBEDTLS_ECP_NIST_OPTIM)"
+    programs/test/selftest
+
+    msg "test: ssl-opt.sh ECC cases (ASan build, new bignum, !MBEDTLS_ECP_NIST_OPTIM)"
+    tests/ssl-opt.sh -f 'ECDH\|ECDSA\|ECJPAKE'
+}
+
+component_test_full_ed25519 () {
+    # Ed25519 is only usable through PSA when the PSA_WANT symbols, which are
+    # off by default, are enabled as well as MBEDTLS_ED25519_C.
+    msg "build: full config + PSA_WANT_ALG_PURE_EDDSA + PSA_WANT_ECC_TWISTED_EDWARDS_255"
+    scripts/config.py full
+    scripts/config.py -f "$CRYPTO_CONFIG_H" set PSA_WANT_ALG_PURE_EDDSA 1
+    scripts/config.py -f "$CRYPTO_CONFIG_H" set PSA_WANT_ECC_TWISTED_EDWARDS_255 1
+    CC=gcc cmake -D CMAKE_BUILD_TYPE:String=Asan .
+    make
+
+    msg "test: test_suite_psa_crypto, test_suite_pk (full config + Ed25519)"
+    (cd tests && ./test_suite_psa_crypto && ./test_suite_pk)
+
+    msg "test: ssl-opt.sh Ed25519 cases (full config + Ed25519)"
+    tests/ssl-opt.sh -f 'Ed25519'
+}
+
 component_test_full_cmake_gcc_asan () {
     msg "build: full config, cmake, gcc, ASan"
     scripts/config.py full
@@ -1623,6 +1660,16 @@ component_test_psa_inject_entropy () {
     make test
 }
 
+component_test_entropy_platform_buffer () {
+    msg "build: full + MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE"
+    scripts/config.py full
+    scripts/config.py set MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE 200
+    make CC=$ASAN_CC CFLAGS="$ASAN_CFLAGS" LDFLAGS="$ASAN_CFLAGS"
+
+    msg "test: full + MBEDTLS_ENTROPY_PLATFORM_BUFFER_SIZE"
+    make test
+}
+
 component_test_sw_inet_pton () {
     msg "build: default plus MBEDTLS_TEST_SW_INET_PTON"
 
@@ -1859,6 +1906,7 @@ component_test_full_no_bignum () {
     scripts/config.py unset MBEDTLS_X509_CSR_WRITE_C
     scripts/config.py unset MBEDTLS_PKCS7_C
     scripts/config.py unset MBEDTLS_SSL_SERVER_NAME_INDICATION
+    scripts/config.py unset MBEDTLS_SSL_CERT_STORE_C
     scripts/config.py unset MBEDTLS_SSL_ASYNC_PRIVATE
     scripts/config.py unset MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
 
@@ -2125,8 +2173,8 @@ component_test_small_ssl_in_content_len () {
     CC=$ASAN_CC cmake -D CMAKE_BUILD_TYPE:String=Asan .
     make
 
-    msg "test: small SSL_IN_CONTENT_LEN - ssl-opt.sh MFL tests"
-    tests/ssl-opt.sh -f "Max fragment"
+    msg "test: small SSL_IN_CONTENT_LEN - ssl-opt.sh MFL and reassembly tests"
+    tests/ssl-opt.sh -f "Max fragment\|Handshake message reassembly"
 }
 
 component_test_small_ssl_dtls_max_buffering () {
@@ -4316,6 +4364,20 @@ component_build_aes_variations() {
         "MBEDTLS_AESNI_C" "MBEDTLS_AESCE_C" "MBEDTLS_AES_ONLY_128_BIT_KEY_LENGTH"
 }
 
+component_test_threading_stats () {
+    msg "build: default config + MBEDTLS_THREADING_STATS, make, gcc"
+    scripts/config.py set MBEDTLS_THREADING_C
+    scripts/config.py set MBEDTLS_THREADING_PTHREAD
+    scripts/config.py set MBEDTLS_THREADING_STATS
+    make CC=gcc CFLAGS='-Werror -Wall -Wextra -O2'
+
+    msg "test: default config + MBEDTLS_THREADING_STATS"
+    make test
+
+    msg "run: ssl_handshake_bench with 4 threads"
+    programs/ssl/ssl_handshake_bench 20 4
+}
+
 component_test_no_platform () {
     # Full configuration build, without platform support, file IO and net sockets.
     # This should catch missing mbedtls_printf definitions, and by disabling file
@@ -5666,6 +5728,7 @@ component_test_tls13_only_psk () {
     scripts/config.py unset MBEDTLS_X509_CRT_PARSE_C
     scripts/config.py unset MBEDTLS_X509_RSASSA_PSS_SUPPORT
     scripts/config.py unset MBEDTLS_SSL_SERVER_NAME_INDICATION
+    scripts/config.py unset MBEDTLS_SSL_CERT_STORE_C
     scripts/config.py unset MBEDTLS_ECDSA_C
     scripts/config.py unset MBEDTLS_PKCS1_V21
     scripts/config.py unset MBEDTLS_PKCS7_C
@@ -5716,6 +5779,7 @@ component_test_tls13_only_psk_ephemeral () {
     scripts/config.py unset MBEDTLS_X509_CRT_PARSE_C
     scripts/config.py unset MBEDTLS_X509_RSASSA_PSS_SUPPORT
     scripts/config.py unset MBEDTLS_SSL_SERVER_NAME_INDICATION
+    scripts/config.py unset MBEDTLS_SSL_CERT_STORE_C
     scripts/config.py unset MBEDTLS_ECDSA_C
     scripts/config.py unset MBEDTLS_PKCS1_V21
     scripts/config.py unset MBEDTLS_PKCS7_C
@@ -5736,6 +5800,7 @@ component_test_tls13_only_psk_ephemeral_ffdh () {
     scripts/config.py unset MBEDTLS_X509_CRT_PARSE_C
     scripts/config.py unset MBEDTLS_X509_RSASSA_PSS_SUPPORT
     scripts/config.py unset MBEDTLS_SSL_SERVER_NAME_INDICATION
+    scripts/config.py unset MBEDTLS_SSL_CERT_STORE_C
     scripts/config.py unset MBEDTLS_ECDSA_C
     scripts/config.py unset MBEDTLS_PKCS1_V21
     scripts/config.py unset MBEDTLS_PKCS7_C
@@ -5756,6 +5821,7 @@ component_test_tls13_only_psk_all () {
     scripts/config.py unset MBEDTLS_X509_CRT_PARSE_C
     scripts/config.py unset MBEDTLS_X509_RSASSA_PSS_SUPPORT
     scripts/config.py unset MBEDTLS_SSL_SERVER_NAME_INDICATION
+    scripts/config.py unset MBEDTLS_SSL_CERT_STORE_C
     scripts/config.py unset MBEDTLS_ECDSA_C
     scripts/config.py unset MBEDTLS_PKCS1_V21
     scripts/config.py unset MBEDTLS_PKCS7_C
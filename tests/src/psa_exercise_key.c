@@ -1297,6 +1297,15 @@ int mbedtls_test_key_consistency_psa_pk(mbedtls_svc_key_id_t psa_key,
             break;
 #endif /* MBEDTLS_PK_HAVE_ECC_KEYS && !MBEDTLS_PK_USE_PSA_EC_DATA */
 
+#if defined(MBEDTLS_ED25519_C)
+        case MBEDTLS_PK_ED25519:
+            TEST_EQUAL(PSA_KEY_TYPE_ECC_GET_FAMILY(psa_type),
+                       PSA_ECC_FAMILY_TWISTED_EDWARDS);
+            pk_public = mbedtls_pk_ed25519(*pk)->pub;
+            pk_public_length = MBEDTLS_ED25519_KEY_SIZE;
+            break;
+#endif /* MBEDTLS_ED25519_C */
+
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
         case MBEDTLS_PK_OPAQUE:
             PSA_ASSERT(psa_get_key_attributes(pk->priv_id, &pk_attributes));
@@ -5173,6 +5173,104 @@ run_test    "Record Size Limit: TLS 1.3 m->m: both peer comply with record size
 
 # End of Record size limit tests
 
+# Tests for dynamic record sizing
+
+requires_max_content_len 16384
+run_test    "Dynamic record sizing: disabled (default)" \
+            "$P_SRV response_size=10000" \
+            "$P_CLI" \
+            0 \
+            -s "10000 bytes written in 1 fragments" \
+            -c "Read from server: 10000 bytes read"
+
+requires_max_content_len 16384
+run_test    "Dynamic record sizing: ramp up after 4000 bytes" \
+            "$P_SRV response_size=10000 dyn_record_size=1400 dyn_record_ramp=4000" \
+            "$P_CLI" \
+            0 \
+            -s "10000 bytes written in 4 fragments"
+
+requires_max_content_len 16384
+run_test    "Dynamic record sizing: small records only" \
+            "$P_SRV response_size=10000 dyn_record_size=1400 dyn_record_ramp=65536" \
+            "$P_CLI" \
+            0 \
+            -s "10000 bytes written in 8 fragments"
+
+requires_max_content_len 16384
+run_test    "Dynamic record sizing: size below record overhead" \
+            "$P_SRV response_size=10000 dyn_record_size=10 dyn_record_ramp=65536" \
+            "$P_CLI" \
+            0 \
+            -s "10000 bytes written in 1 fragments" \
+            -c "Read from server: 10000 bytes read"
+
+requires_config_enabled MBEDTLS_SSL_PROTO_DTLS
+requires_max_content_len 4096
+run_test    "Dynamic record sizing: ignored with DTLS" \
+            "$P_SRV dtls=1 response_size=4000 dyn_record_size=1400 dyn_record_ramp=65536" \
+            "$P_CLI dtls=1" \
+            0 \
+            -s "4000 bytes written in 1 fragments"
+
+# End of dynamic record sizing tests
+
+# Tests for handshake message reassembly
+
+requires_openssl_next
+requires_config_enabled MBEDTLS_SSL_PROTO_TLS1_2
+requires_pk_alg "ECDSA"
+run_test    "Handshake message reassembly: server records of 512 bytes, TLS 1.2" \
+            "$O_NEXT_SRV -tls1_2 -max_send_frag 512" \
+            "$P_CLI debug_level=2" \
+            0 \
+            -c "reassembling handshake message: type = 11" \
+            -c "handshake message reassembled" \
+            -C "mbedtls_ssl_handshake returned" \
+            -c "Protocol is TLSv1.2"
+
+requires_openssl_tls1_3_with_compatible_ephemeral
+requires_all_configs_enabled MBEDTLS_SSL_CLI_C MBEDTLS_SSL_PROTO_TLS1_3 \
+                             MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+requires_pk_alg "ECDSA"
+run_test    "Handshake message reassembly: server records of 512 bytes, TLS 1.3" \
+            "$O_NEXT_SRV -tls1_3 -max_send_frag 512" \
+            "$P_CLI debug_level=2" \
+            0 \
+            -c "reassembling handshake message: type = 11" \
+            -c "handshake message reassembled" \
+            -C "mbedtls_ssl_handshake returned" \
+            -c "Protocol is TLSv1.3"
+
+requires_openssl_next
+requires_config_enabled MBEDTLS_SSL_PROTO_TLS1_2
+requires_pk_alg "ECDSA"
+run_test    "Handshake message reassembly: client records of 512 bytes, TLS 1.2" \
+            "$P_SRV debug_level=2 auth_mode=required" \
+            "$O_NEXT_CLI -tls1_2 -max_send_frag 512 \
+                -cert data_files/server5.crt -key data_files/server5.key" \
+            0 \
+            -s "reassembling handshake message: type = 11" \
+            -s "handshake message reassembled" \
+            -S "mbedtls_ssl_handshake returned" \
+            -s "Protocol is TLSv1.2"
+
+requires_openssl_tls1_3_with_compatible_ephemeral
+requires_all_configs_enabled MBEDTLS_SSL_SRV_C MBEDTLS_SSL_PROTO_TLS1_3 \
+                             MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+requires_pk_alg "ECDSA"
+run_test    "Handshake message reassembly: client records of 512 bytes, TLS 1.3" \
+            "$P_SRV debug_level=2 auth_mode=required" \
+            "$O_NEXT_CLI -tls1_3 -max_send_frag 512 \
+                -cert data_files/server5.crt -key data_files/server5.key" \
+            0 \
+            -s "reassembling handshake message: type = 11" \
+            -s "handshake message reassembled" \
+            -S "mbedtls_ssl_handshake returned" \
+            -s "Protocol is TLSv1.3"
+
+# End of handshake message reassembly tests
+
 # Tests for renegotiation
 
 # G_NEXT_SRV is used in renegotiation tests becuase of the increased
@@ -6424,6 +6522,109 @@ run_test    "SNI: no matching cert" \
             -c "mbedtls_ssl_handshake returned" \
             -c "SSL - A fatal alert message was received from our peer"
 
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_key_exchange_with_cert_in_tls12_or_tls13_enabled
+run_test    "SNI: certificate store, matching cert 1" \
+            "$P_SRV debug_level=3 \
+             crt_file=data_files/server5.crt key_file=data_files/server5.key \
+             sni_store=data_files/server2.crt,data_files/server2.key,data_files/server1-nospace.crt,data_files/server1.key" \
+            "$P_CLI server_name=localhost" \
+            0 \
+            -s "parse ServerName extension" \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=PolarSSL Test CA" \
+            -c "subject name *: C=NL, O=PolarSSL, CN=localhost"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_key_exchange_with_cert_in_tls12_or_tls13_enabled
+run_test    "SNI: certificate store, matching cert 2" \
+            "$P_SRV debug_level=3 \
+             crt_file=data_files/server5.crt key_file=data_files/server5.key \
+             sni_store=data_files/server2.crt,data_files/server2.key,data_files/server1-nospace.crt,data_files/server1.key" \
+            "$P_CLI server_name=polarssl.example" \
+            0 \
+            -s "parse ServerName extension" \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=PolarSSL Test CA" \
+            -c "subject name *: C=NL, O=PolarSSL, CN=polarssl.example"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_any_configs_enabled $TLS1_2_KEY_EXCHANGES_WITH_CERT
+run_test    "SNI: certificate store, wildcard name" \
+            "$P_SRV debug_level=3 \
+             crt_file=data_files/server5.crt key_file=data_files/server5.key \
+             sni_store=data_files/cert_example_multi.crt,data_files/rsa_pkcs1_1024_clear.pem" \
+            "$P_CLI server_name=www.example.org force_version=tls12 auth_mode=optional" \
+            0 \
+            -s "parse ServerName extension" \
+            -c "subject name *: C=NL, O=PolarSSL, CN=www.example.com"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_any_configs_enabled $TLS1_2_KEY_EXCHANGES_WITH_CERT
+run_test    "SNI: certificate store, no matching cert, default cert" \
+            "$P_SRV debug_level=3 \
+             crt_file=data_files/server5.crt key_file=data_files/server5.key \
+             sni_store=data_files/server2.crt,data_files/server2.key" \
+            "$P_CLI server_name=nonesuch.example force_version=tls12 auth_mode=optional" \
+            0 \
+            -s "no certificate in store for server name" \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=Polarssl Test EC CA" \
+            -c "subject name *: C=NL, O=PolarSSL, CN=localhost"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_key_exchange_with_cert_in_tls12_or_tls13_enabled
+run_test    "SNI: certificate store, no matching cert, no default cert" \
+            "$P_SRV debug_level=3 crt_file=none key_file=none \
+             sni_store=data_files/server2.crt,data_files/server2.key" \
+            "$P_CLI server_name=nonesuch.example" \
+            1 \
+            -s "no certificate in store for server name" \
+            -s "ssl_sni_wrapper() returned" \
+            -c "SSL - A fatal alert message was received from our peer"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_enabled MBEDTLS_SSL_PROTO_TLS1_3
+requires_config_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_config_enabled MBEDTLS_PKCS1_V21
+requires_pk_alg "ECDSA"
+run_test    "SNI: certificate store, TLS 1.3, RSA by signature algorithm" \
+            "$P_SRV debug_level=3 crt_file=none key_file=none \
+             sni_store=data_files/server5.crt,data_files/server5.key,data_files/server2.crt,data_files/server2.key" \
+            "$P_CLI server_name=localhost force_version=tls13 sig_algs=rsa_pss_rsae_sha256" \
+            0 \
+            -s "skipping certificate: no usable signature algorithm" \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=PolarSSL Test CA"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_enabled MBEDTLS_SSL_PROTO_TLS1_3
+requires_config_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+requires_config_enabled MBEDTLS_PKCS1_V21
+requires_pk_alg "ECDSA"
+run_test    "SNI: certificate store, TLS 1.3, ECDSA by signature algorithm" \
+            "$P_SRV debug_level=3 crt_file=none key_file=none \
+             sni_store=data_files/server2.crt,data_files/server2.key,data_files/server5.crt,data_files/server5.key" \
+            "$P_CLI server_name=localhost force_version=tls13 sig_algs=ecdsa_secp256r1_sha256" \
+            0 \
+            -s "skipping certificate: no usable signature algorithm" \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=Polarssl Test EC CA"
+
+requires_config_enabled MBEDTLS_SSL_CERT_STORE_C
+requires_config_enabled MBEDTLS_SSL_PROTO_TLS1_2
+requires_config_enabled MBEDTLS_KEY_EXCHANGE_ECDHE_RSA_ENABLED
+requires_pk_alg "ECDSA"
+requires_config_disabled MBEDTLS_X509_REMOVE_INFO
+run_test    "SNI: certificate store, TLS 1.2, RSA by ciphersuite" \
+            "$P_SRV debug_level=3 crt_file=none key_file=none \
+             sni_store=data_files/server5.crt,data_files/server5.key,data_files/server2.crt,data_files/server2.key" \
+            "$P_CLI server_name=localhost force_version=tls12 \
+             force_ciphersuite=TLS-ECDHE-RSA-WITH-AES-128-GCM-SHA256" \
+            0 \
+            -c "issuer name *: C=NL, O=PolarSSL, CN=PolarSSL Test CA"
+
 requires_key_exchange_with_cert_in_tls12_or_tls13_enabled
 run_test    "SNI: client auth no override: optional" \
             "$P_SRV debug_level=3 auth_mode=optional \
@@ -13056,6 +13257,40 @@ run_test    "TLS 1.3: Server side check - openssl with client authentication" \
             -s "=> parse client hello" \
             -s "<= parse client hello"
 
+requires_config_enabled MBEDTLS_DEBUG_C
+requires_config_enabled MBEDTLS_ED25519_C
+requires_config_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+run_test    "TLS 1.3: m->m Ed25519 certificate" \
+            "$P_SRV debug_level=3 force_version=tls13 crt_file=data_files/server-ed25519.crt key_file=data_files/ed25519_prv.pem" \
+            "$P_CLI debug_level=3 ca_file=data_files/test-ca-ed25519.crt" \
+            0 \
+            -s "CertificateVerify signature with ed25519" \
+            -c "Certificate Verify: Signature algorithm ( 0807 )" \
+            -C "! The certificate is not correctly signed by the trusted CA"
+
+requires_openssl_tls1_3_with_compatible_ephemeral
+requires_config_enabled MBEDTLS_DEBUG_C
+requires_config_enabled MBEDTLS_ED25519_C
+requires_config_enabled MBEDTLS_SSL_SRV_C
+requires_config_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+run_test    "TLS 1.3: O->m Ed25519 certificate" \
+            "$P_SRV debug_level=3 crt_file=data_files/server-ed25519.crt key_file=data_files/ed25519_prv.pem tickets=0" \
+            "$O_NEXT_CLI -tls1_3 -no_middlebox -CAfile data_files/test-ca-ed25519.crt -verify_return_error" \
+            0 \
+            -s "CertificateVerify signature with ed25519"
+
+requires_openssl_tls1_3_with_compatible_ephemeral
+requires_config_enabled MBEDTLS_DEBUG_C
+requires_config_enabled MBEDTLS_ED25519_C
+requires_config_enabled MBEDTLS_SSL_CLI_C
+requires_config_enabled MBEDTLS_SSL_TLS1_3_KEY_EXCHANGE_MODE_EPHEMERAL_ENABLED
+run_test    "TLS 1.3: m->O Ed25519 certificate" \
+            "$O_NEXT_SRV_NO_CERT -cert data_files/server-ed25519.crt -key data_files/ed25519_prv.pem -tls1_3 -no_middlebox -num_tickets 0" \
+            "$P_CLI debug_level=3 ca_file=data_files/test-ca-ed25519.crt" \
+            0 \
+            -c "Protocol is TLSv1.3" \
+            -c "Certificate Verify: Signature algorithm ( 0807 )"
+
 requires_gnutls_tls1_3
 requires_gnutls_next_no_ticket
 requires_config_enabled MBEDTLS_DEBUG_C